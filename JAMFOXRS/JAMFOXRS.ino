@@ -8,6 +8,8 @@
 #include "fox_task.h"
 #include "fox_serial.h"
 #include "fox_ble.h"
+#include "fox_i2c.h"
+#include "fox_storage.h"
 
 // =============================================
 // GLOBAL VARIABLES
@@ -31,6 +33,10 @@ void setup() {
     systemStartTime = millis();
     printSystemStartup();
     
+    #if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 2
+    // Buffer Wire default 128 byte: perbesar supaya flush OLED bisa burst (harus sebelum begin)
+    Wire.setBufferSize(I2C_WIRE_BUFFER_BYTES);
+    #endif
     Wire.begin(SDA_PIN, SCL_PIN);
     Wire.setClock(100000);
     #ifdef ESP32
@@ -38,6 +44,9 @@ void setup() {
     #endif
     delay(100);
     
+    // Bus manager + clock governor (transaksi langsung sampai I2C_Bus task jalan)
+    initI2CBus();
+    
     initDisplay();  // Display initialization FIRST
     
     if (initRTC()) {
@@ -45,6 +54,9 @@ void setup() {
         setRTCFromCompileTime();
     }
     
+    // Odometer, trip, SOC terakhir & setting dari AT24C32
+    initStorage();
+    
     #ifdef ESP32
     initFreeRTOS();
     if (!initCAN()) {
@@ -101,7 +113,15 @@ void loop() {
     processBLE();
     #endif
     
-    // 5. WATCHDOG
+    // 5. RTC SOFTWARE CLOCK (normalnya dijalankan display task)
+    if(displayTaskHandle == NULL) {
+        rtcServiceTick();
+    }
+    
+    // 6. PERSISTENCE (odometer/trip, commit batch ke EEPROM)
+    storageServiceTick();
+    
+    // 7. WATCHDOG
     static unsigned long lastLoopHeartbeat = now;
     if(now - lastLoopHeartbeat > 10000) {  // Reset setelah 10 detik tanpa heartbeat
         lastLoopHeartbeat = now;
@@ -117,6 +137,9 @@ void loop() {
         handleButtonPress();
     }
     
+    rtcServiceTick();
+    storageServiceTick();
+    
     static unsigned long lastDisplayUpdate = 0;
     if(millis() - lastDisplayUpdate > 5000) {
         safeDisplayUpdate(currentPage);
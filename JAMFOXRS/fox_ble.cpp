@@ -7,33 +7,225 @@
 #include "fox_page.h"
 #include "fox_rtc.h"
 #include "fox_task.h"
-#include <BLEDevice.h>
-#include <BLEServer.h>
-#include <BLEUtils.h>
-#include <BLE2902.h>
+#include "fox_bleproto.h"
+#include "fox_blecmd.h"
+#include "fox_bletransport.h"
+#include <esp_heap_caps.h>
+#include <stdarg.h>
 
 // =============================================
 // BLE GLOBAL VARIABLES
 // =============================================
-static BLEServer* pServer = nullptr;
-static BLECharacteristic* pCharacteristic = nullptr;
-volatile bool deviceConnected = false;
-static bool oldDeviceConnected = false;
+volatile bool deviceConnected = false;              // Minimal satu client terhubung
+static volatile bool advertisingRestart = false;    // Client lepas: advertising lagi dari processBLE
 
-// BLE TX State
-static char bleTxBuf[2200];
-static uint16_t bleTxLen = 0;
-static uint16_t bleTxOffset = 0;
-static bool bleTxInProgress = false;
-static uint32_t lastFastSend = 0;
-static uint32_t lastSlowSend = 0;
+// Protokol: JSON atau biner, dipilih tiap client lewat set_proto
+typedef enum {
+    BLE_FORMAT_JSON = 0,
+    BLE_FORMAT_BINARY,
+    BLE_FORMAT_DELTA,           // Biner, hanya field yang berubah
+    BLE_FORMAT_COUNT
+} BleFormat;
+
+static const char* const FORMAT_NAMES[BLE_FORMAT_COUNT] = {"JSON", "BINARY", "DELTA"};
+
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t notifications;
+    uint32_t airtimeUs;         // Estimasi total waktu radio
+    uint32_t bytesPerSec;       // Jendela BLE_STATS_WINDOW_MS terakhir
+    uint32_t notificationsPerSec;
+    uint32_t windowBytes;
+    uint32_t windowNotifications;
+} BleFormatStats;
+
+static uint16_t bleBinSeq = 0;          // Frame biner bersama; delta pakai seq per client
+static BleFormatStats formatStats[BLE_FORMAT_COUNT];
+static uint32_t statsWindowStart = 0;
+#ifdef ESP32
+static SemaphoreHandle_t bleStreamMutex = NULL;     // Task stream vs deactivate dari loop
+#endif
+
+// Koneksi: MTU, congestion stack, parameter koneksi
+typedef enum {
+    CONN_PROFILE_NONE = 0,
+    CONN_PROFILE_STREAM,
+    CONN_PROFILE_IDLE
+} ConnProfile;
+
+typedef struct {
+    uint32_t chunksSent;
+    uint32_t chunksDeferred;            // Pump berhenti karena stack congested
+    uint32_t chunksRetried;             // Notify gagal, chunk dicoba lagi
+    uint32_t framesDropped;             // Gagal terus / koneksi putus di tengah frame
+    uint32_t congestionEvents;
+    uint32_t connParamRequests;
+} BlePumpStats;
+
+static BlePumpStats pumpStats = {0};
+
+// Biaya CPU serializer JSON per frame (akumulasi semua chunk)
+static uint32_t jsonLastFrameUs = 0;
+static uint32_t jsonMaxFrameUs = 0;
+static uint16_t jsonLastFrameBytes = 0;
+
+// Statistik delta (semua client)
+typedef struct {
+    uint32_t keyframes;
+    uint32_t deltas;
+    uint32_t requestedKeyframes;        // Diminta client ({"cmd":"keyframe"})
+    uint32_t fieldsSent;
+    uint32_t fieldsSkipped;             // Field tidak berubah, tidak dikirim
+    uint32_t bytesSaved;                // Dibanding frame biner biasa dengan mask sama
+} BleDeltaStats;
+
+static BleDeltaStats deltaStats = {0};
+
+// Langganan grup: tidak aktif = jadwal fast/full bawaan
+typedef struct {
+    uint32_t intervalMs;                // 0 = tidak berlangganan
+    uint32_t lastSendUs;                // 0 = kirim secepatnya
+    uint32_t sends;
+} BleSubGroup;
+
+static const uint32_t SUB_MIN_INTERVAL_MS[BLE_GROUP_COUNT] = {
+    BLE_SUB_MIN_MOTION_MS, BLE_SUB_MIN_PACK_MS, BLE_SUB_MIN_CELLS_MS,
+    BLE_SUB_MIN_TEMPS_MS, BLE_SUB_MIN_CHARGER_MS
+};
+
+static uint32_t subFrames = 0;
+static uint32_t subCoalesced = 0;       // Grup ikut frame lebih awal (BLE_SUB_COALESCE_MS)
+
+// =============================================
+// BLE CLIENTS
+// =============================================
+// Tiap koneksi punya handle, MTU, format, jadwal, langganan dan state delta
+// sendiri. Sesi (format + langganan) direset saat client lepas; entry kosong
+// berikutnya dipakai koneksi baru
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t notifications;
+    uint32_t dropped;
+    uint32_t windowBytes;
+    uint32_t bytesPerSec;
+} BleClientStats;
+
+typedef struct {
+    bool connected;
+    uint16_t connId;                    // Handle koneksi dari backend transport
+    uint16_t mtu;
+    bool congested;
+    BleFormat format;
+    bool formatChosen;                  // Client sudah set_proto, default tidak dipakai lagi
+    int8_t slot;                        // Frame yang sedang diterima, -1 = idle
+    uint8_t retries;                    // Kirim chunk gagal berturut-turut
+    // Jadwal fast/full bawaan (us, 0 = kirim secepatnya)
+    uint32_t lastFastUs;
+    uint32_t lastSlowUs;
+    // Langganan grup
+    bool subActive;
+    uint8_t subMask;                    // BLE_GROUP_BIT grup yang berlangganan
+    BleSubGroup subGroups[BLE_GROUP_COUNT];
+    // Delta: nilai terakhir yang sudah dikirim ke client ini
+    BleBinFields deltaLastSent;
+    bool deltaValid;                    // false = frame berikutnya keyframe
+    bool keyframeRequested;
+    uint32_t lastKeyframeMs;
+    uint16_t binSeq;
+    ConnProfile connProfile;
+    uint32_t lastConnParamMs;
+    // Reply command: menunggu frame yang sedang diterima client selesai
+    char reply[BLE_CMD_REPLY_MAX];
+    uint8_t replyLen;
+    BleClientStats stats;
+} BleClient;
+
+static BleClient bleClients[BLE_MAX_CLIENTS];
+
+static uint16_t clientChunkCap(const BleClient &c) {
+    uint16_t mtu = c.mtu;
+    if (mtu < BLE_DEFAULT_MTU) mtu = BLE_DEFAULT_MTU;
+    if (mtu > BLE_REQUESTED_MTU) mtu = BLE_REQUESTED_MTU;
+    return mtu - BLE_ATT_HEADER_BYTES;
+}
+
+static uint8_t clientBit(const BleClient &c) {
+    return 1 << (&c - bleClients);
+}
+
+static BleClient* findClient(uint16_t connId) {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (bleClients[i].connected && bleClients[i].connId == connId) {
+            return &bleClients[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t connectedClients() {
+    uint8_t count = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (bleClients[i].connected) count++;
+    }
+    return count;
+}
+
+// Konteks client untuk command dari serial (BLE BENCH, tanpa efek samping):
+// client pertama yang terhubung, atau entry 0 (dipakai koneksi berikutnya)
+static BleClient& serialClient() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (bleClients[i].connected) return bleClients[i];
+    }
+    return bleClients[0];
+}
+
+// =============================================
+// BLE TX SLOTS (FRAME BERSAMA)
+// =============================================
+// Satu slot = satu frame yang sedang dipompa. Client yang di tick yang sama
+// minta frame identik (format + isi) ikut slot yang sama: frame
+// diserialisasi sekali, tiap chunk dikirim ke semua member. Chunk baru
+// diambil setelah semua member menerima chunk sekarang (ukuran chunk =
+// MTU terkecil member). Delta selalu satu member (isinya per client)
+typedef struct {
+    bool active;
+    bool reply;                         // Reply command di text, bukan telemetry
+    uint8_t format;                     // BleFormat
+    uint8_t kind;                       // BleJsonKind
+    uint8_t groups;                     // Hanya untuk BLE_JSON_GROUPS
+    uint8_t members;                    // clientBit penerima frame ini
+    uint8_t pending;                    // Member yang belum menerima chunk sekarang
+    uint16_t chunkCap;
+    uint16_t chunkLen;                  // Chunk tertahan (notify gagal), dikirim ulang dulu
+    uint16_t binLen;
+    uint16_t binOffset;
+    uint32_t chunkSinceMs;
+    uint32_t serializeUs;
+    union {
+        BleJsonStream json;             // JSON langsung dari serializer streaming
+        uint8_t bin[BLE_BIN_MAX_FRAME];
+        uint8_t text[BLE_CMD_REPLY_MAX + 1];    // Reply command + '\n'
+    };
+    uint8_t chunk[BLE_MAX_CHUNK];
+} BleTxSlot;
+
+static BleTxSlot txSlots[BLE_MAX_CLIENTS];
+
+typedef struct {
+    uint32_t serialized;                // Frame yang dibangun
+    uint32_t delivered;                 // Frame per client (termasuk yang ikut slot bersama)
+    uint32_t stallDrops;                // Member lambat dilepas dari frame bersama
+} BleFanoutStats;
+
+static BleFanoutStats fanoutStats = {0};
 
 // Heartbeat counter
 static unsigned long heartbeatCounter = 0;
 
 // BLE Activation State
 static bool bleActive = false;
-static bool bleInitialized = false;
 static unsigned long bleActivationStartTime = 0;
 static bool activationPending = false;
 static unsigned long bleLastConnectionTime = 0;
@@ -53,77 +245,33 @@ extern Adafruit_SSD1306 display;
 // =============================================
 // FORWARD DECLARATIONS
 // =============================================
-static void hideAppModeDisplay();
+static void releaseTxSlots();
+static void leaveSlot(BleTxSlot &slot, BleClient &c, bool dropped);
 
 // =============================================
-// HELPER FUNCTIONS FOR JSON PARSING
+// HELPER FUNCTIONS FOR COMMAND VALUES
 // =============================================
-
-// Ekstrak nilai string dari JSON: "key":"value"
-static String extractJsonString(const String& json, const String& key) {
-    String searchKey = "\"" + key + "\":\"";
-    int keyPos = json.indexOf(searchKey);
-    if (keyPos == -1) return "";
-    
-    int startPos = keyPos + searchKey.length();
-    int endPos = json.indexOf("\"", startPos);
-    if (endPos == -1) return "";
-    
-    return json.substring(startPos, endPos);
-}
-
-// Ekstrak nilai integer dari JSON: "key":123
-static int extractJsonInt(const String& json, const String& key, int defaultValue = 0) {
-    String searchKey = "\"" + key + "\":";
-    int keyPos = json.indexOf(searchKey);
-    if (keyPos == -1) return defaultValue;
-    
-    int startPos = keyPos + searchKey.length();
-    int endPos = startPos;
-    
-    // Cari akhir angka (koma atau kurung tutup)
-    while (endPos < json.length()) {
-        char c = json.charAt(endPos);
-        if (c == ',' || c == '}' || c == ']') break;
-        endPos++;
+static bool parseDigits(const char *p, uint8_t count, int &value) {
+    value = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        value = value * 10 + (p[i] - '0');
     }
-    
-    String numStr = json.substring(startPos, endPos);
-    numStr.trim();
-    return numStr.toInt();
-}
-
-// Ekstrak nilai boolean dari JSON: "key":true
-static bool extractJsonBool(const String& json, const String& key, bool defaultValue = false) {
-    String searchKey = "\"" + key + "\":";
-    int keyPos = json.indexOf(searchKey);
-    if (keyPos == -1) return defaultValue;
-    
-    int startPos = keyPos + searchKey.length();
-    if (json.substring(startPos, startPos + 4) == "true") return true;
-    if (json.substring(startPos, startPos + 5) == "false") return false;
-    
-    return defaultValue;
+    return true;
 }
 
-// Parse string waktu "HH:MM:SS"
-static bool parseTimeString(const String& timeStr, int& hour, int& minute, int& second) {
-    if (timeStr.length() < 8) return false;
-    
-    hour = timeStr.substring(0, 2).toInt();
-    minute = timeStr.substring(3, 5).toInt();
-    second = timeStr.substring(6, 8).toInt();
+// Parse waktu "HH:MM:SS" dari span (tanpa NUL)
+static bool parseTimeSpan(const char *s, uint16_t len, int& hour, int& minute, int& second) {
+    if (len < 8) return false;
+    if (!parseDigits(s, 2, hour) || !parseDigits(s + 3, 2, minute) || !parseDigits(s + 6, 2, second)) return false;
     
     return (hour >= 0 && hour < 24 && minute >= 0 && minute < 60 && second >= 0 && second < 60);
 }
 
-// Parse string tanggal "DD/MM/YYYY"
-static bool parseDateString(const String& dateStr, int& day, int& month, int& year) {
-    if (dateStr.length() < 10) return false;
-    
-    day = dateStr.substring(0, 2).toInt();
-    month = dateStr.substring(3, 5).toInt();
-    year = dateStr.substring(6, 10).toInt();
+// Parse tanggal "DD/MM/YYYY" dari span (tanpa NUL)
+static bool parseDateSpan(const char *s, uint16_t len, int& day, int& month, int& year) {
+    if (len < 10) return false;
+    if (!parseDigits(s, 2, day) || !parseDigits(s + 3, 2, month) || !parseDigits(s + 6, 4, year)) return false;
     
     return (day >= 1 && day <= 31 && month >= 1 && month <= 12 && year >= 2000 && year <= 2099);
 }
@@ -190,159 +338,690 @@ static uint32_t getSlowUpdateInterval() {
 }
 
 // =============================================
-// HIDE APP MODE
+// SUBSCRIPTION
 // =============================================
-static void hideAppModeDisplay() {
-    if (!displayReady || !appModeDisplayed) return;
+// Semua grup langganan kirim di tick berikutnya (format baru, keyframe)
+static void resetSubscriptionSchedule(BleClient &c) {
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) c.subGroups[g].lastSendUs = 0;
+}
+
+static void clearSubscription(BleClient &c) {
+    c.subActive = false;
+    c.subMask = 0;
+    memset(c.subGroups, 0, sizeof(c.subGroups));
+}
+
+// Interval tercepat yang sedang dijadwalkan (profil koneksi)
+static uint32_t fastestStreamInterval(const BleClient &c) {
+    if (!c.subActive) return getFastUpdateInterval();
+    uint32_t fastest = BLE_SUB_MAX_INTERVAL_MS;
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        if (c.subGroups[g].intervalMs > 0 && c.subGroups[g].intervalMs < fastest) fastest = c.subGroups[g].intervalMs;
+    }
+    return fastest;
+}
+
+// =============================================
+// BLE COMMANDS (fox_blecmd)
+// =============================================
+// Handler menerima pesan yang sudah diparse dan menulis reply ke buffer
+// tetap; efeknya hanya ke client pengirim. apply = false: validasi + reply
+// saja tanpa efek samping (dipakai BLE BENCH). Return panjang
+// reply, 0 = tidak ada reply
+typedef int (*BleCmdHandler)(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply);
+
+typedef struct {
+    const char *name;
+    BleCmdHandler handler;
+    const char *sample;         // Payload contoh: benchmark & seed corpus host/fuzz
+} BleCommand;
+
+typedef struct {
+    uint32_t received;
+    uint32_t unknown;
+    uint32_t parseErrors[BLE_CMD_STATUS_COUNT];
+    uint32_t lastUs;            // Parse + handler
+    uint32_t maxUs;
+    uint32_t repliesReplaced;   // Reply belum terkirim ditimpa command berikutnya
+} BleCmdStats;
+
+static BleCmdStats cmdStats = {0};
+
+static int replyf(char *reply, size_t cap, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(reply, cap, format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    return (len >= (int)cap) ? (int)cap - 1 : len;
+}
+
+// {"cmd":"set_time","time":"HH:MM:SS","date":"DD/MM/YYYY","dayofweek":1-7}
+static int cmdSetTime(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply) {
+    const char *timeStr = "";
+    const char *dateStr = "";
+    uint16_t timeLen = 0, dateLen = 0;
+    bleCmdString(msg, "time", timeStr, timeLen);
+    bleCmdString(msg, "date", dateStr, dateLen);
+    int dayOfWeek = bleCmdInt(msg, "dayofweek", 1);
     
-    serialPrintfln("[BLE] Switching from APP MODE to Clock Page");
+    int hour = 0, minute = 0, second = 0;
+    int day = 0, month = 0, year = 0;
+    bool timeValid = parseTimeSpan(timeStr, timeLen, hour, minute, second);
+    bool dateValid = parseDateSpan(dateStr, dateLen, day, month, year);
+    bool dowValid = (dayOfWeek >= 1 && dayOfWeek <= 7);
     
-    delay(50);
+    if (!(timeValid && dateValid && dowValid)) {
+        if (apply) serialPrintfln("[BLE] Invalid time/date data");
+        return replyf(reply, cap, "{\"status\":\"error\",\"cmd\":\"set_time\",\"message\":\"Invalid data\"}");
+    }
     
-    appModeDisplayed = false;
-    waitingForConnection = false;
-    currentPage = 1;
+    if (apply) {
+        setRTCTime(year, month, day, hour, minute, second, dayOfWeek);
+        serialPrintflnAlways("[BLE] RTC updated: %02d:%02d:%02d %02d/%02d/%04d DOW:%d", 
+                            hour, minute, second, day, month, year, dayOfWeek);
+        
+        // Update display jika di page jam
+        if (currentPage == 1) {
+            safeDisplayUpdate(currentPage);
+        }
+    }
+    return replyf(reply, cap, "{\"status\":\"ok\",\"cmd\":\"set_time\"}");
+}
+
+// {"cmd":"set_proto","fmt":"json"|"bin"|"delta"}
+static int cmdSetProto(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply) {
+    const char *fmt = "";
+    uint16_t fmtLen = 0;
+    bleCmdString(msg, "fmt", fmt, fmtLen);
     
-    transitionFromAppModeToClock();
+    BleFormat format;
+    if (bleCmdSpanIs(fmt, fmtLen, "bin")) format = BLE_FORMAT_BINARY;
+    else if (bleCmdSpanIs(fmt, fmtLen, "delta")) format = BLE_FORMAT_DELTA;
+    else if (bleCmdSpanIs(fmt, fmtLen, "json")) format = BLE_FORMAT_JSON;
+    else return replyf(reply, cap, "{\"status\":\"error\",\"cmd\":\"set_proto\",\"message\":\"Unknown fmt\"}");
     
-    serialPrintfln("[BLE] Switched to Clock Page");
+    if (format != BLE_FORMAT_JSON && clientChunkCap(client) < BLE_BIN_MAX_FRAME) {
+        // Frame biner tidak punya framing antar chunk: wajib satu notifikasi
+        return replyf(reply, cap, "{\"status\":\"error\",\"cmd\":\"set_proto\",\"message\":\"MTU too small\"}");
+    }
+    
+    if (apply) {
+        client.format = format;
+        client.formatChosen = true;
+        // Frame berikutnya langsung full di format baru
+        client.lastSlowUs = 0;
+        resetSubscriptionSchedule(client);
+        client.deltaValid = false;
+        serialPrintfln("[BLE] Protocol: %s", FORMAT_NAMES[format]);
+    }
+    return replyf(reply, cap, "{\"status\":\"ok\",\"cmd\":\"set_proto\",\"fmt\":\"%.*s\",\"ver\":%d}",
+                  (int)fmtLen, fmt, BLE_BIN_VERSION);
 }
 
-// =============================================
-// BLE CALLBACKS
-// =============================================
-class MyServerCallbacks: public BLEServerCallbacks {
-    void onConnect(BLEServer* pServer) override {
-        deviceConnected = true;
-        bleLastConnectionTime = millis();
-        waitingForConnection = false;
-        serialPrintflnAlways("[BLE] Client connected");
-        
-        if (displayReady && appModeDisplayed) {
-            hideAppModeDisplay();
+// {"cmd":"keyframe"}: client kehilangan urutan seq delta, kirim semua field
+static int cmdKeyframe(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply) {
+    if (apply) {
+        client.keyframeRequested = true;
+        deltaStats.requestedKeyframes++;
+        client.lastFastUs = 0;
+        resetSubscriptionSchedule(client);
+    }
+    return 0;
+}
+
+// {"cmd":"subscribe","motion":100,"pack":500,...}: ms per grup, 0/tidak
+// ada = tidak berlangganan. Interval di-clamp ke batas firmware dan nilai
+// efektifnya dikembalikan ke client
+static int cmdSubscribe(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply) {
+    uint8_t mask = 0;
+    uint32_t intervals[BLE_GROUP_COUNT];
+    
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        int32_t requested = bleCmdInt(msg, BLE_GROUP_NAMES[g], 0);
+        if (requested <= 0) {
+            intervals[g] = 0;
+            continue;
         }
+        intervals[g] = constrain((uint32_t)requested, SUB_MIN_INTERVAL_MS[g], (uint32_t)BLE_SUB_MAX_INTERVAL_MS);
+        mask |= BLE_GROUP_BIT(g);
     }
     
-    void onDisconnect(BLEServer* pServer) override {
-        deviceConnected = false;
-        serialPrintflnAlways("[BLE] Client disconnected");
-        
-        if (bleActive && displayReady) {
-            waitingForConnection = true;
-            showAppModeDisplay();
+    int len = replyf(reply, cap, "{\"status\":\"ok\",\"cmd\":\"subscribe\"");
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        len += replyf(reply + len, cap - len, ",\"%s\":%lu", BLE_GROUP_NAMES[g], (unsigned long)intervals[g]);
+    }
+    len += replyf(reply + len, cap - len, "}");
+    
+    if (apply) {
+        for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+            client.subGroups[g].intervalMs = intervals[g];
+            client.subGroups[g].lastSendUs = 0;
         }
+        client.subMask = mask;
+        client.subActive = true;
+        client.deltaValid = false;  // Isi keyframe ikut set langganan
+        serialPrintfln("[BLE] Subscribe: groups 0x%02X", client.subMask);
+        bleNotifyNewData();
     }
+    return len;
+}
+
+// {"cmd":"unsubscribe"}: kembali ke jadwal fast/full bawaan
+static int cmdUnsubscribe(BleClient &client, const BleCmdMessage &msg, char *reply, size_t cap, bool apply) {
+    if (apply) {
+        clearSubscription(client);
+        client.deltaValid = false;
+        client.lastSlowUs = 0;
+        serialPrintfln("[BLE] Unsubscribe: default schedule");
+        bleNotifyNewData();
+    }
+    return replyf(reply, cap, "{\"status\":\"ok\",\"cmd\":\"unsubscribe\"}");
+}
+
+// Command baru: tambah handler di atas + satu baris di sini
+static constexpr BleCommand BLE_COMMANDS[] = {
+    {"set_time", cmdSetTime,
+     "{\"cmd\":\"set_time\",\"time\":\"12:34:56\",\"date\":\"19/10/2026\",\"dayofweek\":2}"},
+    {"set_proto", cmdSetProto, "{\"cmd\":\"set_proto\",\"fmt\":\"json\"}"},
+    {"keyframe", cmdKeyframe, "{\"cmd\":\"keyframe\"}"},
+    {"subscribe", cmdSubscribe,
+     "{\"cmd\":\"subscribe\",\"motion\":100,\"pack\":500,\"cells\":2000,\"temps\":5000,\"charger\":0}"},
+    {"unsubscribe", cmdUnsubscribe, "{\"cmd\":\"unsubscribe\"}"},
 };
 
-class MyCallbacks: public BLECharacteristicCallbacks {
-    void onWrite(BLECharacteristic *pCharacteristic) override {
-        String value = pCharacteristic->getValue().c_str();
-        if (value.length() > 0) {
-            serialPrintfln("[BLE] Received: %s", value.c_str());
-            
-            // ========== HANDLER SET TIME ==========
-            if (value.indexOf("\"cmd\":\"set_time\"") >= 0) {
-                
-                // Ekstrak data dari JSON
-                String timeStr = extractJsonString(value, "time");
-                String dateStr = extractJsonString(value, "date");
-                int dayOfWeek = extractJsonInt(value, "dayofweek", 1);
-                
-                serialPrintfln("[BLE] Extracted - time:%s, date:%s, dow:%d", 
-                              timeStr.c_str(), dateStr.c_str(), dayOfWeek);
-                
-                // Parse time
-                int hour = 0, minute = 0, second = 0;
-                bool timeValid = parseTimeString(timeStr, hour, minute, second);
-                
-                // Parse date
-                int day = 0, month = 0, year = 0;
-                bool dateValid = parseDateString(dateStr, day, month, year);
-                
-                // Validasi dayOfWeek (1-7)
-                bool dowValid = (dayOfWeek >= 1 && dayOfWeek <= 7);
-                
-                String response;
-                
-                if (timeValid && dateValid && dowValid) {
-                    // Set RTC
-                    setRTCTime(year, month, day, hour, minute, second, dayOfWeek);
-                    serialPrintflnAlways("[BLE] RTC updated: %02d:%02d:%02d %02d/%02d/%04d DOW:%d", 
-                                        hour, minute, second, day, month, year, dayOfWeek);
-                    
-                    // Update display jika di page jam
-                    if (currentPage == 1) {
-                        safeDisplayUpdate(currentPage);
-                    }
-                    
-                    // Response sukses
-                    response = "{\"status\":\"ok\",\"cmd\":\"set_time\"}";
-                    
+static constexpr size_t BLE_COMMAND_COUNT = sizeof(BLE_COMMANDS) / sizeof(BLE_COMMANDS[0]);
+
+static const BleCommand* findCommand(const BleCmdMessage &msg) {
+    if (msg.cmd == NULL) return NULL;
+    for (size_t i = 0; i < BLE_COMMAND_COUNT; i++) {
+        if (bleCmdSpanIs(msg.cmd->value, msg.cmd->valueLen, BLE_COMMANDS[i].name)) return &BLE_COMMANDS[i];
+    }
+    return NULL;
+}
+
+// Parse + jalankan command untuk client. Return panjang reply (0 = tidak ada)
+static int dispatchBleCommand(BleClient &client, const char *data, size_t len, char *reply, size_t cap, bool apply) {
+    uint32_t startUs = micros();
+    BleCmdMessage msg;
+    BleCmdStatus status = bleCmdParse(data, (uint16_t)min(len, (size_t)BLE_CMD_MAX_LEN + 1), msg);
+    reply[0] = '\0';
+    
+    int replyLen = 0;
+    if (status != BLE_CMD_OK) {
+        if (apply) {
+            cmdStats.parseErrors[status]++;
+            serialPrintfln("[BLE] Bad command: %s", bleCmdStatusName(status));
+        }
+        return 0;
+    }
+    
+    const BleCommand *command = findCommand(msg);
+    if (command == NULL) {
+        if (apply) {
+            cmdStats.unknown++;
+            serialPrintfln("[BLE] Unknown command");
+        }
+        return 0;
+    }
+    replyLen = command->handler(client, msg, reply, cap, apply);
+    
+    if (apply) {
+        cmdStats.received++;
+        cmdStats.lastUs = micros() - startUs;
+        if (cmdStats.lastUs > cmdStats.maxUs) cmdStats.maxUs = cmdStats.lastUs;
+    }
+    return replyLen;
+}
+
+// =============================================
+// BLE TRANSPORT EVENTS
+// =============================================
+// Callback backend jalan di task stack BLE, sedangkan bleClients/txSlots
+// milik task stream (di bawah bleStreamMutex). Callback hanya mencatat event;
+// task stream menerapkannya di awal tick. Stack BLE tidak pernah menunggu
+// mutex, jadi deinit di bawah mutex tidak bisa deadlock.
+//
+// Connect/disconnect/MTU/congestion tidak boleh hilang (client hantu,
+// congested macet): disimpan sebagai state pending per koneksi di bawah
+// portMUX, bukan di antrian. Hanya write yang lewat antrian dan boleh
+// dibuang saat antrian penuh (dihitung).
+typedef enum {
+    BLE_EVENT_CONNECT = 0,
+    BLE_EVENT_DISCONNECT,
+    BLE_EVENT_MTU,
+    BLE_EVENT_CONGESTION
+} BleEventType;
+
+typedef struct {
+    uint16_t conn;
+    uint16_t len;
+    uint8_t data[BLE_CMD_MAX_LEN + 1];
+} BleWriteEvent;
+
+// Urutan penerapan: disconnect sesi lama, connect sesi baru, lalu MTU & congestion
+typedef struct {
+    bool used;
+    bool disconnect;                    // Sesi yang sudah diterapkan putus
+    bool connect;                       // Sesi baru (belum diterapkan)
+    int8_t congested;                   // -1 = tidak berubah
+    uint16_t conn;
+    uint16_t mtu;                       // 0 = tidak berubah
+} BlePendingConn;
+
+// Tiap koneksi stack paling banyak punya satu disconnect + satu connect
+// pending; stack menerima maksimal BLE_MAX_CLIENTS + 1 (balapan ditolak)
+#define BLE_PENDING_CONNS (2 * (BLE_MAX_CLIENTS + 1))
+
+static BlePendingConn pendingConns[BLE_PENDING_CONNS];
+static volatile bool pendingAdvertise = false;     // Connect dibatalkan sebelum diterapkan
+#ifdef ESP32
+static portMUX_TYPE pendingConnMux = portMUX_INITIALIZER_UNLOCKED;
+static QueueHandle_t bleEventQueue = NULL;
+#endif
+static uint32_t writesDropped = 0;      // Antrian write penuh
+
+// Client berikutnya di entry ini mulai lagi dengan format & jadwal default.
+// Selalu JSON dulu: frame biner wajib satu notifikasi, jadi
+// BLE_PROTO_BINARY_DEFAULT baru berlaku setelah handleMtu
+static void resetClientSession(BleClient &c) {
+    c.format = BLE_FORMAT_JSON;
+    c.formatChosen = false;
+    clearSubscription(c);
+    c.deltaValid = false;
+    c.keyframeRequested = false;
+    c.lastFastUs = 0;
+    c.lastSlowUs = 0;
+    c.replyLen = 0;
+}
+
+// Kirim ke satu koneksi saja
+static bool clientSend(BleClient &c, const uint8_t *data, uint16_t len) {
+    return bleTransportNotify(c.connId, data, len);
+}
+
+static void handleConnect(uint16_t conn) {
+    BleClient *client = NULL;
+    for (int i = 0; i < BLE_MAX_CLIENTS && client == NULL; i++) {
+        if (!bleClients[i].connected) client = &bleClients[i];
+    }
+    if (client == NULL) {
+        // Advertising sudah berhenti di batas, ini hanya balapan koneksi
+        serialPrintflnAlways("[BLE] Client limit (%d) reached, rejecting", BLE_MAX_CLIENTS);
+        bleTransportDisconnect(conn);
+        return;
+    }
+    
+    bool first = !deviceConnected;
+    client->connId = conn;
+    client->mtu = BLE_DEFAULT_MTU;
+    client->congested = false;
+    client->slot = -1;
+    client->retries = 0;
+    client->connProfile = CONN_PROFILE_NONE;
+    memset(&client->stats, 0, sizeof(client->stats));
+    client->connected = true;
+    deviceConnected = true;
+    bleLastConnectionTime = millis();
+    waitingForConnection = false;
+    
+    uint8_t count = connectedClients();
+    serialPrintflnAlways("[BLE] Client %u connected (%u/%d)", client->connId, count, BLE_MAX_CLIENTS);
+    
+    // Stack berhenti advertising saat ada koneksi: lanjutkan selama masih ada tempat
+    if (count < BLE_MAX_CLIENTS) bleTransportAdvertise(true);
+    
+    // Task stream tidak menggambar sendiri: transisi ke jam oleh display task
+    if (first && appModeDisplayed) {
+        appModeDisplayed = false;
+        currentPage = 1;
+        serialPrintfln("[BLE] Switching from APP MODE to Clock Page");
+        sendDisplayCommand(DISPLAY_CMD_TRANSITION_TO_CLOCK);
+    }
+    wakeDisplayTask();
+}
+
+static void handleMtu(uint16_t conn, uint16_t mtu) {
+    BleClient *client = findClient(conn);
+    if (client == NULL) return;
+    client->mtu = mtu;
+    serialPrintfln("[BLE] Client %u MTU %u", client->connId, mtu);
+    
+    if (BLE_PROTO_BINARY_DEFAULT && !client->formatChosen && client->format == BLE_FORMAT_JSON &&
+        clientChunkCap(*client) >= BLE_BIN_MAX_FRAME) {
+        client->format = BLE_FORMAT_BINARY;
+        client->lastSlowUs = 0;             // Frame berikutnya langsung full biner
+        serialPrintfln("[BLE] Protocol: %s (default)", FORMAT_NAMES[BLE_FORMAT_BINARY]);
+    }
+}
+
+static void handleDisconnect(uint16_t conn) {
+    BleClient *client = findClient(conn);
+    if (client == NULL) return;     // Ditolak di handleConnect / sudah dilepas bleStackStop
+    
+    // Lepas dari frame yang sedang diikuti sebelum entry dipakai koneksi baru
+    if (client->slot >= 0) leaveSlot(txSlots[client->slot], *client, true);
+    client->connected = false;
+    resetClientSession(*client);
+    deviceConnected = connectedClients() > 0;
+    advertisingRestart = true;
+    serialPrintflnAlways("[BLE] Client %u disconnected (%u/%d)", conn,
+                         connectedClients(), BLE_MAX_CLIENTS);
+    
+    // Display task mengikuti isInAppMode(): layar APP MODE digambar di sana
+    if (!deviceConnected && bleActive) {
+        waitingForConnection = true;
+        appModeDisplayed = true;
+        sendDisplayCommand(DISPLAY_CMD_UPDATE_CLOCK);
+    }
+    wakeDisplayTask();
+}
+
+static void handleCongestion(uint16_t conn, bool congested) {
+    BleClient *client = findClient(conn);
+    if (client == NULL) return;
+    client->congested = congested;
+    if (congested) pumpStats.congestionEvents++;
+}
+
+// Command berlaku untuk client penulis, reply hanya dikirim ke client itu.
+// Reply dikirim task stream sebagai frame sendiri (lihat startReplyFrame)
+static void handleWrite(uint16_t conn, const uint8_t *data, uint16_t len) {
+    BleClient *client = findClient(conn);
+    if (client == NULL || data == NULL || len == 0) return;
+    serialPrintfln("[BLE] Received from %u: %.*s", client->connId, (int)min(len, (uint16_t)100), (const char*)data);
+    
+    char reply[BLE_CMD_REPLY_MAX];
+    int replyLen = dispatchBleCommand(*client, (const char*)data, len, reply, sizeof(reply), true);
+    if (replyLen > 0) {
+        bleTransportSetValue((uint8_t*)reply, replyLen);
+        if (client->replyLen > 0) cmdStats.repliesReplaced++;
+        memcpy(client->reply, reply, replyLen);
+        client->replyLen = (uint8_t)replyLen;
+        serialPrintfln("[BLE] Response queued: %s", reply);
+    }
+}
+
+// Pemanggil memegang pendingConnMux. Entry lama untuk koneksi ini dulu
+static BlePendingConn* pendingFor(uint16_t conn) {
+    BlePendingConn *slot = NULL;
+    for (int i = 0; i < BLE_PENDING_CONNS; i++) {
+        BlePendingConn &p = pendingConns[i];
+        if (p.used && p.conn == conn) return &p;
+        if (!p.used && slot == NULL) slot = &p;
+    }
+    if (slot != NULL) {
+        memset(slot, 0, sizeof(*slot));
+        slot->used = true;
+        slot->conn = conn;
+        slot->congested = -1;
+    }
+    return slot;
+}
+
+// Konteks task stack BLE: catat, bangunkan task stream
+static void postLifecycle(uint8_t type, uint16_t conn, uint16_t value) {
+    #ifdef ESP32
+    portENTER_CRITICAL(&pendingConnMux);
+    #endif
+    BlePendingConn *p = pendingFor(conn);
+    if (p != NULL) {
+        switch (type) {
+            case BLE_EVENT_CONNECT:
+                p->connect = true;
+                p->mtu = 0;
+                p->congested = -1;
+                break;
+            case BLE_EVENT_DISCONNECT:
+                if (p->connect) {
+                    // Sesi ini belum pernah terlihat task stream: cukup batalkan
+                    p->connect = false;
+                    pendingAdvertise = true;
+                    if (!p->disconnect) p->used = false;
                 } else {
-                    // Response error
-                    response = "{\"status\":\"error\",\"cmd\":\"set_time\",\"message\":\"Invalid data\"}";
-                    serialPrintfln("[BLE] Invalid time/date data");
+                    p->disconnect = true;
                 }
-                
-                // Kirim response
-                pCharacteristic->setValue((uint8_t*)response.c_str(), response.length());
-                pCharacteristic->notify();
-                serialPrintfln("[BLE] Response sent: %s", response.c_str());
-            }
+                p->mtu = 0;
+                p->congested = -1;
+                break;
+            case BLE_EVENT_MTU:
+                p->mtu = value;
+                break;
+            case BLE_EVENT_CONGESTION:
+                p->congested = value ? 1 : 0;
+                break;
         }
     }
-};
+    #ifdef ESP32
+    portEXIT_CRITICAL(&pendingConnMux);
+    if (bleTaskHandle != NULL) xTaskNotifyGive(bleTaskHandle);
+    #endif
+}
+
+// Timeout pendek: task stream bisa sedang menunggu stack (notify)
+static void postWrite(uint16_t conn, const uint8_t *data, uint16_t len) {
+    #ifdef ESP32
+    static BleWriteEvent evt;           // Satu task stack BLE, hemat stack
+    if (bleEventQueue == NULL) return;
+    evt.conn = conn;
+    evt.len = len;
+    memcpy(evt.data, data, len);
+    if (xQueueSend(bleEventQueue, &evt, pdMS_TO_TICKS(BLE_EVENT_POST_TIMEOUT_MS)) != pdTRUE) {
+        writesDropped++;
+        return;
+    }
+    if (bleTaskHandle != NULL) xTaskNotifyGive(bleTaskHandle);
+    #else
+    handleWrite(conn, data, len);
+    #endif
+}
+
+// Pemanggil memegang bleStreamMutex (atau loop() tanpa task stream).
+// Lifecycle dulu: write dari koneksi baru butuh entry client-nya
+static void drainBleEvents() {
+    for (int i = 0; i < BLE_PENDING_CONNS; i++) {
+        BlePendingConn p;
+        #ifdef ESP32
+        portENTER_CRITICAL(&pendingConnMux);
+        #endif
+        p = pendingConns[i];
+        pendingConns[i].used = false;
+        #ifdef ESP32
+        portEXIT_CRITICAL(&pendingConnMux);
+        #endif
+        if (!p.used) continue;
+        if (p.disconnect) handleDisconnect(p.conn);
+        if (p.connect) handleConnect(p.conn);
+        if (p.mtu != 0) handleMtu(p.conn, p.mtu);
+        if (p.congested >= 0) handleCongestion(p.conn, p.congested != 0);
+    }
+    if (pendingAdvertise) {
+        pendingAdvertise = false;
+        advertisingRestart = true;
+    }
+    
+    #ifdef ESP32
+    static BleWriteEvent evt;           // Hanya satu pemanggil sekaligus, hemat stack
+    if (bleEventQueue == NULL) return;
+    while (xQueueReceive(bleEventQueue, &evt, 0) == pdTRUE) {
+        handleWrite(evt.conn, evt.data, evt.len);
+    }
+    #endif
+}
+
+void bleOnConnect(uint16_t conn) {
+    postLifecycle(BLE_EVENT_CONNECT, conn, 0);
+}
+
+void bleOnDisconnect(uint16_t conn) {
+    postLifecycle(BLE_EVENT_DISCONNECT, conn, 0);
+}
+
+void bleOnMtu(uint16_t conn, uint16_t mtu) {
+    postLifecycle(BLE_EVENT_MTU, conn, mtu);
+}
+
+void bleOnCongestion(uint16_t conn, bool congested) {
+    postLifecycle(BLE_EVENT_CONGESTION, conn, congested ? 1 : 0);
+}
+
+// Write lebih panjang dari BLE_CMD_MAX_LEN dipotong 1 byte di atas batas:
+// parser tetap menolaknya sebagai terlalu panjang
+void bleOnWrite(uint16_t conn, const uint8_t *data, uint16_t len) {
+    if (data == NULL || len == 0) return;
+    len = min(len, (uint16_t)(BLE_CMD_MAX_LEN + 1));
+    postWrite(conn, data, len);
+}
 
 // =============================================
-// ACTIVATE BLE - SIMPLIFIED VERSION
+// BLE STACK LIFECYCLE (WARM / COLD)
 // =============================================
-void activateBLE() {
-    if (bleActive) {
-        serialPrintflnAlways("[BLE] Already active");
-        return;
+// Warm (BLE_DEINIT_ON_DISABLE false): stack + GATT dibuat sekali, aktif/mati
+// hanya start/stop advertising. Cold: deinit penuh saat mati (heap host stack
+// dan controller kembali), aktivasi berikutnya init + GATT ulang.
+
+static bool bleStackReady = false;          // init + GATT sudah ada
+static bool bleMemoryReleased = false;      // deinit(true): BLE mati sampai reboot
+
+typedef struct {
+    uint32_t coldStarts;
+    uint32_t warmStarts;
+    uint32_t stops;
+    uint32_t lastStartUs;
+    uint32_t maxColdStartUs;
+    uint32_t maxWarmStartUs;
+    uint32_t lastStopUs;
+    uint32_t stackHeap;                 // Heap yang dipakai stack + GATT (cold start terakhir)
+    bool lastStartCold;
+} BleLifecycleStats;
+
+static BleLifecycleStats lifecycleStats = {0};
+
+static bool createGattServer() {
+    uint32_t heapBefore = ESP.getFreeHeap();
+    if (!bleTransportInit(BLE_DEVICE_NAME, BLE_REQUESTED_MTU)) {
+        serialPrintflnAlways("[BLE] %s init failed", bleTransportName());
+        return false;
     }
+    uint32_t heapAfter = ESP.getFreeHeap();
+    lifecycleStats.stackHeap = heapBefore > heapAfter ? heapBefore - heapAfter : 0;
     
-    serialPrintflnAlways("[BLE] Activating...");
+    // Server GATT baru: belum ada client, semua entry mulai dari sesi default
+    memset(bleClients, 0, sizeof(bleClients));
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        bleClients[i].slot = -1;
+        resetClientSession(bleClients[i]);
+    }
+    bleStackReady = true;
+    return true;
+}
+
+// Radio siap + advertising. false jika memori BT sudah dilepas permanen
+static bool bleStackStart() {
+    if (bleMemoryReleased) {
+        serialPrintflnAlways("[BLE] Controller memory released - reboot to use BLE");
+        return false;
+    }
     
-    // Simpan page sebelumnya
-    previousPage = currentPage;
+    #ifdef ESP32
+    if (bleEventQueue == NULL) {
+        bleEventQueue = xQueueCreate(BLE_EVENT_QUEUE_SIZE, sizeof(BleWriteEvent));
+    } else if (!bleStackReady) {
+        xQueueReset(bleEventQueue);     // Sisa event stack lama (setelah deinit)
+    }
+    #endif
+    if (!bleStackReady) {
+        memset(pendingConns, 0, sizeof(pendingConns));
+        pendingAdvertise = false;
+    }
     
-    // Initialize BLE Hardware
-    BLEDevice::init(BLE_DEVICE_NAME);
-    BLEDevice::setMTU(512);
+    uint32_t startUs = micros();
+    bool cold = !bleStackReady;
+    if (cold && !createGattServer()) return false;
+    bleTransportAdvertise(true);
+    advertisingRestart = false;
     
-    pServer = BLEDevice::createServer();
-    pServer->setCallbacks(new MyServerCallbacks());
+    lifecycleStats.lastStartUs = micros() - startUs;
+    lifecycleStats.lastStartCold = cold;
+    if (cold) {
+        lifecycleStats.coldStarts++;
+        lifecycleStats.maxColdStartUs = max(lifecycleStats.maxColdStartUs, lifecycleStats.lastStartUs);
+    } else {
+        lifecycleStats.warmStarts++;
+        lifecycleStats.maxWarmStartUs = max(lifecycleStats.maxWarmStartUs, lifecycleStats.lastStartUs);
+    }
+    return true;
+}
+
+// Pemanggil memegang bleStreamMutex (task stream tidak sedang notify)
+static void bleStackStop() {
+    uint32_t startUs = micros();
+    bleTransportAdvertise(false);
+    drainBleEvents();                   // Koneksi yang sudah masuk antrian ikut diputus
     
-    BLEService *pService = pServer->createService(SERVICE_UUID);
+    // Putus semua client. Entry langsung dilepas (onDisconnect setelah ini
+    // diabaikan, dan tidak datang sama sekali setelah deinit)
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        BleClient &c = bleClients[i];
+        if (!c.connected) continue;
+        bleTransportDisconnect(c.connId);
+        c.connected = false;
+        resetClientSession(c);
+    }
+    deviceConnected = false;
+    releaseTxSlots();
     
-    pCharacteristic = pService->createCharacteristic(
-        CHARACTERISTIC_UUID,
-        BLECharacteristic::PROPERTY_READ | 
-        BLECharacteristic::PROPERTY_NOTIFY |
-        BLECharacteristic::PROPERTY_WRITE
-    );
+    if (BLE_DEINIT_ON_DISABLE && bleStackReady) {
+        // Event disconnect tidak akan datang setelah deinit, sesi sudah direset di atas
+        bleTransportDeinit(BLE_COLD_RELEASE_MEMORY);
+        bleStackReady = false;
+        if (BLE_COLD_RELEASE_MEMORY) bleMemoryReleased = true;
+    }
     
-    pCharacteristic->addDescriptor(new BLE2902());
-    pCharacteristic->setCallbacks(new MyCallbacks());
-    pCharacteristic->setValue("JAMFOXRS BLE Ready");
+    lifecycleStats.stops++;
+    lifecycleStats.lastStopUs = micros() - startUs;
+}
+
+static void lockStream() {
+    #ifdef ESP32
+    if (bleStreamMutex != NULL) xSemaphoreTake(bleStreamMutex, portMAX_DELAY);
+    #endif
+}
+
+static void unlockStream() {
+    #ifdef ESP32
+    if (bleStreamMutex != NULL) xSemaphoreGive(bleStreamMutex);
+    #endif
+}
+
+// =============================================
+// ACTIVATE BLE - SIMPLIFIED VERSION
+// =============================================
+void activateBLE() {
+    if (bleActive) {
+        serialPrintflnAlways("[BLE] Already active");
+        return;
+    }
     
-    pService->start();
+    serialPrintflnAlways("[BLE] Activating...");
     
-    // Start advertising
-    BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
-    pAdvertising->addServiceUUID(SERVICE_UUID);
-    pAdvertising->setScanResponse(true);
-    pAdvertising->setMinPreferred(0x06);
-    pAdvertising->setMaxPreferred(0x12);
+    lockStream();
+    bool started = bleStackStart();
+    unlockStream();
+    if (!started) {
+        activationPending = false;
+        return;
+    }
     
-    BLEDevice::startAdvertising();
+    // Simpan page sebelumnya
+    previousPage = currentPage;
     
-    serialPrintflnAlways("[BLE] Advertising started - Name: %s", BLE_DEVICE_NAME);
+    serialPrintflnAlways("[BLE] Advertising started - Name: %s (%s start %lu us)", BLE_DEVICE_NAME,
+                         lifecycleStats.lastStartCold ? "cold" : "warm",
+                         (unsigned long)lifecycleStats.lastStartUs);
     serialPrintflnAlways("[BLE] Service UUID: %s", SERVICE_UUID);
     
     bleActive = true;
-    bleInitialized = true;
     bleLastConnectionTime = millis();
     activationPending = false;
     waitingForConnection = true;
@@ -365,16 +1044,12 @@ void deactivateBLE() {
     
     serialPrintflnAlways("[BLE] Deactivating...");
     
-    // Stop advertising
-    BLEDevice::stopAdvertising();
-    
-    // Disconnect if connected
-    if (deviceConnected) {
-        pServer->disconnect(0);
-        deviceConnected = false;
-    }
-    
+    // Jangan putus di tengah notify dari task stream
+    lockStream();
+    bleStackStop();
     bleActive = false;
+    unlockStream();
+    
     waitingForConnection = false;
     appModeDisplayed = false;
     activationPending = false;
@@ -390,7 +1065,7 @@ void deactivateBLE() {
         safeDisplayUpdate(currentPage);
     }
     
-    serialPrintflnAlways("[BLE] Deactivated - advertising stopped");
+    serialPrintflnAlways("[BLE] Deactivated - %s", BLE_DEINIT_ON_DISABLE ? "stack deinitialized" : "advertising stopped");
 }
 
 // =============================================
@@ -424,146 +1099,655 @@ bool isBLEConnected() {
 }
 
 // =============================================
-// BUILD FAST JSON
+// JSON SNAPSHOT (STREAMING SERIALIZER)
 // =============================================
-static bool buildFastJson() {
-    int len = snprintf(bleTxBuf, sizeof(bleTxBuf),
-        "{\"r\":%d,\"s\":%d,\"m\":\"%s\",\"v\":%.1f,\"a\":%.1f,\"p\":%.0f,\"sc\":%d,"
-        "\"t\":{\"c\":%d,\"m\":%d,\"b\":%d},\"cr\":%lu,\"hb\":%lu,\"type\":\"fast\"}\n",
-        vehicle.rpm, vehicle.speed, getModeString(getCurrentVehicleMode()),
-        vehicle.batteryVoltage, vehicle.batteryCurrent, 
-        vehicle.batteryVoltage * vehicle.batteryCurrent,
-        vehicle.batterySOC,
-        vehicle.tempCtrl, vehicle.tempMotor, vehicle.tempBatt,
-        (unsigned long)getCANMessagesPerSecond(),
-        (unsigned long)heartbeatCounter++
-    );
+static void captureJsonSnapshot(BleJsonSnapshot &v, unsigned long heartbeat) {
+    v.rpm = vehicle.rpm;
+    v.speed = vehicle.speed;
+    v.mode = getModeString(getCurrentVehicleMode());
+    v.voltage = vehicle.batteryVoltage;
+    v.current = vehicle.batteryCurrent;
+    v.soc = vehicle.batterySOC;
+    v.tempCtrl = vehicle.tempCtrl;
+    v.tempMotor = vehicle.tempMotor;
+    v.tempBatt = vehicle.tempBatt;
+    v.canRate = getCANMessagesPerSecond();
+    v.heartbeat = heartbeat;
     
-    if (len < 0 || len >= (int)sizeof(bleTxBuf)) return false;
-    bleTxLen = (uint16_t)len;
-    return true;
-}
-
-// =============================================
-// BUILD FULL JSON
-// =============================================
-static bool buildFullJson() {
     uint16_t minCell = 9999, maxCell = 0;
     for (int i = 0; i < MAX_CELLS; i++) {
+        v.cells[i] = vehicle.cellVoltages[i];
         if (vehicle.cellVoltages[i] > 0 && vehicle.cellVoltages[i] < minCell) 
             minCell = vehicle.cellVoltages[i];
         if (vehicle.cellVoltages[i] > maxCell) 
             maxCell = vehicle.cellVoltages[i];
     }
-    int cellDelta = (minCell > maxCell) ? 0 : ((int)maxCell - (int)minCell);
+    v.cellDelta = (minCell > maxCell) ? 0 : ((int)maxCell - (int)minCell);
+    
+    v.soh = vehicle.batterySOH;
+    v.cycles = vehicle.batteryCycleCount;
+    v.remainCap = vehicle.remainingCapacity;
+    v.fullCap = vehicle.fullCapacity;
+    v.cellHi = vehicle.cellHighestVolt;
+    v.cellHiNum = vehicle.cellHighestNum;
+    v.cellLo = vehicle.cellLowestVolt;
+    v.cellLoNum = vehicle.cellLowestNum;
+    v.cellAvg = vehicle.cellAvgVolt;
+    v.tempMax = vehicle.tempMax;
+    v.tempMaxCell = vehicle.tempMaxCell;
+    v.tempMin = vehicle.tempMin;
+    v.tempMinCell = vehicle.tempMinCell;
+    v.balanceMode = vehicle.balanceMode;
+    v.balanceStatus = vehicle.balanceStatus;
+    memcpy(v.balanceBits, vehicle.balanceBits, sizeof(v.balanceBits));
+    v.chargerVoltage = vehicle.chargerVoltage;
+    v.chargerCurrent = vehicle.chargerCurrent;
+}
+
+// =============================================
+// BUILD BINARY FRAME (fox_bleproto)
+// =============================================
+static int16_t clampInt16(float value) {
+    if (value > 32767.0f) return 32767;
+    if (value < -32768.0f) return -32768;
+    return (int16_t)lroundf(value);
+}
 
-    char balanceCells[64];
-    int bpos = 0;
+static uint16_t toDeci(float value) {
+    if (value <= 0.0f) return 0;
+    if (value > 6553.5f) return 65535;
+    return (uint16_t)lroundf(value * 10.0f);
+}
+
+static void captureBinFields(BleBinFields &f, unsigned long heartbeat) {
+    f.rpm = clampInt16(vehicle.rpm);
+    f.speed = clampInt16(vehicle.speed);
+    f.mode = (uint8_t)getCurrentVehicleMode();
+    f.voltage = toDeci(vehicle.batteryVoltage);
+    f.current = clampInt16(vehicle.batteryCurrent * 10.0f);
+    f.power = clampInt16(vehicle.batteryVoltage * vehicle.batteryCurrent);
+    f.soc = (uint8_t)constrain(vehicle.batterySOC, 0, 100);
+    f.temps[0] = (int8_t)constrain(vehicle.tempCtrl, -128, 127);
+    f.temps[1] = (int8_t)constrain(vehicle.tempMotor, -128, 127);
+    f.temps[2] = (int8_t)constrain(vehicle.tempBatt, -128, 127);
+    f.canRate = (uint16_t)min(getCANMessagesPerSecond(), (uint32_t)65535);
+    f.heartbeat = heartbeat;
+    
+    uint16_t minCell = 9999, maxCell = 0;
     for (int i = 0; i < MAX_CELLS; i++) {
-        int byteIndex = i / 8;
-        int bitIndex = i % 8;
-        bool isBalancing = (vehicle.balanceBits[byteIndex] & (1 << bitIndex)) != 0;
-        bpos += snprintf(balanceCells + bpos, sizeof(balanceCells) - bpos, 
-                         "%d%s", isBalancing ? 1 : 0, (i < MAX_CELLS-1) ? "," : "");
+        f.cells[i] = vehicle.cellVoltages[i];
+        if (vehicle.cellVoltages[i] > 0 && vehicle.cellVoltages[i] < minCell) minCell = vehicle.cellVoltages[i];
+        if (vehicle.cellVoltages[i] > maxCell) maxCell = vehicle.cellVoltages[i];
     }
+    f.cellDelta = (minCell > maxCell) ? 0 : (maxCell - minCell);
+    
+    f.health.soh = (uint8_t)constrain(vehicle.batterySOH, 0, 100);
+    f.health.cycles = vehicle.batteryCycleCount;
+    f.health.remainCap = toDeci(vehicle.remainingCapacity);
+    f.health.fullCap = toDeci(vehicle.fullCapacity);
+    
+    f.cellStats.hi = vehicle.cellHighestVolt;
+    f.cellStats.hiCell = vehicle.cellHighestNum;
+    f.cellStats.lo = vehicle.cellLowestVolt;
+    f.cellStats.loCell = vehicle.cellLowestNum;
+    f.cellStats.avg = vehicle.cellAvgVolt;
+    
+    f.tempStats.max = vehicle.tempMax;
+    f.tempStats.maxCell = vehicle.tempMaxCell;
+    f.tempStats.min = vehicle.tempMin;
+    f.tempStats.minCell = vehicle.tempMinCell;
+    
+    f.balance.mode = vehicle.balanceMode;
+    f.balance.status = vehicle.balanceStatus;
+    f.balance.mask = (uint32_t)vehicle.balanceBits[0] | ((uint32_t)vehicle.balanceBits[1] << 8) |
+                     ((uint32_t)vehicle.balanceBits[2] << 16) | ((uint32_t)vehicle.balanceBits[3] << 24);
+    
+    f.charger.voltage = toDeci(vehicle.chargerVoltage);
+    f.charger.current = toDeci(vehicle.chargerCurrent);
+}
 
-    char cellsStr[200];
-    int cpos = 0;
-    for (int i = 0; i < MAX_CELLS; i++) {
-        cpos += snprintf(cellsStr + cpos, sizeof(cellsStr) - cpos, 
-                         "%u%s", vehicle.cellVoltages[i], (i < MAX_CELLS-1) ? "," : "");
-    }
-
-    int len = snprintf(bleTxBuf, sizeof(bleTxBuf),
-        "{\"r\":%d,\"s\":%d,\"m\":\"%s\",\"v\":%.1f,\"a\":%.1f,\"p\":%.0f,\"sc\":%d,"
-        "\"t\":{\"c\":%d,\"m\":%d,\"b\":%d},\"cells\":[%s],\"cd\":%d,\"cr\":%lu,"
-        "\"h\":{\"soh\":%d,\"cyc\":%u,\"rc\":%.1f,\"fc\":%.1f},"
-        "\"cvs\":{\"hi\":%u,\"hiC\":%u,\"lo\":%u,\"loC\":%u,\"av\":%u},"
-        "\"ts\":{\"max\":%u,\"maxC\":%u,\"min\":%u,\"minC\":%u},"
-        "\"b\":{\"md\":%u,\"st\":%u,\"cells\":[%s]},"
-        "\"chr\":{\"v\":%.1f,\"a\":%.1f},\"hb\":%lu,\"type\":\"full\"}\n",
-        vehicle.rpm, vehicle.speed, getModeString(getCurrentVehicleMode()),
-        vehicle.batteryVoltage, vehicle.batteryCurrent, 
-        vehicle.batteryVoltage * vehicle.batteryCurrent,
-        vehicle.batterySOC,
-        vehicle.tempCtrl, vehicle.tempMotor, vehicle.tempBatt,
-        cellsStr, cellDelta,
-        (unsigned long)getCANMessagesPerSecond(),
-        vehicle.batterySOH, vehicle.batteryCycleCount, 
-        vehicle.remainingCapacity, vehicle.fullCapacity,
-        vehicle.cellHighestVolt, vehicle.cellHighestNum, 
-        vehicle.cellLowestVolt, vehicle.cellLowestNum, 
-        vehicle.cellAvgVolt,
-        vehicle.tempMax, vehicle.tempMaxCell,
-        vehicle.tempMin, vehicle.tempMinCell,
-        vehicle.balanceMode, vehicle.balanceStatus, balanceCells,
-        vehicle.chargerVoltage, vehicle.chargerCurrent,
-        (unsigned long)heartbeatCounter++
-    );
-
-    if (len < 0 || len >= (int)sizeof(bleTxBuf)) return false;
-    bleTxLen = (uint16_t)len;
-    return true;
+static int buildBinaryFrame(uint32_t mask, uint8_t type, uint8_t *buf, uint16_t cap, unsigned long heartbeat) {
+    BleBinFields fields;
+    captureBinFields(fields, heartbeat);
+    return bleBinEncode(fields, mask, type, bleBinSeq++, buf, cap);
+}
+
+static uint8_t countFields(uint32_t mask) {
+    uint8_t count = 0;
+    for (; mask; mask &= mask - 1) count++;
+    return count;
+}
+
+// Delta: jadwal fast/full (atau grup langganan) tetap, tapi hanya field
+// (dalam mask jadwal) yang berbeda dari nilai terakhir terkirim ke client
+// ini yang masuk frame. Keyframe berisi semua field yang bisa dikirim (keyMask)
+static int buildDeltaFrame(BleClient &c, uint32_t mask, uint32_t keyMask, uint8_t *buf, uint16_t cap,
+                           unsigned long heartbeat) {
+    BleBinFields fields;
+    captureBinFields(fields, heartbeat);
+    
+    uint32_t now = millis();
+    bool keyframe = !c.deltaValid || c.keyframeRequested || (now - c.lastKeyframeMs >= BLE_DELTA_KEYFRAME_MS);
+    
+    uint32_t present;
+    uint8_t type, flags;
+    if (keyframe) {
+        present = keyMask;
+        type = (keyMask == BLE_BIN_FULL_MASK) ? BLE_BIN_FULL : BLE_BIN_GROUPS;
+        flags = BLE_BIN_FLAG_KEYFRAME;
+    } else {
+        present = bleBinDiff(fields, c.deltaLastSent, mask);
+        type = BLE_BIN_DELTA;
+        flags = 0;
+    }
+    
+    int len = bleBinEncode(fields, present, type, c.binSeq++, buf, cap, flags);
+    if (len <= 0) return 0;
+    
+    bleBinMerge(c.deltaLastSent, fields, present);
+    if (keyframe) {
+        c.deltaValid = true;
+        c.keyframeRequested = false;
+        c.lastKeyframeMs = now;
+        deltaStats.keyframes++;
+    } else {
+        deltaStats.deltas++;
+        deltaStats.fieldsSkipped += countFields(mask & ~present);
+        deltaStats.bytesSaved += bleBinFrameSize(mask) - len;
+    }
+    deltaStats.fieldsSent += countFields(present);
+    return len;
 }
 
 // =============================================
 // BLE TRANSMISSION
 // =============================================
-static void startBleTxIfIdle(bool useFast) {
-    if (!deviceConnected) return;
-    if (bleTxInProgress) return;
+static uint32_t notifyAirtimeUs(int len) {
+    return (len + BLE_NOTIFY_OVERHEAD_BYTES) * 8 + BLE_NOTIFY_EXCHANGE_US;
+}
 
-    bool ok;
-    if (useFast) {
-        ok = buildFastJson();
+// Serialisasi frame untuk client pertama yang memintanya
+static bool buildSlotFrame(BleTxSlot &slot, BleClient &c, uint8_t kind, uint8_t groups) {
+    slot.reply = false;
+    slot.format = c.format;
+    slot.kind = kind;
+    slot.groups = groups;
+    slot.members = 0;
+    slot.pending = 0;
+    slot.chunkCap = BLE_MAX_CHUNK;
+    slot.chunkLen = 0;
+    
+    if (c.format == BLE_FORMAT_JSON) {
+        uint32_t startUs = micros();
+        captureJsonSnapshot(slot.json.snap, heartbeatCounter++);
+        if (kind == BLE_JSON_GROUPS) bleJsonBeginGroups(slot.json, groups);
+        else bleJsonBegin(slot.json, kind == BLE_JSON_FULL);
+        slot.serializeUs = micros() - startUs;
+        return true;
+    }
+    
+    uint32_t mask;
+    uint8_t type;
+    if (kind == BLE_JSON_GROUPS) {
+        mask = bleGroupFieldMask(groups);
+        type = BLE_BIN_GROUPS;
+    } else if (kind == BLE_JSON_FULL) {
+        mask = BLE_BIN_FULL_MASK;
+        type = BLE_BIN_FULL;
     } else {
-        ok = buildFullJson();
+        mask = BLE_BIN_FAST_MASK;
+        type = BLE_BIN_FAST;
     }
     
-    if (!ok) return;
+    int len;
+    if (c.format == BLE_FORMAT_DELTA) {
+        uint32_t keyMask = c.subActive ? bleGroupFieldMask(c.subMask) : BLE_BIN_FULL_MASK;
+        len = buildDeltaFrame(c, mask, keyMask, slot.bin, sizeof(slot.bin), heartbeatCounter++);
+    } else {
+        len = buildBinaryFrame(mask, type, slot.bin, sizeof(slot.bin), heartbeatCounter++);
+    }
+    if (len <= 0) return false;
+    slot.binLen = (uint16_t)len;
+    slot.binOffset = 0;
+    return true;
+}
+
+static void joinSlot(BleTxSlot &slot, int index, BleClient &c) {
+    slot.members |= clientBit(c);
+    slot.chunkCap = min(slot.chunkCap, clientChunkCap(c));
+    c.slot = index;
+    c.retries = 0;
+    c.stats.frames++;
+    formatStats[slot.format].frames++;
+    fanoutStats.delivered++;
+}
+
+// kind = BleJsonKind; groups hanya dipakai untuk BLE_JSON_GROUPS.
+// openSlots = slot yang dibuat di tick ini (belum ada chunk keluar): client
+// dengan format + isi sama ikut slot itu tanpa serialisasi ulang
+static void startClientFrame(BleClient &c, uint8_t kind, uint8_t groups, uint8_t &openSlots) {
+    if (!c.connected || c.slot >= 0) return;
+    if (kind != BLE_JSON_GROUPS) groups = 0;
     
-    bleTxOffset = 0;
-    bleTxInProgress = true;
+    if (c.format != BLE_FORMAT_DELTA) {
+        for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+            BleTxSlot &slot = txSlots[s];
+            if (!(openSlots & (1 << s)) || slot.format != c.format || slot.kind != kind || slot.groups != groups) {
+                continue;
+            }
+            joinSlot(slot, s, c);
+            return;
+        }
+    }
+    
+    for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+        BleTxSlot &slot = txSlots[s];
+        if (slot.active) continue;
+        if (!buildSlotFrame(slot, c, kind, groups)) return;
+        slot.active = true;
+        fanoutStats.serialized++;
+        joinSlot(slot, s, c);
+        if (c.format != BLE_FORMAT_DELTA) openSlots |= 1 << s;
+        return;
+    }
 }
 
-static void pumpBleTx() {
-    if (!deviceConnected) {
-        bleTxInProgress = false;
-        bleTxOffset = 0;
+// Reply command sebagai frame sendiri untuk satu client: dichunk per MTU dan
+// ditutup '\n' seperti frame JSON, tidak pernah menyela frame yang sedang
+// dikirim (client baru dapat reply setelah c.slot kosong)
+static void startReplyFrame(BleClient &c) {
+    if (!c.connected || c.slot >= 0 || c.replyLen == 0) return;
+    for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+        BleTxSlot &slot = txSlots[s];
+        if (slot.active) continue;
+        slot.reply = true;
+        slot.format = BLE_FORMAT_BINARY;    // Dipompa sebagai byte mentah (binLen/binOffset)
+        slot.kind = 0;
+        slot.groups = 0;
+        slot.members = clientBit(c);
+        slot.pending = 0;
+        slot.chunkCap = clientChunkCap(c);
+        slot.chunkLen = 0;
+        memcpy(slot.text, c.reply, c.replyLen);
+        slot.text[c.replyLen] = '\n';
+        slot.binLen = c.replyLen + 1;
+        slot.binOffset = 0;
+        slot.active = true;
+        c.slot = s;
+        c.retries = 0;
+        c.replyLen = 0;
         return;
     }
+}
+
+static bool slotFrameDone(const BleTxSlot &slot) {
+    if (slot.format == BLE_FORMAT_JSON) return bleJsonDone(slot.json);
+    return slot.binOffset >= slot.binLen;
+}
+
+// Ambil chunk berikutnya dari frame slot. 0 = frame selesai
+static int nextSlotChunk(BleTxSlot &slot) {
+    if (slot.format == BLE_FORMAT_JSON) {
+        uint32_t startUs = micros();
+        int len = bleJsonRead(slot.json, slot.chunk, slot.chunkCap);
+        slot.serializeUs += micros() - startUs;
+        if (bleJsonDone(slot.json) && len > 0) {
+            jsonLastFrameUs = slot.serializeUs;
+            if (slot.serializeUs > jsonMaxFrameUs) jsonMaxFrameUs = slot.serializeUs;
+            jsonLastFrameBytes = slot.json.emitted;
+        }
+        return len;
+    }
+    
+    int len = min((int)slot.chunkCap, (int)slot.binLen - (int)slot.binOffset);
+    if (len <= 0) return 0;
+    memcpy(slot.chunk, (slot.reply ? slot.text : slot.bin) + slot.binOffset, len);
+    slot.binOffset += len;
+    return len;
+}
+
+// dropped: client kehilangan sebagian frame (putus / gagal terus / lambat)
+static void leaveSlot(BleTxSlot &slot, BleClient &c, bool dropped) {
+    slot.members &= ~clientBit(c);
+    slot.pending &= ~clientBit(c);
+    c.slot = -1;
+    c.retries = 0;
+    if (dropped) {
+        c.stats.dropped++;
+        pumpStats.framesDropped++;
+        c.deltaValid = false;       // Delta berikutnya harus keyframe
+    }
+    if (slot.members == 0) slot.active = false;
+}
+
+static void finishSlot(BleTxSlot &slot) {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (slot.members & (1 << i)) leaveSlot(slot, bleClients[i], false);
+    }
+    slot.active = false;
+}
+
+static void releaseTxSlots() {
+    for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+        if (txSlots[s].active) finishSlot(txSlots[s]);
+    }
+}
+
+static bool txBusy() {
+    for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+        if (txSlots[s].active) return true;
+    }
+    return false;
+}
+
+// Interval koneksi rapat hanya saat jadwal fast memang cepat (berkendara)
+static void updateConnProfile(BleClient &c) {
+    ConnProfile wanted = fastestStreamInterval(c) <= 150 ? CONN_PROFILE_STREAM : CONN_PROFILE_IDLE;
+    if (wanted == c.connProfile) return;
+    if (c.connProfile != CONN_PROFILE_NONE && millis() - c.lastConnParamMs < BLE_CONN_PARAM_MIN_GAP_MS) return;
     
-    if (!bleTxInProgress) return;
+    if (wanted == CONN_PROFILE_STREAM) {
+        bleTransportConnParams(c.connId, BLE_CONN_STREAM_MIN_INTERVAL, BLE_CONN_STREAM_MAX_INTERVAL,
+                               BLE_CONN_LATENCY, BLE_CONN_TIMEOUT);
+    } else {
+        bleTransportConnParams(c.connId, BLE_CONN_IDLE_MIN_INTERVAL, BLE_CONN_IDLE_MAX_INTERVAL,
+                               BLE_CONN_LATENCY, BLE_CONN_TIMEOUT);
+    }
+    c.connProfile = wanted;
+    c.lastConnParamMs = millis();
+    pumpStats.connParamRequests++;
+}
+
+// Maks BLE_PUMP_MAX_CHUNKS chunk frame ini per pump, tiap chunk ke semua member
+static void pumpSlot(BleTxSlot &slot, uint32_t startUs) {
+    int chunks = 0;
     
-    if (bleTxOffset >= bleTxLen) {
-        bleTxInProgress = false;
-        return;
+    while (slot.active &&
+           chunks < BLE_PUMP_MAX_CHUNKS &&
+           (micros() - startUs) < BLE_PUMP_BUDGET_US) {
+        
+        if (slot.chunkLen == 0) {
+            int chunkLen = nextSlotChunk(slot);
+            if (chunkLen <= 0) {
+                finishSlot(slot);
+                break;
+            }
+            slot.chunkLen = chunkLen;
+            slot.pending = slot.members;
+            slot.chunkSinceMs = millis();
+        }
+        
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            if (!(slot.pending & (1 << i))) continue;
+            BleClient &c = bleClients[i];
+            if (!c.connected) {
+                leaveSlot(slot, c, true);
+                continue;
+            }
+            // Stack melaporkan congestion: tunggu event lepas, jangan isi antrian lagi
+            if (c.congested) {
+                pumpStats.chunksDeferred++;
+                continue;
+            }
+            if (!clientSend(c, slot.chunk, slot.chunkLen)) {
+                // Chunk tetap ditahan, dicoba lagi di pump berikutnya
+                pumpStats.chunksRetried++;
+                if (++c.retries > BLE_NOTIFY_MAX_RETRIES) leaveSlot(slot, c, true);
+                continue;
+            }
+            
+            slot.pending &= ~(1 << i);
+            c.retries = 0;
+            c.stats.bytes += slot.chunkLen;
+            c.stats.notifications++;
+            c.stats.windowBytes += slot.chunkLen;
+            pumpStats.chunksSent++;
+            if (slot.reply) continue;
+            BleFormatStats &fs = formatStats[slot.format];
+            fs.bytes += slot.chunkLen;
+            fs.notifications++;
+            fs.airtimeUs += notifyAirtimeUs(slot.chunkLen);
+            fs.windowBytes += slot.chunkLen;
+            fs.windowNotifications++;
+        }
+        if (!slot.active) break;
+        
+        if (slot.pending) {
+            // Member lain sudah terima chunk ini: jangan ditahan client lambat terlalu lama
+            if (slot.pending == slot.members || millis() - slot.chunkSinceMs < BLE_SHARED_STALL_MS) break;
+            for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+                if (slot.pending & (1 << i)) {
+                    leaveSlot(slot, bleClients[i], true);
+                    fanoutStats.stallDrops++;
+                }
+            }
+        }
+        
+        slot.chunkLen = 0;
+        chunks++;
+        if (slotFrameDone(slot)) finishSlot(slot);
     }
+}
 
+static void pumpTxSlots() {
     uint32_t startUs = micros();
-    int sent = 0;
+    for (int s = 0; s < BLE_MAX_CLIENTS; s++) {
+        if (txSlots[s].active) pumpSlot(txSlots[s], startUs);
+    }
+}
 
-    while (bleTxInProgress &&
-           sent < BLE_PUMP_MAX_CHUNKS &&
-           (micros() - startUs) < BLE_PUMP_BUDGET_US) {
+// =============================================
+// STREAMING (BLE TASK / LOOP)
+// =============================================
+static uint32_t jitterHistogram[BLE_JITTER_HIST_BUCKETS];
+static uint32_t jitterMaxUs = 0;
+static uint32_t jitterLastUs = 0;
+static uint32_t streamWakeups = 0;
+static uint32_t dataNotifications = 0;
 
-        int remain = bleTxLen - (int)bleTxOffset;
-        if (remain <= 0) {
-            bleTxInProgress = false;
+// Keterlambatan frame terhadap jadwal (due = batas interval berikutnya)
+static void recordSendJitter(uint32_t lateUs) {
+    static const uint32_t limitsUs[BLE_JITTER_HIST_BUCKETS - 1] = {500, 1000, 2000, 5000, 10000};
+    int bucket = BLE_JITTER_HIST_BUCKETS - 1;
+    for (int i = 0; i < BLE_JITTER_HIST_BUCKETS - 1; i++) {
+        if (lateUs < limitsUs[i]) {
+            bucket = i;
             break;
         }
+    }
+    jitterHistogram[bucket]++;
+    jitterLastUs = lateUs;
+    if (lateUs > jitterMaxUs) jitterMaxUs = lateUs;
+}
+
+static void updateRateWindow() {
+    // Laju per format dan per client dalam jendela terakhir
+    uint32_t now = millis();
+    if (now - statsWindowStart >= BLE_STATS_WINDOW_MS) {
+        uint32_t elapsed = now - statsWindowStart;
+        for (int i = 0; i < BLE_FORMAT_COUNT; i++) {
+            BleFormatStats &fs = formatStats[i];
+            fs.bytesPerSec = fs.windowBytes * 1000UL / elapsed;
+            fs.notificationsPerSec = fs.windowNotifications * 1000UL / elapsed;
+            fs.windowBytes = 0;
+            fs.windowNotifications = 0;
+        }
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            BleClientStats &cs = bleClients[i].stats;
+            cs.bytesPerSec = cs.windowBytes * 1000UL / elapsed;
+            cs.windowBytes = 0;
+        }
+        statsWindowStart = now;
+    }
+}
+
+// Jadwal dikunci ke kelipatan interval, bukan ke waktu kirim terakhir:
+// client dengan jadwal sama jatuh tempo di tick yang sama dan berbagi frame.
+// Grid bergeser sekali saat micros() wrap (~71 menit)
+static uint32_t alignedUs(uint32_t nowUs, uint32_t intervalUs) {
+    uint32_t aligned = nowUs - nowUs % intervalUs;
+    return aligned ? aligned : 1;       // 0 = paksa kirim
+}
+
+static uint32_t leftMs(uint32_t nowUs, uint32_t lastUs, uint32_t intervalUs) {
+    if (lastUs == 0) return 0;
+    uint32_t leftUs = intervalUs - min(intervalUs, nowUs - lastUs);
+    return (leftUs + 999) / 1000;
+}
+
+// Jadwal bawaan: fast/full menurut mode kendaraan
+static bool dueDefaultFrame(BleClient &c, uint32_t nowUs, uint8_t &kind) {
+    uint32_t fastUs = getFastUpdateInterval() * 1000UL;
+    uint32_t slowUs = getSlowUpdateInterval() * 1000UL;
+    bool slowDue = c.lastSlowUs == 0 || nowUs - c.lastSlowUs >= slowUs;
+    bool fastDue = c.lastFastUs == 0 || nowUs - c.lastFastUs >= fastUs;
+    if (!slowDue && !fastDue) return false;
+    
+    // lastXxx = 0 berarti dipaksa (updateBLEData / set_proto), bukan jadwal
+    uint32_t lastUs = slowDue ? c.lastSlowUs : c.lastFastUs;
+    uint32_t intervalUs = slowDue ? slowUs : fastUs;
+    if (lastUs != 0 && nowUs - lastUs >= intervalUs) recordSendJitter(nowUs - lastUs - intervalUs);
+    
+    c.lastFastUs = alignedUs(nowUs, fastUs);
+    if (slowDue) c.lastSlowUs = alignedUs(nowUs, slowUs);
+    kind = slowDue ? BLE_JSON_FULL : BLE_JSON_FAST;
+    return true;
+}
+
+static uint32_t defaultWaitMs(const BleClient &c, uint32_t nowUs) {
+    uint32_t fastLeft = leftMs(nowUs, c.lastFastUs, getFastUpdateInterval() * 1000UL);
+    uint32_t slowLeft = leftMs(nowUs, c.lastSlowUs, getSlowUpdateInterval() * 1000UL);
+    return min(fastLeft, slowLeft);
+}
+
+// Langganan: satu frame berisi semua grup yang jatuh tempo. Grup yang
+// tidak berlangganan tidak pernah diserialisasi maupun dikirim
+static bool dueSubscribedFrame(BleClient &c, uint32_t nowUs, uint8_t &due) {
+    bool anyDue = false;
+    uint32_t lateUs = 0;
+    due = 0;
+    
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        BleSubGroup &sg = c.subGroups[g];
+        if (sg.intervalMs == 0) continue;
+        
+        uint32_t intervalUs = sg.intervalMs * 1000UL;
+        uint32_t elapsedUs = nowUs - sg.lastSendUs;
+        if (sg.lastSendUs == 0 || elapsedUs >= intervalUs) {
+            due |= BLE_GROUP_BIT(g);
+            anyDue = true;
+            if (sg.lastSendUs != 0) lateUs = max(lateUs, elapsedUs - intervalUs);
+        } else if (elapsedUs + BLE_SUB_COALESCE_MS * 1000UL >= intervalUs) {
+            due |= BLE_GROUP_BIT(g);     // Hemat satu notifikasi
+        }
+    }
+    if (!anyDue) return false;
+    
+    if (lateUs > 0) recordSendJitter(lateUs);
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        if (!(due & BLE_GROUP_BIT(g))) continue;
+        BleSubGroup &sg = c.subGroups[g];
+        uint32_t intervalUs = sg.intervalMs * 1000UL;
+        if (sg.lastSendUs != 0 && nowUs - sg.lastSendUs < intervalUs) subCoalesced++;
+        sg.lastSendUs = alignedUs(nowUs, intervalUs);
+        sg.sends++;
+    }
+    subFrames++;
+    return true;
+}
 
-        int chunkLen = min((int)BLE_SAFE_CHUNK, remain);
-        const char *p = bleTxBuf + bleTxOffset;
+static uint32_t subscriptionWaitMs(const BleClient &c, uint32_t nowUs) {
+    uint32_t waitMs = BLE_TASK_IDLE_MS;
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+        const BleSubGroup &sg = c.subGroups[g];
+        if (sg.intervalMs == 0) continue;
+        waitMs = min(waitMs, leftMs(nowUs, sg.lastSendUs, sg.intervalMs * 1000UL));
+    }
+    return waitMs;
+}
 
-        pCharacteristic->setValue((uint8_t*)p, chunkLen);
-        pCharacteristic->notify();
+static void scheduleClient(BleClient &c, uint32_t nowUs, uint8_t &openSlots) {
+    // Reply command dulu, frame telemetry di tick setelahnya
+    if (c.replyLen > 0) {
+        startReplyFrame(c);
+        return;
+    }
+    uint8_t kind = BLE_JSON_GROUPS;
+    uint8_t groups = 0;
+    if (c.subActive) {
+        if (!dueSubscribedFrame(c, nowUs, groups)) return;
+    } else if (!dueDefaultFrame(c, nowUs, kind)) {
+        return;
+    }
+    startClientFrame(c, kind, groups, openSlots);
+}
 
-        bleTxOffset += chunkLen;
-        sent++;
+// Jadwal + pump. Return ms sampai perlu dipanggil lagi
+static uint32_t bleStreamTick() {
+    uint32_t waitMs = BLE_TASK_IDLE_MS;
+    
+    drainBleEvents();
+    
+    // Hanya kirim data jika ada koneksi
+    if (bleActive && deviceConnected) {
+        // Client yang masih menerima frame sebelumnya menunggu tick berikutnya
+        uint32_t nowUs = micros();
+        uint8_t openSlots = 0;
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            BleClient &c = bleClients[i];
+            if (c.connected && c.slot < 0) scheduleClient(c, nowUs, openSlots);
+        }
+        
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            if (bleClients[i].connected) updateConnProfile(bleClients[i]);
+        }
+        pumpTxSlots();
+        
+        if (txBusy()) {
+            // Sisa chunk (budget habis / congested): pump lagi sebentar lagi
+            waitMs = BLE_TASK_PUMP_MS;
+        } else {
+            nowUs = micros();
+            for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+                const BleClient &c = bleClients[i];
+                if (!c.connected) continue;
+                if (c.replyLen > 0) waitMs = 0;     // Reply menunggu frame sebelumnya selesai
+                waitMs = min(waitMs, c.subActive ? subscriptionWaitMs(c, nowUs) : defaultWaitMs(c, nowUs));
+            }
+        }
+    } else {
+        pumpTxSlots();  // Putus di tengah frame: lepas client dari slot
     }
+    
+    updateRateWindow();
+    return waitMs > 0 ? waitMs : 1;
+}
 
-    if (bleTxOffset >= bleTxLen) bleTxInProgress = false;
+#ifdef ESP32
+// Task streaming: tidur sampai frame berikutnya jatuh tempo, atau dibangunkan
+// oleh data CAN baru / koneksi / command client
+void bleTask(void *parameter) {
+    serialPrintflnAlways("[BLE] Stream task started on Core %d", xPortGetCoreID());
+    
+    bleStreamMutex = xSemaphoreCreateMutex();
+    
+    while (true) {
+        xSemaphoreTake(bleStreamMutex, portMAX_DELAY);
+        uint32_t waitMs = bleStreamTick();
+        xSemaphoreGive(bleStreamMutex);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+        streamWakeups++;
+    }
+}
+#endif
+
+void bleNotifyNewData() {
+    #ifdef ESP32
+    if (bleTaskHandle != NULL && deviceConnected) {
+        dataNotifications++;
+        xTaskNotifyGive(bleTaskHandle);
+    }
+    #endif
 }
 
 // =============================================
@@ -572,6 +1756,8 @@ static void pumpBleTx() {
 void processBLE() {
     if (!bleActive) return;
     
+    bleTransportPoll();
+    
     // Auto-off jika tidak ada koneksi
     if (bleActive && !deviceConnected) {
         unsigned long now = millis();
@@ -582,44 +1768,31 @@ void processBLE() {
         }
     }
     
-    // Restart advertising jika disconnect
-    if (!deviceConnected && oldDeviceConnected) {
+    // Restart advertising jika ada client lepas (slot kosong lagi)
+    if (advertisingRestart) {
+        advertisingRestart = false;
         delay(200);
-        BLEDevice::startAdvertising();
+        bleTransportAdvertise(true);
         serialPrintflnAlways("[BLE] Restarting advertising");
-        oldDeviceConnected = deviceConnected;
-    }
-    
-    if (deviceConnected && !oldDeviceConnected) {
-        oldDeviceConnected = deviceConnected;
     }
 
-    // Hanya kirim data jika ada koneksi
-    if (deviceConnected) {
-        uint32_t now = millis();
-        
-        if (!bleTxInProgress) {
-            uint32_t fastInterval = getFastUpdateInterval();
-            uint32_t slowInterval = getSlowUpdateInterval();
-            
-            if (now - lastSlowSend >= slowInterval) {
-                lastSlowSend = now;
-                lastFastSend = now;
-                startBleTxIfIdle(false);
-            } else if (now - lastFastSend >= fastInterval) {
-                lastFastSend = now;
-                startBleTxIfIdle(true);
-            }
-        }
-
-        pumpBleTx();
+    // Tanpa task BLE: streaming tetap dari loop()
+    #ifdef ESP32
+    if (bleTaskHandle == NULL) {
+        bleStreamTick();
     }
+    #else
+    bleStreamTick();
+    #endif
 }
 
 void updateBLEData() {
     if (bleActive && deviceConnected) {
-        lastFastSend = 0;
-        lastSlowSend = 0;
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            bleClients[i].lastFastUs = 0;
+            bleClients[i].lastSlowUs = 0;
+        }
+        bleNotifyNewData();
     }
 }
 
@@ -629,12 +1802,243 @@ void updateBLEData() {
 void printBLEStatus() {
     serialPrintflnAlways("\n=== BLE STATUS ===");
     serialPrintflnAlways("Active: %s", bleActive ? "YES" : "NO");
-    serialPrintflnAlways("Initialized: %s", bleInitialized ? "YES" : "NO");
-    serialPrintflnAlways("Connected: %s", deviceConnected ? "YES" : "NO");
-    serialPrintflnAlways("Advertising: %s", (bleActive && !deviceConnected) ? "YES" : "NO");
+    serialPrintflnAlways("Stack: %s %s, lifecycle %s%s", bleTransportName(), bleStackReady ? "UP" : "DOWN",
+                         BLE_DEINIT_ON_DISABLE ? "COLD" : "WARM", bleMemoryReleased ? " (memory released)" : "");
+    // Perbandingan backend: build ulang dengan BLE_BACKEND lain, bandingkan baris ini
+    serialPrintflnAlways("Footprint: stack heap %lu B (last cold start), sketch %lu B, free heap %lu B",
+                         (unsigned long)lifecycleStats.stackHeap, (unsigned long)ESP.getSketchSize(),
+                         (unsigned long)ESP.getFreeHeap());
+    serialPrintflnAlways("Starts: %lu cold (max %lu us), %lu warm (max %lu us), last %lu us, stop %lu us",
+                         (unsigned long)lifecycleStats.coldStarts, (unsigned long)lifecycleStats.maxColdStartUs,
+                         (unsigned long)lifecycleStats.warmStarts, (unsigned long)lifecycleStats.maxWarmStartUs,
+                         (unsigned long)lifecycleStats.lastStartUs, (unsigned long)lifecycleStats.lastStopUs);
+    bleTransportPrintStatus();
+    serialPrintflnAlways("Connected: %u/%d clients", connectedClients(), BLE_MAX_CLIENTS);
+    serialPrintflnAlways("Advertising: %s", (bleActive && connectedClients() < BLE_MAX_CLIENTS) ? "YES" : "NO");
     serialPrintflnAlways("Device Name: %s", BLE_DEVICE_NAME);
     serialPrintflnAlways("Service UUID: %s", SERVICE_UUID);
     serialPrintflnAlways("Waiting connection: %s", waitingForConnection ? "YES" : "NO");
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        const BleClient &c = bleClients[i];
+        if (!c.connected) continue;
+        serialPrintflnAlways("Client %u: %s, MTU %u (chunk %u B), congested %s, profile %s, sub %s",
+                             c.connId, FORMAT_NAMES[c.format], (unsigned)c.mtu, (unsigned)clientChunkCap(c),
+                             c.congested ? "YES" : "NO",
+                             c.connProfile == CONN_PROFILE_STREAM ? "STREAM" :
+                             (c.connProfile == CONN_PROFILE_IDLE ? "IDLE" : "-"),
+                             c.subActive ? "YES" : "NO");
+        serialPrintflnAlways("  %lu frames, %lu B, %lu notif, %lu dropped | now %lu B/s",
+                             (unsigned long)c.stats.frames, (unsigned long)c.stats.bytes,
+                             (unsigned long)c.stats.notifications, (unsigned long)c.stats.dropped,
+                             (unsigned long)c.stats.bytesPerSec);
+    }
+    serialPrintflnAlways("Fan-out: %lu frames serialized, %lu client frames, %lu stalled members dropped",
+                         (unsigned long)fanoutStats.serialized, (unsigned long)fanoutStats.delivered,
+                         (unsigned long)fanoutStats.stallDrops);
+    serialPrintflnAlways("Pump: %lu sent, %lu deferred, %lu retried, %lu frames dropped",
+                         (unsigned long)pumpStats.chunksSent, (unsigned long)pumpStats.chunksDeferred,
+                         (unsigned long)pumpStats.chunksRetried, (unsigned long)pumpStats.framesDropped);
+    serialPrintflnAlways("Congestion events: %lu, conn param requests: %lu, writes dropped: %lu",
+                         (unsigned long)pumpStats.congestionEvents, (unsigned long)pumpStats.connParamRequests,
+                         (unsigned long)writesDropped);
+    #ifdef ESP32
+    if (bleTaskHandle != NULL) {
+        serialPrintflnAlways("Stream task: %lu wakeups (%lu by CAN data), stack free %u B",
+                             (unsigned long)streamWakeups, (unsigned long)dataNotifications,
+                             (unsigned)uxTaskGetStackHighWaterMark(bleTaskHandle));
+    } else {
+        serialPrintflnAlways("Stream task: OFF (loop)");
+    }
+    #endif
+    serialPrintflnAlways("Send jitter: last %lu us, max %lu us", (unsigned long)jitterLastUs,
+                         (unsigned long)jitterMaxUs);
+    serialPrintflnAlways("  <0.5ms %lu | <1ms %lu | <2ms %lu | <5ms %lu | <10ms %lu | >=10ms %lu",
+                         (unsigned long)jitterHistogram[0], (unsigned long)jitterHistogram[1],
+                         (unsigned long)jitterHistogram[2], (unsigned long)jitterHistogram[3],
+                         (unsigned long)jitterHistogram[4], (unsigned long)jitterHistogram[5]);
+    serialPrintflnAlways("JSON serializer: last %u B in %lu us, max %lu us",
+                         jsonLastFrameBytes, (unsigned long)jsonLastFrameUs, (unsigned long)jsonMaxFrameUs);
+    serialPrintflnAlways("Protocol: per client (binary v%d)", BLE_BIN_VERSION);
+    for (int i = 0; i < BLE_FORMAT_COUNT; i++) {
+        const BleFormatStats &fs = formatStats[i];
+        serialPrintflnAlways("%-6s %lu frames, %lu B, %lu notif, %lu ms air | now %lu B/s, %lu notif/s",
+                             FORMAT_NAMES[i],
+                             (unsigned long)fs.frames, (unsigned long)fs.bytes,
+                             (unsigned long)fs.notifications, (unsigned long)(fs.airtimeUs / 1000),
+                             (unsigned long)fs.bytesPerSec, (unsigned long)fs.notificationsPerSec);
+    }
+    serialPrintflnAlways("Delta: %lu keyframes (%lu requested), %lu deltas",
+                         (unsigned long)deltaStats.keyframes, (unsigned long)deltaStats.requestedKeyframes,
+                         (unsigned long)deltaStats.deltas);
+    serialPrintflnAlways("Delta fields: %lu sent, %lu skipped, %lu B saved",
+                         (unsigned long)deltaStats.fieldsSent, (unsigned long)deltaStats.fieldsSkipped,
+                         (unsigned long)deltaStats.bytesSaved);
+    serialPrintflnAlways("Commands: %lu ok, %lu unknown, %lu malformed, last %lu us, max %lu us, %lu replies replaced",
+                         (unsigned long)cmdStats.received, (unsigned long)cmdStats.unknown,
+                         (unsigned long)(cmdStats.parseErrors[BLE_CMD_ERR_SYNTAX] +
+                                         cmdStats.parseErrors[BLE_CMD_ERR_TOO_LONG] +
+                                         cmdStats.parseErrors[BLE_CMD_ERR_TOO_MANY_FIELDS] +
+                                         cmdStats.parseErrors[BLE_CMD_ERR_TOO_DEEP]),
+                         (unsigned long)cmdStats.lastUs, (unsigned long)cmdStats.maxUs,
+                         (unsigned long)cmdStats.repliesReplaced);
+    serialPrintflnAlways("Subscription: %lu frames, %lu groups coalesced", (unsigned long)subFrames,
+                         (unsigned long)subCoalesced);
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        const BleClient &c = bleClients[i];
+        if (!c.connected || !c.subActive) continue;
+        for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+            if (c.subGroups[g].intervalMs == 0) {
+                serialPrintflnAlways("  %u %-8s off", c.connId, BLE_GROUP_NAMES[g]);
+            } else {
+                serialPrintflnAlways("  %u %-8s %5lu ms, %lu sends", c.connId, BLE_GROUP_NAMES[g],
+                                     (unsigned long)c.subGroups[g].intervalMs, (unsigned long)c.subGroups[g].sends);
+            }
+        }
+    }
     serialPrintflnAlways("Uptime: %lu seconds", millis() / 1000);
     serialPrintflnAlways("===================\n");
 }
+
+// Snapshot di bawah bleStreamMutex: semua counter dari tick yang sama
+void getBleStreamStats(BleStreamStats &stats) {
+    lockStream();
+    stats.connectedClients = connectedClients();
+    stats.chunksSent = pumpStats.chunksSent;
+    stats.chunksDeferred = pumpStats.chunksDeferred;
+    stats.chunksRetried = pumpStats.chunksRetried;
+    stats.framesDropped = pumpStats.framesDropped;
+    stats.congestionEvents = pumpStats.congestionEvents;
+    stats.connParamRequests = pumpStats.connParamRequests;
+    stats.framesSerialized = fanoutStats.serialized;
+    stats.clientFrames = fanoutStats.delivered;
+    stats.stallDrops = fanoutStats.stallDrops;
+    stats.writesDropped = writesDropped;
+    unlockStream();
+}
+
+// =============================================
+// COMMAND BENCHMARK (serial BLE BENCH)
+// =============================================
+// Payload contoh tiap command: parse saja, lalu parse + handler tanpa efek
+// samping. Jumlah blok heap sebelum/sesudah harus sama (parser tanpa heap)
+static uint32_t heapBlocks() {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    return info.allocated_blocks;
+}
+
+void bleCommandBenchmark() {
+    char reply[BLE_CMD_REPLY_MAX];
+    BleCmdMessage msg;
+    
+    serialPrintflnAlways("\n=== BLE COMMAND BENCH (%d iterations) ===", BLE_CMD_BENCH_ITERATIONS);
+    serialPrintflnAlways("Command      bytes  parse us  total us  reply  heap blocks");
+    for (size_t i = 0; i < BLE_COMMAND_COUNT; i++) {
+        const BleCommand &command = BLE_COMMANDS[i];
+        uint16_t len = strlen(command.sample);
+        int32_t blocksBefore = heapBlocks();
+        
+        uint32_t startUs = micros();
+        for (int n = 0; n < BLE_CMD_BENCH_ITERATIONS; n++) {
+            bleCmdParse(command.sample, len, msg);
+        }
+        uint32_t parseUs = micros() - startUs;
+        
+        int replyLen = 0;
+        startUs = micros();
+        for (int n = 0; n < BLE_CMD_BENCH_ITERATIONS; n++) {
+            replyLen = dispatchBleCommand(serialClient(), command.sample, len, reply, sizeof(reply), false);
+        }
+        uint32_t totalUs = micros() - startUs;
+        int32_t blocksDelta = (int32_t)heapBlocks() - blocksBefore;
+        
+        serialPrintflnAlways("%-11s  %5u  %8.2f  %8.2f  %5d  %+ld", command.name, len,
+                             (float)parseUs / BLE_CMD_BENCH_ITERATIONS, (float)totalUs / BLE_CMD_BENCH_ITERATIONS,
+                             replyLen, (long)blocksDelta);
+    }
+    serialPrintflnAlways("Parser state: %u B stack, reply buffer %u B",
+                         (unsigned)sizeof(BleCmdMessage), (unsigned)sizeof(reply));
+    serialPrintflnAlways("Live: %lu commands, %lu unknown, last %lu us, max %lu us",
+                         (unsigned long)cmdStats.received, (unsigned long)cmdStats.unknown,
+                         (unsigned long)cmdStats.lastUs, (unsigned long)cmdStats.maxUs);
+    serialPrintflnAlways("=========================================");
+}
+
+// =============================================
+// LIFECYCLE CYCLE TEST (serial BLE CYCLE)
+// =============================================
+// Stop/start stack N kali tanpa UI (tanpa layar APP MODE / BLE OFF), catat
+// latensi aktivasi dan free heap setelah tiap siklus. Heap yang terus turun
+// antar siklus = bocor per toggle
+void bleLifecycleBenchmark(uint32_t cycles) {
+    if (deviceConnected) {
+        serialPrintflnAlways("ERROR - Disconnect client first");
+        return;
+    }
+    if (bleMemoryReleased) {
+        serialPrintflnAlways("ERROR - Controller memory released, reboot first");
+        return;
+    }
+    
+    // processBLE / task stream tidak menyentuh stack selama test
+    lockStream();
+    bool wasActive = bleActive;
+    bleActive = false;
+    unlockStream();
+    
+    lockStream();
+    if (!bleStackReady || !wasActive) bleStackStart();     // Siklus 0: kondisi aktif
+    unlockStream();
+    uint32_t heapStart = ESP.getFreeHeap();
+    uint32_t heapOffFirst = 0, heapOffLast = 0, heapOnLast = 0;
+    uint32_t startMinUs = UINT32_MAX, startMaxUs = 0, startTotalUs = 0, stopMaxUs = 0;
+    
+    serialPrintflnAlways("\n=== BLE LIFECYCLE (%s %s, %lu cycles) ===", bleTransportName(),
+                         BLE_DEINIT_ON_DISABLE ? "COLD" : "WARM", (unsigned long)cycles);
+    serialPrintflnAlways("Heap active: %lu B (largest block %lu B)", (unsigned long)heapStart,
+                         (unsigned long)ESP.getMaxAllocHeap());
+    
+    for (uint32_t i = 0; i < cycles; i++) {
+        lockStream();
+        bleStackStop();
+        unlockStream();
+        uint32_t heapOff = ESP.getFreeHeap();
+        if (i == 0) heapOffFirst = heapOff;
+        heapOffLast = heapOff;
+        stopMaxUs = max(stopMaxUs, lifecycleStats.lastStopUs);
+        
+        lockStream();
+        bool started = bleStackStart();
+        unlockStream();
+        if (!started) break;
+        uint32_t us = lifecycleStats.lastStartUs;
+        startMinUs = min(startMinUs, us);
+        startMaxUs = max(startMaxUs, us);
+        startTotalUs += us;
+        heapOnLast = ESP.getFreeHeap();
+        
+        if (i < 3 || i == cycles - 1) {
+            serialPrintflnAlways("#%-3lu start %6lu us | heap off %6lu B, on %6lu B", (unsigned long)i,
+                                 (unsigned long)us, (unsigned long)heapOff, (unsigned long)heapOnLast);
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));      // Beri waktu task BT menyelesaikan event
+    }
+    
+    if (cycles > 0 && startTotalUs > 0) {
+        serialPrintflnAlways("Start: min %lu us, avg %lu us, max %lu us | stop max %lu us",
+                             (unsigned long)startMinUs, (unsigned long)(startTotalUs / cycles),
+                             (unsigned long)startMaxUs, (unsigned long)stopMaxUs);
+        serialPrintflnAlways("Freed while off: %ld B | active heap drift: %ld B (%ld B/cycle)",
+                             (long)heapOffFirst - (long)heapStart, (long)heapOnLast - (long)heapStart,
+                             ((long)heapOnLast - (long)heapStart) / (long)cycles);
+        serialPrintflnAlways("Off heap drift: %ld B", (long)heapOffLast - (long)heapOffFirst);
+    }
+    
+    // Kembalikan ke kondisi sebelum test
+    lockStream();
+    if (!wasActive) bleStackStop();
+    bleActive = wasActive && bleStackReady;
+    if (bleActive) bleLastConnectionTime = millis();
+    unlockStream();
+    serialPrintflnAlways("=====================================");
+}
@@ -15,10 +15,56 @@
 #define BLE_SLOW_MIN_MS 1000
 #define BLE_SLOW_MAX_MS 2000
 
-#define BLE_SAFE_CHUNK 240
 #define BLE_PUMP_BUDGET_US 10000
 #define BLE_PUMP_MAX_CHUNKS 4
 
+// MTU: chunk notifikasi = MTU hasil negosiasi koneksi - header ATT
+#define BLE_REQUESTED_MTU 512
+#define BLE_DEFAULT_MTU 23              // Sebelum client menegosiasi MTU
+#define BLE_ATT_HEADER_BYTES 3
+#define BLE_MAX_CHUNK (BLE_REQUESTED_MTU - BLE_ATT_HEADER_BYTES)
+#define BLE_NOTIFY_MAX_RETRIES 20       // Notify gagal berturut-turut sebelum frame dibuang
+
+// Multi client: tiap koneksi punya MTU, format, langganan dan state delta
+// sendiri. Batas stack: NimBLE CONFIG_BT_NIMBLE_MAX_CONNECTIONS = 3,
+// Bluedroid CONFIG_BT_ACL_CONNECTIONS = 4; maks 8 (bitmask)
+#define BLE_MAX_CLIENTS 3
+#define BLE_SHARED_STALL_MS 250         // Member congested selama ini dilepas dari frame bersama
+
+// Connection interval (unit 1.25 ms): rapat saat streaming cepat, longgar saat parkir
+#define BLE_CONN_STREAM_MIN_INTERVAL 6          // 7.5 ms
+#define BLE_CONN_STREAM_MAX_INTERVAL 12         // 15 ms
+#define BLE_CONN_IDLE_MIN_INTERVAL 24           // 30 ms
+#define BLE_CONN_IDLE_MAX_INTERVAL 40           // 50 ms
+#define BLE_CONN_LATENCY 0
+#define BLE_CONN_TIMEOUT 400                    // x10 ms = 4 s
+#define BLE_CONN_PARAM_MIN_GAP_MS 5000          // Jarak minimum antar permintaan
+
+// Protokol telemetry: JSON (default) atau frame biner fox_bleproto
+#define BLE_PROTO_BINARY_DEFAULT false  // Biner setelah MTU >= frame biner + 3, sebelumnya JSON
+#define BLE_STATS_WINDOW_MS 1000        // Jendela hitung bytes/s & notifikasi/s
+
+// Mode delta (fmt "delta"): hanya field berubah, keyframe berkala
+#define BLE_DELTA_KEYFRAME_MS 10000     // Paksa keyframe tiap N ms
+
+// Langganan grup ({"cmd":"subscribe"}): interval minta client dibatasi firmware
+#define BLE_SUB_MIN_MOTION_MS 100
+#define BLE_SUB_MIN_PACK_MS 200
+#define BLE_SUB_MIN_CELLS_MS 1000
+#define BLE_SUB_MIN_TEMPS_MS 1000
+#define BLE_SUB_MIN_CHARGER_MS 1000
+#define BLE_SUB_MAX_INTERVAL_MS 60000
+#define BLE_SUB_COALESCE_MS 20          // Grup yang jatuh tempo sebentar lagi ikut frame ini
+
+// Command dari client (fox_blecmd)
+#define BLE_CMD_REPLY_MAX 128           // Reply terpanjang: subscribe ~100 byte
+#define BLE_CMD_BENCH_ITERATIONS 200    // Serial BLE BENCH
+
+// Estimasi airtime per notifikasi (LE 1M PHY, DLE aktif): preamble + access
+// address + header + CRC + L2CAP + ATT, lalu T_IFS + ACK kosong + T_IFS
+#define BLE_NOTIFY_OVERHEAD_BYTES 17
+#define BLE_NOTIFY_EXCHANGE_US 380
+
 // Vehicle mode for adaptive timing
 typedef enum {
     MODE_PARK = 0,
@@ -43,6 +89,31 @@ void setBLEActivationPending(bool pending, unsigned long startTime = 0);
 void resetBLEActivation();
 void printBLEStatus();
 
+// Counter task stream (pump, fan-out, event stack) untuk diagnosa & host test
+typedef struct {
+    uint8_t connectedClients;
+    uint32_t chunksSent;
+    uint32_t chunksDeferred;            // Client congested: chunk ditahan
+    uint32_t chunksRetried;             // Notify gagal, chunk dicoba lagi
+    uint32_t framesDropped;
+    uint32_t congestionEvents;
+    uint32_t connParamRequests;
+    uint32_t framesSerialized;          // Frame dibangun (sekali per slot bersama)
+    uint32_t clientFrames;              // Frame per client
+    uint32_t stallDrops;                // Member lambat dilepas dari frame bersama
+    uint32_t writesDropped;             // Antrian write penuh
+} BleStreamStats;
+
+void getBleStreamStats(BleStreamStats &stats);
+void bleCommandBenchmark();                     // Parse + handler per command (tanpa efek samping)
+void bleLifecycleBenchmark(uint32_t cycles);    // Stop/start stack N kali: latensi & heap
+
+// Task streaming (BLE_TASK_ENABLED). Tanpa task, processBLE() yang streaming
+#ifdef ESP32
+void bleTask(void *parameter);
+#endif
+void bleNotifyNewData();        // Bangunkan task stream (dari sisi CAN)
+
 // Display functions for BLE
 void showAppModeDisplay();
 void showBleOffDisplay();
@@ -0,0 +1,227 @@
+#include "fox_blecmd.h"
+#include <string.h>
+
+// =============================================
+// TOKENIZER
+// =============================================
+static const char* const STATUS_NAMES[BLE_CMD_STATUS_COUNT] = {
+    "OK", "EMPTY", "TOO_LONG", "SYNTAX", "TOO_MANY_FIELDS", "TOO_DEEP"
+};
+
+const char* bleCmdStatusName(BleCmdStatus status) {
+    return status < BLE_CMD_STATUS_COUNT ? STATUS_NAMES[status] : "?";
+}
+
+// Cursor baca; semua fungsi berhenti di end, tidak pernah membaca lewat
+typedef struct {
+    const char *p;
+    const char *end;
+} Cursor;
+
+static void skipSpace(Cursor &c) {
+    while (c.p < c.end && (*c.p == ' ' || *c.p == '\t' || *c.p == '\r' || *c.p == '\n')) c.p++;
+}
+
+// c.p di tanda kutip pembuka. Isi span tanpa kutip, c.p setelah kutip penutup
+static bool scanString(Cursor &c, const char *&start, uint16_t &len) {
+    c.p++;
+    start = c.p;
+    while (c.p < c.end) {
+        char ch = *c.p;
+        if (ch == '"') {
+            len = (uint16_t)(c.p - start);
+            c.p++;
+            return true;
+        }
+        if (ch == '\\') {
+            if (c.p + 1 >= c.end) return false;
+            c.p += 2;
+            continue;
+        }
+        if ((uint8_t)ch < 0x20) return false;   // Kontrol wajib di-escape
+        c.p++;
+    }
+    return false;
+}
+
+static bool scanNumber(Cursor &c) {
+    const char *start = c.p;
+    if (c.p < c.end && *c.p == '-') c.p++;
+    const char *digits = c.p;
+    while (c.p < c.end && ((*c.p >= '0' && *c.p <= '9') || *c.p == '.' || *c.p == 'e' || *c.p == 'E' ||
+                           *c.p == '+' || *c.p == '-')) {
+        c.p++;
+    }
+    return c.p > digits && (*digits >= '0' && *digits <= '9') && c.p > start;
+}
+
+static bool scanLiteral(Cursor &c, const char *literal) {
+    size_t n = strlen(literal);
+    if ((size_t)(c.end - c.p) < n || memcmp(c.p, literal, n) != 0) return false;
+    c.p += n;
+    return true;
+}
+
+// Lewati objek/array bersarang (c.p di '{' / '['), sadar string
+static BleCmdStatus skipNested(Cursor &c) {
+    char stack[BLE_CMD_MAX_DEPTH];
+    uint8_t depth = 0;
+    while (c.p < c.end) {
+        char ch = *c.p;
+        if (ch == '"') {
+            const char *s;
+            uint16_t n;
+            if (!scanString(c, s, n)) return BLE_CMD_ERR_SYNTAX;
+            continue;
+        }
+        if (ch == '{' || ch == '[') {
+            if (depth >= BLE_CMD_MAX_DEPTH) return BLE_CMD_ERR_TOO_DEEP;
+            stack[depth++] = (ch == '{') ? '}' : ']';
+        } else if (ch == '}' || ch == ']') {
+            if (depth == 0 || stack[depth - 1] != ch) return BLE_CMD_ERR_SYNTAX;
+            if (--depth == 0) {
+                c.p++;
+                return BLE_CMD_OK;
+            }
+        }
+        c.p++;
+    }
+    return BLE_CMD_ERR_SYNTAX;
+}
+
+// =============================================
+// PARSE
+// =============================================
+BleCmdStatus bleCmdParse(const char *json, uint16_t len, BleCmdMessage &msg) {
+    msg.count = 0;
+    msg.cmd = NULL;
+    if (json == NULL || len == 0) return BLE_CMD_ERR_EMPTY;
+    if (len > BLE_CMD_MAX_LEN) return BLE_CMD_ERR_TOO_LONG;
+
+    Cursor c = {json, json + len};
+    skipSpace(c);
+    if (c.p >= c.end) return BLE_CMD_ERR_EMPTY;
+    if (*c.p != '{') return BLE_CMD_ERR_SYNTAX;
+    c.p++;
+    skipSpace(c);
+
+    if (c.p < c.end && *c.p == '}') {
+        c.p++;
+    } else {
+        while (true) {
+            // Key
+            skipSpace(c);
+            if (c.p >= c.end || *c.p != '"') return BLE_CMD_ERR_SYNTAX;
+            const char *key;
+            uint16_t keyLen;
+            if (!scanString(c, key, keyLen) || keyLen > 255) return BLE_CMD_ERR_SYNTAX;
+            skipSpace(c);
+            if (c.p >= c.end || *c.p != ':') return BLE_CMD_ERR_SYNTAX;
+            c.p++;
+            skipSpace(c);
+            if (c.p >= c.end) return BLE_CMD_ERR_SYNTAX;
+
+            // Value
+            BleCmdField field;
+            field.key = key;
+            field.keyLen = (uint8_t)keyLen;
+            field.value = c.p;
+            char ch = *c.p;
+            if (ch == '"') {
+                field.type = BLE_VAL_STRING;
+                if (!scanString(c, field.value, field.valueLen)) return BLE_CMD_ERR_SYNTAX;
+            } else {
+                if (ch == '{' || ch == '[') {
+                    field.type = BLE_VAL_NESTED;
+                    BleCmdStatus status = skipNested(c);
+                    if (status != BLE_CMD_OK) return status;
+                } else if (ch == 't' || ch == 'f') {
+                    field.type = BLE_VAL_BOOL;
+                    if (!scanLiteral(c, ch == 't' ? "true" : "false")) return BLE_CMD_ERR_SYNTAX;
+                } else if (ch == 'n') {
+                    field.type = BLE_VAL_NULL;
+                    if (!scanLiteral(c, "null")) return BLE_CMD_ERR_SYNTAX;
+                } else {
+                    field.type = BLE_VAL_NUMBER;
+                    if (!scanNumber(c)) return BLE_CMD_ERR_SYNTAX;
+                }
+                field.valueLen = (uint16_t)(c.p - field.value);
+            }
+
+            if (msg.count >= BLE_CMD_MAX_FIELDS) return BLE_CMD_ERR_TOO_MANY_FIELDS;
+            msg.fields[msg.count++] = field;
+
+            skipSpace(c);
+            if (c.p >= c.end) return BLE_CMD_ERR_SYNTAX;
+            if (*c.p == ',') {
+                c.p++;
+                continue;
+            }
+            if (*c.p != '}') return BLE_CMD_ERR_SYNTAX;
+            c.p++;
+            break;
+        }
+    }
+
+    // Sisa hanya boleh spasi / NUL (beberapa app mengirim terminator)
+    while (c.p < c.end && (*c.p == ' ' || *c.p == '\t' || *c.p == '\r' || *c.p == '\n' || *c.p == '\0')) c.p++;
+    if (c.p != c.end) return BLE_CMD_ERR_SYNTAX;
+
+    const BleCmdField *cmd = bleCmdFind(msg, "cmd");
+    if (cmd != NULL && cmd->type == BLE_VAL_STRING) msg.cmd = cmd;
+    return BLE_CMD_OK;
+}
+
+// =============================================
+// ACCESSORS
+// =============================================
+bool bleCmdSpanIs(const char *span, uint16_t len, const char *literal) {
+    for (uint16_t i = 0; i < len; i++) {
+        if (literal[i] == '\0' || literal[i] != span[i]) return false;
+    }
+    return literal[len] == '\0';
+}
+
+const BleCmdField* bleCmdFind(const BleCmdMessage &msg, const char *key) {
+    for (uint8_t i = 0; i < msg.count; i++) {
+        if (bleCmdSpanIs(msg.fields[i].key, msg.fields[i].keyLen, key)) return &msg.fields[i];
+    }
+    return NULL;
+}
+
+// Bagian bulat dari angka JSON ("100.7" -> 100), clamp ke int32
+int32_t bleCmdInt(const BleCmdMessage &msg, const char *key, int32_t defaultValue) {
+    const BleCmdField *field = bleCmdFind(msg, key);
+    if (field == NULL || field->type != BLE_VAL_NUMBER) return defaultValue;
+
+    const char *p = field->value;
+    const char *end = p + field->valueLen;
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+    int64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (value <= INT32_MAX) value = value * 10 + (*p - '0');
+        p++;
+    }
+    if (negative) value = -value;
+    if (value > INT32_MAX) return INT32_MAX;
+    if (value < INT32_MIN) return INT32_MIN;
+    return (int32_t)value;
+}
+
+bool bleCmdBool(const BleCmdMessage &msg, const char *key, bool defaultValue) {
+    const BleCmdField *field = bleCmdFind(msg, key);
+    if (field == NULL || field->type != BLE_VAL_BOOL) return defaultValue;
+    return field->value[0] == 't';
+}
+
+bool bleCmdString(const BleCmdMessage &msg, const char *key, const char *&value, uint16_t &len) {
+    const BleCmdField *field = bleCmdFind(msg, key);
+    if (field == NULL || field->type != BLE_VAL_STRING) return false;
+    value = field->value;
+    len = field->valueLen;
+    return true;
+}
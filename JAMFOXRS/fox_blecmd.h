@@ -0,0 +1,66 @@
+#ifndef FOX_BLECMD_H
+#define FOX_BLECMD_H
+
+#include <Arduino.h>
+
+// =============================================
+// BLE COMMAND PARSER (TANPA HEAP)
+// =============================================
+// Command dari client berupa satu objek JSON datar, mis.
+// {"cmd":"set_time","time":"12:34:56","date":"19/10/2026","dayofweek":2}.
+// Parser membaca langsung dari buffer characteristic (pointer + panjang),
+// tidak menyalin dan tidak alokasi: tiap field hanya disimpan sebagai span
+// key/value ke buffer asal. Nilai objek/array bersarang dilewati (NESTED).
+// String disimpan mentah (escape tidak di-decode), cukup untuk command yang ada.
+
+#define BLE_CMD_MAX_LEN 512             // Write lebih panjang ditolak (MTU maks)
+#define BLE_CMD_MAX_FIELDS 12
+#define BLE_CMD_MAX_DEPTH 8             // Nilai bersarang lebih dalam ditolak
+
+typedef enum {
+    BLE_VAL_STRING = 0,
+    BLE_VAL_NUMBER,
+    BLE_VAL_BOOL,
+    BLE_VAL_NULL,
+    BLE_VAL_NESTED              // Objek / array, isinya tidak diparse
+} BleCmdValueType;
+
+typedef struct {
+    const char *key;
+    const char *value;          // Tanpa tanda kutip untuk string
+    uint16_t valueLen;
+    uint8_t keyLen;
+    uint8_t type;               // BleCmdValueType
+} BleCmdField;
+
+typedef struct {
+    BleCmdField fields[BLE_CMD_MAX_FIELDS];
+    uint8_t count;
+    const BleCmdField *cmd;     // Field "cmd" (string), NULL jika tidak ada
+} BleCmdMessage;
+
+typedef enum {
+    BLE_CMD_OK = 0,
+    BLE_CMD_ERR_EMPTY,
+    BLE_CMD_ERR_TOO_LONG,
+    BLE_CMD_ERR_SYNTAX,
+    BLE_CMD_ERR_TOO_MANY_FIELDS,
+    BLE_CMD_ERR_TOO_DEEP,
+    BLE_CMD_STATUS_COUNT
+} BleCmdStatus;
+
+BleCmdStatus bleCmdParse(const char *json, uint16_t len, BleCmdMessage &msg);
+const char* bleCmdStatusName(BleCmdStatus status);
+
+// Span sama persis dengan literal (NUL-terminated)
+bool bleCmdSpanIs(const char *span, uint16_t len, const char *literal);
+
+// Field pertama dengan key ini, NULL jika tidak ada
+const BleCmdField* bleCmdFind(const BleCmdMessage &msg, const char *key);
+
+// Akses bertipe; defaultValue jika key tidak ada atau tipenya lain
+int32_t bleCmdInt(const BleCmdMessage &msg, const char *key, int32_t defaultValue);
+bool bleCmdBool(const BleCmdMessage &msg, const char *key, bool defaultValue);
+bool bleCmdString(const BleCmdMessage &msg, const char *key, const char *&value, uint16_t &len);
+
+#endif
@@ -0,0 +1,225 @@
+#include "fox_bletransport.h"
+
+#if BLE_BACKEND == BLE_BACKEND_BLUEDROID
+
+#include "fox_ble.h"
+#include "fox_serial.h"
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLE2902.h>
+
+// =============================================
+// BLUEDROID BACKEND (BLEDevice bawaan core ESP32)
+// =============================================
+static BLEServer* pServer = nullptr;
+static BLECharacteristic* pCharacteristic = nullptr;
+static bool advertisingConfigured = false;  // Objek advertising BLEDevice bertahan lewat deinit
+static bool advertisingWanted = false;      // Permintaan fox_ble terakhir
+static volatile bool advertisingOn = false; // Dari event GAP start/stop complete
+static uint32_t advertisingSeenMs = 0;      // Terakhir advertising / tidak perlu advertising
+
+typedef struct {
+    uint32_t notifyFailed;              // send_indicate gagal: antrian GATT penuh
+    uint32_t advertisingStartFailed;    // ADV_START_COMPLETE dengan status error
+    uint32_t advertisingRestarts;       // Dihidupkan lagi oleh watchdog di poll
+} DroidStats;
+
+static DroidStats droidStats = {0};
+
+// updateConnParams Bluedroid butuh alamat peer, bukan conn_id
+typedef struct {
+    bool used;
+    uint16_t connId;
+    esp_bd_addr_t bda;
+} DroidPeer;
+
+static DroidPeer peers[BLE_MAX_CLIENTS + 1];    // +1: koneksi yang sedang ditolak
+
+// Event GATTS mentah: Arduino BLE tidak meneruskan congestion ke callback
+static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf,
+                              esp_ble_gatts_cb_param_t *param) {
+    if (event == ESP_GATTS_CONGEST_EVT) {
+        bleOnCongestion(param->congest.conn_id, param->congest.congested);
+    }
+}
+
+// Event GAP: BLEAdvertising tidak melaporkan apakah start berhasil
+static void gapEventHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+    if (event == ESP_GAP_BLE_ADV_START_COMPLETE_EVT) {
+        advertisingOn = param->adv_start_cmpl.status == ESP_BT_STATUS_SUCCESS;
+        if (!advertisingOn) droidStats.advertisingStartFailed++;
+    } else if (event == ESP_GAP_BLE_ADV_STOP_COMPLETE_EVT) {
+        advertisingOn = false;
+    }
+}
+
+class DroidServerCallbacks: public BLEServerCallbacks {
+    void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t *param) override {
+        advertisingOn = false;          // Controller berhenti advertising saat koneksi masuk
+        for (int i = 0; i <= BLE_MAX_CLIENTS; i++) {
+            if (peers[i].used) continue;
+            peers[i].used = true;
+            peers[i].connId = param->connect.conn_id;
+            memcpy(peers[i].bda, param->connect.remote_bda, sizeof(peers[i].bda));
+            break;
+        }
+        bleOnConnect(param->connect.conn_id);
+    }
+
+    void onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t *param) override {
+        bleOnMtu(param->mtu.conn_id, param->mtu.mtu);
+    }
+
+    void onDisconnect(BLEServer* pServer, esp_ble_gatts_cb_param_t *param) override {
+        for (int i = 0; i <= BLE_MAX_CLIENTS; i++) {
+            if (peers[i].used && peers[i].connId == param->disconnect.conn_id) peers[i].used = false;
+        }
+        bleOnDisconnect(param->disconnect.conn_id);
+    }
+};
+
+class DroidCharacteristicCallbacks: public BLECharacteristicCallbacks {
+    // Data characteristic dibaca langsung (tanpa salinan String)
+    void onWrite(BLECharacteristic *pCharacteristic, esp_ble_gatts_cb_param_t *param) override {
+        bleOnWrite(param->write.conn_id, pCharacteristic->getData(), pCharacteristic->getLength());
+    }
+};
+
+// Callback cukup satu instance untuk semua siklus init/deinit
+static DroidServerCallbacks serverCallbacks;
+static DroidCharacteristicCallbacks characteristicCallbacks;
+
+bool bleTransportInit(const char *deviceName, uint16_t mtu) {
+    BLEDevice::init(deviceName);
+    BLEDevice::setMTU(mtu);
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
+    BLEDevice::setCustomGapHandler(gapEventHandler);
+
+    pServer = BLEDevice::createServer();
+    pServer->setCallbacks(&serverCallbacks);
+
+    BLEService *pService = pServer->createService(SERVICE_UUID);
+
+    pCharacteristic = pService->createCharacteristic(
+        CHARACTERISTIC_UUID,
+        BLECharacteristic::PROPERTY_READ |
+        BLECharacteristic::PROPERTY_NOTIFY |
+        BLECharacteristic::PROPERTY_WRITE
+    );
+
+    pCharacteristic->addDescriptor(new BLE2902());
+    pCharacteristic->setCallbacks(&characteristicCallbacks);
+    pCharacteristic->setValue("JAMFOXRS BLE Ready");
+
+    pService->start();
+    memset(peers, 0, sizeof(peers));
+
+    // addServiceUUID menambah ke list: sekali saja, bukan tiap init
+    if (!advertisingConfigured) {
+        BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+        pAdvertising->addServiceUUID(SERVICE_UUID);
+        pAdvertising->setScanResponse(true);
+        pAdvertising->setMinPreferred(0x06);
+        pAdvertising->setMaxPreferred(0x12);
+        advertisingConfigured = true;
+    }
+    return true;
+}
+
+// Objek GATT milik library lama tidak dipakai lagi; onDisconnect tidak
+// akan datang setelah deinit
+void bleTransportDeinit(bool releaseMemory) {
+    BLEDevice::deinit(releaseMemory);
+    pServer = nullptr;
+    pCharacteristic = nullptr;
+    memset(peers, 0, sizeof(peers));
+    advertisingWanted = false;
+    advertisingOn = false;
+}
+
+void bleTransportAdvertise(bool on) {
+    advertisingWanted = on;
+    advertisingSeenMs = millis();
+    if (on) BLEDevice::startAdvertising();
+    else BLEDevice::stopAdvertising();
+}
+
+// notify() library menyiarkan ke semua peer: kirim langsung per conn_id
+bool bleTransportNotify(uint16_t conn, const uint8_t *data, uint16_t len) {
+    if (pServer == nullptr || pCharacteristic == nullptr) return false;
+    if (esp_ble_gatts_send_indicate(pServer->getGattsIf(), conn, pCharacteristic->getHandle(),
+                                    len, (uint8_t*)data, false) == ESP_OK) return true;
+    droidStats.notifyFailed++;
+    return false;
+}
+
+void bleTransportSetValue(const uint8_t *data, uint16_t len) {
+    if (pCharacteristic != nullptr) pCharacteristic->setValue((uint8_t*)data, len);
+}
+
+void bleTransportDisconnect(uint16_t conn) {
+    if (pServer != nullptr) pServer->disconnect(conn);
+}
+
+void bleTransportConnParams(uint16_t conn, uint16_t minInterval, uint16_t maxInterval,
+                            uint16_t latency, uint16_t timeout) {
+    if (pServer == nullptr) return;
+    for (int i = 0; i <= BLE_MAX_CLIENTS; i++) {
+        if (peers[i].used && peers[i].connId == conn) {
+            pServer->updateConnParams(peers[i].bda, minInterval, maxInterval, latency, timeout);
+            return;
+        }
+    }
+}
+
+static uint8_t connectedPeers() {
+    uint8_t count = 0;
+    for (int i = 0; i <= BLE_MAX_CLIENTS; i++) {
+        if (peers[i].used) count++;
+    }
+    return count;
+}
+
+// Watchdog advertising: start yang gagal (ADV_START_COMPLETE error, mis.
+// bentrok dengan koneksi yang sedang masuk) tidak dicoba lagi oleh library.
+// Selama masih ada tempat client, start lagi setelah BLE_ADV_WATCHDOG_MS.
+void bleTransportPoll() {
+    if (pServer == nullptr || !advertisingWanted) return;
+    uint32_t now = millis();
+    if (advertisingOn || connectedPeers() >= BLE_MAX_CLIENTS) {
+        advertisingSeenMs = now;
+        return;
+    }
+    if (now - advertisingSeenMs < BLE_ADV_WATCHDOG_MS) return;
+    advertisingSeenMs = now;
+    droidStats.advertisingRestarts++;
+    BLEDevice::startAdvertising();
+}
+
+const char* bleTransportName() {
+    return "Bluedroid";
+}
+
+// Data dari stack (event GAP & tabel peer), bukan state fox_ble
+void bleTransportPrintStatus() {
+    if (pServer == nullptr) {
+        serialPrintflnAlways("Bluedroid: stack down");
+        return;
+    }
+    serialPrintflnAlways("Bluedroid: %u peers, advertising %s, %lu notify failed, "
+                         "%lu advertising start failed, %lu advertising restarts",
+                         connectedPeers(), advertisingOn ? "YES" : "NO",
+                         (unsigned long)droidStats.notifyFailed,
+                         (unsigned long)droidStats.advertisingStartFailed,
+                         (unsigned long)droidStats.advertisingRestarts);
+    for (int i = 0; i <= BLE_MAX_CLIENTS; i++) {
+        if (!peers[i].used) continue;
+        const uint8_t *bda = peers[i].bda;
+        serialPrintflnAlways("  Peer %u %02x:%02x:%02x:%02x:%02x:%02x: MTU %u", peers[i].connId,
+                             bda[0], bda[1], bda[2], bda[3], bda[4], bda[5],
+                             pServer->getPeerMTU(peers[i].connId));
+    }
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "fox_bletransport.h"
+
+#if BLE_BACKEND == BLE_BACKEND_LOOPBACK
+
+#include "fox_ble.h"
+#include "fox_bleloop.h"
+#include "fox_bleproto.h"
+#include "fox_serial.h"
+
+// =============================================
+// LOOPBACK BACKEND (TANPA RADIO)
+// =============================================
+// Seluruh jalur BLE (aktivasi, jadwal, serializer, pump, command) jalan
+// tanpa controller Bluetooth. Default: BLE_LOOPBACK_CONNECT_MS setelah
+// advertising satu client virtual terhubung dengan MTU penuh. Host test
+// mematikan auto-connect dan mengatur sendiri sampai BLE_MAX_CLIENTS client
+// (fox_bleloop.h). Notifikasi dihitung per koneksi dan framing-nya dicek
+// (JSON diakhiri '\n', frame biner diawali magic). Seperti stack asli,
+// advertising berhenti saat client connect, dan disconnect yang diminta
+// fox_ble dilaporkan di poll berikutnya.
+typedef struct {
+    bool used;                          // Handle dipegang (termasuk menunggu event disconnect)
+    bool connected;
+    bool disconnectPending;             // Diputus fox_ble: event menyusul di poll
+    bool congested;
+    uint16_t conn;
+    uint16_t rejectNotifies;
+    BleLoopStats stats;
+} LoopConn;
+
+static LoopConn conns[BLE_MAX_CLIENTS];
+static uint16_t nextConn = 0;           // Handle tidak dipakai ulang: handle basi ketahuan
+static bool stackUp = false;
+static bool advertising = false;
+static bool autoConnect = true;
+static uint32_t advertiseStartMs = 0;
+static BleLoopSink sink = NULL;
+
+static LoopConn* findConn(uint16_t conn) {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (conns[i].used && conns[i].conn == conn) return &conns[i];
+    }
+    return NULL;
+}
+
+static bool anyConn() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (conns[i].used) return true;
+    }
+    return false;
+}
+
+// Reply command = frame JSON ber-'\n' yang diawali {"status"; dichunk seperti
+// frame telemetry dan tidak pernah menyela frame lain
+static bool isCommandReply(const uint8_t *data, uint16_t len) {
+    static const char PREFIX[] = "{\"status\"";
+    return len >= sizeof(PREFIX) - 1 && memcmp(data, PREFIX, sizeof(PREFIX) - 1) == 0;
+}
+
+static void checkFraming(BleLoopStats &s, const uint8_t *data, uint16_t len) {
+    if (!s.midJson && data[0] == '{') s.midReply = isCommandReply(data, len);
+    if (s.midJson || data[0] == '{') {
+        s.midJson = data[len - 1] != '\n';
+        if (s.midJson) return;
+        if (s.midReply) s.replies++;
+        else s.jsonFrames++;
+    } else if (data[0] == BLE_BIN_MAGIC && len >= sizeof(BleBinHeader)) {
+        s.binaryFrames++;
+    } else {
+        s.badChunks++;
+    }
+}
+
+bool bleTransportInit(const char *deviceName, uint16_t mtu) {
+    stackUp = true;
+    return true;
+}
+
+// Tanpa event disconnect, sama seperti deinit stack asli
+void bleTransportDeinit(bool releaseMemory) {
+    stackUp = false;
+    advertising = false;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) conns[i].used = false;
+}
+
+void bleTransportAdvertise(bool on) {
+    if (on && !advertising) advertiseStartMs = millis();
+    advertising = on && stackUp;
+}
+
+bool bleTransportNotify(uint16_t conn, const uint8_t *data, uint16_t len) {
+    LoopConn *c = findConn(conn);
+    if (c == NULL || !c->connected || len == 0) return false;
+    if (c->rejectNotifies > 0 || c->congested) {
+        if (c->rejectNotifies > 0) c->rejectNotifies--;
+        c->stats.rejected++;
+        return false;
+    }
+
+    BleLoopStats &s = c->stats;
+    s.notifications++;
+    s.bytes += len;
+    if (len > s.maxChunk) s.maxChunk = len;
+    checkFraming(s, data, len);
+    if (sink != NULL) sink(conn, data, len);
+    return true;
+}
+
+void bleTransportSetValue(const uint8_t *data, uint16_t len) {
+}
+
+void bleTransportDisconnect(uint16_t conn) {
+    LoopConn *c = findConn(conn);
+    if (c == NULL || !c->connected) return;
+    c->connected = false;
+    c->disconnectPending = true;
+}
+
+void bleTransportConnParams(uint16_t conn, uint16_t minInterval, uint16_t maxInterval,
+                            uint16_t latency, uint16_t timeout) {
+    LoopConn *c = findConn(conn);
+    if (c == NULL) return;
+    c->stats.connParamRequests++;
+    c->stats.minInterval = minInterval;
+    c->stats.maxInterval = maxInterval;
+}
+
+// Koneksi virtual dari processBLE, bukan dari activateBLE: urutan event
+// sama dengan client asli (advertising dulu, connect kemudian)
+void bleTransportPoll() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        LoopConn &c = conns[i];
+        if (!c.used || !c.disconnectPending) continue;
+        c.used = false;
+        advertiseStartMs = millis();    // Client virtual kembali setelah jeda yang sama
+        bleOnDisconnect(c.conn);
+    }
+    if (!autoConnect || !advertising || anyConn()) return;
+    if (millis() - advertiseStartMs < BLE_LOOPBACK_CONNECT_MS) return;
+    bleLoopConnect(BLE_REQUESTED_MTU);
+}
+
+const char* bleTransportName() {
+    return "Loopback";
+}
+
+void bleTransportPrintStatus() {
+    serialPrintflnAlways("Loopback: advertising %s, auto-connect %s", advertising ? "YES" : "NO",
+                         autoConnect ? "ON" : "OFF");
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        const LoopConn &c = conns[i];
+        if (!c.used) continue;
+        const BleLoopStats &s = c.stats;
+        serialPrintflnAlways("  Conn %u: %lu notif, %lu B, %lu JSON + %lu binary frames, %lu bad chunks, %lu rejected",
+                             c.conn, (unsigned long)s.notifications, (unsigned long)s.bytes,
+                             (unsigned long)s.jsonFrames, (unsigned long)s.binaryFrames,
+                             (unsigned long)s.badChunks, (unsigned long)s.rejected);
+    }
+}
+
+// =============================================
+// KENDALI CLIENT VIRTUAL (fox_bleloop.h)
+// =============================================
+void bleLoopAutoConnect(bool on) {
+    autoConnect = on;
+}
+
+int bleLoopConnect(uint16_t mtu) {
+    if (!advertising) return -1;
+    LoopConn *c = NULL;
+    for (int i = 0; i < BLE_MAX_CLIENTS && c == NULL; i++) {
+        if (!conns[i].used) c = &conns[i];
+    }
+    if (c == NULL) return -1;
+
+    memset(c, 0, sizeof(*c));
+    c->used = true;
+    c->connected = true;
+    c->conn = nextConn++;
+    advertising = false;                // Controller berhenti advertising saat koneksi masuk
+    bleOnConnect(c->conn);
+    bleOnMtu(c->conn, mtu);
+    return c->conn;
+}
+
+void bleLoopDisconnect(uint16_t conn) {
+    LoopConn *c = findConn(conn);
+    if (c == NULL || !c->connected) return;
+    c->used = false;
+    c->connected = false;
+    bleOnDisconnect(conn);
+}
+
+void bleLoopWrite(uint16_t conn, const uint8_t *data, uint16_t len) {
+    LoopConn *c = findConn(conn);
+    if (c != NULL && c->connected) bleOnWrite(conn, data, len);
+}
+
+void bleLoopCongest(uint16_t conn, bool congested) {
+    LoopConn *c = findConn(conn);
+    if (c == NULL || !c->connected) return;
+    c->congested = congested;
+    bleOnCongestion(conn, congested);
+}
+
+void bleLoopRejectNotifies(uint16_t conn, uint16_t count) {
+    LoopConn *c = findConn(conn);
+    if (c != NULL) c->rejectNotifies = count;
+}
+
+void bleLoopSetSink(BleLoopSink callback) {
+    sink = callback;
+}
+
+bool bleLoopConnected(uint16_t conn) {
+    LoopConn *c = findConn(conn);
+    return c != NULL && c->connected;
+}
+
+bool bleLoopAdvertising() {
+    return advertising;
+}
+
+const BleLoopStats* bleLoopGetStats(uint16_t conn) {
+    LoopConn *c = findConn(conn);
+    return c != NULL ? &c->stats : NULL;
+}
+
+void bleLoopResetStats() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) memset(&conns[i].stats, 0, sizeof(conns[i].stats));
+}
+
+#endif
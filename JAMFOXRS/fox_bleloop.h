@@ -0,0 +1,52 @@
+#ifndef FOX_BLELOOP_H
+#define FOX_BLELOOP_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// LOOPBACK BACKEND - KENDALI CLIENT VIRTUAL
+// =============================================
+// Hanya ada saat BLE_BACKEND == BLE_BACKEND_LOOPBACK. Dipakai host test
+// sebagai GATT tiruan: client virtual connect dengan MTU tertentu, menulis
+// command, membuat stack congested / menolak notify, dan menerima tiap
+// notifikasi lewat sink. Event dilaporkan lewat bleOn* seperti stack asli.
+#if BLE_BACKEND == BLE_BACKEND_LOOPBACK
+
+typedef struct {
+    uint32_t notifications;
+    uint32_t bytes;
+    uint32_t jsonFrames;                // Diakhiri '\n' (reply command tidak dihitung)
+    uint32_t replies;                   // Reply command utuh ({"status"... '\n')
+    uint32_t binaryFrames;
+    uint32_t badChunks;                 // Chunk biner tanpa magic / bukan awal frame
+    uint32_t rejected;                  // Notify ditolak (bleLoopRejectNotifies / congested)
+    uint32_t connParamRequests;
+    uint16_t minInterval;               // Permintaan conn param terakhir (unit 1.25 ms)
+    uint16_t maxInterval;
+    uint16_t maxChunk;                  // Notifikasi terbesar
+    bool midJson;                       // Frame JSON belum ditutup '\n'
+    bool midReply;                      // Frame yang sedang disusun adalah reply
+} BleLoopStats;
+
+// Notifikasi yang diterima client virtual (setelah framing dicek)
+typedef void (*BleLoopSink)(uint16_t conn, const uint8_t *data, uint16_t len);
+
+// true (default): satu client virtual connect sendiri BLE_LOOPBACK_CONNECT_MS
+// setelah advertising, selama belum ada koneksi lain
+void bleLoopAutoConnect(bool on);
+// Client baru dengan MTU hasil negosiasi. -1 = tidak advertising / penuh
+int bleLoopConnect(uint16_t mtu);
+void bleLoopDisconnect(uint16_t conn);                      // Client yang memutus
+void bleLoopWrite(uint16_t conn, const uint8_t *data, uint16_t len);
+void bleLoopCongest(uint16_t conn, bool congested);         // Seperti ESP_GATTS_CONGEST_EVT
+void bleLoopRejectNotifies(uint16_t conn, uint16_t count);  // count notify berikutnya gagal
+void bleLoopSetSink(BleLoopSink sink);
+bool bleLoopConnected(uint16_t conn);
+bool bleLoopAdvertising();
+const BleLoopStats* bleLoopGetStats(uint16_t conn);         // NULL = handle tidak dikenal
+void bleLoopResetStats();
+
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+#include "fox_bletransport.h"
+
+#if BLE_BACKEND == BLE_BACKEND_NIMBLE
+
+#include "fox_ble.h"
+#include "fox_serial.h"
+#include <NimBLEDevice.h>
+#include <esp_bt.h>
+
+// =============================================
+// NIMBLE BACKEND (NimBLE-Arduino 2.x)
+// =============================================
+// Host NimBLE jauh lebih ramping dari Bluedroid (RAM, flash, waktu init).
+// Tidak ada event congestion: notify() gagal saat mbuf habis dan pump fox_ble
+// mencoba lagi. Batas koneksi CONFIG_BT_NIMBLE_MAX_CONNECTIONS (default 3)
+// sama dengan BLE_MAX_CLIENTS.
+static NimBLEServer* pServer = nullptr;
+static NimBLECharacteristic* pCharacteristic = nullptr;
+static bool advertisingWanted = false;          // Permintaan fox_ble terakhir
+static uint32_t advertisingSeenMs = 0;          // Terakhir advertising / tidak perlu advertising
+
+typedef struct {
+    uint32_t notifyFailed;              // notify() false: mbuf habis, pump mencoba lagi
+    uint32_t advertisingRestarts;       // Dihidupkan lagi oleh watchdog di poll
+} NimStats;
+
+static NimStats nimStats = {0};
+
+class NimServerCallbacks: public NimBLEServerCallbacks {
+    void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) override {
+        bleOnConnect(connInfo.getConnHandle());
+    }
+
+    void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
+        bleOnDisconnect(connInfo.getConnHandle());
+    }
+
+    void onMTUChange(uint16_t mtu, NimBLEConnInfo& connInfo) override {
+        bleOnMtu(connInfo.getConnHandle(), mtu);
+    }
+};
+
+class NimCharacteristicCallbacks: public NimBLECharacteristicCallbacks {
+    void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) override {
+        NimBLEAttValue value = pCharacteristic->getValue();
+        bleOnWrite(connInfo.getConnHandle(), value.data(), value.length());
+    }
+};
+
+// Callback statis: jangan dihapus library saat deinit
+static NimServerCallbacks serverCallbacks;
+static NimCharacteristicCallbacks characteristicCallbacks;
+
+bool bleTransportInit(const char *deviceName, uint16_t mtu) {
+    if (!NimBLEDevice::init(deviceName)) return false;
+    NimBLEDevice::setMTU(mtu);
+
+    pServer = NimBLEDevice::createServer();
+    pServer->setCallbacks(&serverCallbacks, false);
+    pServer->advertiseOnDisconnect(false);      // processBLE yang restart (batas client)
+
+    NimBLEService *pService = pServer->createService(SERVICE_UUID);
+
+    // Descriptor 2902 dibuat otomatis untuk NOTIFY
+    pCharacteristic = pService->createCharacteristic(
+        CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::READ |
+        NIMBLE_PROPERTY::NOTIFY |
+        NIMBLE_PROPERTY::WRITE
+    );
+    pCharacteristic->setCallbacks(&characteristicCallbacks);
+    pCharacteristic->setValue("JAMFOXRS BLE Ready");
+
+    pService->start();
+
+    // deinit(true) menghapus objek advertising: konfigurasi tiap init
+    NimBLEAdvertising *pAdvertising = NimBLEDevice::getAdvertising();
+    pAdvertising->setName(deviceName);
+    pAdvertising->addServiceUUID(SERVICE_UUID);
+    pAdvertising->enableScanResponse(true);
+    pAdvertising->setPreferredParams(0x06, 0x12);
+    return true;
+}
+
+void bleTransportDeinit(bool releaseMemory) {
+    // clearAll: server, service & advertising dibuat ulang di init berikutnya
+    NimBLEDevice::deinit(true);
+    pServer = nullptr;
+    pCharacteristic = nullptr;
+    advertisingWanted = false;
+    if (releaseMemory) esp_bt_controller_mem_release(ESP_BT_MODE_BTDM);
+}
+
+void bleTransportAdvertise(bool on) {
+    advertisingWanted = on;
+    advertisingSeenMs = millis();
+    if (on) NimBLEDevice::startAdvertising();
+    else NimBLEDevice::stopAdvertising();
+}
+
+bool bleTransportNotify(uint16_t conn, const uint8_t *data, uint16_t len) {
+    if (pCharacteristic == nullptr) return false;
+    if (pCharacteristic->notify(data, len, conn)) return true;
+    nimStats.notifyFailed++;
+    return false;
+}
+
+void bleTransportSetValue(const uint8_t *data, uint16_t len) {
+    if (pCharacteristic != nullptr) pCharacteristic->setValue(data, len);
+}
+
+void bleTransportDisconnect(uint16_t conn) {
+    if (pServer != nullptr) pServer->disconnect(conn);
+}
+
+void bleTransportConnParams(uint16_t conn, uint16_t minInterval, uint16_t maxInterval,
+                            uint16_t latency, uint16_t timeout) {
+    if (pServer != nullptr) pServer->updateConnParams(conn, minInterval, maxInterval, latency, timeout);
+}
+
+// Watchdog advertising: host NimBLE bisa berhenti advertising tanpa lewat
+// fox_ble (reset/sync ulang host, start gagal saat koneksi baru masuk).
+// Selama masih ada tempat client, start lagi setelah BLE_ADV_WATCHDOG_MS.
+void bleTransportPoll() {
+    if (pServer == nullptr || !advertisingWanted) return;
+    uint32_t now = millis();
+    if (NimBLEDevice::getAdvertising()->isAdvertising() ||
+        pServer->getConnectedCount() >= BLE_MAX_CLIENTS) {
+        advertisingSeenMs = now;
+        return;
+    }
+    if (now - advertisingSeenMs < BLE_ADV_WATCHDOG_MS) return;
+    advertisingSeenMs = now;
+    nimStats.advertisingRestarts++;
+    NimBLEDevice::startAdvertising();
+}
+
+const char* bleTransportName() {
+    return "NimBLE";
+}
+
+// Data dari host NimBLE sendiri (bukan state fox_ble): advertising nyata,
+// MTU & interval hasil negosiasi per peer
+void bleTransportPrintStatus() {
+    if (pServer == nullptr) {
+        serialPrintflnAlways("NimBLE: host down");
+        return;
+    }
+    uint8_t peers = pServer->getConnectedCount();
+    serialPrintflnAlways("NimBLE: %u peers, advertising %s, %lu notify failed, %lu advertising restarts",
+                         peers, NimBLEDevice::getAdvertising()->isAdvertising() ? "YES" : "NO",
+                         (unsigned long)nimStats.notifyFailed, (unsigned long)nimStats.advertisingRestarts);
+    for (uint8_t i = 0; i < peers; i++) {
+        NimBLEConnInfo info = pServer->getPeerInfo(i);
+        uint32_t intervalUs = info.getConnInterval() * 1250UL;
+        serialPrintflnAlways("  Peer %u %s: MTU %u, interval %lu.%02lu ms, latency %u",
+                             info.getConnHandle(), info.getAddress().toString().c_str(), info.getMTU(),
+                             (unsigned long)(intervalUs / 1000), (unsigned long)(intervalUs % 1000 / 10),
+                             info.getConnLatency());
+    }
+}
+
+#endif
@@ -0,0 +1,339 @@
+#include "fox_bleproto.h"
+#include <stddef.h>
+#include <stdio.h>
+
+// =============================================
+// FIELD TABLE
+// =============================================
+// Posisi slot tiap field di BleBinFields, index = bit di bitmap present
+typedef struct {
+    uint8_t offset;
+    uint8_t size;
+} BleFieldSlot;
+
+#define FIELD_SLOT(member) {offsetof(BleBinFields, member), sizeof(((BleBinFields*)0)->member)}
+
+static const BleFieldSlot FIELD_SLOTS[BLE_FIELD_COUNT] = {
+    FIELD_SLOT(rpm),
+    FIELD_SLOT(speed),
+    FIELD_SLOT(mode),
+    FIELD_SLOT(voltage),
+    FIELD_SLOT(current),
+    FIELD_SLOT(power),
+    FIELD_SLOT(soc),
+    FIELD_SLOT(temps),
+    FIELD_SLOT(canRate),
+    FIELD_SLOT(heartbeat),
+    FIELD_SLOT(cells),
+    FIELD_SLOT(cellDelta),
+    FIELD_SLOT(health),
+    FIELD_SLOT(cellStats),
+    FIELD_SLOT(tempStats),
+    FIELD_SLOT(balance),
+    FIELD_SLOT(charger),
+};
+
+static_assert(sizeof(BleBinHeader) == 10, "BleBinHeader harus packed");
+static_assert(BLE_BIN_MAX_FRAME <= 240, "Frame full harus muat satu notifikasi");
+
+uint16_t bleBinFieldSize(uint8_t field) {
+    return field < BLE_FIELD_COUNT ? FIELD_SLOTS[field].size : 0;
+}
+
+uint16_t bleBinFrameSize(uint32_t present) {
+    uint16_t size = sizeof(BleBinHeader);
+    for (uint8_t f = 0; f < BLE_FIELD_COUNT; f++) {
+        if (present & BLE_FIELD_BIT(f)) size += FIELD_SLOTS[f].size;
+    }
+    return size;
+}
+
+// =============================================
+// FIELD GROUPS
+// =============================================
+const char* const BLE_GROUP_NAMES[BLE_GROUP_COUNT] = {"motion", "pack", "cells", "temps", "charger"};
+
+static const uint32_t GROUP_FIELDS[BLE_GROUP_COUNT] = {
+    BLE_FIELD_BIT(BLE_FIELD_RPM) | BLE_FIELD_BIT(BLE_FIELD_SPEED) | BLE_FIELD_BIT(BLE_FIELD_MODE),
+    BLE_FIELD_BIT(BLE_FIELD_VOLTAGE) | BLE_FIELD_BIT(BLE_FIELD_CURRENT) | BLE_FIELD_BIT(BLE_FIELD_POWER) |
+        BLE_FIELD_BIT(BLE_FIELD_SOC) | BLE_FIELD_BIT(BLE_FIELD_HEALTH),
+    BLE_FIELD_BIT(BLE_FIELD_CELLS) | BLE_FIELD_BIT(BLE_FIELD_CELL_DELTA) | BLE_FIELD_BIT(BLE_FIELD_CELL_STATS) |
+        BLE_FIELD_BIT(BLE_FIELD_BALANCE),
+    BLE_FIELD_BIT(BLE_FIELD_TEMPS) | BLE_FIELD_BIT(BLE_FIELD_TEMP_STATS),
+    BLE_FIELD_BIT(BLE_FIELD_CHARGER),
+};
+
+#define META_FIELDS (BLE_FIELD_BIT(BLE_FIELD_CAN_RATE) | BLE_FIELD_BIT(BLE_FIELD_HEARTBEAT))
+
+uint32_t bleGroupFieldMask(uint8_t groups) {
+    uint32_t mask = META_FIELDS;
+    for (uint8_t g = 0; g < BLE_GROUP_COUNT; g++) {
+        if (groups & BLE_GROUP_BIT(g)) mask |= GROUP_FIELDS[g];
+    }
+    return mask;
+}
+
+// =============================================
+// DELTA
+// =============================================
+uint32_t bleBinDiff(const BleBinFields &a, const BleBinFields &b, uint32_t mask) {
+    const uint8_t *pa = (const uint8_t*)&a;
+    const uint8_t *pb = (const uint8_t*)&b;
+    uint32_t changed = 0;
+    for (uint8_t f = 0; f < BLE_FIELD_COUNT; f++) {
+        if (!(mask & BLE_FIELD_BIT(f))) continue;
+        const BleFieldSlot &slot = FIELD_SLOTS[f];
+        if (memcmp(pa + slot.offset, pb + slot.offset, slot.size) != 0) changed |= BLE_FIELD_BIT(f);
+    }
+    return changed;
+}
+
+void bleBinMerge(BleBinFields &dst, const BleBinFields &src, uint32_t mask) {
+    uint8_t *pd = (uint8_t*)&dst;
+    const uint8_t *ps = (const uint8_t*)&src;
+    for (uint8_t f = 0; f < BLE_FIELD_COUNT; f++) {
+        if (!(mask & BLE_FIELD_BIT(f))) continue;
+        const BleFieldSlot &slot = FIELD_SLOTS[f];
+        memcpy(pd + slot.offset, ps + slot.offset, slot.size);
+    }
+}
+
+// =============================================
+// ENCODE / DECODE
+// =============================================
+uint16_t bleBinEncode(const BleBinFields &fields, uint32_t present, uint8_t type,
+                      uint16_t seq, uint8_t *out, uint16_t cap, uint8_t flags) {
+    if (cap < sizeof(BleBinHeader)) return 0;
+
+    BleBinHeader header;
+    header.magic = BLE_BIN_MAGIC;
+    header.version = BLE_BIN_VERSION;
+    header.type = type;
+    header.flags = flags;
+    header.seq = seq;
+    header.present = present & BLE_BIN_FULL_MASK;
+    memcpy(out, &header, sizeof(header));
+
+    const uint8_t *src = (const uint8_t*)&fields;
+    uint16_t pos = sizeof(header);
+    for (uint8_t f = 0; f < BLE_FIELD_COUNT; f++) {
+        if (!(header.present & BLE_FIELD_BIT(f))) continue;
+        const BleFieldSlot &slot = FIELD_SLOTS[f];
+        if (pos + slot.size > cap) return 0;
+        memcpy(out + pos, src + slot.offset, slot.size);
+        pos += slot.size;
+    }
+    return pos;
+}
+
+bool bleBinDecode(const uint8_t *in, uint16_t len, BleBinHeader &header, BleBinFields &fields) {
+    if (len < sizeof(BleBinHeader)) return false;
+    memcpy(&header, in, sizeof(header));
+    if (header.magic != BLE_BIN_MAGIC || header.version != BLE_BIN_VERSION) return false;
+    if (header.present & ~BLE_BIN_FULL_MASK) return false;   // Field dari versi lebih baru
+
+    uint8_t *dst = (uint8_t*)&fields;
+    uint16_t pos = sizeof(header);
+    for (uint8_t f = 0; f < BLE_FIELD_COUNT; f++) {
+        if (!(header.present & BLE_FIELD_BIT(f))) continue;
+        const BleFieldSlot &slot = FIELD_SLOTS[f];
+        if (pos + slot.size > len) return false;
+        memcpy(dst + slot.offset, in + pos, slot.size);
+        pos += slot.size;
+    }
+    return pos == len;
+}
+
+// =============================================
+// STREAMING JSON
+// =============================================
+typedef enum {
+    JSON_HEAD = 0,              // "{" + motion
+    JSON_VALUES,
+    JSON_TEMPS,
+    JSON_FAST_TAIL,             // Frame fast selesai di sini
+    JSON_CELLS_OPEN,
+    JSON_CELL,
+    JSON_CELLS_TAIL,
+    JSON_CAN_RATE,
+    JSON_HEALTH,
+    JSON_CELL_STATS,
+    JSON_TEMP_STATS,
+    JSON_BALANCE_OPEN,
+    JSON_BALANCE_CELL,
+    JSON_BALANCE_TAIL,
+    JSON_CHARGER,
+    JSON_FULL_TAIL,
+    JSON_DONE
+} JsonStep;
+
+// Langkah ikut serta di frame ini? Frame full = semua grup, jadi urutan
+// dan isinya tetap sama dengan format lama
+static bool jsonStepEnabled(const BleJsonStream &js, uint8_t step) {
+    switch (step) {
+        case JSON_VALUES:
+        case JSON_HEALTH:
+            return js.groups & BLE_GROUP_BIT(BLE_GROUP_PACK);
+        case JSON_TEMPS:
+        case JSON_TEMP_STATS:
+            return js.groups & BLE_GROUP_BIT(BLE_GROUP_TEMPS);
+        case JSON_CELLS_OPEN:
+        case JSON_CELL:
+        case JSON_CELLS_TAIL:
+        case JSON_CELL_STATS:
+        case JSON_BALANCE_OPEN:
+        case JSON_BALANCE_CELL:
+        case JSON_BALANCE_TAIL:
+            return js.groups & BLE_GROUP_BIT(BLE_GROUP_CELLS);
+        case JSON_CHARGER:
+            return js.groups & BLE_GROUP_BIT(BLE_GROUP_CHARGER);
+        case JSON_FAST_TAIL:
+            return js.kind == BLE_JSON_FAST;
+        case JSON_CAN_RATE:
+        case JSON_FULL_TAIL:
+            return js.kind != BLE_JSON_FAST;
+        default:
+            return true;
+    }
+}
+
+static uint8_t nextJsonStep(const BleJsonStream &js, uint8_t step) {
+    do {
+        step++;
+    } while (step < JSON_DONE && !jsonStepEnabled(js, step));
+    return step;
+}
+
+static void beginStream(BleJsonStream &stream, uint8_t kind, uint8_t groups) {
+    stream.kind = kind;
+    stream.groups = groups;
+    stream.step = JSON_HEAD;
+    stream.index = 0;
+    stream.scratchLen = 0;
+    stream.scratchPos = 0;
+    stream.emitted = 0;
+}
+
+void bleJsonBegin(BleJsonStream &stream, bool full) {
+    if (full) {
+        beginStream(stream, BLE_JSON_FULL, BLE_GROUP_ALL);
+    } else {
+        beginStream(stream, BLE_JSON_FAST, BLE_GROUP_BIT(BLE_GROUP_MOTION) | BLE_GROUP_BIT(BLE_GROUP_PACK) |
+                                           BLE_GROUP_BIT(BLE_GROUP_TEMPS));
+    }
+}
+
+void bleJsonBeginGroups(BleJsonStream &stream, uint8_t groups) {
+    beginStream(stream, BLE_JSON_GROUPS, groups & BLE_GROUP_ALL);
+}
+
+bool bleJsonDone(const BleJsonStream &stream) {
+    return stream.step == JSON_DONE && stream.scratchPos >= stream.scratchLen;
+}
+
+// Format satu potongan ke scratch lalu maju ke langkah berikutnya.
+// Untuk fast/full urutan dan format string identik dengan snprintf besar versi lama
+static void formatNextPiece(BleJsonStream &js) {
+    const BleJsonSnapshot &v = js.snap;
+    char *buf = js.scratch;
+    const size_t cap = sizeof(js.scratch);
+    int len = 0;
+    bool repeat = false;        // Array sel: tetap di langkah ini sampai sel terakhir
+
+    switch (js.step) {
+        case JSON_HEAD:
+            if (js.groups & BLE_GROUP_BIT(BLE_GROUP_MOTION)) {
+                len = snprintf(buf, cap, "{\"r\":%d,\"s\":%d,\"m\":\"%s\",", v.rpm, v.speed, v.mode);
+            } else {
+                len = snprintf(buf, cap, "{");
+            }
+            break;
+        case JSON_VALUES:
+            len = snprintf(buf, cap, "\"v\":%.1f,\"a\":%.1f,\"p\":%.0f,\"sc\":%d,",
+                           v.voltage, v.current, v.voltage * v.current, v.soc);
+            break;
+        case JSON_TEMPS:
+            len = snprintf(buf, cap, "\"t\":{\"c\":%d,\"m\":%d,\"b\":%d},",
+                           v.tempCtrl, v.tempMotor, v.tempBatt);
+            break;
+        case JSON_FAST_TAIL:
+            len = snprintf(buf, cap, "\"cr\":%lu,\"hb\":%lu,\"type\":\"fast\"}\n",
+                           (unsigned long)v.canRate, v.heartbeat);
+            js.step = JSON_DONE;
+            break;
+        case JSON_CELLS_OPEN:
+            len = snprintf(buf, cap, "\"cells\":[");
+            js.index = 0;
+            break;
+        case JSON_CELL:
+            len = snprintf(buf, cap, "%u%s", v.cells[js.index], (js.index < MAX_CELLS - 1) ? "," : "");
+            repeat = ++js.index < MAX_CELLS;
+            break;
+        case JSON_CELLS_TAIL:
+            len = snprintf(buf, cap, "],\"cd\":%d,", v.cellDelta);
+            break;
+        case JSON_CAN_RATE:
+            len = snprintf(buf, cap, "\"cr\":%lu,", (unsigned long)v.canRate);
+            break;
+        case JSON_HEALTH:
+            len = snprintf(buf, cap, "\"h\":{\"soh\":%d,\"cyc\":%u,\"rc\":%.1f,\"fc\":%.1f},",
+                           v.soh, v.cycles, v.remainCap, v.fullCap);
+            break;
+        case JSON_CELL_STATS:
+            len = snprintf(buf, cap, "\"cvs\":{\"hi\":%u,\"hiC\":%u,\"lo\":%u,\"loC\":%u,\"av\":%u},",
+                           v.cellHi, v.cellHiNum, v.cellLo, v.cellLoNum, v.cellAvg);
+            break;
+        case JSON_TEMP_STATS:
+            len = snprintf(buf, cap, "\"ts\":{\"max\":%u,\"maxC\":%u,\"min\":%u,\"minC\":%u},",
+                           v.tempMax, v.tempMaxCell, v.tempMin, v.tempMinCell);
+            break;
+        case JSON_BALANCE_OPEN:
+            len = snprintf(buf, cap, "\"b\":{\"md\":%u,\"st\":%u,\"cells\":[", v.balanceMode, v.balanceStatus);
+            js.index = 0;
+            break;
+        case JSON_BALANCE_CELL: {
+            bool isBalancing = (v.balanceBits[js.index / 8] & (1 << (js.index % 8))) != 0;
+            len = snprintf(buf, cap, "%d%s", isBalancing ? 1 : 0, (js.index < MAX_CELLS - 1) ? "," : "");
+            repeat = ++js.index < MAX_CELLS;
+            break;
+        }
+        case JSON_BALANCE_TAIL:
+            len = snprintf(buf, cap, "]},");
+            break;
+        case JSON_CHARGER:
+            len = snprintf(buf, cap, "\"chr\":{\"v\":%.1f,\"a\":%.1f},", v.chargerVoltage, v.chargerCurrent);
+            break;
+        case JSON_FULL_TAIL:
+            len = snprintf(buf, cap, "\"hb\":%lu,\"type\":\"%s\"}\n", v.heartbeat,
+                           js.kind == BLE_JSON_FULL ? "full" : "sub");
+            js.step = JSON_DONE;
+            break;
+        default:
+            js.step = JSON_DONE;
+            break;
+    }
+    if (js.step != JSON_DONE && !repeat) js.step = nextJsonStep(js, js.step);
+
+    if (len < 0) len = 0;
+    if (len >= (int)cap) len = cap - 1;
+    js.scratchLen = (uint8_t)len;
+    js.scratchPos = 0;
+}
+
+uint16_t bleJsonRead(BleJsonStream &stream, uint8_t *out, uint16_t cap) {
+    uint16_t written = 0;
+    while (written < cap) {
+        if (stream.scratchPos >= stream.scratchLen) {
+            if (stream.step == JSON_DONE) break;
+            formatNextPiece(stream);
+            continue;
+        }
+        uint16_t n = stream.scratchLen - stream.scratchPos;
+        if (n > cap - written) n = cap - written;
+        memcpy(out + written, stream.scratch + stream.scratchPos, n);
+        stream.scratchPos += n;
+        written += n;
+    }
+    stream.emitted += written;
+    return written;
+}
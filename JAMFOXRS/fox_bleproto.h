@@ -0,0 +1,231 @@
+#ifndef FOX_BLEPROTO_H
+#define FOX_BLEPROTO_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+#include "fox_vehicle.h"
+
+// =============================================
+// BINARY BLE TELEMETRY FRAME (OPT-IN)
+// =============================================
+// Alternatif stream JSON. Client memilih lewat {"cmd":"set_proto","fmt":"bin"}.
+// Satu frame = header + field yang bit-nya set di bitmap `present`, urut
+// dari bit 0 ke atas. Semua integer little-endian (native ESP32), nilai
+// mentah dalam satuan deci (0.1 V, 0.1 A, 0.1 Ah) tanpa float. Frame full
+// ~110 byte, muat dalam satu notifikasi setelah MTU dinegosiasi.
+
+#define BLE_BIN_MAGIC 0xFB
+#define BLE_BIN_VERSION 1
+
+typedef enum {
+    BLE_BIN_FAST = 0,
+    BLE_BIN_FULL = 1,
+    BLE_BIN_DELTA = 2,          // Hanya field yang berubah sejak frame sebelumnya
+    BLE_BIN_GROUPS = 3          // Field grup langganan yang jatuh tempo (subscribe)
+} BleBinType;
+
+// Flag header
+#define BLE_BIN_FLAG_KEYFRAME 0x01      // Semua field ada, client boleh reset state
+
+// Mode delta: client menyimpan state terakhir dan menimpa field yang ada di
+// frame. Frame delta hanya sah jika seq = seq sebelumnya + 1; kalau loncat,
+// client minta keyframe dengan {"cmd":"keyframe"}.
+
+typedef struct __attribute__((packed)) {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t type;               // BleBinType
+    uint8_t flags;              // BLE_BIN_FLAG_*
+    uint16_t seq;               // Naik tiap frame biner
+    uint32_t present;           // Bitmap BLE_FIELD_*
+} BleBinHeader;
+
+// Bit field di bitmap present (urutan = urutan di payload)
+typedef enum {
+    BLE_FIELD_RPM = 0,
+    BLE_FIELD_SPEED,
+    BLE_FIELD_MODE,
+    BLE_FIELD_VOLTAGE,
+    BLE_FIELD_CURRENT,
+    BLE_FIELD_POWER,
+    BLE_FIELD_SOC,
+    BLE_FIELD_TEMPS,
+    BLE_FIELD_CAN_RATE,
+    BLE_FIELD_HEARTBEAT,
+    BLE_FIELD_CELLS,
+    BLE_FIELD_CELL_DELTA,
+    BLE_FIELD_HEALTH,
+    BLE_FIELD_CELL_STATS,
+    BLE_FIELD_TEMP_STATS,
+    BLE_FIELD_BALANCE,
+    BLE_FIELD_CHARGER,
+    BLE_FIELD_COUNT
+} BleField;
+
+#define BLE_FIELD_BIT(f) (1UL << (f))
+
+// Isi setara frame JSON "fast" dan "full"
+#define BLE_BIN_FAST_MASK (BLE_FIELD_BIT(BLE_FIELD_RPM) | BLE_FIELD_BIT(BLE_FIELD_SPEED) | \
+                           BLE_FIELD_BIT(BLE_FIELD_MODE) | BLE_FIELD_BIT(BLE_FIELD_VOLTAGE) | \
+                           BLE_FIELD_BIT(BLE_FIELD_CURRENT) | BLE_FIELD_BIT(BLE_FIELD_POWER) | \
+                           BLE_FIELD_BIT(BLE_FIELD_SOC) | BLE_FIELD_BIT(BLE_FIELD_TEMPS) | \
+                           BLE_FIELD_BIT(BLE_FIELD_CAN_RATE) | BLE_FIELD_BIT(BLE_FIELD_HEARTBEAT))
+#define BLE_BIN_FULL_MASK (BLE_FIELD_BIT(BLE_FIELD_COUNT) - 1)
+
+// =============================================
+// FIELD GROUPS (SUBSCRIBE)
+// =============================================
+// Client berlangganan per grup dengan interval sendiri lewat
+// {"cmd":"subscribe","motion":100,"pack":500,...}. Tiap frame langganan
+// berisi grup yang jatuh tempo + meta (canRate, heartbeat).
+typedef enum {
+    BLE_GROUP_MOTION = 0,       // rpm, speed, mode
+    BLE_GROUP_PACK,             // voltage, current, power, soc, health
+    BLE_GROUP_CELLS,            // cells, cellDelta, cellStats, balance
+    BLE_GROUP_TEMPS,            // temps, tempStats
+    BLE_GROUP_CHARGER,          // charger
+    BLE_GROUP_COUNT
+} BleGroup;
+
+#define BLE_GROUP_BIT(g) (1U << (g))
+#define BLE_GROUP_ALL (BLE_GROUP_BIT(BLE_GROUP_COUNT) - 1)
+
+extern const char* const BLE_GROUP_NAMES[BLE_GROUP_COUNT];
+
+// Bitmap field untuk gabungan grup (termasuk meta)
+uint32_t bleGroupFieldMask(uint8_t groups);
+
+// Nilai semua field dalam format kabel. Encoder menyalin slot field yang
+// diminta apa adanya, decoder mengisi slot yang ada di bitmap
+typedef struct __attribute__((packed)) {
+    int16_t rpm;
+    int16_t speed;              // km/h
+    uint8_t mode;               // VehicleMode
+    uint16_t voltage;           // 0.1 V
+    int16_t current;            // 0.1 A, positif = charge
+    int16_t power;              // W (clamp int16)
+    uint8_t soc;
+    int8_t temps[3];            // Controller, motor, baterai (°C)
+    uint16_t canRate;           // Pesan CAN per detik
+    uint32_t heartbeat;
+    uint16_t cells[MAX_CELLS];  // mV
+    uint16_t cellDelta;         // mV
+    struct __attribute__((packed)) {
+        uint8_t soh;
+        uint16_t cycles;
+        uint16_t remainCap;     // 0.1 Ah
+        uint16_t fullCap;       // 0.1 Ah
+    } health;
+    struct __attribute__((packed)) {
+        uint16_t hi;
+        uint8_t hiCell;
+        uint16_t lo;
+        uint8_t loCell;
+        uint16_t avg;
+    } cellStats;
+    struct __attribute__((packed)) {
+        uint8_t max;
+        uint8_t maxCell;
+        uint8_t min;
+        uint8_t minCell;
+    } tempStats;
+    struct __attribute__((packed)) {
+        uint8_t mode;
+        uint8_t status;
+        uint32_t mask;          // Bit i = sel i sedang balancing
+    } balance;
+    struct __attribute__((packed)) {
+        uint16_t voltage;       // 0.1 V
+        uint16_t current;       // 0.1 A
+    } charger;
+} BleBinFields;
+
+#define BLE_BIN_MAX_FRAME (sizeof(BleBinHeader) + sizeof(BleBinFields))
+
+// Encode field di `present` ke out. Return panjang frame, 0 jika cap kurang
+uint16_t bleBinEncode(const BleBinFields &fields, uint32_t present, uint8_t type,
+                      uint16_t seq, uint8_t *out, uint16_t cap, uint8_t flags = 0);
+
+// Decode frame. Field yang tidak ada di bitmap tidak disentuh
+bool bleBinDecode(const uint8_t *in, uint16_t len, BleBinHeader &header, BleBinFields &fields);
+
+uint16_t bleBinFieldSize(uint8_t field);
+uint16_t bleBinFrameSize(uint32_t present);
+
+// Delta: bitmap field (dalam mask) yang berbeda antara a dan b
+uint32_t bleBinDiff(const BleBinFields &a, const BleBinFields &b, uint32_t mask);
+// Salin field di mask dari src ke dst (update state terakhir terkirim)
+void bleBinMerge(BleBinFields &dst, const BleBinFields &src, uint32_t mask);
+
+// =============================================
+// STREAMING JSON SERIALIZER
+// =============================================
+// Menghasilkan JSON "fast"/"full" yang sama persis dengan format snprintf
+// lama, tapi langsung ke chunk notifikasi sesuai permintaan pump. Yang
+// disimpan hanya snapshot nilai (diambil sekali di awal frame supaya
+// konsisten) dan cursor langkah; satu potongan kecil diformat ke scratch
+// lalu disalin sebanyak muat, sisanya dilanjut di chunk berikutnya.
+
+#define BLE_JSON_SCRATCH 96             // Potongan terpanjang (statistik sel) ~62 byte
+
+typedef struct {
+    int rpm;
+    int speed;
+    const char *mode;
+    float voltage;
+    float current;
+    int soc;
+    int tempCtrl;
+    int tempMotor;
+    int tempBatt;
+    uint32_t canRate;
+    unsigned long heartbeat;
+    uint16_t cells[MAX_CELLS];
+    int cellDelta;
+    int soh;
+    uint16_t cycles;
+    float remainCap;
+    float fullCap;
+    uint16_t cellHi;
+    uint8_t cellHiNum;
+    uint16_t cellLo;
+    uint8_t cellLoNum;
+    uint16_t cellAvg;
+    uint8_t tempMax;
+    uint8_t tempMaxCell;
+    uint8_t tempMin;
+    uint8_t tempMinCell;
+    uint8_t balanceMode;
+    uint8_t balanceStatus;
+    uint8_t balanceBits[4];
+    float chargerVoltage;
+    float chargerCurrent;
+} BleJsonSnapshot;
+
+typedef enum {
+    BLE_JSON_FAST = 0,          // "type":"fast"
+    BLE_JSON_FULL,              // "type":"full"
+    BLE_JSON_GROUPS             // "type":"sub", hanya grup di `groups`
+} BleJsonKind;
+
+typedef struct {
+    BleJsonSnapshot snap;
+    uint8_t kind;               // BleJsonKind
+    uint8_t groups;             // BLE_GROUP_BIT yang diserialisasi
+    uint8_t step;
+    uint8_t index;              // Sel ke-i untuk langkah array
+    uint8_t scratchLen;
+    uint8_t scratchPos;
+    uint16_t emitted;           // Byte frame ini yang sudah keluar
+    char scratch[BLE_JSON_SCRATCH];
+} BleJsonStream;
+
+// snap sudah diisi pemanggil. Langkah grup yang tidak diminta dilewati,
+// tidak pernah diformat
+void bleJsonBegin(BleJsonStream &stream, bool full);
+void bleJsonBeginGroups(BleJsonStream &stream, uint8_t groups);
+// Isi out sampai cap byte. Return jumlah byte, 0 jika frame selesai
+uint16_t bleJsonRead(BleJsonStream &stream, uint8_t *out, uint16_t cap);
+bool bleJsonDone(const BleJsonStream &stream);
+
+#endif
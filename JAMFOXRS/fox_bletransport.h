@@ -0,0 +1,43 @@
+#ifndef FOX_BLETRANSPORT_H
+#define FOX_BLETRANSPORT_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// BLE TRANSPORT (BACKEND STACK)
+// =============================================
+// Lapisan tipis antara logika stream/command (fox_ble) dan stack BLE.
+// Tepat satu backend dikompilasi, dipilih lewat BLE_BACKEND di fox_config.h:
+//   fox_blenimble.cpp  - NimBLE-Arduino (default, host BLE saja)
+//   fox_bledroid.cpp   - Bluedroid bawaan core ESP32 (BLEDevice)
+//   fox_bleloop.cpp    - Tanpa radio: satu client virtual, uji pipeline
+// Ukuran image & heap tiap backend: ukur di board (README, baris Footprint:)
+// Satu service + satu characteristic (READ | WRITE | NOTIFY), UUID di fox_ble.h.
+// conn = handle koneksi milik backend, hanya dipakai sebagai kunci.
+
+// Stack + GATT (cold start). false = gagal init
+bool bleTransportInit(const char *deviceName, uint16_t mtu);
+// Matikan stack. releaseMemory: memori controller dilepas permanen
+void bleTransportDeinit(bool releaseMemory);
+void bleTransportAdvertise(bool on);
+// Notifikasi ke satu koneksi. false = antrian stack penuh, coba lagi nanti
+bool bleTransportNotify(uint16_t conn, const uint8_t *data, uint16_t len);
+// Nilai characteristic untuk READ (reply command terakhir)
+void bleTransportSetValue(const uint8_t *data, uint16_t len);
+void bleTransportDisconnect(uint16_t conn);
+// Interval unit 1.25 ms, timeout unit 10 ms
+void bleTransportConnParams(uint16_t conn, uint16_t minInterval, uint16_t maxInterval,
+                            uint16_t latency, uint16_t timeout);
+void bleTransportPoll();                // Dari processBLE(): watchdog advertising / event virtual
+const char* bleTransportName();
+void bleTransportPrintStatus();         // Baris BLE status dari sisi stack (peer, advertising nyata)
+
+// Event dari backend (konteks task stack BLE), diimplementasi di fox_ble.cpp
+void bleOnConnect(uint16_t conn);
+void bleOnDisconnect(uint16_t conn);
+void bleOnMtu(uint16_t conn, uint16_t mtu);
+void bleOnCongestion(uint16_t conn, bool congested);   // Hanya Bluedroid yang melapor
+void bleOnWrite(uint16_t conn, const uint8_t *data, uint16_t len);
+
+#endif
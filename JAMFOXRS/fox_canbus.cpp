@@ -2,6 +2,8 @@
 #include "fox_config.h"
 #include "fox_vehicle.h"
 #include "fox_serial.h"
+#include "fox_history.h"
+#include "fox_ble.h"
 #include <Arduino.h>
 #include <Wire.h>
 
@@ -272,6 +274,10 @@ void parseCANMessage(twai_message_t &message) {
         vehicle.chargingCurrent = (current > 1.0f);
         vehicle.lastMessageTime = receivedTime;
         
+        // Riwayat sparkline (decimation di dalam)
+        historyAddSample(voltage, current);
+        bleNotifyNewData();
+        
         return;
     }
     
@@ -325,11 +331,9 @@ void parseCANMessage(twai_message_t &message) {
         vehicle.balanceBits[2] = message.data[4];
         vehicle.balanceBits[3] = message.data[5];
         
-        char buff[20];
-        snprintf(buff, sizeof(buff), "%02X %02X %02X %02X %02X %02X",
+        snprintf(vehicle.rawBalanceHex, sizeof(vehicle.rawBalanceHex), "%02X %02X %02X %02X %02X %02X",
                  message.data[0], message.data[1], message.data[2], 
                  message.data[3], message.data[4], message.data[5]);
-        vehicle.rawBalanceHex = String(buff);
         vehicle.lastMessageTime = receivedTime;
         return;
     }
@@ -86,10 +86,12 @@
 #define PAGE_2_ENABLE true    // Temperature  
 #define PAGE_3_ENABLE true    // BMS Data
 #define PAGE_4_ENABLE true    // Power Display
+#define PAGE_5_ENABLE true    // Sparkline riwayat daya/arus
+#define PAGE_COUNT 5
 
-// Define page order (1-4 in desired order)
-const uint8_t PAGE_ORDER[] = {1, 2, 3, 4};  // Default: normal order
-const uint8_t PAGE_ORDER_COUNT = 4;         // Number of pages in order array
+// Define page order (1-5 in desired order)
+const uint8_t PAGE_ORDER[] = {1, 2, 3, 4, 5};  // Default: normal order
+const uint8_t PAGE_ORDER_COUNT = 5;            // Number of pages in order array
 
 // =============================================
 // CHARGING MODE CONFIGURATION
@@ -165,6 +167,10 @@ static const char* MONTH_NAMES[] = {
 // RTC CONFIGURATION
 // =============================================
 #define RTC_I2C_ADDRESS 0x68
+#define RTC_CACHE_ENABLED true                  // Jam software dari esp_timer, baca DS3231 hanya saat resync
+#define RTC_RESYNC_INTERVAL_MS 60000            // Baca ulang DS3231 tiap menit (tanpa SQW)
+#define RTC_SQW_PIN -1                          // GPIO ke pin SQW DS3231 (1 Hz), -1 = tidak dipakai
+#define RTC_SQW_RESYNC_INTERVAL_MS 3600000      // Dengan SQW cukup resync tiap jam
 
 // =============================================
 // DISPLAY TEXT CONFIGURATION
@@ -220,6 +226,13 @@ static const char* MONTH_NAMES[] = {
 #define MAX_DISPLAY_POWER 9999
 #define MIN_DISPLAY_POWER -9999
 
+// Sparkline (page 5): satu kolom per sampel, layar penuh = SPARK_WINDOW_MS
+#define SPARK_SOURCE_POWER true                 // true: daya (W), false: arus (0.1 A)
+#define SPARK_WINDOW_MS 120000                  // ~2 menit terakhir
+#define SPARK_SAMPLE_INTERVAL_MS (SPARK_WINDOW_MS / SCREEN_WIDTH)
+#define SPARK_SCALE_MAX 2000                    // Atas layar (charge/regen), satuan ikut sumber
+#define SPARK_SCALE_MIN -6000                   // Bawah layar (discharge)
+
 // =============================================
 // DISPLAY POSITION CONFIGURATION
 // =============================================
@@ -262,6 +275,11 @@ static const char* MONTH_NAMES[] = {
 #define BMS_VALUE_VOLTAGE_POS_Y 16
 #define BMS_VALUE_CURRENT_POS_X 78
 #define BMS_VALUE_CURRENT_POS_Y 16
+#define BMS_UNIT_GAP_X 6                 // Unit "V" setelah angka
+#define BMS_UNIT_OFFSET_Y 6              // Unit & tanda minus sejajar bawah angka size 2
+#define BMS_UNIT_MAX_X 118               // Unit "A" tidak melewati tepi kanan
+#define BMS_STALE_POS_X 120              // Penanda "x" saat data CAN basi
+#define BMS_STALE_POS_Y 0
 
 // Page 4: Power Display Positions
 #define POWER_LABEL_POS_X 0
@@ -270,6 +288,13 @@ static const char* MONTH_NAMES[] = {
 #define POWER_VALUE_POS_Y 4      
 #define POWER_UNIT_POS_X 110     
 #define POWER_UNIT_POS_Y 28     
+#define POWER_SIGN_POS_X 10              // Tanda +/- (size 2)
+#define POWER_SIGN_POS_Y 4
+#define POWER_NUMBER_POS_Y 2             // X angka mengikuti jumlah digit & tanda
+#define POWER_UNIT_GAP_X 4               // Unit di kanan angka (< 1000)
+#define POWER_UNIT_INLINE_POS_Y 14
+#define POWER_UNIT_BELOW_POS_Y 26        // Unit di bawah angka (>= 1000)
+#define POWER_UNIT_TEXT "watt"
 
 // =============================================
 // I2C CONFIGURATION
@@ -279,6 +304,32 @@ static const char* MONTH_NAMES[] = {
 #define I2C_MUTEX_TIMEOUT_MS 100
 #define DATA_MUTEX_TIMEOUT_MS 50
 
+// Bus manager: satu task pemilik Wire, transaksi diantrikan per prioritas/deadline
+#define EEPROM_I2C_ADDRESS 0x57                 // AT24C32 di modul DS3231
+#define I2C_CLOCK_START_HZ 400000               // Clock awal governor
+#define I2C_CLOCK_MAX_HZ 400000                 // Naikkan ke 800000/1000000 jika OLED kuat (DS3231 maks 400k)
+#define I2C_CLOCK_MIN_HZ 50000
+#define I2C_GOVERNOR_WINDOW 64                  // Transaksi per jendela evaluasi error
+#define I2C_GOVERNOR_STEP_DOWN_ERRORS 2         // Error NACK/timeout per jendela untuk turun satu level
+#define I2C_GOVERNOR_QUIET_MS 30000             // Tanpa error selama ini: naik satu level
+#define I2C_QUEUE_DEPTH 12                      // Transaksi menunggu maksimal
+#define I2C_QUEUE_AGING_MS 20                   // Tiap kelipatan ini menunggu: naik satu level prioritas (anti starvation)
+#define I2C_BUS_TASK_STACK_SIZE 3072               // Termasuk display.begin() saat recovery
+#define I2C_BUS_TASK_PRIORITY 4                 // Di atas flush & display task
+#define I2C_BUS_TASK_CORE 1
+
+// =============================================
+// PERSISTENT STORAGE (AT24C32)
+// =============================================
+#define STORAGE_ENABLED true
+#define STORAGE_BASE_ADDRESS 0x0000             // Page-aligned (kelipatan 32)
+#define STORAGE_SLOT_COUNT 64                   // 64 x 32 byte = 2 KB ring, sisa EEPROM bebas
+#define STORAGE_COMMIT_INTERVAL_MS 60000        // Batch: paling sering satu page per menit saat berubah
+#define STORAGE_MIN_COMMIT_GAP_MS 1000          // Commit segera (berhenti, trip reset) tetap dijeda
+#define STORAGE_WRITE_CYCLE_MS 10               // tWR AT24C32, EEPROM NACK selama ini
+#define STORAGE_IO_TIMEOUT_MS 50
+#define STORAGE_MAX_TICK_GAP_MS 2000            // Batas dt integrasi odometer per tick, sisanya dibawa
+
 // =============================================
 // BLE CONFIGURATION
 // =============================================
@@ -302,23 +353,77 @@ static const char* MONTH_NAMES[] = {
 #define DISPLAY_TASK_STACK_SIZE 3072           // Stack untuk display task
 #define DISPLAY_TASK_PRIORITY 2                 // Priority display task
 #define DISPLAY_TASK_CORE 1                      // Jalankan di Core 1
+#define DISPLAY_HEAP_PROBE_ENABLED true          // Hitung frame yang melakukan alokasi heap
+
+// =============================================
+// OLED DOUBLE BUFFER / FLUSH TASK
+// =============================================
+#define OLED_FLUSH_CHUNK_BYTES 256              // Data per transaksi I2C (burst), bus dilepas di antaranya
+#define OLED_FLUSH_SLOTS 2                      // Chunk yang boleh antri di bus manager sekaligus
+#define OLED_CHUNK_TIMEOUT_MS 100               // Chunk tidak selesai selama ini: dibatalkan
+#define I2C_WIRE_BUFFER_BYTES (OLED_FLUSH_CHUNK_BYTES + 8) // Wire.setBufferSize (core 2.x), default 128
+#define OLED_PRESENT_WAIT_MS 50                 // Tunggu flush sebelumnya sebelum ganti front buffer
+#define OLED_FLUSH_TASK_STACK_SIZE 2048
+#define OLED_FLUSH_TASK_PRIORITY 3              // Di atas display task, sebagian besar menunggu I2C
+
+// Pre-render page berikutnya supaya tombol langsung tampil
+#define PRERENDER_REFRESH_MS 500                // Refresh salinan off-screen saat idle
+#define PRERENDER_MAX_AGE_MS 1000               // Lebih tua dari ini: render ulang saat tombol
+#define RENDER_BENCH_ITERATIONS 8               // Render per page per mode saat DISP RENDER
+#define LATENCY_PROBE_PIN -1                    // GPIO HIGH saat tombol, LOW saat pixel terkirim (-1 = off)
+
+// Transisi page (hardware scroll lewat display start line SSD1306)
+#define TRANSITION_ENABLED true
+#define TRANSITION_STEP_ROWS 4                  // Baris per langkah (32/4 = 8 langkah)
+#define TRANSITION_FRAME_MS 33                  // ~30 FPS
 
 // =============================================
-// I2C RECOVERY CONFIGURATION - ENHANCED
+// I2C RECOVERY CONFIGURATION - STATE MACHINE
 // =============================================
-#define I2C_MAX_RETRIES 5
-#define I2C_RETRY_DELAY_BASE_MS 100             // Base delay untuk exponential backoff
-#define I2C_HARD_RESET_ENABLED true              // Reset pin SDA/SCL ke LOW dulu
-#define I2C_RECOVERY_MAX_ATTEMPTS 3               // Maksimal reset total sebelum restart
+#define I2C_RECOVERY_ERROR_THRESHOLD 3            // Error berturut-turut sebelum recovery otomatis
+#define I2C_RECOVERY_MAX_ATTEMPTS 3               // Siklus pulse+STOP+probe sebelum menyerah
+#define I2C_RECOVERY_PROBE_RETRIES 3              // Probe per siklus
+#define I2C_RECOVERY_SETTLE_MS 5                  // Tunggu setelah Wire.begin sebelum probe
+#define I2C_RECOVERY_RETRY_MS 20                  // Jeda antar probe
+#define I2C_RECOVERY_COOLDOWN_MS 1000             // Setelah gagal, abaikan request selama ini
+#define I2C_WIRE_TIMEOUT_MS 50                    // Wire.setTimeOut setelah reinit
 
 // =============================================
 // BLE LIFECYCLE CONFIGURATION - NEW
 // =============================================
 #define BLE_AUTO_OFF_MINUTES 5                    // Auto-off setelah X menit idle
 #define BLE_KEEP_ALIVE_WHEN_CONNECTED true        // BLE tetap menyala jika ada koneksi
-#define BLE_DEINIT_ON_DISABLE true                 // BLE benar-benar dideinit saat mati
+#define BLE_DEINIT_ON_DISABLE true                 // true = cold (deinit stack saat mati), false = warm (GATT tetap, hanya advertising)
+#define BLE_COLD_RELEASE_MEMORY false              // deinit(true): lepas memori controller, BLE tidak bisa aktif lagi sampai reboot
+#define BLE_CYCLE_DEFAULT 10                       // Serial BLE CYCLE tanpa angka
 #define BLE_RECONNECT_DELAY_MS 2000                // Delay sebelum restart advertising
 
+// Backend stack BLE (fox_bletransport.h)
+#define BLE_BACKEND_NIMBLE 0                       // Library NimBLE-Arduino (2.x)
+#define BLE_BACKEND_BLUEDROID 1                    // BLEDevice bawaan core ESP32
+#define BLE_BACKEND_LOOPBACK 2                     // Tanpa radio, client virtual
+#ifndef BLE_BACKEND                                // Bisa dioverride build flag -DBLE_BACKEND=1
+#define BLE_BACKEND BLE_BACKEND_NIMBLE
+#endif
+#define BLE_LOOPBACK_CONNECT_MS 1000               // Loopback: client virtual terhubung setelah advertising
+#define BLE_ADV_WATCHDOG_MS 3000                   // NimBLE/Bluedroid: advertising berhenti diam-diam selama ini -> start lagi
+
+// =============================================
+// BLE STREAMING TASK
+// =============================================
+// Jadwal fast/full + pump notifikasi di task sendiri, bukan dari loop()
+// (yang ikut tertahan delay(10) dan kerja lain). Task tidur sampai frame
+// berikutnya jatuh tempo atau dibangunkan data CAN baru.
+#define BLE_TASK_ENABLED true
+#define BLE_TASK_STACK_SIZE 4096                // notify() backend + snprintf serializer JSON
+#define BLE_TASK_PRIORITY 3                     // Di atas display task
+#define BLE_TASK_CORE 0                         // Bareng stack Bluetooth
+#define BLE_TASK_PUMP_MS 5                      // Frame belum habis (budget/congested): cek lagi
+#define BLE_TASK_IDLE_MS 100                    // Tidak terkoneksi: cek lagi
+#define BLE_EVENT_QUEUE_SIZE 6                  // Write client menunggu task stream, ~520 B/slot
+#define BLE_EVENT_POST_TIMEOUT_MS 10            // Antrian penuh: write dibuang setelah ini (connect dkk tidak pernah)
+#define BLE_JITTER_HIST_BUCKETS 6               // <0.5, <1, <2, <5, <10, >=10 ms
+
 // =============================================
 // DISPLAY COMMAND TYPES FOR QUEUE - NEW
 // =============================================
@@ -331,7 +436,9 @@ typedef enum {
     DISPLAY_CMD_CLEAR,
     DISPLAY_CMD_RESET,
     DISPLAY_CMD_TRANSITION_TO_CLOCK,
-    DISPLAY_CMD_SHOW_BLE_OFF 
+    DISPLAY_CMD_SHOW_BLE_OFF,
+    DISPLAY_CMD_SHOW_PAGE,                // Ganti page (pakai hasil pre-render jika ada)
+    DISPLAY_CMD_RENDER_BENCH              // Ukur waktu render tiap page (serial DISP RENDER)
 } DisplayCommandType;
 
 typedef struct {
@@ -339,6 +446,8 @@ typedef struct {
     int page;
     bool blinkState;
     uint32_t timestamp;
+    uint32_t eventUs;                     // micros() saat event (untuk ukur latency), 0 = tidak diukur
+    uint32_t queuedUs;                    // micros() saat masuk queue (command-to-flush latency)
 } DisplayCommand;
 
 #endif
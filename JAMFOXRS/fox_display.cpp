@@ -8,13 +8,20 @@
 #include "fox_page.h"
 #include "fox_ble.h"
 #include "fox_task.h"
-#include <Fonts/FreeSansBold18pt7b.h>
-#include <Fonts/FreeSansBold12pt7b.h>
-#include <Fonts/FreeSansBold9pt7b.h>
+#include "fox_oled.h"
+#include "fox_i2c.h"
+#include "fox_history.h"
+#include "fox_fonts.h"
+#include "fox_font_clock18.h"
+#include "fox_font_label9.h"
+#if SPLASH_FONT_SIZE == 2
+#include "fox_font_label12.h"
+#endif
 
 #ifdef ESP32
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <esp_heap_caps.h>
 #endif
 
 // =============================================
@@ -24,6 +31,16 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
 bool displayInitialized = false;
 bool displayReady = false;
 
+// Page yang isinya ada di back buffer untuk engine widget (0 = tidak valid)
+static int widgetCanvasPage = 0;
+
+// Semua gambar di luar engine widget lewat sini supaya state widget ikut dibuang
+static void clearCanvas() {
+    display.clearDisplay();
+    widgetCanvasPage = 0;
+}
+
+
 #ifdef ESP32
 extern SemaphoreHandle_t i2cMutex;
 QueueHandle_t displayQueue = NULL;
@@ -32,7 +49,6 @@ QueueHandle_t displayQueue = NULL;
 // =============================================
 // I2C SAFETY VARIABLES
 // =============================================
-static volatile bool i2cOperationInProgress = false;
 static unsigned long lastI2CFailure = 0;
 static uint32_t i2cFailureCount = 0;
 
@@ -58,6 +74,7 @@ static const float DAMPING = 0.9f;
 // =============================================
 bool appModeDisplayActive = false;
 unsigned long lastDisplayUpdateTime = 0;
+static int shownPage = 0;               // Page terakhir yang digeser masuk (arah slide)
 
 // =============================================
 // EXTERNAL VARIABLES FROM BLE
@@ -67,265 +84,313 @@ extern volatile bool deviceConnected;
 // =============================================
 // I2C RECOVERY FUNCTIONS
 // =============================================
-void recoverI2CBus() {
-    serialPrintf("[I2C-RECOVERY] Starting recovery...\n");
-    
-    #ifdef ESP32
-    if(i2cMutex != NULL) {
-        xSemaphoreGive(i2cMutex);
-    }
-    #endif
-    
-    Wire.end();
-    delay(100);
-    
-    #ifdef ESP32
-    gpio_reset_pin((gpio_num_t)SDA_PIN);
-    gpio_reset_pin((gpio_num_t)SCL_PIN);
-    delay(10);
-    #endif
-    
-    Wire.begin(SDA_PIN, SCL_PIN);
-    Wire.setClock(50000);
-    #ifdef ESP32
-    Wire.setTimeOut(1000);
-    #endif
-    
-    delay(100);
-    
-    for(int i = 0; i < 3; i++) {
-        Wire.beginTransmission(OLED_ADDRESS);
-        if(Wire.endTransmission() == 0) {
-            serialPrintf("[I2C-RECOVERY] Success\n");
-            
-            if(display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS)) {
-                displayInitialized = true;
-                displayReady = true;
-                display.clearDisplay();
-                display.display();
-                i2cFailureCount = 0;
-            }
-            break;
-        }
-        delay(50);
-    }
-    
-    #ifdef ESP32
-    if(i2cMutex != NULL) {
-        xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(100));
-    }
-    #endif
-}
-
-// =============================================
-// HARD RESET I2C - TARIK PIN KE LOW
-// =============================================
-void hardResetI2C() {
-    serialPrintflnAlways("[I2C] HARD RESET - Pulling pins LOW");
-    
-    #ifdef ESP32
-    // Pull SDA and SCL LOW to reset I2C bus
-    pinMode(SDA_PIN, OUTPUT);
-    pinMode(SCL_PIN, OUTPUT);
-    digitalWrite(SDA_PIN, LOW);
-    digitalWrite(SCL_PIN, LOW);
-    delay(10);
-    
-    // Release pins
-    pinMode(SDA_PIN, INPUT_PULLUP);
-    pinMode(SCL_PIN, INPUT_PULLUP);
-    delay(10);
-    
-    // Restart I2C
-    Wire.end();
-    delay(100);
-    Wire.begin(SDA_PIN, SCL_PIN);
-    Wire.setClock(50000);
-    
-    // Re-init display
-    if(display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS)) {
+// Dipanggil bus task setelah bus pulih (bus masih dipegang bus task)
+static void reinitDisplayAfterRecovery() {
+    // periphBegin=false: Wire sudah di-begin ulang oleh state machine
+    if(display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS, false, false)) {
+        // begin() mengosongkan back buffer: frame berikutnya harus render penuh
+        widgetCanvasPage = 0;
         displayInitialized = true;
         displayReady = true;
-        serialPrintflnAlways("[I2C] HARD RESET successful");
-    } else {
-        serialPrintflnAlways("[I2C] HARD RESET failed - display not responding");
+        oledInvalidate();
+        i2cFailureCount = 0;
     }
-    #endif
+}
+
+// Non-blocking: recovery dijalankan bertahap oleh bus task (fox_i2c)
+void recoverI2CBus() {
+    i2cRequestRecovery();
 }
 
 // =============================================
-// SAFE I2C OPERATION (ORIGINAL)
+// SAFE I2C OPERATION
 // =============================================
+// Probe OLED lewat bus manager (control byte saja). Tidak memegang bus:
+// render hanya ke back buffer, pengiriman dilakukan flush task.
+// Tidak ada retry/backoff di sini; kegagalan beruntun memicu recovery
+// di bus task dan frame berikutnya mencoba lagi.
 bool safeI2COperation(uint32_t timeoutMs) {
     if(!displayInitialized) return false;
     
-    #ifdef ESP32
-    if(i2cOperationInProgress) return false;
-    i2cOperationInProgress = true;
-    
-    if(i2cMutex != NULL) {
-        if(xSemaphoreTake(i2cMutex, 0) != pdTRUE) {
-            i2cOperationInProgress = false;
-            return false;
-        }
-    }
-    #endif
+    // Bus sedang dipulihkan: lewati frame ini tanpa menunggu
+    if(i2cRecoveryActive()) return false;
     
-    unsigned long startTime = micros();
-    uint8_t error = 5;
-    
-    while(micros() - startTime < 500) {
-        Wire.beginTransmission(OLED_ADDRESS);
-        Wire.write(0x00);
-        error = Wire.endTransmission(true);
-        
-        if(error == 0) break;
-        delayMicroseconds(10);
-    }
-    
-    bool success = (error == 0);
-    
-    #ifdef ESP32
-    if(i2cMutex != NULL) xSemaphoreGive(i2cMutex);
-    i2cOperationInProgress = false;
-    #endif
+    static const uint8_t probe[] = {0x00};
+    bool success = (i2cWrite(I2C_DEV_OLED, probe, sizeof(probe), I2C_PRIO_HIGH, timeoutMs) == I2C_STATUS_OK);
     
     if(!success) {
         lastI2CFailure = millis();
         i2cFailureCount++;
         
-        if(i2cFailureCount >= 3) recoverI2CBus();
+        if(i2cFailureCount >= I2C_RECOVERY_ERROR_THRESHOLD) {
+            i2cFailureCount = 0;
+            recoverI2CBus();
+        }
+    } else {
+        i2cFailureCount = 0;
     }
     
     return success;
 }
 
 // =============================================
-// ENHANCED I2C OPERATION WITH EXPONENTIAL BACKOFF
+// TEXT METRICS - FONT GFX
 // =============================================
-bool safeI2COperationWithBackoff(uint32_t timeoutMs) {
-    if(!displayInitialized) return false;
-    
-    #ifdef ESP32
-    if(i2cOperationInProgress) return false;
-    i2cOperationInProgress = true;
-    
-    if(i2cMutex != NULL) {
-        if(xSemaphoreTake(i2cMutex, 0) != pdTRUE) {
-            i2cOperationInProgress = false;
-            return false;
-        }
-    }
-    #endif
-    
-    bool success = false;
-    int retryCount = 0;
-    uint32_t delayMs = I2C_RETRY_DELAY_BASE_MS;
-    
-    while (retryCount < I2C_MAX_RETRIES && !success) {
-        unsigned long startTime = micros();
-        uint8_t error = 5;
-        
-        while(micros() - startTime < 500) {
-            Wire.beginTransmission(OLED_ADDRESS);
-            Wire.write(0x00);
-            error = Wire.endTransmission(true);
-            
-            if(error == 0) break;
-            delayMicroseconds(10);
-        }
-        
-        success = (error == 0);
-        
-        if (!success) {
-            retryCount++;
-            delay(delayMs);
-            delayMs *= 2; // Exponential backoff
+// Jalan glyph seperti Adafruit_GFX::getTextBounds (tanpa wrap), tapi tanpa
+// menyentuh state display sehingga aman dipanggil sebelum display siap.
+FontTextExtent fontTextExtent(const GFXfont* font, const char* text) {
+    FontTextExtent extent = {0, 0};
+    uint16_t first = pgm_read_word(&font->first);
+    uint16_t last = pgm_read_word(&font->last);
+    const GFXglyph* glyphs = (const GFXglyph*)pgm_read_ptr(&font->glyph);
+    int16_t cursor = 0;
+    int16_t minX = INT16_MAX;
+    int16_t maxX = INT16_MIN;
+
+    for (; *text; text++) {
+        uint8_t c = (uint8_t)*text;
+        if (c < first || c > last) continue;
+
+        const GFXglyph* glyph = glyphs + (c - first);
+        uint8_t width = pgm_read_byte(&glyph->width);
+        uint8_t height = pgm_read_byte(&glyph->height);
+        int8_t xOffset = (int8_t)pgm_read_byte(&glyph->xOffset);
+
+        if (width > 0 && height > 0) {
+            minX = min(minX, (int16_t)(cursor + xOffset));
+            maxX = max(maxX, (int16_t)(cursor + xOffset + width - 1));
         }
+        cursor += pgm_read_byte(&glyph->xAdvance);
     }
-    
-    #ifdef ESP32
-    if(i2cMutex != NULL) xSemaphoreGive(i2cMutex);
-    i2cOperationInProgress = false;
-    #endif
-    
-    if(!success) {
-        lastI2CFailure = millis();
-        i2cFailureCount++;
-        
-        if(i2cFailureCount >= I2C_RECOVERY_MAX_ATTEMPTS) {
-            hardResetI2C();
-            i2cFailureCount = 0;
-        }
+
+    if (maxX >= minX) {
+        extent.left = minX;
+        extent.width = maxX - minX + 1;
     }
-    
-    return success;
+    return extent;
 }
 
-void releaseI2C() {
-    #ifdef ESP32
-    if(i2cMutex != NULL) xSemaphoreGive(i2cMutex);
-    #endif
-    delayMicroseconds(50);
+int16_t centeredXFont(const GFXfont* font, const char* text) {
+    FontTextExtent extent = fontTextExtent(font, text);
+    return (SCREEN_WIDTH - (int16_t)extent.width) / 2 - extent.left;
 }
 
+// Label tetap dengan font GFX subset: posisi dihitung compiler dari metrik
+// constexpr header font. Teks baru di luar subset = error compile, bukan
+// label yang hilang di layar.
+#define APP_MODE_TEXT "APP MODE"
+#define BLE_OFF_TEXT "BLE OFF"
+#define FONT_SUBSET_HINT "glyph tidak ada di subset: buat ulang header dengan host/tools/fontconvert"
+
+static_assert(fontCovers(FreeSansBold9ptLabelsLayout, APP_MODE_TEXT), FONT_SUBSET_HINT);
+static_assert(fontCovers(FreeSansBold9ptLabelsLayout, BLE_OFF_TEXT), FONT_SUBSET_HINT);
+static_assert(fontCovers(FreeSansBold9ptLabelsLayout, SETUP_TEXT), FONT_SUBSET_HINT);
+static_assert(fontCovers(FreeSansBold18ptClockLayout, "0123456789:"), FONT_SUBSET_HINT);
+
+static constexpr int16_t appModeX = constCenteredXFont(FreeSansBold9ptLabelsLayout, APP_MODE_TEXT);
+static constexpr int16_t bleOffX = constCenteredXFont(FreeSansBold9ptLabelsLayout, BLE_OFF_TEXT);
+static constexpr int16_t setupX = constCenteredXFont(FreeSansBold9ptLabelsLayout, SETUP_TEXT);
+
+#if SPLASH_FONT_SIZE == 1
+static_assert(fontCovers(FreeSansBold9ptLabelsLayout, SPLASH_TEXT), FONT_SUBSET_HINT);
+static constexpr int16_t splashX = constCenteredXFont(FreeSansBold9ptLabelsLayout, SPLASH_TEXT);
+static const GFXfont* splashFont() { return &FreeSansBold9ptLabels; }
+#elif SPLASH_FONT_SIZE == 2
+static_assert(fontCovers(FreeSansBold12ptLabelsLayout, SPLASH_TEXT), FONT_SUBSET_HINT);
+static constexpr int16_t splashX = constCenteredXFont(FreeSansBold12ptLabelsLayout, SPLASH_TEXT);
+static const GFXfont* splashFont() { return &FreeSansBold12ptLabels; }
+#else
+static constexpr int16_t splashX = centeredXDefaultFont(SPLASH_TEXT);
+static const GFXfont* splashFont() { return NULL; }
+#endif
+
 // =============================================
-// HELPER FUNCTIONS
+// HELPER FUNCTIONS - FORMAT TANPA HEAP
 // =============================================
-int calculateWidthFont2(const String& text) {
-    int width = 0;
-    for (unsigned int i = 0; i < text.length(); i++) {
-        char c = text[i];
-        if (c == '.' || c == ',') width += 6;
-        else if (c == '+' || c == '-') width += 8;
-        else width += 12;
+static TextExtent makeExtent(uint8_t length, uint8_t textSize) {
+    TextExtent extent;
+    extent.length = length;
+    extent.width = (uint8_t)min((uint16_t)255, textWidthDefaultFont(length, textSize));
+    return extent;
+}
+
+// Tulis angka unsigned ke buffer, return jumlah karakter
+static uint8_t writeUnsigned(char* buf, size_t size, uint32_t value) {
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0 && count < sizeof(digits));
+    
+    if (count >= size) return 0;
+    for (uint8_t i = 0; i < count; i++) {
+        buf[i] = digits[count - 1 - i];
     }
-    return width;
+    buf[count] = '\0';
+    return count;
 }
 
-String removeTrailingZero(float value, int decimalPlaces) {
-    char buffer[20];
-    dtostrf(value, 0, decimalPlaces, buffer);
-    String result = String(buffer);
-    if (result.indexOf('.') != -1) {
-        while (result.endsWith("0")) result.remove(result.length() - 1);
-        if (result.endsWith(".")) result.remove(result.length() - 1);
+// Port dtostrf(value, 0, decimalPlaces) arduino-esp32 (stdlib_noniso.c) lalu
+// buang nol di belakang koma, langsung ke buffer milik pemanggil (tanpa String /
+// malloc). Pembulatannya ikut dtostrf: +0.5 digit terakhir lalu digit diambil
+// satu per satu dalam double, jadi 72.25 -> "72.3" dan 98.75 -> "98.7"
+uint8_t removeTrailingZero(char* buf, size_t size, float value, int decimalPlaces) {
+    if (buf == NULL || size < 2) return 0;
+    if (decimalPlaces < 0) decimalPlaces = 0;
+    if (decimalPlaces > 3) decimalPlaces = 3;
+    
+    if (isnan(value) || isinf(value)) {
+        if (size < 4) {
+            buf[0] = '\0';
+            return 0;
+        }
+        strcpy(buf, isnan(value) ? "nan" : "inf");
+        return 3;
+    }
+    
+    double number = value;
+    size_t pos = 0;
+    if (number < 0.0) {
+        buf[pos++] = '-';
+        number = -number;
+    }
+    
+    double rounding = 2.0;
+    for (int i = 0; i < decimalPlaces; i++) rounding *= 10.0;
+    number += 1.0 / rounding;
+    
+    double tenpow = 1.0;
+    int digitCount = 1;
+    while (number >= 10.0 * tenpow) {
+        tenpow *= 10.0;
+        digitCount++;
+    }
+    number /= tenpow;
+    
+    // Digit + titik + '\0' harus muat
+    if (pos + digitCount + (decimalPlaces > 0 ? decimalPlaces + 1 : 0) >= size) {
+        buf[0] = '\0';
+        return 0;
+    }
+    
+    digitCount += decimalPlaces;
+    while (digitCount-- > 0) {
+        int8_t digit = (int8_t)number;
+        if (digit > 9) digit = 9;
+        buf[pos++] = (char)('0' | digit);
+        if (digitCount == decimalPlaces && decimalPlaces > 0) buf[pos++] = '.';
+        number -= digit;
+        number *= 10.0;
+    }
+    
+    // Buang nol di belakang koma
+    if (decimalPlaces > 0) {
+        while (buf[pos - 1] == '0') pos--;
+        if (buf[pos - 1] == '.') pos--;
     }
-    return result;
+    buf[pos] = '\0';
+    return (uint8_t)pos;
 }
 
-String formatVoltage(float voltage) {
-    if (voltage < 0.05f && voltage > -0.05f) return "0";
-    if (voltage < 100.0f) return removeTrailingZero(voltage, 1);
-    else {
-        char buffer[10];
-        sprintf(buffer, "%.0f", voltage);
-        return String(buffer);
+// Sama seperti sprintf("%.0f"): pembulatan half-even (rint), bukan cara dtostrf
+static uint8_t writeWholeNumber(char* buf, size_t size, float value) {
+    double rounded = rint((double)value);
+    
+    // Di luar uint32: jalur printf biasa (tidak terjadi untuk nilai kendaraan)
+    if (!(fabs(rounded) <= (double)UINT32_MAX)) {
+        int len = snprintf(buf, size, "%.0f", (double)value);
+        if (len < 0 || (size_t)len >= size) {
+            buf[0] = '\0';
+            return 0;
+        }
+        return (uint8_t)len;
+    }
+    
+    uint8_t pos = 0;
+    if (value < 0.0f) {
+        buf[pos++] = '-';
+        rounded = -rounded;
     }
+    uint8_t n = writeUnsigned(buf + pos, size - pos, (uint32_t)rounded);
+    if (n == 0) {
+        buf[0] = '\0';
+        return 0;
+    }
+    return pos + n;
+}
+
+static uint8_t writeZero(char* buf, size_t size) {
+    if (size < 2) return 0;
+    buf[0] = '0';
+    buf[1] = '\0';
+    return 1;
+}
+
+TextExtent formatVoltage(char* buf, size_t size, float voltage, uint8_t textSize) {
+    uint8_t len;
+    if (voltage < 0.05f && voltage > -0.05f) len = writeZero(buf, size);
+    else if (voltage < 100.0f) len = removeTrailingZero(buf, size, voltage, 1);
+    else len = writeWholeNumber(buf, size, voltage);
+    return makeExtent(len, textSize);
 }
 
-String formatCurrent(float current) {
+TextExtent formatCurrent(char* buf, size_t size, float current, uint8_t textSize) {
     float absCurrent = fabs(current);
-    if (absCurrent < 0.05f) return "0";
-    if (absCurrent < 10.0f) return removeTrailingZero(absCurrent, 1);
-    else if (absCurrent < 100.0f) return removeTrailingZero(absCurrent, 1);
-    else {
-        char buffer[10];
-        sprintf(buffer, "%.0f", absCurrent);
-        return String(buffer);
-    }
+    uint8_t len;
+    if (absCurrent < 0.05f) len = writeZero(buf, size);
+    else if (absCurrent < 100.0f) len = removeTrailingZero(buf, size, absCurrent, 1);
+    else len = writeWholeNumber(buf, size, absCurrent);
+    return makeExtent(len, textSize);
 }
 
-String formatPower(float power) {
+TextExtent formatPower(char* buf, size_t size, float power, uint8_t textSize) {
     float absPower = fabs(power);
-    if (absPower < 0.05f) return "0";
-    if (absPower < 10.0f) return removeTrailingZero(absPower, 1);
-    else {
-        char buffer[10];
-        sprintf(buffer, "%.0f", absPower);
-        return String(buffer);
+    uint8_t len;
+    if (absPower < 0.05f) len = writeZero(buf, size);
+    else if (absPower < 10.0f) len = removeTrailingZero(buf, size, absPower, 1);
+    else len = writeWholeNumber(buf, size, absPower);
+    return makeExtent(len, textSize);
+}
+
+// =============================================
+// HEAP PROBE - BUKTI 0 ALOKASI PER FRAME
+// =============================================
+static uint32_t heapProbeFrames = 0;
+static uint32_t heapProbeAllocFrames = 0;
+static int32_t heapProbeLastDelta = 0;
+
+#ifdef ESP32
+static size_t heapProbeBlocks = 0;
+
+static void heapProbeBegin() {
+    if (!DISPLAY_HEAP_PROBE_ENABLED) return;
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    heapProbeBlocks = info.allocated_blocks;
+}
+
+static void heapProbeEnd() {
+    if (!DISPLAY_HEAP_PROBE_ENABLED) return;
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    
+    heapProbeFrames++;
+    heapProbeLastDelta = (int32_t)info.allocated_blocks - (int32_t)heapProbeBlocks;
+    if (heapProbeLastDelta != 0) {
+        heapProbeAllocFrames++;
     }
 }
+#else
+static void heapProbeBegin() {}
+static void heapProbeEnd() {}
+#endif
+
+void getDisplayHeapStats(uint32_t &frames, uint32_t &framesWithAlloc, int32_t &lastDelta) {
+    frames = heapProbeFrames;
+    framesWithAlloc = heapProbeAllocFrames;
+    lastDelta = heapProbeLastDelta;
+}
 
 // =============================================
 // ENHANCED ANIMATION FUNCTIONS
@@ -451,22 +516,17 @@ void resetDisplayState() {
 void showSplashScreen() {
     if(!displayInitialized) return;
     resetDisplayState();
-    display.clearDisplay();
+    clearCanvas();
     display.setTextColor(SSD1306_WHITE);
     
-    const GFXfont* splashFont = NULL;
-    if(SPLASH_FONT_SIZE == 1) splashFont = &FreeSansBold9pt7b;
-    else if(SPLASH_FONT_SIZE == 2) splashFont = &FreeSansBold12pt7b;
+    if(splashFont() != NULL) display.setFont(splashFont());
     
-    if(splashFont != NULL) display.setFont(splashFont);
-    
-    int textWidth = strlen(SPLASH_TEXT) * (SPLASH_FONT_SIZE == 0 ? 6 : (SPLASH_FONT_SIZE == 1 ? 10 : 15));
-    int xPos = SPLASH_POS_X == 0 ? (SCREEN_WIDTH - textWidth) / 2 : SPLASH_POS_X;
+    int xPos = SPLASH_POS_X == 0 ? splashX : SPLASH_POS_X;
     int yPos = SPLASH_POS_Y == 0 ? (SPLASH_FONT_SIZE == 0 ? 16 : (SPLASH_FONT_SIZE == 1 ? 22 : 24)) : SPLASH_POS_Y;
     
     display.setCursor(xPos, yPos);
     display.print(SPLASH_TEXT);
-    display.display();
+    oledPresent();
     delay(SPLASH_DURATION_MS);
     resetDisplayState();
 }
@@ -480,8 +540,9 @@ void initDisplay() {
         Wire.end();
         delay(100);
         
+        // Probe awal di clock terendah; governor menaikkan lagi setelah begin()
         Wire.begin(SDA_PIN, SCL_PIN);
-        Wire.setClock(50000);
+        Wire.setClock(I2C_CLOCK_MIN_HZ);
         #ifdef ESP32
         Wire.setTimeOut(1000);
         #endif
@@ -500,13 +561,15 @@ void initDisplay() {
         if(display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS)) {
             displayInitialized = true;
             displayReady = true;
+            i2cMarkClockDirty();
+            i2cSetRecoveryHook(reinitDisplayAfterRecovery);
             resetAnimation();
             
             // Tampilkan splash screen hanya SEKALI
             showSplashScreen();
             
-            display.clearDisplay();
-            display.display();
+            clearCanvas();
+            oledPresent();
             serialPrintf("[DISPLAY] Initialized successfully\n");
             return;
         }
@@ -532,7 +595,6 @@ void resetDisplayFont() {
         display.setTextColor(SSD1306_WHITE);
         display.setTextWrap(false);
         display.setCursor(0, 0);
-        releaseI2C();
     }
 }
 
@@ -542,19 +604,16 @@ void resetDisplayFont() {
 void updateAppModeDisplay() {
     if (!displayInitialized || !displayReady) return;
     
-    if (safeI2COperationWithBackoff(I2C_MUTEX_TIMEOUT_MS)) {
+    if (safeI2COperation(I2C_MUTEX_TIMEOUT_MS)) {
         // Clear seluruh display
-        display.clearDisplay();
+        clearCanvas();
         
         // Tampilkan "APP MODE" dengan font splash screen (9pt)
-        display.setFont(&FreeSansBold9pt7b);
+        display.setFont(&FreeSansBold9ptLabels);
         display.setTextSize(1);
         
-        // Hitung posisi tengah untuk "APP MODE"
-        int textWidth = 7 * 10; // "APP MODE" = 7 karakter * 10px (approx)
-        int textX = (SCREEN_WIDTH - textWidth) / 2;
-        display.setCursor(textX, 20); // Y=20 agar pas di tengah
-        display.print("APP MODE");
+        display.setCursor(appModeX, 20); // Y=20 agar pas di tengah
+        display.print(APP_MODE_TEXT);
         
         // Tampilkan status koneksi di bagian bawah
         display.setFont();
@@ -562,15 +621,14 @@ void updateAppModeDisplay() {
         
         // Gunakan deviceConnected dari BLE
         if (deviceConnected) {
-            display.setCursor((SCREEN_WIDTH - 50) / 2, 55);
+            display.setCursor(centeredXDefaultFont("connected"), 55);
             display.print("connected");
         } else {
-            display.setCursor((SCREEN_WIDTH - 60) / 2, 55);
+            display.setCursor(centeredXDefaultFont("waiting..."), 55);
             display.print("waiting...");
         }
         
-        display.display();
-        releaseI2C();
+        oledPresent();
     }
 }
 
@@ -586,25 +644,22 @@ void showBleOffDisplay() {
         display.setTextColor(SSD1306_WHITE);
         display.setTextWrap(false);
         
-        display.clearDisplay();
+        clearCanvas();
         
         // Tampilkan "BLE OFF" dengan font splash screen (9pt)
-        display.setFont(&FreeSansBold9pt7b);
+        display.setFont(&FreeSansBold9ptLabels);
         display.setTextSize(1);
         
-        int textWidth = 6 * 10; // "BLE OFF" = 6 karakter * 10px
-        int textX = (SCREEN_WIDTH - textWidth) / 2;
-        display.setCursor(textX, 20);
-        display.print("BLE OFF");
+        display.setCursor(bleOffX, 20);
+        display.print(BLE_OFF_TEXT);
         
         // Tampilkan teks tambahan
         display.setFont();
         display.setTextSize(1);
-        display.setCursor((SCREEN_WIDTH - 70) / 2, 35);
+        display.setCursor(centeredXDefaultFont("Disconnected"), 35);
         display.print("Disconnected");
         
-        display.display();
-        releaseI2C();
+        oledPresent();
         
         serialPrintfln("[DISPLAY] BLE OFF shown");
     }
@@ -620,55 +675,19 @@ void showAppModeDisplay() {
 // =============================================
 // TRANSISI HALUS DARI APP MODE KE JAM
 // =============================================
+static void renderPage(int page, bool advanceAnimation);
+
 void transitionFromAppModeToClock() {
     if (!displayInitialized || !displayReady) return;
     
     serialPrintfln("[DISPLAY] Starting smooth transition");
     
     if (safeI2COperation(I2C_MUTEX_TIMEOUT_MS)) {
-        
-        // Reset font dulu
-        display.setFont();
-        display.setTextSize(1);
-        
-        display.clearDisplay();
-        display.display();
-        delay(20);
-        
-        resetDisplayState();
-        delay(10);
-        
-        RTCDateTime dt = getRTC();
-        
-        display.setFont(&FreeSansBold18pt7b);
-        display.setCursor(CLOCK_TIME_POS_X, CLOCK_TIME_POS_Y);
-        display.printf("%02d:%02d", dt.hour, dt.minute);
-        
-        display.setFont();
-        display.setTextSize(1);
-        
-        int hariIndex = dt.dayOfWeek - 1;
-        if(hariIndex < 0) hariIndex = 0;
-        if(hariIndex > 6) hariIndex = 6;
-        
-        int bulanIndex = dt.month - 1;
-        if(bulanIndex < 0) bulanIndex = 0;
-        if(bulanIndex > 11) bulanIndex = 11;
-        
-        display.setCursor(CLOCK_DAY_POS_X, CLOCK_DAY_POS_Y);
-        display.print(DAY_NAMES[hariIndex]);
-        
-        display.setCursor(CLOCK_DATE_POS_X, CLOCK_DATE_POS_Y);
-        display.printf("%d %s", dt.day, MONTH_NAMES[bulanIndex]);
-        
-        display.setCursor(CLOCK_YEAR_POS_X, CLOCK_YEAR_POS_Y);
-        display.printf("%04d", dt.year);
-        
-        display.display();
-        delay(10);
-        display.display();
-        
-        releaseI2C();
+        // Gambar jam sekali ke back buffer, lalu geser masuk (hardware scroll)
+        oledBeginFrame();
+        renderPage(1, false);
+        oledPresentSlide(OLED_SLIDE_DOWN);
+        shownPage = 1;
         
         serialPrintfln("[DISPLAY] Transition complete");
     } else {
@@ -697,257 +716,731 @@ void resetDisplay() {
     if(!displayInitialized) return;
     if(safeI2COperation(I2C_MUTEX_TIMEOUT_MS)) {
         resetDisplayState();
-        display.clearDisplay();
-        display.display();
-        releaseI2C();
+        clearCanvas();
+        oledPresent();
     }
 }
 
 // =============================================
-// updateDisplay
+// WIDGET LAYOUT - TABEL PER PAGE
 // =============================================
-void updateDisplay(int page) {
-    if(!displayInitialized) return;
-    
+// Tiap page = daftar widget (label, nilai, unit, tanda, penanda data basi).
+// prepare() menghitung model page sekali per frame, lalu source tiap widget
+// menulis teks + posisinya. Widget hanya digambar ulang jika teks/posisinya
+// berubah; flush dirty-region (fox_oled) lalu hanya mengirim byte yang beda.
+#define WIDGET_TEXT_MAX 12
+#define MAX_PAGE_WIDGETS 10
+
+typedef struct {
+    char text[WIDGET_TEXT_MAX];   // "" = tidak digambar
+    int16_t x;
+    int16_t y;
+} WidgetText;
+
+typedef void (*WidgetSource)(WidgetText &out);
+
+typedef struct {
+    const char* label;            // Teks tetap; NULL = isi dari source
+    WidgetSource source;
+    const GFXfont* font;          // NULL = font default
+    uint8_t textSize;
+    int16_t x;                    // Posisi default (source boleh menggeser)
+    int16_t y;
+} WidgetDef;
+
+typedef struct {
+    const WidgetDef* widgets;
+    uint8_t count;
+    void (*prepare)(bool advanceAnimation);
+} PageLayout;
+
+typedef struct {
+    WidgetText drawn;
+    int16_t boundsX;              // Area tinta terakhir, dihapus saat berubah
+    int16_t boundsY;
+    uint16_t boundsW;
+    uint16_t boundsH;
+} WidgetState;
+
+static WidgetState widgetState[MAX_PAGE_WIDGETS];
+static uint32_t widgetFullRenders = 0;
+static uint32_t widgetIncrementalRenders = 0;
+static uint32_t widgetsRedrawn = 0;
+static uint32_t widgetsUnchanged = 0;
+
+static bool rectsOverlap(const WidgetState &a, const WidgetState &b) {
+    if (a.boundsW == 0 || b.boundsW == 0) return false;
+    return a.boundsX < b.boundsX + (int16_t)b.boundsW && b.boundsX < a.boundsX + (int16_t)a.boundsW &&
+           a.boundsY < b.boundsY + (int16_t)b.boundsH && b.boundsY < a.boundsY + (int16_t)a.boundsH;
+}
+
+// ========== PAGE 1: JAM ==========
+static RTCDateTime clockModel;
+
+static void prepareClockPage(bool advanceAnimation) {
+    clockModel = getRTC();
+}
+
+static void sourceClockTime(WidgetText &out) {
+    snprintf(out.text, sizeof(out.text), CLOCK_TIME_FORMAT, clockModel.hour, clockModel.minute);
+}
+
+static void sourceClockDay(WidgetText &out) {
+    int index = constrain(clockModel.dayOfWeek - 1, 0, 6);
+    snprintf(out.text, sizeof(out.text), "%s", DAY_NAMES[index]);
+}
+
+static void sourceClockDate(WidgetText &out) {
+    int index = constrain(clockModel.month - 1, 0, 11);
+    snprintf(out.text, sizeof(out.text), CLOCK_DATE_FORMAT, clockModel.day, MONTH_NAMES[index]);
+}
+
+static void sourceClockYear(WidgetText &out) {
+    snprintf(out.text, sizeof(out.text), CLOCK_YEAR_FORMAT, clockModel.year);
+}
+
+static const WidgetDef CLOCK_WIDGETS[] = {
+    {NULL, sourceClockTime, &FreeSansBold18ptClock, 1, CLOCK_TIME_POS_X, CLOCK_TIME_POS_Y},
+    {NULL, sourceClockDay,  NULL, 1, CLOCK_DAY_POS_X,  CLOCK_DAY_POS_Y},
+    {NULL, sourceClockDate, NULL, 1, CLOCK_DATE_POS_X, CLOCK_DATE_POS_Y},
+    {NULL, sourceClockYear, NULL, 1, CLOCK_YEAR_POS_X, CLOCK_YEAR_POS_Y},
+};
+
+// ========== PAGE 2: SUHU ==========
+static void prepareTempPage(bool advanceAnimation) {
+}
+
+static void sourceTempEcu(WidgetText &out) {
+    snprintf(out.text, sizeof(out.text), "%d", getTempCtrl());
+}
+
+static void sourceTempMotor(WidgetText &out) {
+    snprintf(out.text, sizeof(out.text), "%d", getTempMotor());
+}
+
+static void sourceTempBatt(WidgetText &out) {
+    snprintf(out.text, sizeof(out.text), "%d", getTempBatt());
+}
+
+static const WidgetDef TEMP_WIDGETS[] = {
+    {TEMP_LABEL_ECU,   NULL, NULL, 1, TEMP_LABEL_ECU_POS_X,   TEMP_LABEL_ECU_POS_Y},
+    {TEMP_LABEL_MOTOR, NULL, NULL, 1, TEMP_LABEL_MOTOR_POS_X, TEMP_LABEL_MOTOR_POS_Y},
+    {TEMP_LABEL_BATT,  NULL, NULL, 1, TEMP_LABEL_BATT_POS_X,  TEMP_LABEL_BATT_POS_Y},
+    {NULL, sourceTempEcu,   NULL, 2, TEMP_VALUE_ECU_POS_X,   TEMP_VALUE_ECU_POS_Y},
+    {NULL, sourceTempMotor, NULL, 2, TEMP_VALUE_MOTOR_POS_X, TEMP_VALUE_MOTOR_POS_Y},
+    {NULL, sourceTempBatt,  NULL, 2, TEMP_VALUE_BATT_POS_X,  TEMP_VALUE_BATT_POS_Y},
+};
+
+// ========== PAGE 3: BMS (VOLT / ARUS) ==========
+static struct {
+    char voltage[WIDGET_TEXT_MAX];
+    int16_t voltageUnitX;
+    char current[WIDGET_TEXT_MAX];
+    int16_t currentX;
+    int16_t currentUnitX;
+    bool negative;
+    bool stale;
+} bmsModel;
+
+static void prepareBmsPage(bool advanceAnimation) {
     #ifdef ESP32
-    if (isInAppMode()) {
-        return;
+    if(advanceAnimation && !isChargingModeActive()) {
+        updateAnimationTargets();
+        updateAnimation();
     }
     #endif
     
-    if (!safeI2COperation(10)) {
-        serialPrintfln("[DISPLAY] I2C busy, skipping update");
+    float displayCurrent = animatedCurrent;
+    
+    TextExtent voltage = formatVoltage(bmsModel.voltage, sizeof(bmsModel.voltage), animatedVoltage, 2);
+    bmsModel.voltageUnitX = BMS_VALUE_VOLTAGE_POS_X + voltage.width + BMS_UNIT_GAP_X;
+    bmsModel.stale = !isDataFresh();
+    bmsModel.negative = false;
+    
+    float deadzone = CURRENT_DISPLAY_DEADZONE;
+    #ifdef ESP32
+    if(isChargingModeActive()) deadzone = CHARGING_CURRENT_DEADZONE;
+    #endif
+    
+    if(fabs(displayCurrent) < deadzone || (bmsModel.stale && fabs(displayCurrent) < 0.1f)) {
+        // Nol: posisi tetap, unit di kanan
+        strcpy(bmsModel.current, "0");
+        bmsModel.currentX = BMS_VALUE_CURRENT_POS_X + 12;
+        bmsModel.currentUnitX = BMS_UNIT_MAX_X;
         return;
     }
     
-    resetDisplayState();
-    display.clearDisplay();
-    display.setTextColor(SSD1306_WHITE);
+    TextExtent current = formatCurrent(bmsModel.current, sizeof(bmsModel.current), displayCurrent, 2);
+    bmsModel.negative = (displayCurrent < -deadzone);
     
+    // Rata kanan kira-kira: 1 digit paling kanan, 4+ karakter geser ke kiri
+    int16_t currentX = BMS_VALUE_CURRENT_POS_X;
+    if (current.length == 1) currentX += 12;
+    else if (current.length == 2) currentX += 6;
+    else if (current.length >= 4) currentX -= 6;
+    
+    bmsModel.currentX = currentX;
+    bmsModel.currentUnitX = min((int16_t)(currentX + current.width), (int16_t)BMS_UNIT_MAX_X);
+}
+
+static void sourceVoltage(WidgetText &out) {
+    strcpy(out.text, bmsModel.voltage);
+}
+
+static void sourceVoltageUnit(WidgetText &out) {
+    strcpy(out.text, "V");
+    out.x = bmsModel.voltageUnitX;
+}
+
+static void sourceCurrentSign(WidgetText &out) {
+    if (bmsModel.negative) strcpy(out.text, "-");
+    out.x = bmsModel.currentX - 8;
+}
+
+static void sourceCurrent(WidgetText &out) {
+    strcpy(out.text, bmsModel.current);
+    out.x = bmsModel.currentX;
+}
+
+static void sourceCurrentUnit(WidgetText &out) {
+    strcpy(out.text, "A");
+    out.x = bmsModel.currentUnitX;
+}
+
+static void sourceStale(WidgetText &out) {
+    if (bmsModel.stale) strcpy(out.text, "x");
+}
+
+static const WidgetDef BMS_WIDGETS[] = {
+    {BMS_LABEL_VOLTAGE, NULL, NULL, 1, BMS_LABEL_VOLTAGE_POS_X, BMS_LABEL_VOLTAGE_POS_Y},
+    {NULL, sourceVoltage,     NULL, 2, BMS_VALUE_VOLTAGE_POS_X, BMS_VALUE_VOLTAGE_POS_Y},
+    {NULL, sourceVoltageUnit, NULL, 1, 0, BMS_VALUE_VOLTAGE_POS_Y + BMS_UNIT_OFFSET_Y},
+    {BMS_LABEL_CURRENT, NULL, NULL, 1, BMS_LABEL_CURRENT_POS_X, BMS_LABEL_CURRENT_POS_Y},
+    {NULL, sourceCurrentSign, NULL, 1, 0, BMS_VALUE_CURRENT_POS_Y + BMS_UNIT_OFFSET_Y},
+    {NULL, sourceCurrent,     NULL, 2, 0, BMS_VALUE_CURRENT_POS_Y},
+    {NULL, sourceCurrentUnit, NULL, 1, 0, BMS_VALUE_CURRENT_POS_Y + BMS_UNIT_OFFSET_Y},
+    {NULL, sourceStale,       NULL, 1, BMS_STALE_POS_X, BMS_STALE_POS_Y},
+};
+
+// ========== PAGE 4: POWER ==========
+static struct {
+    char power[WIDGET_TEXT_MAX];
+    char sign[2];
+    int16_t numberX;
+    int16_t unitX;
+    int16_t unitY;
+} powerModel;
+
+static void preparePowerPage(bool advanceAnimation) {
     #ifdef ESP32
-    if(isChargingModeActive() && CHARGING_PAGE_ENABLED) {
-        display.setTextSize(2);
-        display.setCursor(0, 0);
-        display.print("LOCKED");
-        display.display();
-        releaseI2C();
-        return;
+    if(advanceAnimation && !isChargingModeActive()) {
+        updateAnimationTargets();
+        updateAnimation();
     }
     #endif
     
-    if(page == 1) {
-        RTCDateTime dt = getRTC();
-        
-        display.setFont(&FreeSansBold18pt7b);
-        display.setCursor(CLOCK_TIME_POS_X, CLOCK_TIME_POS_Y);
-        display.printf("%02d:%02d", dt.hour, dt.minute);
-        
-        display.setFont();
-        display.setTextSize(1);
-        
-        int hariIndex = dt.dayOfWeek - 1;
-        if(hariIndex < 0) hariIndex = 0;
-        if(hariIndex > 6) hariIndex = 6;
-        
-        int bulanIndex = dt.month - 1;
-        if(bulanIndex < 0) bulanIndex = 0;
-        if(bulanIndex > 11) bulanIndex = 11;
-        
-        display.setCursor(CLOCK_DAY_POS_X, CLOCK_DAY_POS_Y);
-        display.print(DAY_NAMES[hariIndex]);
-        
-        display.setCursor(CLOCK_DATE_POS_X, CLOCK_DATE_POS_Y);
-        display.printf("%d %s", dt.day, MONTH_NAMES[bulanIndex]);
-        
-        display.setCursor(CLOCK_YEAR_POS_X, CLOCK_YEAR_POS_Y);
-        display.printf("%04d", dt.year);
-        
-    } else if(page == 2) {
-        display.setTextSize(1);
-        
-        display.setCursor(TEMP_LABEL_ECU_POS_X, TEMP_LABEL_ECU_POS_Y);
-        display.print(TEMP_LABEL_ECU);
-        display.setCursor(TEMP_LABEL_MOTOR_POS_X, TEMP_LABEL_MOTOR_POS_Y);
-        display.print(TEMP_LABEL_MOTOR);
-        display.setCursor(TEMP_LABEL_BATT_POS_X, TEMP_LABEL_BATT_POS_Y);
-        display.print(TEMP_LABEL_BATT);
-        
-        display.setTextSize(2);
-        display.setCursor(TEMP_VALUE_ECU_POS_X, TEMP_VALUE_ECU_POS_Y);
-        display.print(getTempCtrl());
-        display.setCursor(TEMP_VALUE_MOTOR_POS_X, TEMP_VALUE_MOTOR_POS_Y);
-        display.print(getTempMotor());
-        display.setCursor(TEMP_VALUE_BATT_POS_X, TEMP_VALUE_BATT_POS_Y);
-        display.print(getTempBatt());
-        
-    } else if(page == 3) {
-        #ifdef ESP32
-        if(!isChargingModeActive()) {
-            updateAnimationTargets();
-            updateAnimation();
+    float displayPower = constrain(animatedPower, (float)MIN_DISPLAY_POWER, (float)MAX_DISPLAY_POWER);
+    
+    TextExtent power = formatPower(powerModel.power, sizeof(powerModel.power), displayPower, POWER_FONT_SIZE);
+    bool isThousand = power.length >= 4;
+    bool hasSign = displayPower > 0.1f || displayPower < -0.1f;
+    
+    powerModel.sign[0] = displayPower > 0.1f ? '+' : (displayPower < -0.1f ? '-' : '\0');
+    powerModel.sign[1] = '\0';
+    
+    if (hasSign) powerModel.numberX = isThousand ? 28 : 36;
+    else powerModel.numberX = isThousand ? 32 : 40;
+    
+    if (isThousand) {
+        // Angka 4 digit memenuhi lebar: unit turun ke bawah, di tengah angka
+        powerModel.unitX = powerModel.numberX + (power.width / 2) - 10;
+        powerModel.unitY = POWER_UNIT_BELOW_POS_Y;
+    } else {
+        powerModel.unitX = powerModel.numberX + power.width + POWER_UNIT_GAP_X;
+        powerModel.unitY = POWER_UNIT_INLINE_POS_Y;
+    }
+}
+
+static void sourcePowerSign(WidgetText &out) {
+    strcpy(out.text, powerModel.sign);
+}
+
+static void sourcePower(WidgetText &out) {
+    strcpy(out.text, powerModel.power);
+    out.x = powerModel.numberX;
+}
+
+static void sourcePowerUnit(WidgetText &out) {
+    strcpy(out.text, POWER_UNIT_TEXT);
+    out.x = powerModel.unitX;
+    out.y = powerModel.unitY;
+}
+
+static const WidgetDef POWER_WIDGETS[] = {
+    {NULL, sourcePowerSign, NULL, 2, POWER_SIGN_POS_X, POWER_SIGN_POS_Y},
+    {NULL, sourcePower,     NULL, POWER_FONT_SIZE, 0, POWER_NUMBER_POS_Y},
+    {NULL, sourcePowerUnit, NULL, 1, 0, 0},
+};
+
+#define WIDGET_COUNT(table) (sizeof(table) / sizeof(table[0]))
+
+static const PageLayout PAGE_LAYOUTS[] = {
+    {CLOCK_WIDGETS, WIDGET_COUNT(CLOCK_WIDGETS), prepareClockPage},
+    {TEMP_WIDGETS,  WIDGET_COUNT(TEMP_WIDGETS),  prepareTempPage},
+    {BMS_WIDGETS,   WIDGET_COUNT(BMS_WIDGETS),   prepareBmsPage},
+    {POWER_WIDGETS, WIDGET_COUNT(POWER_WIDGETS), preparePowerPage},
+};
+
+static_assert(WIDGET_COUNT(CLOCK_WIDGETS) <= MAX_PAGE_WIDGETS &&
+              WIDGET_COUNT(TEMP_WIDGETS) <= MAX_PAGE_WIDGETS &&
+              WIDGET_COUNT(BMS_WIDGETS) <= MAX_PAGE_WIDGETS &&
+              WIDGET_COUNT(POWER_WIDGETS) <= MAX_PAGE_WIDGETS, "MAX_PAGE_WIDGETS terlalu kecil");
+
+static void drawWidget(const WidgetDef &def, const WidgetText &text, WidgetState &state) {
+    display.setFont(def.font);
+    display.setTextSize(def.textSize);
+    
+    state.drawn = text;
+    state.boundsW = 0;
+    state.boundsH = 0;
+    if (text.text[0] == '\0') return;
+    
+    display.getTextBounds(text.text, text.x, text.y, &state.boundsX, &state.boundsY,
+                          &state.boundsW, &state.boundsH);
+    display.setCursor(text.x, text.y);
+    display.print(text.text);
+}
+
+static void renderWidgets(int page) {
+    const PageLayout &layout = PAGE_LAYOUTS[page - 1];
+    WidgetText next[MAX_PAGE_WIDGETS];
+    bool dirty[MAX_PAGE_WIDGETS];
+    bool incremental = (widgetCanvasPage == page);
+    
+    for (uint8_t i = 0; i < layout.count; i++) {
+        const WidgetDef &def = layout.widgets[i];
+        next[i].text[0] = '\0';
+        next[i].x = def.x;
+        next[i].y = def.y;
+        if (def.label != NULL) {
+            strncpy(next[i].text, def.label, sizeof(next[i].text) - 1);
+            next[i].text[sizeof(next[i].text) - 1] = '\0';
+        } else {
+            def.source(next[i]);
         }
-        #endif
         
-        float displayVoltage = animatedVoltage;
-        float displayCurrent = animatedCurrent;
-        
-        display.setTextSize(1);
-        display.setCursor(BMS_LABEL_VOLTAGE_POS_X, BMS_LABEL_VOLTAGE_POS_Y);
-        display.print(BMS_LABEL_VOLTAGE);
-        
-        display.setTextSize(2);
-        String voltageStr = formatVoltage(displayVoltage);
-        int voltageWidth = calculateWidthFont2(voltageStr);
-        display.setCursor(BMS_VALUE_VOLTAGE_POS_X, BMS_VALUE_VOLTAGE_POS_Y);
-        display.print(voltageStr);
-        
-        display.setTextSize(1);
-        display.setCursor(BMS_VALUE_VOLTAGE_POS_X + voltageWidth + 6, BMS_VALUE_VOLTAGE_POS_Y + 6);
-        display.print("V");
-        
-        display.setTextSize(1);
-        display.setCursor(BMS_LABEL_CURRENT_POS_X, BMS_LABEL_CURRENT_POS_Y);
-        display.print(BMS_LABEL_CURRENT);
-        
-        bool dataFresh = isDataFresh();
-        
-        if(!dataFresh && fabs(displayCurrent) < 0.1f) {
-            display.setTextSize(2);
-            display.setCursor(BMS_VALUE_CURRENT_POS_X + 12, BMS_VALUE_CURRENT_POS_Y);
-            display.print("0");
-            
-            display.setTextSize(1);
-            display.setCursor(BMS_VALUE_CURRENT_POS_X + 40, BMS_VALUE_CURRENT_POS_Y + 6);
-            display.print("A");
-        } else {
-            float deadzone = CURRENT_DISPLAY_DEADZONE;
-            #ifdef ESP32
-            if(isChargingModeActive()) deadzone = CHARGING_CURRENT_DEADZONE;
-            #endif
-            
-            if(fabs(displayCurrent) < deadzone) {
-                display.setTextSize(2);
-                display.setCursor(BMS_VALUE_CURRENT_POS_X + 12, BMS_VALUE_CURRENT_POS_Y);
-                display.print("0");
-                
-                display.setTextSize(1);
-                display.setCursor(118, BMS_VALUE_CURRENT_POS_Y + 6);
-                display.print("A");
-            } else {
-                String currentStr = formatCurrent(displayCurrent);
-                bool isNegative = (displayCurrent < -deadzone);
-                
-                int digitCount = currentStr.length();
-                int currentX = BMS_VALUE_CURRENT_POS_X;
-                
-                if (digitCount == 1) currentX += 12;
-                else if (digitCount == 2) currentX += 6;
-                else if (digitCount == 3) currentX += 0;
-                else currentX -= 6;
-                
-                if (isNegative) {
-                    display.setTextSize(1);
-                    display.setCursor(currentX - 8, BMS_VALUE_CURRENT_POS_Y + 6);
-                    display.print("-");
+        const WidgetText &drawn = widgetState[i].drawn;
+        dirty[i] = !incremental || drawn.x != next[i].x || drawn.y != next[i].y ||
+                   strcmp(drawn.text, next[i].text) != 0;
+    }
+    
+    if (!incremental) {
+        clearCanvas();
+        widgetFullRenders++;
+    } else {
+        // Area lama yang dihapus bisa memotong widget tetangga: ikut digambar ulang
+        bool grew = true;
+        while (grew) {
+            grew = false;
+            for (uint8_t i = 0; i < layout.count; i++) {
+                if (!dirty[i]) continue;
+                for (uint8_t j = 0; j < layout.count; j++) {
+                    if (!dirty[j] && rectsOverlap(widgetState[i], widgetState[j])) {
+                        dirty[j] = true;
+                        grew = true;
+                    }
                 }
-                
-                display.setTextSize(2);
-                display.setCursor(currentX, BMS_VALUE_CURRENT_POS_Y);
-                display.print(currentStr);
-                
-                display.setTextSize(1);
-                int unitX;
-                
-                if (digitCount == 1) unitX = currentX + 12;
-                else if (digitCount == 2) unitX = currentX + 24;
-                else if (digitCount == 3) unitX = currentX + 36;
-                else unitX = currentX + 48;
-                
-                if (unitX > 118) unitX = 118;
-                
-                display.setCursor(unitX, BMS_VALUE_CURRENT_POS_Y + 6);
-                display.print("A");
             }
         }
         
-        display.setCursor(120, 0);
-        if(isDataFresh()) 
-            display.print("");
-        else 
-            display.print("x");
-        
-    } else if(page == 4) {
-        #ifdef ESP32
-        if(!isChargingModeActive()) {
-            updateAnimationTargets();
-            updateAnimation();
-        }
-        #endif
-        
-        float displayPower = animatedPower;
-        
-        if(displayPower > MAX_DISPLAY_POWER) displayPower = MAX_DISPLAY_POWER;
-        if(displayPower < MIN_DISPLAY_POWER) displayPower = MIN_DISPLAY_POWER;
-        
-        String powerStr = formatPower(displayPower);
-        int digits = powerStr.length();
-        bool isThousand = digits >= 4;
-        
-        if(displayPower > 0.1f) {
-            display.setTextSize(2);
-            display.setCursor(10, 4);
-            display.print("+");
-        } else if(displayPower < -0.1f) {
-            display.setTextSize(2);
-            display.setCursor(10, 4);
-            display.print("-");
+        for (uint8_t i = 0; i < layout.count; i++) {
+            const WidgetState &state = widgetState[i];
+            if (dirty[i] && state.boundsW > 0) {
+                display.fillRect(state.boundsX, state.boundsY, state.boundsW, state.boundsH, SSD1306_BLACK);
+            }
         }
-        
-        display.setTextSize(3);
-        int numberX;
-        if(displayPower > 0.1f || displayPower < -0.1f) {
-            numberX = isThousand ? 28 : 36;
-        } else {
-            numberX = isThousand ? 32 : 40;
+        widgetIncrementalRenders++;
+    }
+    
+    for (uint8_t i = 0; i < layout.count; i++) {
+        if (!dirty[i]) {
+            widgetsUnchanged++;
+            continue;
         }
-        
-        display.setCursor(numberX, 2);
-        display.print(powerStr);
-        
-        display.setTextSize(1);
-        if(isThousand) {
-            int approxNumWidth = digits * 18;
-            int wattX = numberX + (approxNumWidth / 2) - 10;
-            display.setCursor(wattX, 26);
-        } else {
-            int numberEndX = numberX + (digits * 18);
-            display.setCursor(numberEndX + 4, 14);
+        drawWidget(layout.widgets[i], next[i], widgetState[i]);
+        widgetsRedrawn++;
+    }
+    
+    display.setFont();
+    display.setTextSize(1);
+    widgetCanvasPage = page;
+}
+
+static void printWidgetStats() {
+    serialPrintflnAlways("\n=== WIDGETS ===");
+    serialPrintflnAlways("Renders: %lu full, %lu incremental",
+                         (unsigned long)widgetFullRenders, (unsigned long)widgetIncrementalRenders);
+    serialPrintflnAlways("Widgets: %lu redrawn, %lu unchanged",
+                         (unsigned long)widgetsRedrawn, (unsigned long)widgetsUnchanged);
+}
+
+// =============================================
+// SPARKLINE PAGE (PAGE 5)
+// =============================================
+// Satu kolom per sampel riwayat. Sampel baru: isi layar digeser ke kiri
+// langsung di buffer GDDRAM (page-major, satu byte = 8 pixel vertikal satu
+// kolom) lalu hanya kolom baru yang digambar. Skala tetap supaya kolom lama
+// tetap benar setelah digeser.
+#define SPARK_PAGE 5
+
+static uint32_t sparkDrawnSeq = 0;      // Sampel berikutnya yang belum digambar
+static uint32_t sparkSamplesDrawn = 0;
+static uint32_t sparkShiftRenders = 0;
+static uint32_t sparkFullRenders = 0;
+static uint32_t sparkShiftUs = 0;       // Render incremental terakhir (geser + kolom baru)
+static uint32_t sparkShiftMaxUs = 0;
+static uint32_t sparkShiftTotalUs = 0;
+static uint32_t sparkShiftSamples = 0;  // Sampel yang digambar lewat jalur incremental
+static uint32_t sparkFullUs = 0;
+
+static int16_t sparkValueToY(int16_t value) {
+    int32_t v = constrain((int32_t)value, (int32_t)SPARK_SCALE_MIN, (int32_t)SPARK_SCALE_MAX);
+    return (int16_t)(((int32_t)SPARK_SCALE_MAX - v) * (SCREEN_HEIGHT - 1) /
+                     ((int32_t)SPARK_SCALE_MAX - SPARK_SCALE_MIN));
+}
+
+// Garis dari sampel sebelumnya ke sampel ini, hanya di kolom x
+static void drawSparkColumn(int16_t x, uint32_t seq) {
+    int16_t value = 0;
+    if (!historyGetSample(seq, value)) return;
+    
+    int16_t prevValue = value;
+    if (seq > 0) historyGetSample(seq - 1, prevValue);
+    
+    int16_t y = sparkValueToY(value);
+    int16_t prevY = sparkValueToY(prevValue);
+    int16_t top = y < prevY ? y : prevY;
+    int16_t height = abs(y - prevY) + 1;
+    
+    // Baseline nol putus-putus, polanya ikut bergeser bersama data
+    if ((seq & 1) == 0) display.drawPixel(x, sparkValueToY(0), SSD1306_WHITE);
+    display.drawFastVLine(x, top, height, SSD1306_WHITE);
+}
+
+static void shiftCanvasLeft(uint16_t columns) {
+    uint8_t* buffer = display.getBuffer();
+    for (int page = 0; page < SCREEN_HEIGHT / 8; page++) {
+        uint8_t* row = buffer + page * SCREEN_WIDTH;
+        memmove(row, row + columns, SCREEN_WIDTH - columns);
+        memset(row + SCREEN_WIDTH - columns, 0, columns);
+    }
+}
+
+static void renderSparkPage() {
+    uint32_t head = historyHeadSeq();
+    uint32_t pending = head - sparkDrawnSeq;
+    bool incremental = widgetCanvasPage == SPARK_PAGE && sparkDrawnSeq > 0 &&
+                       pending < SCREEN_WIDTH;
+    
+    if (incremental && pending == 0) return;   // Belum ada sampel baru, frame sama
+    
+    uint32_t startUs = micros();
+    if (incremental) {
+        shiftCanvasLeft(pending);
+        for (uint32_t i = 0; i < pending; i++) {
+            drawSparkColumn(SCREEN_WIDTH - pending + i, sparkDrawnSeq + i);
         }
-        display.print("watt");
-        
+        sparkShiftUs = micros() - startUs;
+        if (sparkShiftUs > sparkShiftMaxUs) sparkShiftMaxUs = sparkShiftUs;
+        sparkShiftTotalUs += sparkShiftUs;
+        sparkShiftSamples += pending;
+        sparkShiftRenders++;
     } else {
-        updateDisplay(1);
-        releaseI2C();
+        clearCanvas();
+        uint32_t available = head < SCREEN_WIDTH ? head : SCREEN_WIDTH;
+        if (available == 0) {
+            display.setCursor(0, 0);
+            display.print("WAIT DATA");
+        }
+        for (uint32_t i = 0; i < available; i++) {
+            drawSparkColumn(SCREEN_WIDTH - available + i, head - available + i);
+        }
+        sparkFullUs = micros() - startUs;
+        sparkFullRenders++;
+    }
+    
+    sparkSamplesDrawn += pending;
+    sparkDrawnSeq = head;
+    widgetCanvasPage = SPARK_PAGE;
+}
+
+static void printSparkStats() {
+    serialPrintflnAlways("\n=== SPARKLINE ===");
+    serialPrintflnAlways("Samples: %lu in history, %lu drawn (1 per %d ms)",
+                         (unsigned long)historyHeadSeq(), (unsigned long)sparkSamplesDrawn,
+                         SPARK_SAMPLE_INTERVAL_MS);
+    serialPrintflnAlways("Renders: %lu shift, %lu full (last full %lu us)",
+                         (unsigned long)sparkShiftRenders, (unsigned long)sparkFullRenders,
+                         (unsigned long)sparkFullUs);
+    serialPrintflnAlways("Per sample: last %lu us, max %lu us, avg %lu us",
+                         (unsigned long)sparkShiftUs, (unsigned long)sparkShiftMaxUs,
+                         (unsigned long)(sparkShiftSamples ? sparkShiftTotalUs / sparkShiftSamples : 0));
+}
+
+// =============================================
+// renderPage - gambar page ke back buffer (tanpa I2C)
+// =============================================
+static void renderPage(int page, bool advanceAnimation) {
+    resetDisplayState();
+    
+    #ifdef ESP32
+    if(isChargingModeActive() && CHARGING_PAGE_ENABLED) {
+        clearCanvas();
+        display.setTextSize(2);
+        display.setCursor(0, 0);
+        display.print("LOCKED");
+        return;
+    }
+    #endif
+    
+    if(page < 1 || page > PAGE_COUNT) page = 1;
+    
+    if(page == SPARK_PAGE) {
+        renderSparkPage();
+        return;
+    }
+    
+    PAGE_LAYOUTS[page - 1].prepare(advanceAnimation);
+    renderWidgets(page);
+}
+
+// =============================================
+// updateDisplay
+// =============================================
+void updateDisplay(int page) {
+    if(!displayInitialized) return;
+    
+    #ifdef ESP32
+    if (isInAppMode()) {
+        return;
+    }
+    #endif
+    
+    if (!safeI2COperation(10)) {
+        serialPrintfln("[DISPLAY] I2C busy, skipping update");
+        return;
+    }
+    
+    heapProbeBegin();
+    oledBeginFrame();
+    renderPage(page, true);
+    oledPresent();
+    heapProbeEnd();
+}
+
+// =============================================
+// PRE-RENDER PAGE BERIKUTNYA (OFF-SCREEN)
+// =============================================
+static uint8_t preRenderBuffer[OLED_BUFFER_SIZE];
+static int preRenderedPage = 0;
+static unsigned long preRenderedAt = 0;
+static uint32_t preRenderHits = 0;
+static uint32_t preRenderMisses = 0;
+static uint32_t preRenderCount = 0;
+
+static void invalidatePreRender() {
+    preRenderedPage = 0;
+}
+
+// Dipanggil display task saat idle: gambar page berikutnya di PAGE_ORDER
+// ke back buffer lalu simpan salinannya
+static void refreshPreRender(int page) {
+    if(!displayInitialized) return;
+    
+    #ifdef ESP32
+    if(isChargingModeActive() && CHARGING_PAGE_ENABLED) {
+        invalidatePreRender();
         return;
     }
+    #endif
+    
+    // Back buffer page aktif dititipkan di buffer pre-render lalu ditukar kembali,
+    // jadi refresh page aktif berikutnya tetap incremental
+    static WidgetState savedState[MAX_PAGE_WIDGETS];
+    int savedCanvasPage = widgetCanvasPage;
+    memcpy(savedState, widgetState, sizeof(widgetState));
+    memcpy(preRenderBuffer, display.getBuffer(), OLED_BUFFER_SIZE);
+    
+    renderPage(page, false);
+    
+    uint8_t* back = display.getBuffer();
+    for (int i = 0; i < OLED_BUFFER_SIZE; i++) {
+        uint8_t tmp = back[i];
+        back[i] = preRenderBuffer[i];
+        preRenderBuffer[i] = tmp;
+    }
+    memcpy(widgetState, savedState, sizeof(widgetState));
+    widgetCanvasPage = savedCanvasPage;
+    
+    preRenderedPage = page;
+    preRenderedAt = millis();
+    preRenderCount++;
+}
+
+// Arah slide mengikuti navigasi: maju (tombol, termasuk wrap ke page
+// pertama) masuk dari bawah, lompat mundur (serial PAGE) masuk dari atas
+static OledSlide slideForPage(int page) {
+    if (shownPage == 0 || page == getNextPageInOrder(shownPage)) return OLED_SLIDE_UP;
+    if (page == shownPage) return OLED_SLIDE_NONE;
+    return getPageOrderIndex(page) < getPageOrderIndex(shownPage) ? OLED_SLIDE_DOWN : OLED_SLIDE_UP;
+}
+
+static void showPageFromTask(int page, uint32_t eventUs) {
+    if(!displayInitialized) return;
+    
+    OledSlide slide = slideForPage(page);
+    shownPage = page;
+    bool fresh = (millis() - preRenderedAt) < PRERENDER_MAX_AGE_MS;
+    
+    if(page == preRenderedPage && fresh) {
+        // Cukup tukar buffer: salin hasil pre-render ke back buffer lalu flush
+        memcpy(display.getBuffer(), preRenderBuffer, OLED_BUFFER_SIZE);
+        widgetCanvasPage = 0;
+        oledPresentSlide(slide, eventUs);
+        preRenderHits++;
+    } else {
+        oledBeginFrame();
+        renderPage(page, true);
+        oledPresentSlide(slide, eventUs);
+        preRenderMisses++;
+    }
+    
+    invalidatePreRender();
+}
+
+void getPreRenderStats(uint32_t &hits, uint32_t &misses, uint32_t &refreshes) {
+    hits = preRenderHits;
+    misses = preRenderMisses;
+    refreshes = preRenderCount;
+}
+
+// =============================================
+// RENDER BENCHMARK (DISP RENDER)
+// =============================================
+// Jalan di display task supaya tidak balapan dengan renderer. Tiap page
+// dirender penuh (canvas kosong) dan incremental (data sama), hasilnya
+// waktu min/avg/max dan hash frame untuk dicocokkan dengan DISP DUMP
+static void benchRenderPage(int page, bool incremental, uint32_t &minUs, uint32_t &avgUs, uint32_t &maxUs) {
+    uint32_t totalUs = 0;
+    minUs = UINT32_MAX;
+    maxUs = 0;
+    
+    if (incremental) {
+        clearCanvas();
+        renderPage(page, false);
+    }
+    
+    for (int i = 0; i < RENDER_BENCH_ITERATIONS; i++) {
+        if (!incremental) clearCanvas();
+        uint32_t startUs = micros();
+        renderPage(page, false);
+        uint32_t elapsedUs = micros() - startUs;
+        totalUs += elapsedUs;
+        if (elapsedUs < minUs) minUs = elapsedUs;
+        if (elapsedUs > maxUs) maxUs = elapsedUs;
+    }
+    avgUs = totalUs / RENDER_BENCH_ITERATIONS;
+}
+
+static void runRenderBenchmark() {
+    if (!displayInitialized) return;
+    
+    // Statistik widget tidak ikut terhitung
+    uint32_t savedFull = widgetFullRenders;
+    uint32_t savedIncremental = widgetIncrementalRenders;
+    uint32_t savedRedrawn = widgetsRedrawn;
+    uint32_t savedUnchanged = widgetsUnchanged;
+    uint32_t savedSparkFull = sparkFullRenders;
+    uint32_t savedSparkFullUs = sparkFullUs;
+    
+    serialPrintflnAlways("\n=== RENDER BENCH (%d iterations) ===", RENDER_BENCH_ITERATIONS);
+    serialPrintflnAlways("Page  full min/avg/max us   incr min/avg/max us   hash");
+    for (int page = 1; page <= PAGE_COUNT; page++) {
+        uint32_t fullMin, fullAvg, fullMax, incMin, incAvg, incMax;
+        benchRenderPage(page, false, fullMin, fullAvg, fullMax);
+        uint32_t hash = oledFrameHash(display.getBuffer());
+        benchRenderPage(page, true, incMin, incAvg, incMax);
+        serialPrintflnAlways("%d     %5lu/%5lu/%5lu     %5lu/%5lu/%5lu     %08lX", page,
+                             (unsigned long)fullMin, (unsigned long)fullAvg, (unsigned long)fullMax,
+                             (unsigned long)incMin, (unsigned long)incAvg, (unsigned long)incMax,
+                             (unsigned long)hash);
+    }
+    #ifdef ESP32
+    if (isChargingModeActive() && CHARGING_PAGE_ENABLED) {
+        serialPrintflnAlways("(charging lock aktif: semua page = LOCKED)");
+    }
+    #endif
+    serialPrintflnAlways("=============================");
+    
+    widgetFullRenders = savedFull;
+    widgetIncrementalRenders = savedIncremental;
+    widgetsRedrawn = savedRedrawn;
+    widgetsUnchanged = savedUnchanged;
+    sparkFullRenders = savedSparkFull;
+    sparkFullUs = savedSparkFullUs;
+    
+    // Back buffer berisi page terakhir bench: gambar ulang page aktif
+    invalidatePreRender();
+    clearCanvas();
+    oledBeginFrame();
+    renderPage(currentPage, true);
+    oledPresent();
+}
+
+// =============================================
+// PAGE CHANGE REQUEST (BUTTON / SERIAL)
+// =============================================
+bool requestPageChange(int page, uint32_t eventUs) {
+    #ifdef ESP32
+    if (isInAppMode()) {
+        return false;
+    }
     
-    display.display();
-    releaseI2C();
+    if (displayTaskHandle != NULL) {
+        sendDisplayCommand(DISPLAY_CMD_SHOW_PAGE, page, false, eventUs);
+        return true;
+    }
+    #endif
+    
+    return safeDisplayUpdate(page);
+}
+
+void printDisplayStats() {
+    serialPrintflnAlways("\n=== PAGE PRE-RENDER ===");
+    serialPrintflnAlways("Pre-rendered page: %d (%lu ms ago)", preRenderedPage,
+                         preRenderedPage ? millis() - preRenderedAt : 0UL);
+    serialPrintflnAlways("Press hits: %lu, misses: %lu, refreshes: %lu",
+                         (unsigned long)preRenderHits, (unsigned long)preRenderMisses,
+                         (unsigned long)preRenderCount);
+    serialPrintflnAlways("\n=== DISPLAY QUEUE ===");
+    printDisplayQueueStats();
+    printWidgetStats();
+    printSparkStats();
+    printOledStats();
 }
 
 void showSetupMode(bool blinkState) {
     if(!displayInitialized) return;
     resetDisplayState();
-    display.clearDisplay();
-    display.setFont(&FreeSansBold9pt7b);
+    clearCanvas();
+    display.setFont(&FreeSansBold9ptLabels);
     display.setTextColor(SSD1306_WHITE);
     
     int xPos = SETUP_MODE_POS_X;
     int yPos = SETUP_MODE_POS_Y;
     
     if(SETUP_MODE_POS_X == 0) {
-        int textWidth = strlen(SETUP_TEXT) * 10;
-        xPos = (SCREEN_WIDTH - textWidth) / 2;
+        xPos = setupX;
         yPos = 22;
     }
     
@@ -956,13 +1449,27 @@ void showSetupMode(bool blinkState) {
         display.print(SETUP_TEXT);
     }
     
-    display.display();
+    oledPresent();
 }
 
 bool isDisplayInitialized() {
     return displayInitialized;
 }
 
+// =============================================
+// MINUTE CHANGED (RTC EVENT)
+// =============================================
+// Jam hanya menampilkan HH:MM, jadi cukup digambar ulang saat menit berganti
+static void onClockMinuteChanged(const RTCDateTime &dt) {
+    if (preRenderedPage == 1) invalidatePreRender();
+    
+    if (isInAppMode()) {
+        sendDisplayCommand(DISPLAY_CMD_UPDATE_CLOCK);
+    } else if (currentPage == 1) {
+        sendDisplayCommand(DISPLAY_CMD_UPDATE_PAGE, currentPage);
+    }
+}
+
 // =============================================
 // INIT DISPLAY TASK
 // =============================================
@@ -970,6 +1477,11 @@ void initDisplayTask() {
     #ifdef ESP32
     if (!DISPLAY_TASK_ENABLED) return;
     
+    onRTCMinuteChanged(onClockMinuteChanged);
+    
+    // Double buffer + semaphore untuk flush task
+    initOledFlush();
+    
     // Create queue for display commands
     displayQueue = xQueueCreate(DISPLAY_QUEUE_SIZE, sizeof(DisplayCommand));
     
@@ -982,24 +1494,100 @@ void initDisplayTask() {
     #endif
 }
 
+// =============================================
+// COMMAND COALESCING & STATS
+// =============================================
+// UPDATE_PAGE / UPDATE_CLOCK tidak masuk queue: cukup satu flag pending,
+// permintaan berikutnya sebelum diproses hanya menimpa flag (coalesced)
+#ifdef ESP32
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+static bool pageUpdatePending = false;
+static int pendingUpdatePage = 1;
+static uint32_t pageUpdateQueuedUs = 0;
+static bool clockUpdatePending = false;
+static uint32_t clockUpdateQueuedUs = 0;
+
+static uint32_t queueDepthMax = 0;
+static uint32_t commandsCoalesced = 0;
+static uint32_t commandsDropped = 0;
+static uint32_t commandsPreempted = 0;
+static uint32_t commandsHandled = 0;
+
+static bool isUrgentCommand(DisplayCommandType type) {
+    return type == DISPLAY_CMD_SHOW_BLE_OFF || type == DISPLAY_CMD_RESET;
+}
+
+// Bangunkan display task (command baru atau mode berubah)
+void wakeDisplayTask() {
+    #ifdef ESP32
+    if (displayTaskHandle != NULL) {
+        xTaskNotifyGive(displayTaskHandle);
+    }
+    #endif
+}
+
 // =============================================
 // SEND COMMAND TO DISPLAY TASK
 // =============================================
-void sendDisplayCommand(DisplayCommandType type, int page, bool blinkState) {
+void sendDisplayCommand(DisplayCommandType type, int page, bool blinkState, uint32_t eventUs) {
     #ifdef ESP32
     if (displayQueue == NULL) return;
     
+    uint32_t nowUs = micros();
+    
+    if (type == DISPLAY_CMD_UPDATE_PAGE || type == DISPLAY_CMD_UPDATE_CLOCK) {
+        portENTER_CRITICAL(&pendingMux);
+        if (type == DISPLAY_CMD_UPDATE_PAGE) {
+            if (pageUpdatePending) {
+                commandsCoalesced++;
+            } else {
+                pageUpdateQueuedUs = nowUs;
+            }
+            pageUpdatePending = true;
+            pendingUpdatePage = page;
+        } else {
+            if (clockUpdatePending) {
+                commandsCoalesced++;
+            } else {
+                clockUpdateQueuedUs = nowUs;
+            }
+            clockUpdatePending = true;
+        }
+        portEXIT_CRITICAL(&pendingMux);
+        wakeDisplayTask();
+        return;
+    }
+    
     DisplayCommand cmd;
     cmd.type = type;
     cmd.page = page;
     cmd.blinkState = blinkState;
     cmd.timestamp = millis();
+    cmd.eventUs = eventUs;
+    cmd.queuedUs = nowUs ? nowUs : 1;
+    
+    BaseType_t sent;
+    if (isUrgentCommand(type)) {
+        // BLE OFF / reset langsung ke depan antrian
+        sent = xQueueSendToFront(displayQueue, &cmd, 0);
+        if (sent == pdTRUE && uxQueueMessagesWaiting(displayQueue) > 1) {
+            commandsPreempted++;
+        }
+    } else {
+        sent = xQueueSend(displayQueue, &cmd, 0);
+    }
     
-    // Try to send to queue, don't block if full
-    if (xQueueSend(displayQueue, &cmd, 0) != pdTRUE) {
+    if (sent != pdTRUE) {
         // Queue full, drop command
+        commandsDropped++;
         serialPrintfln("[DISPLAY] Queue full, dropping command %d", type);
+    } else {
+        uint32_t depth = uxQueueMessagesWaiting(displayQueue);
+        if (depth > queueDepthMax) queueDepthMax = depth;
     }
+    
+    wakeDisplayTask();
     #endif
 }
 
@@ -1009,18 +1597,38 @@ void sendDisplayCommand(DisplayCommandType type, int page, bool blinkState) {
 bool isDisplayTaskBusy() {
     #ifdef ESP32
     if (displayQueue == NULL) return false;
-    return (uxQueueMessagesWaiting(displayQueue) > 0);
+    return (uxQueueMessagesWaiting(displayQueue) > 0) || pageUpdatePending || clockUpdatePending;
     #else
     return false;
     #endif
 }
 
+void printDisplayQueueStats() {
+    #ifdef ESP32
+    uint32_t depth = displayQueue ? uxQueueMessagesWaiting(displayQueue) : 0;
+    serialPrintflnAlways("Queue depth: %lu now, %lu max (size %d)",
+                         (unsigned long)depth, (unsigned long)queueDepthMax, DISPLAY_QUEUE_SIZE);
+    serialPrintflnAlways("Commands: %lu handled, %lu coalesced, %lu preempted, %lu dropped",
+                         (unsigned long)commandsHandled, (unsigned long)commandsCoalesced,
+                         (unsigned long)commandsPreempted, (unsigned long)commandsDropped);
+    #endif
+}
+
+void resetDisplayQueueStats() {
+    queueDepthMax = 0;
+    commandsCoalesced = 0;
+    commandsDropped = 0;
+    commandsPreempted = 0;
+    commandsHandled = 0;
+}
+
 // =============================================
 // DISPLAY TASK FUNCTION - RUN ON CORE 1
 // =============================================
+// Task tidur sampai ada command (task notification) atau jadwal frame
+// berikutnya, tidak lagi polling queue tiap 100ms
 void displayTask(void *pvParameters) {
     #ifdef ESP32
-    TickType_t xLastWakeTime = xTaskGetTickCount();
     DisplayCommand cmd;
     unsigned long lastUpdateTime = 0;
     bool inAppMode = false;
@@ -1042,31 +1650,28 @@ void displayTask(void *pvParameters) {
     
     // Clear display once at start
     if (displayReady) {
-        if (safeI2COperationWithBackoff(I2C_MUTEX_TIMEOUT_MS)) {
-            display.clearDisplay();
-            display.display();
+        if (safeI2COperation(I2C_MUTEX_TIMEOUT_MS)) {
+            clearCanvas();
+            oledPresent();
             serialPrintflnAlways("[DISPLAY] Initial clear done");
         }
     }
     
     while (true) {
-        // Check for commands in queue (non-blocking)
-        if (xQueueReceive(displayQueue, &cmd, 0) == pdTRUE) {
-            // Process command
+        // Jam software: resync DS3231 bila jatuh tempo, picu event menit
+        rtcServiceTick();
+        
+        // Proses semua command di queue (urgent sudah di depan)
+        while (xQueueReceive(displayQueue, &cmd, 0) == pdTRUE) {
             if (!displayReady) continue;
             
+            commandsHandled++;
+            oledTagCommand(cmd.queuedUs);
+            
             switch (cmd.type) {
-                case DISPLAY_CMD_UPDATE_PAGE:
+                case DISPLAY_CMD_SHOW_PAGE:
                     if (!inAppMode && !showingBleOff) {
-                        safeI2COperationWithBackoff(I2C_MUTEX_TIMEOUT_MS);
-                        updateDisplay(cmd.page);
-                        lastUpdateTime = millis();
-                    }
-                    break;
-                    
-                case DISPLAY_CMD_UPDATE_CLOCK:
-                    if (inAppMode && !showingBleOff) {
-                        updateAppModeDisplay();
+                        showPageFromTask(cmd.page, cmd.eventUs);
                         lastUpdateTime = millis();
                     }
                     break;
@@ -1081,9 +1686,9 @@ void displayTask(void *pvParameters) {
                     
                 case DISPLAY_CMD_CLEAR:
                     if (!showingBleOff) {
-                        if (safeI2COperationWithBackoff(I2C_MUTEX_TIMEOUT_MS)) {
-                            display.clearDisplay();
-                            display.display();
+                        if (safeI2COperation(I2C_MUTEX_TIMEOUT_MS)) {
+                            clearCanvas();
+                            oledPresent();
                         }
                     }
                     break;
@@ -1096,15 +1701,65 @@ void displayTask(void *pvParameters) {
                     break;
                     
                 case DISPLAY_CMD_RESET:
-                    hardResetI2C();
+                    recoverI2CBus();
+                    break;
+                    
+                case DISPLAY_CMD_RENDER_BENCH:
+                    if (inAppMode || showingBleOff) {
+                        serialPrintflnAlways("ERROR - Render bench needs page mode");
+                    } else {
+                        runRenderBenchmark();
+                        lastUpdateTime = millis();
+                    }
                     break;
                     
                 default:
                     break;
             }
+            
+            // Frame tidak dibuat untuk command ini, jangan bawa tag ke frame lain
+            oledTagCommand(0);
         }
         
-        // Auto-update based on mode
+        // Ambil update yang sudah digabung
+        bool doPageUpdate, doClockUpdate;
+        int updatePage;
+        uint32_t pageQueuedUs, clockQueuedUs;
+        portENTER_CRITICAL(&pendingMux);
+        doPageUpdate = pageUpdatePending;
+        updatePage = pendingUpdatePage;
+        pageQueuedUs = pageUpdateQueuedUs;
+        doClockUpdate = clockUpdatePending;
+        clockQueuedUs = clockUpdateQueuedUs;
+        pageUpdatePending = false;
+        clockUpdatePending = false;
+        portEXIT_CRITICAL(&pendingMux);
+        
+        // Check for mode change (set by BLE, task dibangunkan lewat wakeDisplayTask)
+        if (!showingBleOff) {
+            inAppMode = isInAppMode();
+        }
+        
+        if (displayReady && !showingBleOff) {
+            if (doPageUpdate && !inAppMode) {
+                commandsHandled++;
+                oledTagCommand(pageQueuedUs ? pageQueuedUs : 1);
+                updateDisplay(updatePage);
+                oledTagCommand(0);
+                lastUpdateTime = millis();
+            }
+            if (doClockUpdate && inAppMode) {
+                commandsHandled++;
+                oledTagCommand(clockQueuedUs ? clockQueuedUs : 1);
+                updateAppModeDisplay();
+                oledTagCommand(0);
+                lastUpdateTime = millis();
+            }
+        }
+        
+        // Jadwal: hitung kapan frame berikutnya jatuh tempo
+        uint32_t waitMs = DISPLAY_UPDATE_INTERVAL_MS;
+        
         if (displayReady) {
             unsigned long now = millis();
             
@@ -1117,6 +1772,9 @@ void displayTask(void *pvParameters) {
                     if (!inAppMode) {
                         transitionFromAppModeToClock();
                     }
+                    lastUpdateTime = millis();
+                } else {
+                    waitMs = 3000 - (now - bleOffStartTime);
                 }
             } else {
                 uint32_t updateInterval = inAppMode ? DISPLAY_APP_MODE_UPDATE_MS : DISPLAY_UPDATE_INTERVAL_MS;
@@ -1125,20 +1783,31 @@ void displayTask(void *pvParameters) {
                     if (inAppMode) {
                         updateAppModeDisplay();
                     } else {
-                        safeI2COperationWithBackoff(I2C_MUTEX_TIMEOUT_MS);
-                        updateDisplay(currentPage);
+                        updateDisplay(currentPage);     // Probe bus sudah di dalam
                     }
                     lastUpdateTime = now;
                 }
+                
+                // Frame bisa lebih lama dari interval (slide, bus lambat): jangan wrap
+                unsigned long elapsed = millis() - lastUpdateTime;
+                waitMs = elapsed >= updateInterval ? 1 : updateInterval - elapsed;
+                
+                // Idle: siapkan page berikutnya di buffer off-screen
+                if (!inAppMode) {
+                    int nextPage = getNextPageInOrder(currentPage);
+                    if (nextPage != currentPage &&
+                        (nextPage != preRenderedPage || millis() - preRenderedAt >= PRERENDER_REFRESH_MS)) {
+                        refreshPreRender(nextPage);
+                    }
+                }
             }
         }
         
-        // Check for mode change (set by main loop via flag)
-        if (!showingBleOff) {
-            inAppMode = isInAppMode();
-        }
+        if (waitMs == 0) waitMs = 1;
         
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100)); // 100ms = 10Hz check
+        // Tidur sampai frame berikutnya atau sampai ada command
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
     }
     #endif
 }
+
@@ -3,9 +3,6 @@
 
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
-#include <Fonts/FreeSansBold18pt7b.h>
-#include <Fonts/FreeSansBold12pt7b.h>
-#include <Fonts/FreeSansBold9pt7b.h>
 #include "fox_config.h"
 
 // Basic display functions
@@ -27,18 +24,53 @@ void updateAnimation();
 void updateAnimationTargets();
 void resetAnimation();
 
-// Formatting functions
-String formatVoltage(float voltage);
-String formatCurrent(float current);
-String formatPower(float power);
-String removeTrailingZero(float value, int decimalPlaces);
+// Formatting functions - tulis ke buffer milik pemanggil, tanpa alokasi heap
+typedef struct {
+    uint8_t length;   // Jumlah karakter (tanpa '\0')
+    uint8_t width;    // Lebar pixel dengan font default pada textSize
+} TextExtent;
+
+TextExtent formatVoltage(char* buf, size_t size, float voltage, uint8_t textSize = 1);
+TextExtent formatCurrent(char* buf, size_t size, float current, uint8_t textSize = 1);
+TextExtent formatPower(char* buf, size_t size, float power, uint8_t textSize = 1);
+uint8_t removeTrailingZero(char* buf, size_t size, float value, int decimalPlaces);
+
+// =============================================
+// TEXT METRICS
+// =============================================
+// Font default Adafruit GFX: setiap karakter 5px + 1px spasi, dikali textSize.
+// Lebar tetap, jadi bisa dihitung saat compile untuk teks konstan.
+constexpr uint16_t textWidthDefaultFont(uint8_t length, uint8_t textSize) {
+    return (uint16_t)length * 6 * textSize;
+}
+
+constexpr uint8_t constTextLength(const char* text) {
+    return *text ? 1 + constTextLength(text + 1) : 0;
+}
+
+// Kolom spasi terakhir tidak ikut dihitung supaya tinta benar-benar di tengah
+constexpr int16_t centeredXDefaultFont(const char* text, uint8_t textSize = 1) {
+    return (SCREEN_WIDTH - ((int16_t)textWidthDefaultFont(constTextLength(text), textSize) - textSize)) / 2;
+}
+
+// Font GFX (proporsional): lebar tinta dari tabel glyph, sama dengan getTextBounds()
+typedef struct {
+    int16_t left;     // Offset tinta pertama dari cursor
+    uint16_t width;   // Lebar tinta (pixel)
+} FontTextExtent;
+
+FontTextExtent fontTextExtent(const GFXfont* font, const char* text);
+int16_t centeredXFont(const GFXfont* font, const char* text);
+
+// Heap probe: jumlah frame yang mengubah jumlah blok heap
+void getDisplayHeapStats(uint32_t &frames, uint32_t &framesWithAlloc, int32_t &lastDelta);
+
+// Pre-render: tombol yang memakai salinan off-screen (hit) / render ulang (miss)
+void getPreRenderStats(uint32_t &hits, uint32_t &misses, uint32_t &refreshes);
 
 // I2C Safety & Recovery
 bool safeI2COperation(uint32_t timeoutMs);
-void releaseI2C();
 void recoverI2CBus();
-bool safeI2COperationWithBackoff(uint32_t timeoutMs);
-void hardResetI2C();
 
 // Display status
 extern bool displayReady;
@@ -49,8 +81,15 @@ bool isChargingPageDisplayed();
 
 // DISPLAY TASK FUNCTIONS
 void initDisplayTask();
-void sendDisplayCommand(DisplayCommandType type, int page = 0, bool blinkState = false);
+void sendDisplayCommand(DisplayCommandType type, int page = 0, bool blinkState = false, uint32_t eventUs = 0);
 bool isDisplayTaskBusy();
+void wakeDisplayTask();
+void printDisplayQueueStats();
+void resetDisplayQueueStats();
+
+// Ganti page lewat display task (pakai pre-render page berikutnya)
+bool requestPageChange(int page, uint32_t eventUs = 0);
+void printDisplayStats();
 
 // Display State
 extern bool appModeDisplayActive;
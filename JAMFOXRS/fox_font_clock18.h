@@ -0,0 +1,94 @@
+// Dibuat oleh host/tools/fontconvert dari GNU FreeFont FreeSansBold 18pt (FreeSansBold18ptClock)
+// Subset: "0123456789:"
+#ifndef FREESANSBOLD18PTCLOCK_H
+#define FREESANSBOLD18PTCLOCK_H
+
+#include <Adafruit_GFX.h>
+#include "fox_fonts.h"
+
+const uint8_t FreeSansBold18ptClockBitmaps[] PROGMEM = {
+  0x03, 0xF0, 0x07, 0xFC, 0x07, 0xFF, 0x07, 0xFF, 0xC7, 0xE3, 0xF3, 0xE0,
+  0xF9, 0xF0, 0x7D, 0xF0, 0x1F, 0xF8, 0x0F, 0xFC, 0x07, 0xFE, 0x03, 0xFF,
+  0x01, 0xFF, 0x80, 0xFF, 0xC0, 0x7F, 0xE0, 0x3F, 0xF0, 0x1F, 0xF8, 0x0F,
+  0xFC, 0x07, 0xFE, 0x03, 0xEF, 0x83, 0xE7, 0xC1, 0xF3, 0xF1, 0xF8, 0xFF,
+  0xF8, 0x3F, 0xF8, 0x0F, 0xF8, 0x03, 0xF0, 0x00, 0x01, 0xE0, 0x3C, 0x0F,
+  0x83, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0xE0, 0x7C, 0x0F, 0x81,
+  0xF0, 0x3E, 0x07, 0xC0, 0xF8, 0x1F, 0x03, 0xE0, 0x7C, 0x0F, 0x81, 0xF0,
+  0x3E, 0x07, 0xC0, 0xF8, 0x1F, 0x03, 0xE0, 0x07, 0xF0, 0x0F, 0xFE, 0x0F,
+  0xFF, 0x8F, 0xFF, 0xE7, 0xE3, 0xF7, 0xE0, 0xFF, 0xE0, 0x3F, 0xF0, 0x1F,
+  0xF8, 0x0F, 0x80, 0x07, 0xC0, 0x07, 0xE0, 0x03, 0xE0, 0x03, 0xF0, 0x07,
+  0xF0, 0x07, 0xF0, 0x07, 0xE0, 0x0F, 0xE0, 0x0F, 0xE0, 0x0F, 0xC0, 0x0F,
+  0xC0, 0x07, 0xE0, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x80, 0x07, 0xF0, 0x0F, 0xFC, 0x0F, 0xFF, 0x8F, 0xFF, 0xCF, 0xC3, 0xF7,
+  0xC0, 0xFB, 0xE0, 0x7D, 0xF0, 0x3E, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x1F,
+  0x80, 0x7F, 0x00, 0x3F, 0xC0, 0x1F, 0xF0, 0x01, 0xFC, 0x00, 0x3F, 0x00,
+  0x0F, 0x80, 0x07, 0xFE, 0x03, 0xFF, 0x01, 0xFF, 0x81, 0xFF, 0xE1, 0xF9,
+  0xFF, 0xFC, 0x7F, 0xFC, 0x1F, 0xFC, 0x03, 0xF8, 0x00, 0x00, 0x7E, 0x00,
+  0x3F, 0x80, 0x0F, 0xE0, 0x07, 0xF8, 0x03, 0xFE, 0x00, 0xEF, 0x80, 0x7B,
+  0xE0, 0x1C, 0xF8, 0x0E, 0x3E, 0x07, 0x8F, 0x81, 0xC3, 0xE0, 0xF0, 0xF8,
+  0x78, 0x3E, 0x1C, 0x0F, 0x8F, 0x03, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0xF8, 0x00, 0x3E, 0x00, 0x0F, 0x80, 0x03,
+  0xE0, 0x00, 0xF8, 0x00, 0x3E, 0x00, 0x3F, 0xFF, 0x1F, 0xFF, 0x8F, 0xFF,
+  0xC7, 0xFF, 0xE3, 0xC0, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0x79,
+  0xF0, 0x3F, 0xFE, 0x1F, 0xFF, 0x8F, 0xFF, 0xE7, 0xC3, 0xF7, 0xC0, 0xFC,
+  0x00, 0x3E, 0x00, 0x1F, 0x00, 0x0F, 0x80, 0x07, 0xC0, 0x03, 0xFF, 0x01,
+  0xFF, 0x81, 0xF7, 0xE1, 0xF9, 0xFF, 0xF8, 0xFF, 0xF8, 0x3F, 0xF8, 0x07,
+  0xF0, 0x00, 0x03, 0xF0, 0x03, 0xFF, 0x01, 0xFF, 0xE0, 0xFF, 0xFC, 0x3E,
+  0x1F, 0x1F, 0x03, 0xE7, 0xC0, 0x01, 0xE0, 0x00, 0xF8, 0x00, 0x3E, 0x7E,
+  0x0F, 0xBF, 0xE3, 0xFF, 0xFC, 0xFF, 0xFF, 0xBF, 0x87, 0xEF, 0xC0, 0xFF,
+  0xE0, 0x1F, 0xF8, 0x07, 0xFE, 0x01, 0xFF, 0x80, 0x7D, 0xE0, 0x1F, 0x7C,
+  0x0F, 0x9F, 0x87, 0xE3, 0xFF, 0xF0, 0x7F, 0xFC, 0x0F, 0xFC, 0x00, 0xFC,
+  0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x0F,
+  0x80, 0x07, 0xC0, 0x01, 0xF0, 0x00, 0xF8, 0x00, 0x7C, 0x00, 0x1F, 0x00,
+  0x0F, 0x80, 0x07, 0xC0, 0x01, 0xF0, 0x00, 0x78, 0x00, 0x3E, 0x00, 0x0F,
+  0x80, 0x07, 0xC0, 0x01, 0xF0, 0x00, 0x7C, 0x00, 0x1E, 0x00, 0x0F, 0x80,
+  0x03, 0xE0, 0x00, 0xF8, 0x00, 0x3E, 0x00, 0x0F, 0x80, 0x00, 0x03, 0xE0,
+  0x03, 0xFE, 0x03, 0xFF, 0xC0, 0xFF, 0xF8, 0x7E, 0x3F, 0x1F, 0x07, 0xC7,
+  0x80, 0xF1, 0xE0, 0x3C, 0x78, 0x0F, 0x0F, 0x07, 0x83, 0xE3, 0xE0, 0x3F,
+  0xE0, 0x1F, 0xFC, 0x0F, 0xFF, 0x87, 0xE1, 0xF3, 0xF0, 0x3E, 0xF8, 0x07,
+  0xFE, 0x01, 0xFF, 0x80, 0x7F, 0xE0, 0x1F, 0xFC, 0x0F, 0xDF, 0x87, 0xE7,
+  0xFF, 0xF8, 0xFF, 0xFC, 0x1F, 0xFE, 0x00, 0xFE, 0x00, 0x07, 0xE0, 0x0F,
+  0xFC, 0x0F, 0xFF, 0x0F, 0xFF, 0xC7, 0xE1, 0xF7, 0xE0, 0x7B, 0xE0, 0x3F,
+  0xF0, 0x1F, 0xF8, 0x0F, 0xFC, 0x07, 0xFE, 0x03, 0xFF, 0x81, 0xF7, 0xE1,
+  0xFB, 0xFF, 0xFC, 0xFF, 0xFE, 0x3F, 0xDF, 0x07, 0xCF, 0x80, 0x07, 0xC0,
+  0x03, 0xE0, 0x03, 0xEF, 0x81, 0xF3, 0xE1, 0xF9, 0xFF, 0xF8, 0x7F, 0xF8,
+  0x1F, 0xF8, 0x03, 0xF0, 0x00, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x7F, 0xFF, 0xFF, 0xC0 };
+
+const GFXglyph FreeSansBold18ptClockGlyphs[] PROGMEM = {
+  {     0,  17,  26,  20,    1,  -25 },   // 0x30 '0'
+  {    56,  11,  25,  20,    2,  -24 },   // 0x31 '1'
+  {    91,  17,  25,  20,    1,  -24 },   // 0x32 '2'
+  {   145,  17,  26,  20,    1,  -25 },   // 0x33 '3'
+  {   201,  18,  25,  20,    1,  -24 },   // 0x34 '4'
+  {   258,  17,  26,  20,    1,  -25 },   // 0x35 '5'
+  {   314,  18,  26,  20,    1,  -25 },   // 0x36 '6'
+  {   373,  18,  25,  20,    1,  -24 },   // 0x37 '7'
+  {   430,  18,  26,  20,    1,  -25 },   // 0x38 '8'
+  {   489,  17,  26,  20,    1,  -24 },   // 0x39 '9'
+  {   545,   5,  18,  12,    4,  -17 }    // 0x3A ':'
+};
+
+const GFXfont FreeSansBold18ptClock PROGMEM = {
+  (uint8_t  *)FreeSansBold18ptClockBitmaps,
+  (GFXglyph *)FreeSansBold18ptClockGlyphs,
+  0x30, 0x3A, 38 };
+
+// Lebar tinta, advance, xOffset per glyph untuk posisi teks saat compile
+constexpr FontGlyphMetric FreeSansBold18ptClockMetrics[] = {
+  {  17,  20,    1 },   // 0x30 '0'
+  {  11,  20,    2 },   // 0x31 '1'
+  {  17,  20,    1 },   // 0x32 '2'
+  {  17,  20,    1 },   // 0x33 '3'
+  {  18,  20,    1 },   // 0x34 '4'
+  {  17,  20,    1 },   // 0x35 '5'
+  {  18,  20,    1 },   // 0x36 '6'
+  {  18,  20,    1 },   // 0x37 '7'
+  {  18,  20,    1 },   // 0x38 '8'
+  {  17,  20,    1 },   // 0x39 '9'
+  {   5,  12,    4 }    // 0x3A ':'
+};
+
+constexpr FontMetrics FreeSansBold18ptClockLayout = {FreeSansBold18ptClockMetrics, 0x30, 0x3A};
+
+#endif
@@ -0,0 +1,72 @@
+// Dibuat oleh host/tools/fontconvert dari GNU FreeFont FreeSansBold 12pt (FreeSansBold12ptLabels)
+// Subset: "LNOPRTY"
+#ifndef FREESANSBOLD12PTLABELS_H
+#define FREESANSBOLD12PTLABELS_H
+
+#include <Adafruit_GFX.h>
+#include "fox_fonts.h"
+
+const uint8_t FreeSansBold12ptLabelsBitmaps[] PROGMEM = {
+  0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00,
+  0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF0, 0xF0, 0x1F, 0xF0, 0x3F, 0xE0, 0x7F, 0xE0, 0xFF, 0xE1, 0xFF,
+  0xC3, 0xFD, 0xC7, 0xFB, 0x8F, 0xF3, 0x9F, 0xE3, 0xBF, 0xC7, 0x7F, 0x87,
+  0xFF, 0x0F, 0xFE, 0x0F, 0xFC, 0x0F, 0xF8, 0x1F, 0xF0, 0x1E, 0x07, 0xF0,
+  0x0F, 0xFE, 0x0F, 0xFF, 0x8F, 0x83, 0xE7, 0x80, 0xF7, 0xC0, 0x7F, 0xC0,
+  0x1F, 0xE0, 0x0F, 0xF0, 0x07, 0xF8, 0x03, 0xFC, 0x01, 0xFF, 0x01, 0xF7,
+  0x80, 0xF3, 0xE0, 0xF8, 0xFF, 0xF8, 0x3F, 0xF8, 0x07, 0xF0, 0x00, 0xFF,
+  0xE3, 0xFF, 0xEF, 0xFF, 0xBC, 0x1F, 0xF0, 0x3F, 0xC0, 0xFF, 0x03, 0xFC,
+  0x1F, 0xFF, 0xFB, 0xFF, 0xCF, 0xFE, 0x3C, 0x00, 0xF0, 0x03, 0xC0, 0x0F,
+  0x00, 0x3C, 0x00, 0xF0, 0x00, 0xFF, 0xF9, 0xFF, 0xFB, 0xFF, 0xFF, 0x81,
+  0xFF, 0x01, 0xFE, 0x03, 0xFC, 0x0F, 0xFF, 0xFE, 0xFF, 0xF9, 0xFF, 0xF3,
+  0xC0, 0xF7, 0x81, 0xEF, 0x03, 0xDE, 0x07, 0xBC, 0x0F, 0x78, 0x1E, 0xF0,
+  0x1E, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC1, 0xE0, 0x07, 0x80, 0x1E, 0x00,
+  0x78, 0x01, 0xE0, 0x07, 0x80, 0x1E, 0x00, 0x78, 0x01, 0xE0, 0x07, 0x80,
+  0x1E, 0x00, 0x78, 0x01, 0xE0, 0x07, 0x80, 0xF0, 0x1E, 0xF0, 0x3C, 0xE0,
+  0xF1, 0xE1, 0xE1, 0xC7, 0x83, 0xCF, 0x03, 0xBC, 0x07, 0xF8, 0x07, 0xE0,
+  0x0F, 0xC0, 0x0F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0x00, 0xF0, 0x01,
+  0xE0, 0x03, 0xC0 };
+
+const GFXglyph FreeSansBold12ptLabelsGlyphs[] PROGMEM = {
+  {     0,  12,  17,  14,    2,  -16 },   // 0x4C 'L'
+  {    26,   0,   0,   0,    0,    0 },   // 0x4D 'M'
+  {    26,  15,  17,  17,    2,  -16 },   // 0x4E 'N'
+  {    58,  17,  17,  18,    1,  -16 },   // 0x4F 'O'
+  {    95,  14,  17,  16,    2,  -16 },   // 0x50 'P'
+  {   125,   0,   0,   0,    0,    0 },   // 0x51 'Q'
+  {   125,  15,  17,  17,    2,  -16 },   // 0x52 'R'
+  {   157,   0,   0,   0,    0,    0 },   // 0x53 'S'
+  {   157,  14,  17,  14,    1,  -16 },   // 0x54 'T'
+  {   187,   0,   0,   0,    0,    0 },   // 0x55 'U'
+  {   187,   0,   0,   0,    0,    0 },   // 0x56 'V'
+  {   187,   0,   0,   0,    0,    0 },   // 0x57 'W'
+  {   187,   0,   0,   0,    0,    0 },   // 0x58 'X'
+  {   187,  15,  17,  16,    0,  -16 }    // 0x59 'Y'
+};
+
+const GFXfont FreeSansBold12ptLabels PROGMEM = {
+  (uint8_t  *)FreeSansBold12ptLabelsBitmaps,
+  (GFXglyph *)FreeSansBold12ptLabelsGlyphs,
+  0x4C, 0x59, 26 };
+
+// Lebar tinta, advance, xOffset per glyph untuk posisi teks saat compile
+constexpr FontGlyphMetric FreeSansBold12ptLabelsMetrics[] = {
+  {  12,  14,    2 },   // 0x4C 'L'
+  {   0,   0,    0 },   // 0x4D 'M'
+  {  15,  17,    2 },   // 0x4E 'N'
+  {  17,  18,    1 },   // 0x4F 'O'
+  {  14,  16,    2 },   // 0x50 'P'
+  {   0,   0,    0 },   // 0x51 'Q'
+  {  15,  17,    2 },   // 0x52 'R'
+  {   0,   0,    0 },   // 0x53 'S'
+  {  14,  14,    1 },   // 0x54 'T'
+  {   0,   0,    0 },   // 0x55 'U'
+  {   0,   0,    0 },   // 0x56 'V'
+  {   0,   0,    0 },   // 0x57 'W'
+  {   0,   0,    0 },   // 0x58 'X'
+  {  15,  16,    0 }    // 0x59 'Y'
+};
+
+constexpr FontMetrics FreeSansBold12ptLabelsLayout = {FreeSansBold12ptLabelsMetrics, 0x4C, 0x59};
+
+#endif
@@ -0,0 +1,164 @@
+// Dibuat oleh host/tools/fontconvert dari GNU FreeFont FreeSansBold 9pt (FreeSansBold9ptLabels)
+// Subset: " ABDEFLMNOPRSTUY"
+#ifndef FREESANSBOLD9PTLABELS_H
+#define FREESANSBOLD9PTLABELS_H
+
+#include <Adafruit_GFX.h>
+#include "fox_fonts.h"
+
+const uint8_t FreeSansBold9ptLabelsBitmaps[] PROGMEM = {
+  0x07, 0x00, 0xF0, 0x0F, 0x80, 0xD8, 0x1D, 0x81, 0xDC, 0x18, 0xC3, 0x8E,
+  0x3F, 0xE3, 0xFE, 0x70, 0x77, 0x07, 0xE0, 0x30, 0xFF, 0x9F, 0xFB, 0x87,
+  0xF0, 0x7E, 0x0F, 0xC1, 0xBF, 0xF7, 0xFF, 0xE0, 0xFC, 0x1F, 0x83, 0xFF,
+  0xEF, 0xF8, 0xFF, 0x1F, 0xF3, 0x87, 0x70, 0x7E, 0x0F, 0xC1, 0xF8, 0x3F,
+  0x07, 0xE0, 0xFC, 0x1F, 0x87, 0x7F, 0xCF, 0xF0, 0xFF, 0xFF, 0xFE, 0x03,
+  0x80, 0xE0, 0x38, 0x0F, 0xFB, 0xFE, 0xE0, 0x38, 0x0E, 0x03, 0xFF, 0xFF,
+  0xC0, 0xFF, 0xFF, 0xF8, 0x1C, 0x0E, 0x07, 0xFF, 0xFF, 0xC0, 0xE0, 0x70,
+  0x38, 0x1C, 0x0E, 0x00, 0xE0, 0x70, 0x38, 0x1C, 0x0E, 0x07, 0x03, 0x81,
+  0xC0, 0xE0, 0x70, 0x38, 0x1F, 0xFF, 0xF8, 0xF0, 0x7F, 0x83, 0xFE, 0x3F,
+  0xF1, 0xFF, 0x8F, 0xF4, 0x5F, 0xB6, 0xFD, 0xB7, 0xED, 0xBF, 0x6D, 0xF9,
+  0xCF, 0xCE, 0x7E, 0x73, 0x80, 0xE0, 0xFE, 0x1F, 0xC3, 0xFC, 0x7F, 0x8F,
+  0xD9, 0xFB, 0xBF, 0x37, 0xE7, 0xFC, 0x7F, 0x87, 0xF0, 0xFE, 0x0E, 0x0F,
+  0x81, 0xFF, 0x1E, 0x3C, 0xE0, 0xEE, 0x03, 0xF0, 0x1F, 0x80, 0xFC, 0x07,
+  0xE0, 0x3B, 0x83, 0x9E, 0x3C, 0x7F, 0xC0, 0xF8, 0x00, 0xFF, 0x9F, 0xFB,
+  0x87, 0xF0, 0x7E, 0x0F, 0xC3, 0xFF, 0xF7, 0xFC, 0xE0, 0x1C, 0x03, 0x80,
+  0x70, 0x0E, 0x00, 0xFF, 0x9F, 0xFB, 0x83, 0xF0, 0x7E, 0x0F, 0xC1, 0xBF,
+  0xE7, 0xFE, 0xE1, 0xDC, 0x1B, 0x83, 0xF0, 0x7E, 0x0E, 0x1F, 0x0F, 0xFB,
+  0x87, 0x70, 0x6E, 0x01, 0xFC, 0x0F, 0xF0, 0x3F, 0x00, 0xFC, 0x1F, 0x87,
+  0xBF, 0xE3, 0xF0, 0xFF, 0xFF, 0xFC, 0x38, 0x07, 0x00, 0xE0, 0x1C, 0x03,
+  0x80, 0x70, 0x0E, 0x01, 0xC0, 0x38, 0x07, 0x00, 0xE0, 0xE0, 0xFC, 0x1F,
+  0x83, 0xF0, 0x7E, 0x0F, 0xC1, 0xF8, 0x3F, 0x07, 0xE0, 0xFC, 0x1F, 0xC7,
+  0xBF, 0xE1, 0xF0, 0xE0, 0xEC, 0x39, 0xC7, 0x19, 0xC3, 0xB8, 0x36, 0x07,
+  0xC0, 0x70, 0x0E, 0x01, 0xC0, 0x38, 0x07, 0x00, 0xE0 };
+
+const GFXglyph FreeSansBold9ptLabelsGlyphs[] PROGMEM = {
+  {     0,   0,   0,   5,    0,    1 },   // 0x20 ' '
+  {     0,   0,   0,   0,    0,    0 },   // 0x21 '!'
+  {     0,   0,   0,   0,    0,    0 },   // 0x22 '"'
+  {     0,   0,   0,   0,    0,    0 },   // 0x23 '#'
+  {     0,   0,   0,   0,    0,    0 },   // 0x24 '$'
+  {     0,   0,   0,   0,    0,    0 },   // 0x25 '%'
+  {     0,   0,   0,   0,    0,    0 },   // 0x26 '&'
+  {     0,   0,   0,   0,    0,    0 },   // 0x27 '''
+  {     0,   0,   0,   0,    0,    0 },   // 0x28 '('
+  {     0,   0,   0,   0,    0,    0 },   // 0x29 ')'
+  {     0,   0,   0,   0,    0,    0 },   // 0x2A '*'
+  {     0,   0,   0,   0,    0,    0 },   // 0x2B '+'
+  {     0,   0,   0,   0,    0,    0 },   // 0x2C ','
+  {     0,   0,   0,   0,    0,    0 },   // 0x2D '-'
+  {     0,   0,   0,   0,    0,    0 },   // 0x2E '.'
+  {     0,   0,   0,   0,    0,    0 },   // 0x2F '/'
+  {     0,   0,   0,   0,    0,    0 },   // 0x30 '0'
+  {     0,   0,   0,   0,    0,    0 },   // 0x31 '1'
+  {     0,   0,   0,   0,    0,    0 },   // 0x32 '2'
+  {     0,   0,   0,   0,    0,    0 },   // 0x33 '3'
+  {     0,   0,   0,   0,    0,    0 },   // 0x34 '4'
+  {     0,   0,   0,   0,    0,    0 },   // 0x35 '5'
+  {     0,   0,   0,   0,    0,    0 },   // 0x36 '6'
+  {     0,   0,   0,   0,    0,    0 },   // 0x37 '7'
+  {     0,   0,   0,   0,    0,    0 },   // 0x38 '8'
+  {     0,   0,   0,   0,    0,    0 },   // 0x39 '9'
+  {     0,   0,   0,   0,    0,    0 },   // 0x3A ':'
+  {     0,   0,   0,   0,    0,    0 },   // 0x3B ';'
+  {     0,   0,   0,   0,    0,    0 },   // 0x3C '<'
+  {     0,   0,   0,   0,    0,    0 },   // 0x3D '='
+  {     0,   0,   0,   0,    0,    0 },   // 0x3E '>'
+  {     0,   0,   0,   0,    0,    0 },   // 0x3F '?'
+  {     0,   0,   0,   0,    0,    0 },   // 0x40 '@'
+  {     0,  12,  13,  13,    0,  -12 },   // 0x41 'A'
+  {    20,  11,  13,  13,    1,  -12 },   // 0x42 'B'
+  {    38,   0,   0,   0,    0,    0 },   // 0x43 'C'
+  {    38,  11,  13,  13,    1,  -12 },   // 0x44 'D'
+  {    56,  10,  13,  12,    1,  -12 },   // 0x45 'E'
+  {    73,   9,  13,  11,    1,  -12 },   // 0x46 'F'
+  {    88,   0,   0,   0,    0,    0 },   // 0x47 'G'
+  {    88,   0,   0,   0,    0,    0 },   // 0x48 'H'
+  {    88,   0,   0,   0,    0,    0 },   // 0x49 'I'
+  {    88,   0,   0,   0,    0,    0 },   // 0x4A 'J'
+  {    88,   0,   0,   0,    0,    0 },   // 0x4B 'K'
+  {    88,   9,  13,  11,    1,  -12 },   // 0x4C 'L'
+  {   103,  13,  13,  15,    1,  -12 },   // 0x4D 'M'
+  {   125,  11,  13,  13,    1,  -12 },   // 0x4E 'N'
+  {   143,  13,  13,  14,    1,  -12 },   // 0x4F 'O'
+  {   165,  11,  13,  12,    1,  -12 },   // 0x50 'P'
+  {   183,   0,   0,   0,    0,    0 },   // 0x51 'Q'
+  {   183,  11,  13,  13,    1,  -12 },   // 0x52 'R'
+  {   201,  11,  13,  12,    1,  -12 },   // 0x53 'S'
+  {   219,  11,  13,  11,    0,  -12 },   // 0x54 'T'
+  {   237,  11,  13,  13,    1,  -12 },   // 0x55 'U'
+  {   255,   0,   0,   0,    0,    0 },   // 0x56 'V'
+  {   255,   0,   0,   0,    0,    0 },   // 0x57 'W'
+  {   255,   0,   0,   0,    0,    0 },   // 0x58 'X'
+  {   255,  11,  13,  12,    1,  -12 }    // 0x59 'Y'
+};
+
+const GFXfont FreeSansBold9ptLabels PROGMEM = {
+  (uint8_t  *)FreeSansBold9ptLabelsBitmaps,
+  (GFXglyph *)FreeSansBold9ptLabelsGlyphs,
+  0x20, 0x59, 19 };
+
+// Lebar tinta, advance, xOffset per glyph untuk posisi teks saat compile
+constexpr FontGlyphMetric FreeSansBold9ptLabelsMetrics[] = {
+  {   0,   5,    0 },   // 0x20 ' '
+  {   0,   0,    0 },   // 0x21 '!'
+  {   0,   0,    0 },   // 0x22 '"'
+  {   0,   0,    0 },   // 0x23 '#'
+  {   0,   0,    0 },   // 0x24 '$'
+  {   0,   0,    0 },   // 0x25 '%'
+  {   0,   0,    0 },   // 0x26 '&'
+  {   0,   0,    0 },   // 0x27 '''
+  {   0,   0,    0 },   // 0x28 '('
+  {   0,   0,    0 },   // 0x29 ')'
+  {   0,   0,    0 },   // 0x2A '*'
+  {   0,   0,    0 },   // 0x2B '+'
+  {   0,   0,    0 },   // 0x2C ','
+  {   0,   0,    0 },   // 0x2D '-'
+  {   0,   0,    0 },   // 0x2E '.'
+  {   0,   0,    0 },   // 0x2F '/'
+  {   0,   0,    0 },   // 0x30 '0'
+  {   0,   0,    0 },   // 0x31 '1'
+  {   0,   0,    0 },   // 0x32 '2'
+  {   0,   0,    0 },   // 0x33 '3'
+  {   0,   0,    0 },   // 0x34 '4'
+  {   0,   0,    0 },   // 0x35 '5'
+  {   0,   0,    0 },   // 0x36 '6'
+  {   0,   0,    0 },   // 0x37 '7'
+  {   0,   0,    0 },   // 0x38 '8'
+  {   0,   0,    0 },   // 0x39 '9'
+  {   0,   0,    0 },   // 0x3A ':'
+  {   0,   0,    0 },   // 0x3B ';'
+  {   0,   0,    0 },   // 0x3C '<'
+  {   0,   0,    0 },   // 0x3D '='
+  {   0,   0,    0 },   // 0x3E '>'
+  {   0,   0,    0 },   // 0x3F '?'
+  {   0,   0,    0 },   // 0x40 '@'
+  {  12,  13,    0 },   // 0x41 'A'
+  {  11,  13,    1 },   // 0x42 'B'
+  {   0,   0,    0 },   // 0x43 'C'
+  {  11,  13,    1 },   // 0x44 'D'
+  {  10,  12,    1 },   // 0x45 'E'
+  {   9,  11,    1 },   // 0x46 'F'
+  {   0,   0,    0 },   // 0x47 'G'
+  {   0,   0,    0 },   // 0x48 'H'
+  {   0,   0,    0 },   // 0x49 'I'
+  {   0,   0,    0 },   // 0x4A 'J'
+  {   0,   0,    0 },   // 0x4B 'K'
+  {   9,  11,    1 },   // 0x4C 'L'
+  {  13,  15,    1 },   // 0x4D 'M'
+  {  11,  13,    1 },   // 0x4E 'N'
+  {  13,  14,    1 },   // 0x4F 'O'
+  {  11,  12,    1 },   // 0x50 'P'
+  {   0,   0,    0 },   // 0x51 'Q'
+  {  11,  13,    1 },   // 0x52 'R'
+  {  11,  12,    1 },   // 0x53 'S'
+  {  11,  11,    0 },   // 0x54 'T'
+  {  11,  13,    1 },   // 0x55 'U'
+  {   0,   0,    0 },   // 0x56 'V'
+  {   0,   0,    0 },   // 0x57 'W'
+  {   0,   0,    0 },   // 0x58 'X'
+  {  11,  12,    1 }    // 0x59 'Y'
+};
+
+constexpr FontMetrics FreeSansBold9ptLabelsLayout = {FreeSansBold9ptLabelsMetrics, 0x20, 0x59};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef FOX_FONTS_H
+#define FOX_FONTS_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// METRIK FONT SUBSET (COMPILE TIME)
+// =============================================
+// Header fox_font_*.h dibuat host/tools/fontconvert dengan daftar karakter:
+// hanya glyph label / jam yang ikut ke flash. Selain GFXfont, tiap header
+// membawa salinan constexpr lebar tinta, advance, dan xOffset per glyph
+// supaya posisi label konstan dihitung compiler, bukan saat init.
+typedef struct {
+    uint8_t width;      // Lebar tinta (0 = tanpa tinta / di luar subset)
+    uint8_t xAdvance;   // Geser cursor
+    int8_t xOffset;     // Tinta pertama dari cursor
+} FontGlyphMetric;
+
+typedef struct {
+    const FontGlyphMetric* metrics;
+    uint8_t first;
+    uint8_t last;
+} FontMetrics;
+
+constexpr int16_t constMin(int16_t a, int16_t b) {
+    return a < b ? a : b;
+}
+
+constexpr int16_t constMax(int16_t a, int16_t b) {
+    return a > b ? a : b;
+}
+
+constexpr bool fontInRange(const FontMetrics& f, char c) {
+    return (uint8_t)c >= f.first && (uint8_t)c <= f.last;
+}
+
+constexpr const FontGlyphMetric& fontGlyph(const FontMetrics& f, char c) {
+    return f.metrics[(uint8_t)c - f.first];
+}
+
+// Sama dengan drawChar(): karakter di luar first..last dilewati tanpa geser
+constexpr int16_t fontAdvance(const FontMetrics& f, char c) {
+    return fontInRange(f, c) ? fontGlyph(f, c).xAdvance : 0;
+}
+
+constexpr bool fontInk(const FontMetrics& f, char c) {
+    return fontInRange(f, c) && fontGlyph(f, c).width > 0;
+}
+
+// Kolom tinta paling kiri / kanan dari cursor (INT16_MAX / INT16_MIN = kosong)
+constexpr int16_t fontInkLeft(const FontMetrics& f, const char* text, int16_t cursor = 0) {
+    return *text == '\0' ? INT16_MAX
+        : constMin(fontInk(f, *text) ? (int16_t)(cursor + fontGlyph(f, *text).xOffset) : INT16_MAX,
+                   fontInkLeft(f, text + 1, cursor + fontAdvance(f, *text)));
+}
+
+constexpr int16_t fontInkRight(const FontMetrics& f, const char* text, int16_t cursor = 0) {
+    return *text == '\0' ? INT16_MIN
+        : constMax(fontInk(f, *text) ? (int16_t)(cursor + fontGlyph(f, *text).xOffset + fontGlyph(f, *text).width - 1) : INT16_MIN,
+                   fontInkRight(f, text + 1, cursor + fontAdvance(f, *text)));
+}
+
+// Semua karakter teks punya glyph di subset (spasi cukup punya advance)
+constexpr bool fontCovers(const FontMetrics& f, const char* text) {
+    return *text == '\0' ? true
+        : fontInRange(f, *text) && (*text == ' ' || fontGlyph(f, *text).width > 0) && fontCovers(f, text + 1);
+}
+
+// Hasil sama dengan centeredXFont() pada GFXfont yang sama
+constexpr int16_t constCenteredXFont(const FontMetrics& f, const char* text) {
+    return fontInkRight(f, text) < fontInkLeft(f, text) ? SCREEN_WIDTH / 2
+        : (SCREEN_WIDTH - (fontInkRight(f, text) - fontInkLeft(f, text) + 1)) / 2 - fontInkLeft(f, text);
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "fox_history.h"
+#include "fox_config.h"
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#endif
+
+// =============================================
+// STATE
+// =============================================
+static int16_t samples[SPARK_HISTORY_LEN];
+static uint32_t headSeq = 0;
+
+// Akumulator decimation (hanya disentuh task CAN)
+static float accumSum = 0.0f;
+static uint16_t accumCount = 0;
+static unsigned long windowStartMs = 0;
+
+#ifdef ESP32
+static portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED;
+#define HISTORY_LOCK() portENTER_CRITICAL(&historyMux)
+#define HISTORY_UNLOCK() portEXIT_CRITICAL(&historyMux)
+#else
+#define HISTORY_LOCK()
+#define HISTORY_UNLOCK()
+#endif
+
+// =============================================
+// PRODUCER (DECODER CAN)
+// =============================================
+void historyAddSample(float voltage, float current) {
+    unsigned long now = millis();
+    
+    // Satuan sampel: watt atau 0.1 A, sama dengan SPARK_SCALE_MIN/MAX
+    float value = SPARK_SOURCE_POWER ? voltage * current : current * 10.0f;
+    
+    if (accumCount == 0) windowStartMs = now;
+    accumSum += value;
+    accumCount++;
+    
+    if (now - windowStartMs < SPARK_SAMPLE_INTERVAL_MS) return;
+    
+    float avg = accumSum / accumCount;
+    if (avg > 32767.0f) avg = 32767.0f;
+    if (avg < -32768.0f) avg = -32768.0f;
+    accumSum = 0.0f;
+    accumCount = 0;
+    
+    HISTORY_LOCK();
+    samples[headSeq % SPARK_HISTORY_LEN] = (int16_t)lroundf(avg);
+    headSeq++;
+    HISTORY_UNLOCK();
+}
+
+// =============================================
+// CONSUMER (DISPLAY TASK)
+// =============================================
+uint32_t historyHeadSeq() {
+    HISTORY_LOCK();
+    uint32_t seq = headSeq;
+    HISTORY_UNLOCK();
+    return seq;
+}
+
+bool historyGetSample(uint32_t seq, int16_t &value) {
+    bool ok;
+    HISTORY_LOCK();
+    ok = seq < headSeq && headSeq - seq <= SPARK_HISTORY_LEN;
+    if (ok) value = samples[seq % SPARK_HISTORY_LEN];
+    HISTORY_UNLOCK();
+    return ok;
+}
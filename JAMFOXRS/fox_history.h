@@ -0,0 +1,22 @@
+#ifndef FOX_HISTORY_H
+#define FOX_HISTORY_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// RIWAYAT ARUS/DAYA UNTUK SPARKLINE (PAGE 5)
+// =============================================
+// Decoder CAN memanggil historyAddSample() tiap frame tegangan/arus. Nilai
+// dirata-rata lalu satu sampel masuk ring tiap SPARK_SAMPLE_INTERVAL_MS,
+// jadi SCREEN_WIDTH sampel = SPARK_WINDOW_MS terakhir. Sampel diberi nomor
+// urut (seq) supaya renderer tahu berapa kolom baru sejak frame terakhir.
+
+#define SPARK_HISTORY_LEN (SCREEN_WIDTH + 8)    // Lebih dari satu layar: aman dibaca saat ada push baru
+
+void historyAddSample(float voltage, float current);
+
+uint32_t historyHeadSeq();                      // Jumlah sampel yang pernah masuk (seq berikutnya)
+bool historyGetSample(uint32_t seq, int16_t &value);   // false jika sudah tertimpa / belum ada
+
+#endif
@@ -0,0 +1,715 @@
+#include "fox_i2c.h"
+#include "fox_config.h"
+#include "fox_serial.h"
+#include "fox_task.h"
+#include <Wire.h>
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+extern SemaphoreHandle_t i2cMutex;
+#endif
+
+// =============================================
+// DEVICE TABLE
+// =============================================
+static const uint8_t DEVICE_ADDRESS[I2C_DEV_COUNT] = {
+    OLED_ADDRESS,
+    RTC_I2C_ADDRESS,
+    EEPROM_I2C_ADDRESS
+};
+
+static const char* const DEVICE_NAME[I2C_DEV_COUNT] = {
+    "OLED",
+    "RTC",
+    "EEPROM"
+};
+
+// =============================================
+// QUEUE & STATE
+// =============================================
+#ifdef ESP32
+static portMUX_TYPE queueMux = portMUX_INITIALIZER_UNLOCKED;
+#define QUEUE_LOCK() portENTER_CRITICAL(&queueMux)
+#define QUEUE_UNLOCK() portEXIT_CRITICAL(&queueMux)
+#else
+#define QUEUE_LOCK()
+#define QUEUE_UNLOCK()
+#endif
+
+static I2CTransaction* pending[I2C_QUEUE_DEPTH];
+static uint8_t pendingCount = 0;
+static uint32_t nextSeq = 0;
+
+static volatile bool clockDirty = true;
+
+static I2CDeviceStats deviceStats[I2C_DEV_COUNT];
+static uint32_t queueDepthMax = 0;
+static uint32_t queueFullCount = 0;
+static unsigned long statsStartMs = 0;
+static uint8_t consecutiveErrors = 0;
+
+// =============================================
+// CLOCK GOVERNOR STATE
+// =============================================
+static const uint32_t CLOCK_LEVELS[] = {1000000, 800000, 400000, 200000, 100000, 50000};
+#define CLOCK_LEVEL_COUNT (sizeof(CLOCK_LEVELS) / sizeof(CLOCK_LEVELS[0]))
+
+static uint8_t clockLevel = 0;
+static uint16_t windowTransactions = 0;
+static uint16_t windowErrors = 0;
+static unsigned long lastErrorOrChangeMs = 0;
+static uint32_t clockStepsDown = 0;
+static uint32_t clockStepsUp = 0;
+
+static uint8_t levelForHz(uint32_t hz) {
+    for (uint8_t i = 0; i < CLOCK_LEVEL_COUNT; i++) {
+        if (CLOCK_LEVELS[i] <= hz) return i;
+    }
+    return CLOCK_LEVEL_COUNT - 1;
+}
+
+// =============================================
+// INIT
+// =============================================
+void initI2CBus() {
+    clockLevel = levelForHz(I2C_CLOCK_START_HZ);
+    lastErrorOrChangeMs = millis();
+    pendingCount = 0;
+    memset(deviceStats, 0, sizeof(deviceStats));
+    statsStartMs = millis();
+    clockDirty = true;
+
+    serialPrintflnAlways("[I2C] Bus manager ready (queue %d, %lu Hz)",
+                         I2C_QUEUE_DEPTH, (unsigned long)i2cGetClockHz());
+}
+
+bool isI2CBusTaskRunning() {
+    #ifdef ESP32
+    return i2cBusTaskHandle != NULL;
+    #else
+    return false;
+    #endif
+}
+
+void i2cMarkClockDirty() {
+    clockDirty = true;
+}
+
+// =============================================
+// CLOCK GOVERNOR
+// =============================================
+uint32_t i2cGetClockHz() {
+    return CLOCK_LEVELS[clockLevel];
+}
+
+static void setClockLevel(uint8_t level, const char* reason) {
+    uint8_t fastest = levelForHz(I2C_CLOCK_MAX_HZ);
+    uint8_t slowest = levelForHz(I2C_CLOCK_MIN_HZ);
+    if (level < fastest) level = fastest;
+    if (level > slowest) level = slowest;
+
+    windowTransactions = 0;
+    windowErrors = 0;
+    lastErrorOrChangeMs = millis();
+
+    if (level == clockLevel) return;
+
+    if (level > clockLevel) clockStepsDown++;
+    else clockStepsUp++;
+
+    serialPrintfln("[I2C] Clock %lu -> %lu Hz (%s)", (unsigned long)CLOCK_LEVELS[clockLevel],
+                   (unsigned long)CLOCK_LEVELS[level], reason);
+    clockLevel = level;
+    clockDirty = true;
+}
+
+// Dipanggil untuk tiap transaksi yang benar-benar sampai ke kabel. Address
+// NACK (2) bukan masalah sinyal: device absen atau sibuk, clock lebih pelan
+// tidak membantu. Dihitung per device di addressNacks
+static void governorRecord(uint8_t status) {
+    bool busError = (status == 3 || status == I2C_STATUS_TIMEOUT ||
+                     status == 4 || status == I2C_STATUS_SHORT_READ);
+
+    if (busError) {
+        windowErrors++;
+        lastErrorOrChangeMs = millis();
+        if (windowErrors >= I2C_GOVERNOR_STEP_DOWN_ERRORS) {
+            setClockLevel(clockLevel + 1, "errors");
+            return;
+        }
+    }
+
+    if (++windowTransactions >= I2C_GOVERNOR_WINDOW) {
+        windowTransactions = 0;
+        windowErrors = 0;
+    }
+
+    if (millis() - lastErrorOrChangeMs >= I2C_GOVERNOR_QUIET_MS && clockLevel > levelForHz(I2C_CLOCK_MAX_HZ)) {
+        setClockLevel(clockLevel - 1, "quiet");
+    }
+}
+
+// =============================================
+// EXECUTE - SATU TRANSAKSI DI WIRE
+// =============================================
+static bool takeBus() {
+    #ifdef ESP32
+    if (i2cMutex == NULL) return true;
+    return xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(I2C_MUTEX_TIMEOUT_MS)) == pdTRUE;
+    #else
+    return true;
+    #endif
+}
+
+static void giveBus() {
+    #ifdef ESP32
+    if (i2cMutex != NULL) xSemaphoreGive(i2cMutex);
+    #endif
+}
+
+static void execute(I2CTransaction *txn) {
+    uint8_t address = DEVICE_ADDRESS[txn->device];
+    I2CDeviceStats &ds = deviceStats[txn->device];
+
+    if (!takeBus()) {
+        txn->status = I2C_STATUS_BUS_BUSY;
+        return;
+    }
+
+    unsigned long startUs = micros();
+
+    if (clockDirty) {
+        Wire.setClock(i2cGetClockHz());
+        clockDirty = false;
+    }
+
+    uint8_t status = I2C_STATUS_OK;
+
+    if (txn->txLen > 0 || txn->rxLen == 0) {
+        Wire.beginTransmission(address);
+        size_t written = (txn->txLen > 0) ? Wire.write(txn->txData, txn->txLen) : 0;
+        // Repeated start jika lanjut baca
+        status = Wire.endTransmission(txn->rxLen == 0);
+        // Melebihi buffer Wire: data terpotong di kabel, anggap "data too long"
+        if (status == I2C_STATUS_OK && written != txn->txLen) status = 1;
+    }
+
+    if (status == I2C_STATUS_OK && txn->rxLen > 0) {
+        uint16_t received = Wire.requestFrom(address, (uint8_t)txn->rxLen);
+        for (uint16_t i = 0; i < received && i < txn->rxLen; i++) {
+            txn->rxData[i] = Wire.read();
+        }
+        if (received != txn->rxLen) status = I2C_STATUS_SHORT_READ;
+    }
+
+    uint32_t execUs = micros() - startUs;
+    giveBus();
+
+    txn->status = status;
+    if (status == 2 || status == 3) ds.nacks++;
+    if (status == 2) ds.addressNacks++;
+    if (status == I2C_STATUS_TIMEOUT) ds.timeouts++;
+    governorRecord(status);
+    ds.busyUs += execUs;
+    if (execUs > ds.execMaxUs) ds.execMaxUs = execUs;
+    ds.bytes += 1 + txn->txLen + (txn->rxLen > 0 ? 1 + txn->rxLen : 0);
+}
+
+static void complete(I2CTransaction *txn) {
+    I2CDeviceStats &ds = deviceStats[txn->device];
+
+    uint32_t latency = micros() - txn->submitUs;
+    ds.transactions++;
+    ds.latencyUs = latency;
+    ds.latencySumUs += latency;
+    if (latency > ds.latencyMaxUs) ds.latencyMaxUs = latency;
+
+    if (txn->status == I2C_STATUS_EXPIRED) {
+        ds.expired++;
+    } else if (txn->status != I2C_STATUS_OK) {
+        ds.errors++;
+        // NACK / timeout beruntun: bus kemungkinan macet (SDA ditahan slave)
+        if (txn->status != I2C_STATUS_QUEUE_FULL && txn->status != I2C_STATUS_BUS_BUSY &&
+            ++consecutiveErrors >= I2C_RECOVERY_ERROR_THRESHOLD) {
+            consecutiveErrors = 0;
+            i2cRequestRecovery();
+        }
+    } else {
+        consecutiveErrors = 0;
+    }
+
+    if (txn->callback != NULL) txn->callback(txn);
+}
+
+// =============================================
+// RECOVERY STATE MACHINE
+// =============================================
+typedef enum {
+    REC_IDLE = 0,
+    REC_RELEASE,        // Lepas Wire, ambil alih pin sebagai GPIO
+    REC_PULSE,          // Maksimal 9 pulsa SCL sampai SDA high
+    REC_STOP,           // Kondisi STOP: SDA naik saat SCL high
+    REC_REINIT,         // Wire.begin + clock + timeout
+    REC_PROBE           // Alamat OLED harus ACK
+} RecoveryState;
+
+static volatile bool recoveryRequested = false;
+static RecoveryState recoveryState = REC_IDLE;
+static uint32_t recoveryWaitMs = 0;        // Jeda sebelum langkah berikutnya
+static uint8_t recoveryAttempt = 0;
+static uint8_t probeAttempt = 0;
+static unsigned long recoveryStartUs = 0;
+static unsigned long cooldownUntilMs = 0;
+static bool cooldownActive = false;
+static bool recoveryHoldsBus = false;
+static I2CRecoveryHook recoveryHook = NULL;
+static I2CRecoveryStats recoveryStats = {0};
+
+#define SCL_HALF_PERIOD_US 5        // ~100 kHz saat bit-bang
+
+static void runRecoveryBlocking();
+
+void i2cRequestRecovery() {
+    if (recoveryRequested || recoveryState != REC_IDLE ||
+        (cooldownActive && (long)(millis() - cooldownUntilMs) < 0)) {
+        recoveryStats.ignored++;
+        return;
+    }
+    cooldownActive = false;
+    recoveryRequested = true;
+    recoveryStats.requested++;
+
+    #ifdef ESP32
+    if (isI2CBusTaskRunning()) {
+        xTaskNotifyGive(i2cBusTaskHandle);
+        return;
+    }
+    #endif
+    runRecoveryBlocking();
+}
+
+bool i2cRecoveryActive() {
+    return recoveryRequested || recoveryState != REC_IDLE;
+}
+
+const char* i2cRecoveryStateName() {
+    static const char* const names[] = {"IDLE", "RELEASE", "PULSE", "STOP", "REINIT", "PROBE"};
+    return names[recoveryState];
+}
+
+void i2cSetRecoveryHook(I2CRecoveryHook hook) {
+    recoveryHook = hook;
+}
+
+void getI2CRecoveryStats(I2CRecoveryStats &stats) {
+    stats = recoveryStats;
+}
+
+static void finishRecovery(bool success) {
+    if (recoveryHoldsBus) {
+        giveBus();
+        recoveryHoldsBus = false;
+    }
+
+    uint32_t elapsed = micros() - recoveryStartUs;
+    recoveryStats.lastTimeUs = elapsed;
+    if (elapsed > recoveryStats.maxTimeUs) recoveryStats.maxTimeUs = elapsed;
+
+    if (success) {
+        recoveryStats.succeeded++;
+        serialPrintflnAlways("[I2C-RECOVERY] Bus recovered in %lu us", (unsigned long)elapsed);
+    } else {
+        recoveryStats.failed++;
+        cooldownActive = true;
+        cooldownUntilMs = millis() + I2C_RECOVERY_COOLDOWN_MS;
+        serialPrintflnAlways("[I2C-RECOVERY] Failed after %d attempts", I2C_RECOVERY_MAX_ATTEMPTS);
+    }
+
+    recoveryState = REC_IDLE;
+    recoveryWaitMs = 0;
+}
+
+// Jalankan satu langkah; tiap langkah < 1 ms CPU, jeda lewat recoveryWaitMs
+static void runRecoveryStep() {
+    unsigned long stepStartUs = micros();
+    recoveryWaitMs = 0;
+
+    switch (recoveryState) {
+        case REC_IDLE:
+            if (!recoveryRequested) return;
+            // Bus task biasanya pemegang tunggal; coba lagi tick berikutnya jika dipakai kode lama
+            if (!takeBus()) {
+                recoveryWaitMs = 1;
+                return;
+            }
+            recoveryRequested = false;
+            recoveryHoldsBus = true;
+            recoveryStartUs = micros();
+            recoveryAttempt = 0;
+            serialPrintflnAlways("[I2C-RECOVERY] Starting recovery...");
+            recoveryState = REC_RELEASE;
+            break;
+
+        case REC_RELEASE:
+            Wire.end();
+            pinMode(SDA_PIN, INPUT_PULLUP);
+            // Latch HIGH dulu: tanpa ini pinMode menarik SCL low sesaat (pulsa ekstra)
+            digitalWrite(SCL_PIN, HIGH);
+            pinMode(SCL_PIN, OUTPUT_OPEN_DRAIN);
+            recoveryState = REC_PULSE;
+            break;
+
+        case REC_PULSE: {
+            // Slave yang menahan SDA akan melepasnya setelah byte selesai di-clock
+            uint8_t pulses = 0;
+            while (pulses < 9 && digitalRead(SDA_PIN) == LOW) {
+                digitalWrite(SCL_PIN, LOW);
+                delayMicroseconds(SCL_HALF_PERIOD_US);
+                digitalWrite(SCL_PIN, HIGH);
+                delayMicroseconds(SCL_HALF_PERIOD_US);
+                pulses++;
+            }
+            recoveryStats.lastPulses = pulses;
+            recoveryState = REC_STOP;
+            break;
+        }
+
+        case REC_STOP:
+            // Sama: SDA turun saat SCL high akan jadi START palsu
+            digitalWrite(SDA_PIN, HIGH);
+            pinMode(SDA_PIN, OUTPUT_OPEN_DRAIN);
+            digitalWrite(SCL_PIN, LOW);
+            digitalWrite(SDA_PIN, LOW);
+            delayMicroseconds(SCL_HALF_PERIOD_US);
+            digitalWrite(SCL_PIN, HIGH);
+            delayMicroseconds(SCL_HALF_PERIOD_US);
+            digitalWrite(SDA_PIN, HIGH);
+            delayMicroseconds(SCL_HALF_PERIOD_US);
+            recoveryState = REC_REINIT;
+            break;
+
+        case REC_REINIT:
+            pinMode(SDA_PIN, INPUT_PULLUP);
+            pinMode(SCL_PIN, INPUT_PULLUP);
+            Wire.begin(SDA_PIN, SCL_PIN);
+            Wire.setClock(i2cGetClockHz());
+            #ifdef ESP32
+            Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+            #endif
+            clockDirty = false;
+            probeAttempt = 0;
+            recoveryWaitMs = I2C_RECOVERY_SETTLE_MS;
+            recoveryState = REC_PROBE;
+            break;
+
+        case REC_PROBE:
+            Wire.beginTransmission(OLED_ADDRESS);
+            if (Wire.endTransmission() == 0) {
+                // Reinit device (display.begin) selagi bus masih dipegang
+                if (recoveryHook != NULL) recoveryHook();
+                // Bus sempat macet: mulai lagi satu level lebih lambat
+                setClockLevel(clockLevel + 1, "recovery");
+                clockDirty = true;
+                consecutiveErrors = 0;
+                finishRecovery(true);
+                break;
+            }
+            if (++probeAttempt < I2C_RECOVERY_PROBE_RETRIES) {
+                recoveryWaitMs = I2C_RECOVERY_RETRY_MS;
+            } else if (++recoveryAttempt < I2C_RECOVERY_MAX_ATTEMPTS) {
+                recoveryState = REC_RELEASE;
+            } else {
+                finishRecovery(false);
+            }
+            break;
+    }
+
+    uint32_t stepUs = micros() - stepStartUs;
+    if (stepUs > recoveryStats.stepMaxUs) recoveryStats.stepMaxUs = stepUs;
+}
+
+// Tanpa bus task (setup): jalankan semua langkah di pemanggil
+static void runRecoveryBlocking() {
+    do {
+        runRecoveryStep();
+        if (recoveryWaitMs > 0) delay(recoveryWaitMs);
+    } while (i2cRecoveryActive());
+}
+
+// =============================================
+// SUBMIT / CANCEL
+// =============================================
+static void stampSubmit(I2CTransaction *txn) {
+    txn->status = I2C_STATUS_PENDING;
+    txn->submitUs = micros();
+    txn->deadlineUs = txn->deadlineMs ? txn->submitUs + txn->deadlineMs * 1000UL : 0;
+}
+
+bool i2cSubmit(I2CTransaction *txn) {
+    if (txn == NULL || txn->device >= I2C_DEV_COUNT) return false;
+
+    stampSubmit(txn);
+
+    // Sebelum task jalan (setup): eksekusi langsung
+    if (!isI2CBusTaskRunning()) {
+        execute(txn);
+        complete(txn);
+        return true;
+    }
+
+    #ifdef ESP32
+    bool queued = false;
+    QUEUE_LOCK();
+    if (pendingCount < I2C_QUEUE_DEPTH) {
+        txn->seq = nextSeq++;
+        pending[pendingCount++] = txn;
+        if (pendingCount > queueDepthMax) queueDepthMax = pendingCount;
+        queued = true;
+    }
+    QUEUE_UNLOCK();
+
+    if (!queued) {
+        queueFullCount++;
+        txn->status = I2C_STATUS_QUEUE_FULL;
+        return false;
+    }
+
+    xTaskNotifyGive(i2cBusTaskHandle);
+    #endif
+    return true;
+}
+
+bool i2cCancel(I2CTransaction *txn) {
+    bool removed = false;
+
+    QUEUE_LOCK();
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        if (pending[i] == txn) {
+            pending[i] = pending[--pendingCount];
+            removed = true;
+            break;
+        }
+    }
+    QUEUE_UNLOCK();
+
+    return removed;
+}
+
+// =============================================
+// SYNC WRAPPERS
+// =============================================
+#ifdef ESP32
+static void signalDone(I2CTransaction *txn) {
+    xSemaphoreGive((SemaphoreHandle_t)txn->context);
+}
+#endif
+
+uint8_t i2cTransfer(I2CTransaction *txn, uint32_t timeoutMs) {
+    #ifdef ESP32
+    if (isI2CBusTaskRunning() && xTaskGetCurrentTaskHandle() != i2cBusTaskHandle) {
+        StaticSemaphore_t semBuffer;
+        SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&semBuffer);
+
+        txn->callback = signalDone;
+        txn->context = done;
+
+        if (i2cSubmit(txn)) {
+            if (xSemaphoreTake(done, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+                if (i2cCancel(txn)) {
+                    txn->status = I2C_STATUS_EXPIRED;
+                    deviceStats[txn->device].expired++;
+                } else {
+                    // Sedang dieksekusi: txn ada di stack ini, tunggu sampai selesai
+                    xSemaphoreTake(done, portMAX_DELAY);
+                }
+            }
+        }
+
+        vSemaphoreDelete(done);
+        return txn->status;
+    }
+    #endif
+
+    // Setup / dipanggil dari bus task sendiri: jalankan langsung
+    txn->callback = NULL;
+    stampSubmit(txn);
+    execute(txn);
+    complete(txn);
+    return txn->status;
+}
+
+uint8_t i2cWrite(I2CDevice device, const uint8_t *data, uint16_t len,
+                 I2CPriority priority, uint32_t timeoutMs) {
+    I2CTransaction txn = {};
+    txn.device = device;
+    txn.priority = priority;
+    txn.txData = data;
+    txn.txLen = len;
+    return i2cTransfer(&txn, timeoutMs);
+}
+
+uint8_t i2cWriteRead(I2CDevice device, const uint8_t *tx, uint16_t txLen, uint8_t *rx, uint16_t rxLen,
+                     I2CPriority priority, uint32_t timeoutMs) {
+    I2CTransaction txn = {};
+    txn.device = device;
+    txn.priority = priority;
+    txn.txData = tx;
+    txn.txLen = txLen;
+    txn.rxData = rx;
+    txn.rxLen = rxLen;
+    return i2cTransfer(&txn, timeoutMs);
+}
+
+// =============================================
+// BUS TASK
+// =============================================
+#ifdef ESP32
+// Prioritas efektif: naik satu level per I2C_QUEUE_AGING_MS menunggu, supaya
+// transaksi LOW tetap jalan walau antrian HIGH tidak pernah kosong
+static uint8_t effectivePriority(const I2CTransaction *txn, uint32_t now) {
+    uint32_t waitedMs = (now - txn->submitUs) / 1000;
+    uint32_t boost = waitedMs / I2C_QUEUE_AGING_MS;
+    return boost >= (uint32_t)txn->priority ? 0 : (uint8_t)(txn->priority - boost);
+}
+
+// true jika a harus jalan sebelum b
+static bool runsBefore(const I2CTransaction *a, const I2CTransaction *b, uint32_t now) {
+    uint8_t priorityA = effectivePriority(a, now);
+    uint8_t priorityB = effectivePriority(b, now);
+    if (priorityA != priorityB) return priorityA < priorityB;
+    if (a->deadlineUs != b->deadlineUs) {
+        if (a->deadlineUs == 0) return false;
+        if (b->deadlineUs == 0) return true;
+        return (int32_t)(a->deadlineUs - b->deadlineUs) < 0;
+    }
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+// Ambil transaksi berikutnya; yang sudah lewat deadline dikeluarkan ke expired[]
+static I2CTransaction* takeNext(I2CTransaction **expired, uint8_t &expiredCount) {
+    I2CTransaction *best = NULL;
+    uint8_t bestIndex = 0;
+    uint32_t now = micros();
+    expiredCount = 0;
+
+    QUEUE_LOCK();
+    uint8_t i = 0;
+    while (i < pendingCount) {
+        I2CTransaction *txn = pending[i];
+        if (txn->deadlineUs != 0 && (int32_t)(now - txn->deadlineUs) > 0) {
+            expired[expiredCount++] = txn;
+            pending[i] = pending[--pendingCount];
+            continue;
+        }
+        if (best == NULL || runsBefore(txn, best, now)) {
+            best = txn;
+            bestIndex = i;
+        }
+        i++;
+    }
+    if (best != NULL) {
+        pending[bestIndex] = pending[--pendingCount];
+    }
+    QUEUE_UNLOCK();
+
+    return best;
+}
+
+void i2cBusTask(void *parameter) {
+    I2CTransaction *expired[I2C_QUEUE_DEPTH];
+    uint8_t expiredCount;
+
+    serialPrintflnAlways("[I2C] Bus task started on Core %d", xPortGetCoreID());
+
+    while (true) {
+        TickType_t wait = portMAX_DELAY;
+        if (i2cRecoveryActive()) {
+            TickType_t ticks = pdMS_TO_TICKS(recoveryWaitMs);
+            wait = ticks > 0 ? ticks : 1;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        // Selama recovery transaksi tetap di antrian (atau expired oleh deadline)
+        if (i2cRecoveryActive()) {
+            runRecoveryStep();
+            if (i2cRecoveryActive()) continue;
+        }
+
+        while (!recoveryRequested) {
+            I2CTransaction *txn = takeNext(expired, expiredCount);
+
+            for (uint8_t i = 0; i < expiredCount; i++) {
+                expired[i]->status = I2C_STATUS_EXPIRED;
+                complete(expired[i]);
+            }
+
+            if (txn == NULL) break;
+
+            execute(txn);
+            complete(txn);
+        }
+    }
+}
+#endif
+
+// =============================================
+// STATISTICS
+// =============================================
+void getI2CDeviceStats(I2CDevice device, I2CDeviceStats &stats) {
+    if (device >= I2C_DEV_COUNT) return;
+    stats = deviceStats[device];
+}
+
+void printI2CStats() {
+    uint64_t elapsedUs = (uint64_t)(millis() - statsStartMs) * 1000;
+    if (elapsedUs == 0) elapsedUs = 1;
+    uint64_t totalBusyUs = 0;
+
+    serialPrintflnAlways("\n=== I2C BUS ===");
+    serialPrintflnAlways("Bus task: %s, clock %lu Hz (range %lu-%lu, %lu down / %lu up)",
+                         isI2CBusTaskRunning() ? "running" : "not started",
+                         (unsigned long)i2cGetClockHz(), (unsigned long)I2C_CLOCK_MIN_HZ,
+                         (unsigned long)I2C_CLOCK_MAX_HZ, (unsigned long)clockStepsDown,
+                         (unsigned long)clockStepsUp);
+    serialPrintflnAlways("Queue: %d now, %lu max, %lu full",
+                         pendingCount, (unsigned long)queueDepthMax, (unsigned long)queueFullCount);
+
+    for (uint8_t d = 0; d < I2C_DEV_COUNT; d++) {
+        const I2CDeviceStats &ds = deviceStats[d];
+        uint32_t avg = ds.transactions ? (uint32_t)(ds.latencySumUs / ds.transactions) : 0;
+        totalBusyUs += ds.busyUs;
+
+        serialPrintflnAlways("%-6s txn %lu, err %lu (nack %lu, addr %lu, timeout %lu), expired %lu, %lu bytes",
+                             DEVICE_NAME[d], (unsigned long)ds.transactions, (unsigned long)ds.errors,
+                             (unsigned long)ds.nacks, (unsigned long)ds.addressNacks, (unsigned long)ds.timeouts,
+                             (unsigned long)ds.expired, (unsigned long)ds.bytes);
+        serialPrintflnAlways("       latency %lu us (avg %lu, max %lu), exec max %lu us, util %lu.%lu%%",
+                             (unsigned long)ds.latencyUs, (unsigned long)avg, (unsigned long)ds.latencyMaxUs,
+                             (unsigned long)ds.execMaxUs,
+                             (unsigned long)(ds.busyUs * 100 / elapsedUs),
+                             (unsigned long)(ds.busyUs * 1000 / elapsedUs % 10));
+    }
+
+    serialPrintflnAlways("Bus utilisation: %lu.%lu%%",
+                         (unsigned long)(totalBusyUs * 100 / elapsedUs),
+                         (unsigned long)(totalBusyUs * 1000 / elapsedUs % 10));
+
+    serialPrintflnAlways("Recovery: %lu requested, %lu ok, %lu failed, %lu ignored%s%s%s",
+                         (unsigned long)recoveryStats.requested, (unsigned long)recoveryStats.succeeded,
+                         (unsigned long)recoveryStats.failed, (unsigned long)recoveryStats.ignored,
+                         i2cRecoveryActive() ? " (active, next " : "",
+                         i2cRecoveryActive() ? i2cRecoveryStateName() : "",
+                         i2cRecoveryActive() ? ")" : "");
+    serialPrintflnAlways("Time-to-recovery: %lu us (max %lu), step max %lu us, last SCL pulses %d",
+                         (unsigned long)recoveryStats.lastTimeUs, (unsigned long)recoveryStats.maxTimeUs,
+                         (unsigned long)recoveryStats.stepMaxUs, recoveryStats.lastPulses);
+}
+
+void resetI2CStats() {
+    memset(deviceStats, 0, sizeof(deviceStats));
+    memset(&recoveryStats, 0, sizeof(recoveryStats));
+    queueDepthMax = pendingCount;
+    queueFullCount = 0;
+    statsStartMs = millis();
+}
@@ -0,0 +1,129 @@
+#ifndef FOX_I2C_H
+#define FOX_I2C_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// I2C BUS MANAGER
+// =============================================
+// Semua transaksi Wire saat runtime dijalankan oleh satu task (I2C_Bus).
+// Antrian dipilih berdasarkan prioritas, lalu deadline terdekat, lalu urutan masuk.
+// Prioritas naik satu level tiap I2C_QUEUE_AGING_MS menunggu (tidak ada starvation).
+
+typedef enum {
+    I2C_DEV_OLED = 0,
+    I2C_DEV_RTC,
+    I2C_DEV_EEPROM,
+    I2C_DEV_COUNT
+} I2CDevice;
+
+typedef enum {
+    I2C_PRIO_HIGH = 0,          // Timing kritis (start line transisi, probe)
+    I2C_PRIO_NORMAL,            // Flush chunk, baca RTC
+    I2C_PRIO_LOW                // Resync, tulis EEPROM
+} I2CPriority;
+
+// Status 0-5 sama dengan Wire.endTransmission()
+#define I2C_STATUS_OK 0
+#define I2C_STATUS_TIMEOUT 5
+#define I2C_STATUS_SHORT_READ 10
+#define I2C_STATUS_EXPIRED 11       // Deadline lewat sebelum dijalankan
+#define I2C_STATUS_QUEUE_FULL 12
+#define I2C_STATUS_BUS_BUSY 13      // i2cMutex dipegang kode lain, tidak sampai ke kabel
+#define I2C_STATUS_PENDING 0xFF
+
+struct I2CTransaction;
+typedef void (*I2CCallback)(I2CTransaction *txn);
+
+struct I2CTransaction {
+    I2CDevice device;
+    I2CPriority priority;
+    const uint8_t *txData;      // Ditulis dulu (boleh NULL/0 = probe alamat)
+    uint16_t txLen;
+    uint8_t *rxData;            // Lalu dibaca dengan repeated start
+    uint16_t rxLen;
+    uint32_t deadlineMs;        // Relatif saat submit, 0 = tanpa deadline
+    I2CCallback callback;       // Dipanggil dari bus task setelah selesai
+    void *context;
+    
+    // Diisi bus manager
+    volatile uint8_t status;
+    uint32_t submitUs;
+    uint32_t deadlineUs;
+    uint32_t seq;
+};
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t errors;
+    uint32_t nacks;             // Status 2/3 (address/data NACK)
+    uint32_t addressNacks;      // Status 2: device absen / sibuk (EEPROM saat tWR)
+    uint32_t timeouts;          // Status 5
+    uint32_t expired;
+    uint32_t bytes;
+    uint32_t latencyUs;         // Submit sampai selesai (antri + eksekusi)
+    uint32_t latencyMaxUs;
+    uint64_t latencySumUs;
+    uint32_t execMaxUs;         // Paling lama bus dipakai satu transaksi
+    uint64_t busyUs;
+} I2CDeviceStats;
+
+void initI2CBus();
+bool isI2CBusTaskRunning();
+
+// Async: txn harus tetap hidup sampai callback dipanggil
+bool i2cSubmit(I2CTransaction *txn);
+bool i2cCancel(I2CTransaction *txn);
+
+// Sync: submit lalu tunggu selesai (langsung dieksekusi jika bus task belum jalan)
+uint8_t i2cTransfer(I2CTransaction *txn, uint32_t timeoutMs);
+uint8_t i2cWrite(I2CDevice device, const uint8_t *data, uint16_t len,
+                 I2CPriority priority = I2C_PRIO_NORMAL, uint32_t timeoutMs = I2C_MUTEX_TIMEOUT_MS);
+uint8_t i2cWriteRead(I2CDevice device, const uint8_t *tx, uint16_t txLen, uint8_t *rx, uint16_t rxLen,
+                     I2CPriority priority = I2C_PRIO_NORMAL, uint32_t timeoutMs = I2C_MUTEX_TIMEOUT_MS);
+
+// Kode lama (Adafruit begin/display, recovery) mengubah clock Wire: set ulang sebelum transaksi berikutnya
+void i2cMarkClockDirty();
+
+// =============================================
+// CLOCK GOVERNOR
+// =============================================
+// Mulai di I2C_CLOCK_START_HZ, turun satu level jika error NACK/timeout
+// melewati ambang per jendela, naik lagi setelah I2C_GOVERNOR_QUIET_MS tanpa error.
+uint32_t i2cGetClockHz();
+
+// =============================================
+// BUS RECOVERY (NON-BLOCKING)
+// =============================================
+// Dijalankan bus task langkah demi langkah: 9 pulsa SCL, STOP, Wire.begin,
+// probe OLED. Pemanggil tidak pernah menunggu; transaksi ditahan selama recovery.
+typedef void (*I2CRecoveryHook)();
+
+typedef struct {
+    uint32_t requested;
+    uint32_t succeeded;
+    uint32_t failed;
+    uint32_t ignored;           // Datang saat cooldown / recovery sedang jalan
+    uint32_t lastTimeUs;        // Request sampai bus kembali normal
+    uint32_t maxTimeUs;
+    uint32_t stepMaxUs;         // Langkah terlama (CPU terpakai per langkah)
+    uint8_t lastPulses;         // Pulsa SCL sampai SDA dilepas slave
+} I2CRecoveryStats;
+
+void i2cRequestRecovery();
+bool i2cRecoveryActive();
+const char* i2cRecoveryStateName();               // Langkah berikutnya ("IDLE" jika tidak aktif)
+void i2cSetRecoveryHook(I2CRecoveryHook hook);   // Dipanggil di bus task setelah probe berhasil
+void getI2CRecoveryStats(I2CRecoveryStats &stats);
+
+// Statistik
+void getI2CDeviceStats(I2CDevice device, I2CDeviceStats &stats);
+void printI2CStats();
+void resetI2CStats();
+
+#ifdef ESP32
+void i2cBusTask(void *parameter);
+#endif
+
+#endif
@@ -0,0 +1,770 @@
+#include "fox_oled.h"
+#include "fox_config.h"
+#include "fox_display.h"
+#include "fox_serial.h"
+#include "fox_task.h"
+#include "fox_i2c.h"
+#include "fox_page.h"
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// SSD1306 command bytes
+#define SSD1306_CTRL_COMMAND 0x00
+#define SSD1306_CTRL_DATA 0x40
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define SSD1306_SETSTARTLINE 0x40
+
+// GDDRAM SSD1306 selalu 64 baris; panel 128x32 hanya menampilkan 32 baris
+// mulai dari start line, sisanya bisa dipakai sebagai buffer off-screen
+#define OLED_RAM_ROWS 64
+#define OLED_HAS_HIDDEN_RAM (SCREEN_HEIGHT * 2 <= OLED_RAM_ROWS)
+
+// Burst terbesar yang muat di buffer Wire. Core 2.x bisa diperbesar lewat
+// Wire.setBufferSize (lihat setup), core lama terbatas I2C_BUFFER_LENGTH.
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 2
+#define OLED_BURST_BYTES OLED_FLUSH_CHUNK_BYTES
+#elif defined(I2C_BUFFER_LENGTH)
+#define OLED_BURST_BYTES (OLED_FLUSH_CHUNK_BYTES < I2C_BUFFER_LENGTH - 1 ? OLED_FLUSH_CHUNK_BYTES : I2C_BUFFER_LENGTH - 1)
+#else
+#define OLED_BURST_BYTES (OLED_FLUSH_CHUNK_BYTES < 31 ? OLED_FLUSH_CHUNK_BYTES : 31)
+#endif
+
+// WIRE_MAX Adafruit_SSD1306 (dihitung dengan cara yang sama) untuk perbandingan bench
+#if defined(I2C_BUFFER_LENGTH)
+#define ADAFRUIT_WIRE_MAX (I2C_BUFFER_LENGTH < 256 ? I2C_BUFFER_LENGTH : 256)
+#else
+#define ADAFRUIT_WIRE_MAX 32
+#endif
+
+// =============================================
+// BUFFER & STATE
+// =============================================
+static uint8_t frontBuffer[OLED_BUFFER_SIZE];
+static uint8_t sendBuffer[OLED_BUFFER_SIZE];    // Snapshot front buffer yang sedang dikirim
+static uint8_t shadowBuffer[OLED_BUFFER_SIZE];  // Isi GDDRAM yang tampil (basis dirty region)
+static volatile bool shadowValid = false;
+static volatile bool flushBusy = false;
+static volatile bool flushRestart = false;
+static unsigned long renderStartUs = 0;
+static bool renderStarted = false;
+
+// Event latency: tag frame dengan micros() event, dicatat saat frame selesai terkirim
+static volatile uint32_t pendingEventUs = 0;
+static uint32_t flushingEventUs = 0;
+
+// Command latency: tag frame dengan micros() saat command masuk queue display
+static uint32_t taggedCommandUs = 0;
+static volatile uint32_t pendingCommandUs = 0;
+static uint32_t flushingCommandUs = 0;
+
+// Transisi: page GDDRAM yang sedang tampil (0 atau 4) dan arah slide berikutnya
+static volatile uint8_t visibleBasePage = 0;
+static volatile OledSlide pendingSlide = OLED_SLIDE_NONE;
+
+static OledStats stats = {0};
+
+#ifdef ESP32
+static SemaphoreHandle_t frontMutex = NULL;
+static SemaphoreHandle_t flushDoneSem = NULL;
+static SemaphoreHandle_t chunkDoneSem = NULL;
+#endif
+
+// =============================================
+// INIT
+// =============================================
+void initOledFlush() {
+    memset(frontBuffer, 0, sizeof(frontBuffer));
+
+    if (LATENCY_PROBE_PIN >= 0) {
+        pinMode(LATENCY_PROBE_PIN, OUTPUT);
+        digitalWrite(LATENCY_PROBE_PIN, LOW);
+    }
+
+    #ifdef ESP32
+    frontMutex = xSemaphoreCreateMutex();
+    flushDoneSem = xSemaphoreCreateBinary();
+    chunkDoneSem = xSemaphoreCreateBinary();
+
+    if (frontMutex == NULL || flushDoneSem == NULL || chunkDoneSem == NULL) {
+        serialPrintflnAlways("[OLED] ERROR: Failed to create flush semaphores");
+        return;
+    }
+
+    serialPrintflnAlways("[OLED] Double buffer ready (%d bytes, burst %d, %d slots)",
+                         OLED_BUFFER_SIZE, OLED_BURST_BYTES, OLED_FLUSH_SLOTS);
+    #endif
+}
+
+// =============================================
+// LOW LEVEL SSD1306 WRITES
+// =============================================
+// Byte di kabel: 1 address + 1 control + payload
+#define WINDOW_WIRE_BYTES 8
+#define DATA_WIRE_BYTES(len) (2 + (len))
+#define COMMAND_WIRE_BYTES 3
+#define WINDOW_PACKET_BYTES 7
+
+static void fillWindow(uint8_t* window, uint8_t firstPage, uint8_t lastPage,
+                       uint8_t firstCol, uint8_t lastCol) {
+    window[0] = SSD1306_CTRL_COMMAND;
+    window[1] = SSD1306_PAGEADDR;
+    window[2] = firstPage;
+    window[3] = lastPage;
+    window[4] = SSD1306_COLUMNADDR;
+    window[5] = firstCol;
+    window[6] = lastCol;
+}
+
+static uint8_t sendCommand(uint8_t cmd) {
+    const uint8_t packet[] = {SSD1306_CTRL_COMMAND, cmd};
+    stats.i2cBytes += COMMAND_WIRE_BYTES;
+    return i2cWrite(I2C_DEV_OLED, packet, sizeof(packet), I2C_PRIO_HIGH);
+}
+
+// Byte satu frame penuh lewat jalur burst (untuk baseline software scroll)
+static uint32_t fullFrameWireBytes() {
+    uint32_t chunks = (OLED_BUFFER_SIZE + OLED_BURST_BYTES - 1) / OLED_BURST_BYTES;
+    return WINDOW_WIRE_BYTES + chunks * DATA_WIRE_BYTES(0) + OLED_BUFFER_SIZE;
+}
+
+// =============================================
+// PRESENT - SALIN BACK BUFFER KE FRONT BUFFER
+// =============================================
+void oledBeginFrame() {
+    renderStartUs = micros();
+    renderStarted = true;
+}
+
+static bool flushTaskRunning() {
+    #ifdef ESP32
+    return oledFlushTaskHandle != NULL && frontMutex != NULL;
+    #else
+    return false;
+    #endif
+}
+
+// =============================================
+// LATENCY PROBE
+// =============================================
+uint32_t oledLatencyMark() {
+    if (LATENCY_PROBE_PIN >= 0) digitalWrite(LATENCY_PROBE_PIN, HIGH);
+    uint32_t now = micros();
+    return now ? now : 1;
+}
+
+static void recordEventLatency(uint32_t eventUs) {
+    if (eventUs == 0) return;
+    if (LATENCY_PROBE_PIN >= 0) digitalWrite(LATENCY_PROBE_PIN, LOW);
+    stats.eventLatencyUs = micros() - eventUs;
+    if (stats.eventLatencyUs > stats.eventLatencyMaxUs) {
+        stats.eventLatencyMaxUs = stats.eventLatencyUs;
+    }
+}
+
+static void recordCommandLatency(uint32_t queuedUs) {
+    if (queuedUs == 0) return;
+    stats.commandLatencyUs = micros() - queuedUs;
+    if (stats.commandLatencyUs > stats.commandLatencyMaxUs) {
+        stats.commandLatencyMaxUs = stats.commandLatencyUs;
+    }
+}
+
+void oledTagCommand(uint32_t queuedUs) {
+    taggedCommandUs = queuedUs;
+}
+
+void oledPresent() {
+    oledPresentSlide(OLED_SLIDE_NONE, 0);
+}
+
+void oledPresentTagged(uint32_t eventUs) {
+    oledPresentSlide(OLED_SLIDE_NONE, eventUs);
+}
+
+void oledPresentSlide(OledSlide slide, uint32_t eventUs) {
+    if (renderStarted) {
+        stats.renderUs = micros() - renderStartUs;
+        if (stats.renderUs > stats.renderMaxUs) stats.renderMaxUs = stats.renderUs;
+        renderStarted = false;
+    }
+    stats.framesPresented++;
+
+    // Sebelum flush task jalan (splash, init) pakai jalur Adafruit biasa
+    if (!flushTaskRunning()) {
+        display.display();
+        i2cMarkClockDirty();
+        recordEventLatency(eventUs);
+        recordCommandLatency(taggedCommandUs);
+        taggedCommandUs = 0;
+        return;
+    }
+
+    #ifdef ESP32
+    // Tunggu flush sebelumnya selesai supaya tidak tearing
+    xSemaphoreTake(flushDoneSem, 0);
+    if (flushBusy) {
+        if (xSemaphoreTake(flushDoneSem, pdMS_TO_TICKS(OLED_PRESENT_WAIT_MS)) != pdTRUE) {
+            // Masih sibuk: ganti isi front buffer, flush mulai ulang dari awal
+            flushRestart = true;
+            stats.flushRestarts++;
+        }
+    }
+
+    if (xSemaphoreTake(frontMutex, pdMS_TO_TICKS(OLED_PRESENT_WAIT_MS)) == pdTRUE) {
+        memcpy(frontBuffer, display.getBuffer(), OLED_BUFFER_SIZE);
+        if (eventUs != 0) pendingEventUs = eventUs;
+        if (taggedCommandUs != 0) pendingCommandUs = taggedCommandUs;
+        taggedCommandUs = 0;
+        // Slide ter-latch sampai di-flush: present biasa sesudahnya tidak
+        // menghapusnya, frame terbaru yang digeser masuk
+        if (TRANSITION_ENABLED && OLED_HAS_HIDDEN_RAM && slide != OLED_SLIDE_NONE) pendingSlide = slide;
+        flushBusy = true;
+        xSemaphoreGive(frontMutex);
+        xTaskNotifyGive(oledFlushTaskHandle);
+    }
+    #endif
+}
+
+void oledInvalidate() {
+    // display.begin() mengembalikan start line ke 0 dan mengubah clock Wire
+    visibleBasePage = 0;
+    shadowValid = false;
+    i2cMarkClockDirty();
+    flushRestart = true;
+}
+
+bool oledIsFlushing() {
+    return flushBusy;
+}
+
+// =============================================
+// FLUSH TASK - KIRIM REGION YANG BERUBAH
+// =============================================
+#ifdef ESP32
+
+static const uint32_t FLUSH_HIST_LIMIT_US[OLED_FLUSH_HIST_BUCKETS - 1] = {
+    5000, 10000, 20000, 40000, 80000
+};
+
+static void recordFlushHistogram(uint32_t flushUs) {
+    uint8_t bucket = 0;
+    while (bucket < OLED_FLUSH_HIST_BUCKETS - 1 && flushUs >= FLUSH_HIST_LIMIT_US[bucket]) {
+        bucket++;
+    }
+    stats.flushHistogram[bucket]++;
+}
+
+// =============================================
+// DIRTY REGION - BANDINGKAN DENGAN SHADOW
+// =============================================
+// shadowBuffer = isi GDDRAM yang sedang tampil. Frame baru dibandingkan per
+// page; page dirty yang berurutan digabung jadi satu region (window diset
+// sekali) selama kolom tambahan lebih murah daripada window + header baru.
+#define OLED_PAGES (SCREEN_HEIGHT / 8)
+#define REGION_OVERHEAD_BYTES (WINDOW_WIRE_BYTES + DATA_WIRE_BYTES(0))
+
+typedef struct {
+    uint8_t firstPage;          // Relatif terhadap base page
+    uint8_t lastPage;
+    uint8_t firstCol;
+    uint8_t lastCol;
+} DirtyRegion;
+
+// Kolom pertama & terakhir yang berbeda di satu page, false jika sama persis
+static bool pageDirtySpan(uint8_t page, uint8_t &firstCol, uint8_t &lastCol) {
+    const uint8_t *now = sendBuffer + page * SCREEN_WIDTH;
+    const uint8_t *old = shadowBuffer + page * SCREEN_WIDTH;
+
+    int first = 0;
+    while (first < SCREEN_WIDTH && now[first] == old[first]) first++;
+    if (first == SCREEN_WIDTH) return false;
+
+    int last = SCREEN_WIDTH - 1;
+    while (now[last] == old[last]) last--;
+
+    firstCol = first;
+    lastCol = last;
+    return true;
+}
+
+static uint32_t regionBytes(uint8_t firstPage, uint8_t lastPage, uint8_t firstCol, uint8_t lastCol) {
+    return (uint32_t)(lastPage - firstPage + 1) * (lastCol - firstCol + 1);
+}
+
+static uint8_t collectRegions(bool full, DirtyRegion *regions) {
+    if (full) {
+        regions[0] = {0, OLED_PAGES - 1, 0, SCREEN_WIDTH - 1};
+        return 1;
+    }
+
+    uint8_t count = 0;
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        uint8_t first, last;
+        if (!pageDirtySpan(page, first, last)) continue;
+
+        if (count > 0 && regions[count - 1].lastPage == page - 1) {
+            DirtyRegion &prev = regions[count - 1];
+            uint8_t mergedFirst = min(prev.firstCol, first);
+            uint8_t mergedLast = max(prev.lastCol, last);
+            uint32_t merged = regionBytes(prev.firstPage, page, mergedFirst, mergedLast);
+            uint32_t separate = regionBytes(prev.firstPage, prev.lastPage, prev.firstCol, prev.lastCol) +
+                                REGION_OVERHEAD_BYTES + (last - first + 1);
+            if (merged <= separate) {
+                prev.lastPage = page;
+                prev.firstCol = mergedFirst;
+                prev.lastCol = mergedLast;
+                continue;
+            }
+        }
+
+        regions[count++] = {page, page, first, last};
+    }
+    return count;
+}
+
+// Ambil front buffer terbaru + tag latency yang menyertainya
+static bool snapshotFrontBuffer() {
+    if (xSemaphoreTake(frontMutex, pdMS_TO_TICKS(OLED_PRESENT_WAIT_MS)) != pdTRUE) {
+        return false;
+    }
+    memcpy(sendBuffer, frontBuffer, OLED_BUFFER_SIZE);
+    flushRestart = false;
+    if (pendingEventUs != 0) {
+        flushingEventUs = pendingEventUs;
+        pendingEventUs = 0;
+    }
+    if (pendingCommandUs != 0) {
+        flushingCommandUs = pendingCommandUs;
+        pendingCommandUs = 0;
+    }
+    xSemaphoreGive(frontMutex);
+    return true;
+}
+
+// =============================================
+// ASYNC CHUNK PIPELINE
+// =============================================
+// Tiap chunk = window (hanya di awal region) + satu burst data, di-submit ke
+// antrian bus manager tanpa menunggu. Chunk berikutnya disiapkan selagi chunk
+// sebelumnya dikirim; transaksi RTC/EEPROM tetap bisa masuk di antaranya.
+typedef struct {
+    I2CTransaction windowTxn;
+    I2CTransaction dataTxn;
+    uint8_t window[WINDOW_PACKET_BYTES];
+    uint8_t data[OLED_BURST_BYTES + 1];     // data[0] = control byte
+    bool hasWindow;
+    bool inUse;
+} FlushSlot;
+
+static FlushSlot slots[OLED_FLUSH_SLOTS];
+static uint8_t nextSlot = 0;
+
+static void onChunkDone(I2CTransaction *txn) {
+    xSemaphoreGive(chunkDoneSem);
+}
+
+static bool slotPending(const FlushSlot &slot) {
+    return slot.dataTxn.status == I2C_STATUS_PENDING ||
+           (slot.hasWindow && slot.windowTxn.status == I2C_STATUS_PENDING);
+}
+
+// Tunggu chunk di slot selesai, return true jika window & data terkirim
+static bool waitSlot(FlushSlot &slot) {
+    if (!slot.inUse) return true;
+
+    while (slotPending(slot)) {
+        if (xSemaphoreTake(chunkDoneSem, pdMS_TO_TICKS(OLED_CHUNK_TIMEOUT_MS)) == pdTRUE) {
+            continue;
+        }
+        // Bus tertahan (recovery, dll): tarik dari antrian, yang sedang jalan ditunggu
+        if (slot.hasWindow && i2cCancel(&slot.windowTxn)) slot.windowTxn.status = I2C_STATUS_EXPIRED;
+        if (i2cCancel(&slot.dataTxn)) slot.dataTxn.status = I2C_STATUS_EXPIRED;
+    }
+
+    slot.inUse = false;
+    return slot.dataTxn.status == I2C_STATUS_OK &&
+           (!slot.hasWindow || slot.windowTxn.status == I2C_STATUS_OK);
+}
+
+static bool drainSlots() {
+    bool ok = true;
+    for (uint8_t i = 0; i < OLED_FLUSH_SLOTS; i++) {
+        if (!waitSlot(slots[i])) ok = false;
+    }
+    return ok;
+}
+
+static bool submitChunk(I2CTransaction &txn, const uint8_t *data, uint16_t len) {
+    txn.device = I2C_DEV_OLED;
+    txn.priority = I2C_PRIO_NORMAL;
+    txn.txData = data;
+    txn.txLen = len;
+    txn.rxData = NULL;
+    txn.rxLen = 0;
+    txn.deadlineMs = 0;
+    txn.callback = onChunkDone;
+    txn.context = NULL;
+
+    for (uint8_t attempt = 0; attempt < I2C_RETRY_COUNT; attempt++) {
+        if (i2cSubmit(&txn)) return true;
+        vTaskDelay(pdMS_TO_TICKS(1));   // Antrian penuh, beri bus task waktu
+    }
+    return false;
+}
+
+// Isi slot dengan stream region (page demi page, kolom firstCol..lastCol) lalu submit
+static void queueChunk(FlushSlot &slot, const DirtyRegion &region, uint8_t basePage,
+                       uint16_t offset, uint16_t len) {
+    uint8_t width = region.lastCol - region.firstCol + 1;
+    uint16_t filled = 0;
+
+    while (filled < len) {
+        uint16_t pos = offset + filled;
+        uint16_t index = (region.firstPage + pos / width) * SCREEN_WIDTH + region.firstCol + pos % width;
+        uint16_t run = min((uint16_t)(len - filled), (uint16_t)(width - pos % width));
+        memcpy(slot.data + 1 + filled, sendBuffer + index, run);
+        // Shadow diperbarui saat submit; kalau chunk gagal shadow dibuang
+        memcpy(shadowBuffer + index, sendBuffer + index, run);
+        filled += run;
+    }
+
+    slot.inUse = true;
+    slot.hasWindow = (offset == 0);
+    slot.dataTxn.status = I2C_STATUS_OK;
+
+    if (slot.hasWindow) {
+        fillWindow(slot.window, basePage + region.firstPage, basePage + region.lastPage,
+                   region.firstCol, region.lastCol);
+        stats.i2cBytes += WINDOW_WIRE_BYTES;
+        if (!submitChunk(slot.windowTxn, slot.window, WINDOW_PACKET_BYTES)) {
+            // Tanpa window data akan mendarat di posisi salah: jangan kirim
+            slot.dataTxn.status = I2C_STATUS_QUEUE_FULL;
+            return;
+        }
+    }
+
+    slot.data[0] = SSD1306_CTRL_DATA;
+    stats.i2cBytes += DATA_WIRE_BYTES(len);
+    submitChunk(slot.dataTxn, slot.data, len + 1);
+}
+
+// Kirim front buffer ke page GDDRAM basePage..basePage+3. full = semua byte
+// (separuh tersembunyi / shadow tidak valid), selain itu hanya region dirty.
+// Return true jika lengkap.
+static bool flushFrame(uint8_t basePage, bool full) {
+    unsigned long startUs = micros();
+    DirtyRegion regions[OLED_PAGES];
+    uint32_t transactions = 0;
+    uint32_t payloadBytes = 0;
+    uint8_t regionTotal = 0;
+    bool ok = snapshotFrontBuffer();
+
+    full = full || !shadowValid;
+    shadowValid = true;
+
+    while (ok) {
+        uint8_t regionCount = collectRegions(full, regions);
+        bool restarted = false;
+        regionTotal += regionCount;
+
+        for (uint8_t r = 0; r < regionCount && ok && !restarted; r++) {
+            uint16_t total = regionBytes(regions[r].firstPage, regions[r].lastPage,
+                                         regions[r].firstCol, regions[r].lastCol);
+
+            for (uint16_t offset = 0; offset < total; ) {
+                FlushSlot &slot = slots[nextSlot];
+                nextSlot = (nextSlot + 1) % OLED_FLUSH_SLOTS;
+
+                // Slot ini dipakai chunk sebelumnya: pastikan sudah sampai ke OLED
+                if (!waitSlot(slot)) {
+                    ok = false;
+                    break;
+                }
+
+                uint16_t len = min((uint16_t)OLED_BURST_BYTES, (uint16_t)(total - offset));
+                queueChunk(slot, regions[r], basePage, offset, len);
+                transactions += (offset == 0) ? 2 : 1;
+                payloadBytes += len;
+                offset += len;
+
+                // Frame baru datang: sisa region dihitung ulang dari shadow
+                if (flushRestart) {
+                    restarted = true;
+                    break;
+                }
+            }
+        }
+
+        if (!drainSlots()) ok = false;
+        if (!restarted || !ok) break;
+        ok = snapshotFrontBuffer();
+    }
+
+    if (!ok) {
+        // Posisi pointer / isi GDDRAM tidak pasti, frame berikutnya dikirim penuh
+        shadowValid = false;
+        stats.chunkErrors++;
+    }
+
+    stats.flushUs = micros() - startUs;
+    if (stats.flushUs > stats.flushMaxUs) stats.flushMaxUs = stats.flushUs;
+    stats.framesFlushed++;
+    recordFlushHistogram(stats.flushUs);
+
+    stats.frameTransactions = transactions;
+    stats.frameRegions = regionTotal;
+    stats.framePayloadBytes = payloadBytes;
+    if (transactions == 0) stats.framesUnchanged++;
+    if (full && ok) {
+        stats.fullFrameUs = stats.flushUs;
+        stats.fullFrameTransactions = transactions;
+    }
+
+    if (ok) {
+        recordEventLatency(flushingEventUs);
+        recordCommandLatency(flushingCommandUs);
+    }
+    flushingEventUs = 0;
+    flushingCommandUs = 0;
+    return ok;
+}
+
+// =============================================
+// SLIDE TRANSITION - HARDWARE SCROLL VIA START LINE
+// =============================================
+// Frame baru sudah ada di separuh GDDRAM yang tersembunyi; geser display
+// start line (40h-7Fh) beberapa baris per frame sampai separuh itu tampil.
+// Tiap langkah hanya 1 command byte, framebuffer tidak dikirim ulang.
+static void runSlide(OledSlide slide, uint8_t fromBase, uint8_t toBase) {
+    int line = fromBase * 8;
+    int step = (slide == OLED_SLIDE_UP) ? TRANSITION_STEP_ROWS : -TRANSITION_STEP_ROWS;
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (int moved = 0; moved < SCREEN_HEIGHT; moved += TRANSITION_STEP_ROWS) {
+        line = (line + step + OLED_RAM_ROWS) % OLED_RAM_ROWS;
+        if (moved + TRANSITION_STEP_ROWS >= SCREEN_HEIGHT) {
+            line = toBase * 8;
+        }
+
+        sendCommand(SSD1306_SETSTARTLINE | line);
+
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TRANSITION_FRAME_MS));
+    }
+
+    visibleBasePage = toBase;
+}
+
+static void flushWithTransition(OledSlide slide) {
+    uint32_t bytesBefore = stats.i2cBytes;
+    uint8_t fromBase = visibleBasePage;
+    uint8_t toBase = fromBase ^ (SCREEN_HEIGHT / 8);
+
+    // Upload penuh ke separuh tersembunyi (isinya tidak dilacak shadow);
+    // restart di sini aman karena belum tampil
+    if (!flushFrame(toBase, true)) return;
+
+    runSlide(slide, fromBase, toBase);
+
+    int steps = (SCREEN_HEIGHT + TRANSITION_STEP_ROWS - 1) / TRANSITION_STEP_ROWS;
+    stats.transitions++;
+    stats.transitionBytes = stats.i2cBytes - bytesBefore;
+    stats.softwareScrollBytes = steps * fullFrameWireBytes();
+}
+
+void oledFlushTask(void *parameter) {
+    serialPrintflnAlways("[OLED] Flush task started on Core %d", xPortGetCoreID());
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (displayReady) {
+            // Ambil + hapus slide di bawah frontMutex (sama dengan present)
+            OledSlide slide = OLED_SLIDE_NONE;
+            if (xSemaphoreTake(frontMutex, pdMS_TO_TICKS(OLED_PRESENT_WAIT_MS)) == pdTRUE) {
+                slide = pendingSlide;
+                pendingSlide = OLED_SLIDE_NONE;
+                xSemaphoreGive(frontMutex);
+            }
+
+            if (slide != OLED_SLIDE_NONE) {
+                flushWithTransition(slide);
+            } else {
+                flushFrame(visibleBasePage, false);
+            }
+        }
+
+        flushBusy = false;
+        xSemaphoreGive(flushDoneSem);
+    }
+}
+#endif
+
+// =============================================
+// STATISTICS
+// =============================================
+void getOledStats(OledStats &out) {
+    out = stats;
+}
+
+void resetOledStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void printOledStats() {
+    serialPrintflnAlways("\n=== DISPLAY PIPELINE ===");
+    serialPrintflnAlways("Render: %lu us (max %lu)",
+                         (unsigned long)stats.renderUs, (unsigned long)stats.renderMaxUs);
+    serialPrintflnAlways("Flush: %lu us (max %lu) @ %lu Hz",
+                         (unsigned long)stats.flushUs, (unsigned long)stats.flushMaxUs,
+                         (unsigned long)i2cGetClockHz());
+    serialPrintflnAlways("Flush hist: <5ms %lu, <10 %lu, <20 %lu, <40 %lu, <80 %lu, >=80 %lu",
+                         (unsigned long)stats.flushHistogram[0], (unsigned long)stats.flushHistogram[1],
+                         (unsigned long)stats.flushHistogram[2], (unsigned long)stats.flushHistogram[3],
+                         (unsigned long)stats.flushHistogram[4], (unsigned long)stats.flushHistogram[5]);
+    serialPrintflnAlways("Frames: %lu presented, %lu flushed, %lu restarted",
+                         (unsigned long)stats.framesPresented, (unsigned long)stats.framesFlushed,
+                         (unsigned long)stats.flushRestarts);
+    serialPrintflnAlways("Last frame: %lu regions, %lu txn, %lu bytes (%lu unchanged frames)",
+                         (unsigned long)stats.frameRegions, (unsigned long)stats.frameTransactions,
+                         (unsigned long)stats.framePayloadBytes, (unsigned long)stats.framesUnchanged);
+    serialPrintflnAlways("Full frame: %lu us, %lu txn (burst %d)",
+                         (unsigned long)stats.fullFrameUs, (unsigned long)stats.fullFrameTransactions,
+                         OLED_BURST_BYTES);
+    serialPrintflnAlways("Chunk errors: %lu", (unsigned long)stats.chunkErrors);
+    serialPrintflnAlways("Press-to-pixels: %lu us (max %lu)",
+                         (unsigned long)stats.eventLatencyUs, (unsigned long)stats.eventLatencyMaxUs);
+    serialPrintflnAlways("Command-to-flush: %lu us (max %lu)",
+                         (unsigned long)stats.commandLatencyUs, (unsigned long)stats.commandLatencyMaxUs);
+    serialPrintflnAlways("I2C bytes: %lu total", (unsigned long)stats.i2cBytes);
+    serialPrintflnAlways("Transitions: %lu, last %lu bytes (software scroll: %lu bytes)",
+                         (unsigned long)stats.transitions, (unsigned long)stats.transitionBytes,
+                         (unsigned long)stats.softwareScrollBytes);
+    serialPrintflnAlways("========================");
+}
+
+// =============================================
+// BENCHMARK - ADAFRUIT VS BURST
+// =============================================
+#ifdef ESP32
+static bool waitFlushIdle(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (flushBusy) {
+        if (millis() - start > timeoutMs) return false;
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return true;
+}
+
+// Flush ulang front buffer yang sekarang tanpa present baru
+static bool benchFlush(bool full) {
+    if (!waitFlushIdle(OLED_CHUNK_TIMEOUT_MS * 5)) return false;
+    if (full) shadowValid = false;
+    flushBusy = true;
+    xTaskNotifyGive(oledFlushTaskHandle);
+    return waitFlushIdle(OLED_CHUNK_TIMEOUT_MS * 5);
+}
+#endif
+
+void oledBenchmark() {
+    #ifdef ESP32
+    if (!flushTaskRunning() || !displayReady) {
+        serialPrintflnAlways("ERROR - Flush task not running");
+        return;
+    }
+    if (!waitFlushIdle(OLED_CHUNK_TIMEOUT_MS * 5)) {
+        serialPrintflnAlways("ERROR - Flush busy");
+        return;
+    }
+
+    // Adafruit display(): Wire langsung, bus manager ditahan lewat i2cMutex
+    if (xSemaphoreTake(i2cMutex, pdMS_TO_TICKS(I2C_MUTEX_TIMEOUT_MS)) != pdTRUE) {
+        serialPrintflnAlways("ERROR - I2C bus busy");
+        return;
+    }
+    uint32_t startUs = micros();
+    display.display();
+    uint32_t adafruitUs = micros() - startUs;
+    xSemaphoreGive(i2cMutex);
+    i2cMarkClockDirty();
+
+    // Adafruit: window 0x22..0x21 (2 transaksi) + data per (WIRE_MAX - 1) byte
+    uint32_t adafruitTxn = 2 + (OLED_BUFFER_SIZE + ADAFRUIT_WIRE_MAX - 2) / (ADAFRUIT_WIRE_MAX - 1);
+
+    // GDDRAM sudah ditimpa Adafruit: frame penuh lalu frame tanpa perubahan
+    bool fullOk = benchFlush(true);
+    uint32_t fullUs = stats.flushUs;
+    uint32_t fullTxn = stats.frameTransactions;
+    bool idleOk = benchFlush(false);
+    uint32_t idleUs = stats.flushUs;
+    uint32_t idleTxn = stats.frameTransactions;
+
+    serialPrintflnAlways("\n=== OLED BENCH (%d bytes/frame) ===", OLED_BUFFER_SIZE);
+    serialPrintflnAlways("Adafruit display(): %lu us, %lu txn (WIRE_MAX %d, own clock)",
+                         (unsigned long)adafruitUs, (unsigned long)adafruitTxn, ADAFRUIT_WIRE_MAX);
+    serialPrintflnAlways("Burst full frame:   %lu us, %lu txn (burst %d @ %lu Hz)%s",
+                         (unsigned long)fullUs, (unsigned long)fullTxn, OLED_BURST_BYTES,
+                         (unsigned long)i2cGetClockHz(), fullOk ? "" : " TIMEOUT");
+    serialPrintflnAlways("Burst unchanged:    %lu us, %lu txn%s",
+                         (unsigned long)idleUs, (unsigned long)idleTxn, idleOk ? "" : " TIMEOUT");
+    serialPrintflnAlways("=============================");
+    #else
+    serialPrintflnAlways("ERROR - Bench needs ESP32");
+    #endif
+}
+
+// =============================================
+// FRAME DUMP (PBM) & HASH
+// =============================================
+// Salin front buffer (yang terakhir dikirim ke OLED) tanpa mengganggu flush
+bool oledCopyFrontBuffer(uint8_t* out) {
+    #ifdef ESP32
+    if (frontMutex == NULL) return false;
+    if (xSemaphoreTake(frontMutex, pdMS_TO_TICKS(OLED_PRESENT_WAIT_MS)) != pdTRUE) return false;
+    memcpy(out, frontBuffer, OLED_BUFFER_SIZE);
+    xSemaphoreGive(frontMutex);
+    return true;
+    #else
+    memcpy(out, display.getBuffer(), OLED_BUFFER_SIZE);
+    return true;
+    #endif
+}
+
+// FNV-1a 32-bit: sidik jari frame untuk dibandingkan dengan hash referensi
+uint32_t oledFrameHash(const uint8_t* buf) {
+    uint32_t hash = 2166136261UL;
+    for (int i = 0; i < OLED_BUFFER_SIZE; i++) {
+        hash ^= buf[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+// Tulis frame sebagai PBM ASCII (P1). Layout GDDRAM page-major: byte
+// [page * WIDTH + x], bit (y & 7) = pixel (x, y). Output serial bisa
+// langsung disimpan jadi file .pbm di PC
+void oledDumpFrame() {
+    static uint8_t frame[OLED_BUFFER_SIZE];
+    if (!oledCopyFrontBuffer(frame)) {
+        serialPrintflnAlways("ERROR - Front buffer busy");
+        return;
+    }
+
+    char row[SCREEN_WIDTH + 1];
+    serialPrintflnAlways("P1");
+    serialPrintflnAlways("# JAMFOXRS page %d hash %08lX", currentPage,
+                         (unsigned long)oledFrameHash(frame));
+    serialPrintflnAlways("%d %d", SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        const uint8_t* page = &frame[(y >> 3) * SCREEN_WIDTH];
+        uint8_t mask = 1 << (y & 7);
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            row[x] = (page[x] & mask) ? '1' : '0';
+        }
+        row[SCREEN_WIDTH] = '\0';
+        Serial.println(row);    // Lebih panjang dari buffer serialPrintfln
+    }
+}
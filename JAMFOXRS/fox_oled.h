@@ -0,0 +1,71 @@
+#ifndef FOX_OLED_H
+#define FOX_OLED_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+#define OLED_BUFFER_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+#define OLED_FLUSH_HIST_BUCKETS 6           // <5, <10, <20, <40, <80, >=80 ms
+
+// Statistik render & flush (microseconds)
+typedef struct {
+    uint32_t renderUs;          // Render terakhir (gambar ke back buffer)
+    uint32_t renderMaxUs;
+    uint32_t flushUs;           // Flush terakhir (front buffer ke OLED)
+    uint32_t flushMaxUs;
+    uint32_t flushHistogram[OLED_FLUSH_HIST_BUCKETS];
+    uint32_t framesPresented;
+    uint32_t framesFlushed;
+    uint32_t flushRestarts;     // Frame baru datang saat flush berjalan
+    uint32_t chunkErrors;
+    uint32_t frameTransactions; // Transaksi I2C frame terakhir (window + burst data)
+    uint32_t frameRegions;      // Region dirty frame terakhir
+    uint32_t framePayloadBytes; // Byte GDDRAM frame terakhir
+    uint32_t framesUnchanged;   // Frame tanpa perubahan, tidak ada yang dikirim
+    uint32_t fullFrameUs;       // Frame penuh terakhir (shadow tidak valid / transisi)
+    uint32_t fullFrameTransactions;
+    uint32_t eventLatencyUs;    // Event (tombol) sampai pixel terkirim
+    uint32_t eventLatencyMaxUs;
+    uint32_t commandLatencyUs;  // Command masuk queue display sampai frame terkirim
+    uint32_t commandLatencyMaxUs;
+    uint32_t i2cBytes;          // Total byte di kabel I2C (address + control + data)
+    uint32_t transitions;
+    uint32_t transitionBytes;   // Byte I2C transisi terakhir
+    uint32_t softwareScrollBytes; // Baseline: kirim frame penuh di setiap langkah
+} OledStats;
+
+typedef enum {
+    OLED_SLIDE_NONE = 0,
+    OLED_SLIDE_UP,              // Page baru masuk dari bawah (maju)
+    OLED_SLIDE_DOWN             // Page baru masuk dari atas (mundur)
+} OledSlide;
+
+// Double buffer: renderer menggambar ke buffer Adafruit (back buffer),
+// oledPresent() menyalin ke front buffer lalu kembali; flush task mengirim
+// region yang berubah sebagai burst async lewat bus manager
+void initOledFlush();
+void oledBeginFrame();
+void oledPresent();
+void oledPresentTagged(uint32_t eventUs);
+void oledPresentSlide(OledSlide slide, uint32_t eventUs = 0);
+uint32_t oledLatencyMark();
+void oledTagCommand(uint32_t queuedUs);
+void oledInvalidate();
+bool oledIsFlushing();
+
+// Statistik
+void getOledStats(OledStats &stats);
+void resetOledStats();
+void printOledStats();
+void oledBenchmark();           // Bandingkan Adafruit display() vs flush burst (frame penuh)
+
+// Snapshot frame untuk regresi visual
+bool oledCopyFrontBuffer(uint8_t* out);
+uint32_t oledFrameHash(const uint8_t* buf);
+void oledDumpFrame();           // Front buffer sebagai PBM ASCII lewat serial
+
+#ifdef ESP32
+void oledFlushTask(void *parameter);
+#endif
+
+#endif
@@ -4,6 +4,7 @@
 #include "fox_canbus.h"
 #include "fox_serial.h"
 #include "fox_ble.h"
+#include "fox_oled.h"
 
 // =============================================
 // GLOBAL VARIABLES
@@ -33,6 +34,7 @@ int getNextPageInOrder(int currentPage) {
                     case 2: enabled = PAGE_2_ENABLE; break;
                     case 3: enabled = PAGE_3_ENABLE; break;
                     case 4: enabled = PAGE_4_ENABLE; break;
+                    case 5: enabled = PAGE_5_ENABLE; break;
                 }
                 
                 if (enabled) {
@@ -45,6 +47,13 @@ int getNextPageInOrder(int currentPage) {
     return getFirstEnabledPage();
 }
 
+int getPageOrderIndex(int page) {
+    for (int i = 0; i < PAGE_ORDER_COUNT; i++) {
+        if (PAGE_ORDER[i] == page) return i;
+    }
+    return -1;
+}
+
 int getFirstEnabledPage() {
     for (int i = 0; i < PAGE_ORDER_COUNT; i++) {
         int page = PAGE_ORDER[i];
@@ -55,6 +64,7 @@ int getFirstEnabledPage() {
             case 2: enabled = PAGE_2_ENABLE; break;
             case 3: enabled = PAGE_3_ENABLE; break;
             case 4: enabled = PAGE_4_ENABLE; break;
+            case 5: enabled = PAGE_5_ENABLE; break;
         }
         
         if (enabled) {
@@ -125,7 +135,15 @@ void handleButtonPress() {
         return;
     }
     
-    // SHORT PRESS - Normal page switching (hanya jika BLE tidak aktif)
+    // SHORT PRESS - timestamp untuk ukur press-to-pixels
+    handleShortPress(oledLatencyMark());
+}
+
+// =============================================
+// SHORT PRESS - PINDAH PAGE
+// =============================================
+void handleShortPress(uint32_t eventUs) {
+    // Normal page switching (hanya jika BLE tidak aktif)
     #ifdef ESP32
     if (isBLEActive()) {
         // Jika BLE aktif, short press tidak melakukan apa-apa
@@ -152,7 +170,7 @@ void handleButtonPress() {
     if (nextPage != currentPage) {
         currentPage = nextPage;
         lastNormalPage = currentPage;
-        safeDisplayUpdate(currentPage);
+        requestPageChange(currentPage, eventUs);
         
         if (debugModeEnabled) {
             serialPrintfln("[PAGE] Changed to page %d", currentPage);
@@ -164,7 +182,7 @@ void handleButtonPress() {
 // PAGE MANAGEMENT
 // =============================================
 void switchToPage(int page) {
-    if (page < 1 || page > 4) return;
+    if (page < 1 || page > PAGE_COUNT) return;
     
     bool enabled = false;
     switch (page) {
@@ -172,6 +190,7 @@ void switchToPage(int page) {
         case 2: enabled = PAGE_2_ENABLE; break;
         case 3: enabled = PAGE_3_ENABLE; break;
         case 4: enabled = PAGE_4_ENABLE; break;
+        case 5: enabled = PAGE_5_ENABLE; break;
     }
     
     if (!enabled) {
@@ -184,7 +203,7 @@ void switchToPage(int page) {
     currentPage = page;
     lastNormalPage = currentPage;
     
-    safeDisplayUpdate(currentPage);
+    requestPageChange(currentPage);
     
     if (debugModeEnabled) {
         serialPrintfln("[PAGE] Manual switch to page %d", page);
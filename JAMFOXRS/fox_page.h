@@ -21,6 +21,7 @@ extern const uint8_t PAGE_ORDER_COUNT;
 void initButton();
 bool checkButtonPress();
 void handleButtonPress();
+void handleShortPress(uint32_t eventUs = 0);
 void updateModeDetection();
 
 // Page management
@@ -29,6 +30,7 @@ void switchToPage(int page);
 // NEW: Page order functions
 int getNextPageInOrder(int currentPage);
 int getFirstEnabledPage();
+int getPageOrderIndex(int page);            // Posisi di PAGE_ORDER, -1 = tidak ada
 
 // Getter functions
 uint8_t getCurrentSpecialMode();
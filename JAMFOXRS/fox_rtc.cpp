@@ -1,9 +1,13 @@
 #include "fox_rtc.h"
 #include "fox_config.h"
-#include <Wire.h>
+#include "fox_serial.h"
+#include "fox_i2c.h"
+
+#ifdef ESP32
+#include <esp_timer.h>
+#endif
 
 // Register addresses untuk DS3231
-#define DS3231_ADDRESS 0x68
 #define DS3231_TIME_REG 0x00
 #define DS3231_CONTROL_REG 0x0E
 #define DS3231_TEMP_REG 0x11
@@ -18,22 +22,179 @@ static uint8_t decToBcd(uint8_t val) {
     return ((val / 10) << 4) | (val % 10);
 }
 
+// =============================================
+// SOFTWARE CLOCK CACHE
+// =============================================
+// DS3231 dibaca sekali, lalu waktu dihitung dari esp_timer (atau jumlah
+// pulsa SQW 1 Hz). Resync berkala oleh rtcServiceTick(), bukan oleh getRTC().
+#define RTC_MAX_MINUTE_CALLBACKS 4
+
+#ifdef ESP32
+static portMUX_TYPE rtcMux = portMUX_INITIALIZER_UNLOCKED;
+#define RTC_LOCK() portENTER_CRITICAL(&rtcMux)
+#define RTC_UNLOCK() portEXIT_CRITICAL(&rtcMux)
+#else
+#define RTC_LOCK()
+#define RTC_UNLOCK()
+#endif
+
+static RTCDateTime baseTime;              // Waktu DS3231 saat terakhir dibaca
+static int64_t baseUs = 0;                // esp_timer saat baseTime dibaca
+static uint32_t baseSqwTicks = 0;
+static bool cacheValid = false;
+static bool rtcPresent = false;
+
+static volatile uint32_t sqwTicks = 0;
+static bool sqwActive = false;
+
+static RTCMinuteCallback minuteCallbacks[RTC_MAX_MINUTE_CALLBACKS];
+static uint8_t minuteCallbackCount = 0;
+static int lastMinuteSeen = -1;
+
+static uint32_t i2cTransactions = 0;
+static uint32_t cacheReads = 0;
+static uint32_t resyncCount = 0;
+static int32_t lastDriftSec = 0;
+static unsigned long statsStartMs = 0;
+
+static inline int64_t rtcNowUs() {
+    #ifdef ESP32
+    return esp_timer_get_time();
+    #else
+    return (int64_t)millis() * 1000;
+    #endif
+}
+
+#ifdef ESP32
+static void IRAM_ATTR sqwISR() {
+    sqwTicks++;
+}
+#endif
+
+static bool isLeapYear(uint16_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+static uint8_t daysInMonth(uint16_t year, uint8_t month) {
+    static const uint8_t DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12) return 31;
+    if (month == 2 && isLeapYear(year)) return 29;
+    return DAYS[month - 1];
+}
+
+// Tambahkan detik ke waktu kalender (termasuk pergantian hari/bulan/tahun)
+static void advanceDateTime(RTCDateTime &dt, uint32_t seconds) {
+    uint32_t secOfDay = dt.hour * 3600UL + dt.minute * 60UL + dt.second + seconds;
+    uint32_t days = secOfDay / 86400UL;
+    secOfDay %= 86400UL;
+    
+    dt.hour = secOfDay / 3600;
+    dt.minute = (secOfDay / 60) % 60;
+    dt.second = secOfDay % 60;
+    
+    while (days > 0) {
+        days--;
+        dt.dayOfWeek = (dt.dayOfWeek % 7) + 1;
+        if (++dt.day > daysInMonth(dt.year, dt.month)) {
+            dt.day = 1;
+            if (++dt.month > 12) {
+                dt.month = 1;
+                dt.year++;
+            }
+        }
+    }
+}
+
+static int32_t secondsOfDay(const RTCDateTime &dt) {
+    return dt.hour * 3600L + dt.minute * 60L + dt.second;
+}
+
+static void setCache(const RTCDateTime &dt) {
+    RTC_LOCK();
+    baseTime = dt;
+    baseUs = rtcNowUs();
+    baseSqwTicks = sqwTicks;
+    cacheValid = true;
+    RTC_UNLOCK();
+}
+
+// Baca satu/lebih register DS3231 lewat bus manager (2 transaksi I2C)
+static bool readRegisters(uint8_t reg, uint8_t* data, uint8_t len, I2CPriority priority = I2C_PRIO_NORMAL) {
+    i2cTransactions += 2;
+    return i2cWriteRead(I2C_DEV_RTC, &reg, 1, data, len, priority) == I2C_STATUS_OK;
+}
+
+static bool writeRegisters(const uint8_t* data, uint8_t len) {
+    i2cTransactions++;
+    return i2cWrite(I2C_DEV_RTC, data, len) == I2C_STATUS_OK;
+}
+
+// Baca 7 register waktu dari DS3231
+static bool readRTCHardware(RTCDateTime &dt, I2CPriority priority = I2C_PRIO_NORMAL) {
+    uint8_t raw[7];
+    if (!readRegisters(DS3231_TIME_REG, raw, sizeof(raw), priority)) return false;
+    
+    dt.second = bcdToDec(raw[0] & 0x7F);
+    dt.minute = bcdToDec(raw[1]);
+    dt.hour = bcdToDec(raw[2] & 0x3F);
+    dt.dayOfWeek = bcdToDec(raw[3]);
+    dt.day = bcdToDec(raw[4]);
+    dt.month = bcdToDec(raw[5] & 0x1F);
+    dt.year = bcdToDec(raw[6]) + 2000;
+    return true;
+}
+
+// Waktu saat ini dari cache tanpa I2C
+static RTCDateTime readCache() {
+    RTCDateTime dt;
+    uint32_t elapsed;
+    
+    RTC_LOCK();
+    dt = baseTime;
+    if (sqwActive) {
+        // Tiap falling edge SQW = register detik DS3231 bertambah
+        elapsed = sqwTicks - baseSqwTicks;
+    } else {
+        elapsed = (uint32_t)((rtcNowUs() - baseUs) / 1000000LL);
+    }
+    RTC_UNLOCK();
+    
+    advanceDateTime(dt, elapsed);
+    return dt;
+}
+
 bool initRTC() {
-    Wire.beginTransmission(DS3231_ADDRESS);
-    if (Wire.endTransmission() == 0) {
-        Wire.beginTransmission(DS3231_ADDRESS);
-        Wire.write(DS3231_CONTROL_REG);
-        Wire.endTransmission();
+    statsStartMs = millis();
+    
+    if (writeRegisters(NULL, 0)) {
+        rtcPresent = true;
         
-        Wire.requestFrom(DS3231_ADDRESS, 1);
-        if (Wire.available()) {
-            uint8_t status = Wire.read();
+        uint8_t status;
+        if (readRegisters(DS3231_CONTROL_REG, &status, 1)) {
             if (!(status & 0x80)) {
                 // RTC berjalan normal
             } else {
                 setRTCFromCompileTime();
             }
         }
+        
+        #ifdef ESP32
+        if (RTC_SQW_PIN >= 0) {
+            // Control reg: INTCN=0, RS2:RS1=00 -> SQW 1 Hz
+            const uint8_t control[] = {DS3231_CONTROL_REG, 0x00};
+            writeRegisters(control, sizeof(control));
+            
+            pinMode(RTC_SQW_PIN, INPUT_PULLUP);
+            attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), sqwISR, FALLING);
+            sqwActive = true;
+        }
+        #endif
+        
+        RTCDateTime dt;
+        if (readRTCHardware(dt)) {
+            setCache(dt);
+            lastMinuteSeen = dt.minute;
+        }
         return true;
     }
     
@@ -41,49 +202,103 @@ bool initRTC() {
 }
 
 RTCDateTime getRTC() {
+    if (RTC_CACHE_ENABLED && cacheValid) {
+        cacheReads++;
+        return readCache();
+    }
+    
     RTCDateTime dt;
+    if (rtcPresent && readRTCHardware(dt)) {
+        if (RTC_CACHE_ENABLED) setCache(dt);
+        return dt;
+    }
     
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TIME_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 7);
-    if (Wire.available() == 7) {
-        uint8_t seconds = bcdToDec(Wire.read() & 0x7F);
-        uint8_t minutes = bcdToDec(Wire.read());
-        uint8_t hours = bcdToDec(Wire.read() & 0x3F);
-        uint8_t dayOfWeek = bcdToDec(Wire.read());
-        uint8_t day = bcdToDec(Wire.read());
-        uint8_t month = bcdToDec(Wire.read() & 0x1F);
-        uint16_t year = bcdToDec(Wire.read()) + 2000;
-        
-        dt.second = seconds;
-        dt.minute = minutes;
-        dt.hour = hours;
-        dt.dayOfWeek = dayOfWeek;
-        dt.day = day;
-        dt.month = month;
-        dt.year = year;
-    } else {
-        static unsigned long lastMillis = 0;
-        static unsigned long seconds = 0;
+    // DS3231 tidak ada: jam software mulai 01/01/2024 00:00 saat boot
+    dt.second = 0;
+    dt.minute = 0;
+    dt.hour = 0;
+    dt.dayOfWeek = 1;
+    dt.day = 1;
+    dt.month = 1;
+    dt.year = 2024;
+    advanceDateTime(dt, millis() / 1000);
+    return dt;
+}
+
+// =============================================
+// RTC SERVICE - RESYNC & MINUTE EVENT
+// =============================================
+bool onRTCMinuteChanged(RTCMinuteCallback callback) {
+    if (callback == NULL || minuteCallbackCount >= RTC_MAX_MINUTE_CALLBACKS) return false;
+    minuteCallbacks[minuteCallbackCount++] = callback;
+    return true;
+}
+
+static void resyncFromHardware() {
+    RTCDateTime chip;
+    
+    // Prioritas rendah: flush OLED didahulukan, gagal = coba lagi tick berikutnya
+    if (!readRTCHardware(chip, I2C_PRIO_LOW)) return;
+    
+    RTCDateTime soft = readCache();
+    lastDriftSec = secondsOfDay(chip) - secondsOfDay(soft);
+    if (lastDriftSec > 43200) lastDriftSec -= 86400;
+    if (lastDriftSec < -43200) lastDriftSec += 86400;
+    setCache(chip);
+    resyncCount++;
+}
+
+// Dipanggil minimal 1x per detik (display task / loop)
+void rtcServiceTick() {
+    if (!RTC_CACHE_ENABLED) return;
+    
+    if (rtcPresent) {
+        uint32_t interval = sqwActive ? RTC_SQW_RESYNC_INTERVAL_MS : RTC_RESYNC_INTERVAL_MS;
+        int64_t age;
+        RTC_LOCK();
+        age = rtcNowUs() - baseUs;
+        RTC_UNLOCK();
         
-        unsigned long currentMillis = millis();
-        if(currentMillis - lastMillis >= 1000) {
-            seconds++;
-            lastMillis = currentMillis;
+        if (!cacheValid || age >= (int64_t)interval * 1000) {
+            resyncFromHardware();
         }
-        
-        dt.second = seconds % 60;
-        dt.minute = (seconds / 60) % 60;
-        dt.hour = (seconds / 3600) % 24;
-        dt.dayOfWeek = 1;
-        dt.day = 1;
-        dt.month = 1;
-        dt.year = 2024;
     }
     
-    return dt;
+    if (!cacheValid) return;
+    
+    RTCDateTime dt = readCache();
+    if (dt.minute != lastMinuteSeen) {
+        lastMinuteSeen = dt.minute;
+        for (uint8_t i = 0; i < minuteCallbackCount; i++) {
+            minuteCallbacks[i](dt);
+        }
+    }
+}
+
+void printRTCStats() {
+    unsigned long elapsedMs = millis() - statsStartMs;
+    if (elapsedMs == 0) elapsedMs = 1;
+    
+    // Tanpa cache setiap getRTC() = 2 transaksi I2C
+    uint32_t uncached = i2cTransactions + cacheReads * 2;
+    
+    serialPrintflnAlways("\n=== RTC SERVICE ===");
+    serialPrintflnAlways("Mode: %s, DS3231 %s", 
+                         !RTC_CACHE_ENABLED ? "direct read" : (sqwActive ? "cache + SQW 1Hz" : "cache + resync"),
+                         rtcPresent ? "OK" : "NOT FOUND");
+    serialPrintflnAlways("Reads from cache: %lu, resyncs: %lu, last drift: %ld s",
+                         (unsigned long)cacheReads, (unsigned long)resyncCount, (long)lastDriftSec);
+    serialPrintflnAlways("I2C transactions: %lu (%lu/hour)", (unsigned long)i2cTransactions,
+                         (unsigned long)((uint64_t)i2cTransactions * 3600000ULL / elapsedMs));
+    serialPrintflnAlways("Without cache: ~%lu (%lu/hour)", (unsigned long)uncached,
+                         (unsigned long)((uint64_t)uncached * 3600000ULL / elapsedMs));
+}
+
+void resetRTCStats() {
+    i2cTransactions = 0;
+    cacheReads = 0;
+    resyncCount = 0;
+    statsStartMs = millis();
 }
 
 void setRTCTime(uint16_t year, uint8_t month, uint8_t day,
@@ -100,23 +315,31 @@ void setRTCTime(uint16_t year, uint8_t month, uint8_t day,
         dayOfWeek = 1;
     }
     
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TIME_REG);
-    
-    Wire.write(decToBcd(second));
-    Wire.write(decToBcd(minute));
-    Wire.write(decToBcd(hour));
-    Wire.write(decToBcd(dayOfWeek));
-    Wire.write(decToBcd(day));
-    Wire.write(decToBcd(month));
-    Wire.write(decToBcd(year2digit));
+    const uint8_t timeRegs[] = {
+        DS3231_TIME_REG,
+        decToBcd(second),
+        decToBcd(minute),
+        decToBcd(hour),
+        decToBcd(dayOfWeek),
+        decToBcd(day),
+        decToBcd(month),
+        decToBcd(year2digit)
+    };
+    writeRegisters(timeRegs, sizeof(timeRegs));
     
-    Wire.endTransmission();
+    const uint8_t control[] = {DS3231_CONTROL_REG, 0x00};
+    writeRegisters(control, sizeof(control));
     
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_CONTROL_REG);
-    Wire.write(0x00);
-    Wire.endTransmission();
+    // Waktu yang baru ditulis langsung jadi basis cache (tanpa baca ulang)
+    RTCDateTime dt;
+    dt.year = year;
+    dt.month = month;
+    dt.day = day;
+    dt.hour = hour;
+    dt.minute = minute;
+    dt.second = second;
+    dt.dayOfWeek = dayOfWeek;
+    setCache(dt);
 }
 
 void setRTCFromCompileTime() {
@@ -139,14 +362,10 @@ void setRTCFromCompileTime() {
 }
 
 float getTemperature() {
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_TEMP_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 2);
-    if (Wire.available() == 2) {
-        uint8_t temp_msb = Wire.read();
-        uint8_t temp_lsb = Wire.read();
+    uint8_t raw[2];
+    if (readRegisters(DS3231_TEMP_REG, raw, sizeof(raw))) {
+        uint8_t temp_msb = raw[0];
+        uint8_t temp_lsb = raw[1];
         
         float temp = temp_msb + ((temp_lsb >> 6) * 0.25);
         return temp;
@@ -155,41 +374,37 @@ float getTemperature() {
 }
 
 bool isRunning() {
-    Wire.beginTransmission(DS3231_ADDRESS);
-    Wire.write(DS3231_CONTROL_REG);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(DS3231_ADDRESS, 1);
-    if (Wire.available()) {
-        uint8_t status = Wire.read();
+    uint8_t status;
+    if (readRegisters(DS3231_CONTROL_REG, &status, 1)) {
         return !(status & 0x80);
     }
     return false;
 }
 
-String getTimeString(bool includeSeconds) {
+uint8_t getTimeString(char* buf, size_t size, bool includeSeconds) {
     RTCDateTime dt = getRTC();
     
-    char buffer[9];
+    int len;
     if(includeSeconds) {
-        snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", 
-                 dt.hour, dt.minute, dt.second);
+        len = snprintf(buf, size, "%02d:%02d:%02d", 
+                       dt.hour, dt.minute, dt.second);
     } else {
-        snprintf(buffer, sizeof(buffer), "%02d:%02d", 
-                 dt.hour, dt.minute);
+        len = snprintf(buf, size, "%02d:%02d", 
+                       dt.hour, dt.minute);
     }
     
-    return String(buffer);
+    if (len < 0 || (size_t)len >= size) return 0;
+    return (uint8_t)len;
 }
 
-String getDateString() {
+uint8_t getDateString(char* buf, size_t size) {
     RTCDateTime dt = getRTC();
     
-    char buffer[11];
-    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", 
-             dt.day, dt.month, dt.year);
+    int len = snprintf(buf, size, "%02d/%02d/%04d", 
+                       dt.day, dt.month, dt.year);
     
-    return String(buffer);
+    if (len < 0 || (size_t)len >= size) return 0;
+    return (uint8_t)len;
 }
 
 bool setTimeFromString(String timeStr) {
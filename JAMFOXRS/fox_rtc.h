@@ -13,10 +13,19 @@ struct RTCDateTime {
     uint8_t dayOfWeek;
 };
 
+// Dipanggil saat menit berganti (dari konteks rtcServiceTick)
+typedef void (*RTCMinuteCallback)(const RTCDateTime &dt);
+
 bool initRTC();
 RTCDateTime getRTC();
-String getTimeString(bool includeSeconds = true);
-String getDateString();
+
+// Jam software: resync DS3231 berkala + event menit berganti
+void rtcServiceTick();
+bool onRTCMinuteChanged(RTCMinuteCallback callback);
+void printRTCStats();
+void resetRTCStats();
+uint8_t getTimeString(char* buf, size_t size, bool includeSeconds = true);
+uint8_t getDateString(char* buf, size_t size);
 
 void setRTCTime(uint16_t year, uint8_t month, uint8_t day, 
                 uint8_t hour, uint8_t minute, uint8_t second,
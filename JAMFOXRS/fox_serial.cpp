@@ -6,6 +6,9 @@
 #include "fox_page.h"
 #include "fox_vehicle.h"
 #include "fox_ble.h"
+#include "fox_oled.h"
+#include "fox_i2c.h"
+#include "fox_storage.h"
 #include <Arduino.h>
 #include <stdarg.h>
 
@@ -104,6 +107,7 @@ void printSystemStartup() {
 // =============================================
 void toggleDebugMode(bool enable) {
     debugModeEnabled = enable;
+    storageSetSetting(STORAGE_SETTING_DEBUG, enable);
     if (enable) {
         serialPrintflnAlways("DEBUG MODE ENABLED");
     } else {
@@ -135,6 +139,12 @@ void printSystemStatus() {
     serialPrintflnAlways("Charger: %s", 
         isChargerConnected() ? "CONNECTED" : "NOT CONNECTED");
     
+    uint32_t frames, allocFrames;
+    int32_t lastDelta;
+    getDisplayHeapStats(frames, allocFrames, lastDelta);
+    serialPrintflnAlways("Display heap: %lu/%lu frames alloc (last delta %ld)",
+        (unsigned long)allocFrames, (unsigned long)frames, (long)lastDelta);
+    
     serialPrintflnAlways("====================");
 }
 
@@ -188,11 +198,23 @@ void printHelp() {
     serialPrintflnAlways("TIME HH:MM:SS - Set time (24h format)");
     serialPrintflnAlways("DATE DD/MM/YYYY - Set date");
     serialPrintflnAlways("DEBUG [ON/OFF] - Enable/disable debug");
-    serialPrintflnAlways("PAGE [1-4]    - Switch display page");
+    serialPrintflnAlways("PAGE [1-5]    - Switch display page");
     serialPrintflnAlways("STATUS        - System status");
     serialPrintflnAlways("DIAG          - Same as STATUS");
     serialPrintflnAlways("RESET         - Emergency reset");
     serialPrintflnAlways("DATA          - Detailed data (debug mode)");
+    serialPrintflnAlways("DISP [RESET]  - Display render/flush/queue timing");
+    serialPrintflnAlways("DISP BENCH    - Adafruit vs burst flush, full frame");
+    serialPrintflnAlways("DISP RENDER   - Render time & frame hash per page");
+    serialPrintflnAlways("DISP DUMP     - Current frame as PBM (P1)");
+    serialPrintflnAlways("PRESS         - Simulate short button press");
+    serialPrintflnAlways("BLE           - BLE status");
+    serialPrintflnAlways("BLE BENCH     - Command parse + handler time per command");
+    serialPrintflnAlways("BLE CYCLE [n] - Stop/start BLE n times: latency & heap");
+    serialPrintflnAlways("RTC [RESET]   - RTC cache & I2C transaction stats");
+    serialPrintflnAlways("I2C [RESET]   - I2C bus latency & utilisation");
+    serialPrintflnAlways("TRIP [RESET]  - Odometer & trip");
+    serialPrintflnAlways("STORE [SAVE]  - EEPROM slots, commits & wear");
     serialPrintflnAlways("");
     serialPrintflnAlways("=== DAY MAPPING ===");
     serialPrintflnAlways("1=MINGGU, 2=SENIN, 3=SELASA, 4=RABU");
@@ -266,23 +288,27 @@ void processSerialCommands() {
     }
     else if (cmd == "PAGE") {
         int pageNum = param.toInt();
-        if (pageNum >= 1 && pageNum <= 4) {
+        if (pageNum >= 1 && pageNum <= PAGE_COUNT) {
             switchToPage(pageNum);
             serialPrintflnAlways("OK - Page %d", pageNum);
         } else {
-            serialPrintflnAlways("ERROR - Page must be 1-4");
+            serialPrintflnAlways("ERROR - Page must be 1-5");
         }
     }
     else if (cmd == "PAGES") {
         serialPrintflnAlways("\n=== PAGE CONFIGURATION ===");
-        serialPrintflnAlways("Order: [%d, %d, %d, %d]", 
-                            PAGE_ORDER[0], PAGE_ORDER[1], 
-                            PAGE_ORDER[2], PAGE_ORDER[3]);
-        serialPrintflnAlways("Enabled: 1=%s, 2=%s, 3=%s, 4=%s",
+        char order[32];
+        int len = 0;
+        for (int i = 0; i < PAGE_ORDER_COUNT && len < (int)sizeof(order) - 4; i++) {
+            len += snprintf(order + len, sizeof(order) - len, i ? ", %d" : "%d", PAGE_ORDER[i]);
+        }
+        serialPrintflnAlways("Order: [%s]", order);
+        serialPrintflnAlways("Enabled: 1=%s, 2=%s, 3=%s, 4=%s, 5=%s",
                             PAGE_1_ENABLE ? "YES" : "NO",
                             PAGE_2_ENABLE ? "YES" : "NO",
                             PAGE_3_ENABLE ? "YES" : "NO",
-                            PAGE_4_ENABLE ? "YES" : "NO");
+                            PAGE_4_ENABLE ? "YES" : "NO",
+                            PAGE_5_ENABLE ? "YES" : "NO");
         serialPrintflnAlways("Current: %d", currentPage);
         serialPrintflnAlways("==========================");
     }
@@ -299,8 +325,73 @@ void processSerialCommands() {
         }
         printDetailedData();
     }
+    else if (cmd == "DISP") {
+        param.toUpperCase();
+        if (param == "RESET") {
+            resetOledStats();
+            resetDisplayQueueStats();
+            serialPrintflnAlways("OK - Display stats reset");
+        } else if (param == "BENCH") {
+            oledBenchmark();
+        } else if (param == "RENDER") {
+            sendDisplayCommand(DISPLAY_CMD_RENDER_BENCH);
+        } else if (param == "DUMP") {
+            oledDumpFrame();
+        } else {
+            printDisplayStats();
+        }
+    }
+    else if (cmd == "RTC") {
+        param.toUpperCase();
+        if (param == "RESET") {
+            resetRTCStats();
+            serialPrintflnAlways("OK - RTC stats reset");
+        } else {
+            printRTCStats();
+        }
+    }
+    else if (cmd == "I2C") {
+        param.toUpperCase();
+        if (param == "RESET") {
+            resetI2CStats();
+            serialPrintflnAlways("OK - I2C stats reset");
+        } else {
+            printI2CStats();
+        }
+    }
+    else if (cmd == "TRIP") {
+        param.toUpperCase();
+        if (param == "RESET") {
+            storageResetTrip();
+            serialPrintflnAlways("OK - Trip reset");
+        } else {
+            printTripInfo();
+        }
+    }
+    else if (cmd == "STORE") {
+        param.toUpperCase();
+        if (param == "SAVE") {
+            storageRequestCommit();
+            serialPrintflnAlways("OK - Commit requested");
+        } else {
+            printStorageStats();
+        }
+    }
+    else if (cmd == "PRESS") {
+        handleShortPress(oledLatencyMark());
+        serialPrintflnAlways("OK - Page %d", currentPage);
+    }
     else if (cmd == "BLE") {
-    printBLEStatus();
+        String arg = param;
+        arg.toUpperCase();
+        if (arg == "BENCH") {
+            bleCommandBenchmark();
+        } else if (arg.startsWith("CYCLE")) {
+            long cycles = param.substring(5).toInt();
+            bleLifecycleBenchmark(cycles > 0 ? cycles : BLE_CYCLE_DEFAULT);
+        } else {
+            printBLEStatus();
+        }
     }
     else if (cmd == "BLEON") {
         if (!isBLEActive()) {
@@ -0,0 +1,385 @@
+#include "fox_storage.h"
+#include "fox_config.h"
+#include "fox_serial.h"
+#include "fox_vehicle.h"
+#include "fox_canbus.h"
+#include "fox_i2c.h"
+
+#define STORAGE_PAGE_SIZE 32
+#define STORAGE_CRC_BYTES (sizeof(StorageRecord) - sizeof(uint16_t))
+
+static_assert(sizeof(StorageRecord) == STORAGE_PAGE_SIZE, "StorageRecord harus tepat satu page AT24C32");
+static_assert((STORAGE_BASE_ADDRESS % STORAGE_PAGE_SIZE) == 0, "STORAGE_BASE_ADDRESS harus page-aligned");
+static_assert(STORAGE_BASE_ADDRESS + STORAGE_SLOT_COUNT * STORAGE_PAGE_SIZE <= 4096, "Melebihi kapasitas AT24C32");
+
+// =============================================
+// STATE
+// =============================================
+typedef enum {
+    STORE_IDLE = 0,
+    STORE_WRITE_CYCLE           // Page sudah dikirim, EEPROM sedang memprogram (tWR)
+} StorageState;
+
+static bool storageAvailable = false;
+static StorageRecord committed;         // Isi slot terbaru di EEPROM
+static StorageRecord working;           // State RAM, ditulis saat commit
+static StorageRecord writing;           // Sedang diprogram, dibandingkan saat verify
+static int16_t currentSlot = -1;        // Slot record terbaru (-1 = kosong)
+static uint16_t nextSlot = 0;
+static StorageState state = STORE_IDLE;
+static unsigned long writeStartMs = 0;
+static unsigned long lastCommitMs = 0;
+static bool commitRequested = false;
+static StorageStats stats = {0};
+
+// Integrasi jarak/waktu: sisa pecahan disimpan supaya tidak hilang tiap tick
+static unsigned long lastTickMs = 0;
+static uint32_t carriedGapMs = 0;               // Sisa dt di atas STORAGE_MAX_TICK_GAP_MS
+static uint32_t distanceRemainderMm = 0;
+static uint32_t movingRemainderMs = 0;
+static bool wasMoving = false;
+
+// =============================================
+// CRC16-CCITT (poly 0x1021, init 0xFFFF)
+// =============================================
+static uint16_t crc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool recordValid(const StorageRecord &rec) {
+    return rec.magic == STORAGE_RECORD_MAGIC &&
+           rec.version == STORAGE_RECORD_VERSION &&
+           rec.crc == crc16((const uint8_t*)&rec, STORAGE_CRC_BYTES);
+}
+
+// Isi yang berarti (tanpa seq & CRC) sama dengan record terakhir?
+static bool recordUnchanged(const StorageRecord &a, const StorageRecord &b) {
+    return a.bootCount == b.bootCount && a.odometer == b.odometer &&
+           a.tripMeters == b.tripMeters && a.tripSeconds == b.tripSeconds &&
+           a.soc == b.soc && a.settings == b.settings;
+}
+
+static uint16_t slotAddress(uint16_t slot) {
+    return STORAGE_BASE_ADDRESS + slot * STORAGE_PAGE_SIZE;
+}
+
+// =============================================
+// EEPROM ACCESS (LEWAT BUS MANAGER)
+// =============================================
+static bool readSlot(uint16_t slot, StorageRecord &rec) {
+    uint16_t address = slotAddress(slot);
+    const uint8_t addr[] = {(uint8_t)(address >> 8), (uint8_t)(address & 0xFF)};
+
+    if (i2cWriteRead(I2C_DEV_EEPROM, addr, sizeof(addr), (uint8_t*)&rec, sizeof(rec),
+                     I2C_PRIO_LOW, STORAGE_IO_TIMEOUT_MS) != I2C_STATUS_OK) {
+        stats.readErrors++;
+        return false;
+    }
+    return true;
+}
+
+// Satu page write: 2 byte alamat + 32 byte record, tidak melewati batas page
+static bool writeSlot(uint16_t slot, const StorageRecord &rec) {
+    uint16_t address = slotAddress(slot);
+    uint8_t packet[2 + STORAGE_PAGE_SIZE];
+    packet[0] = address >> 8;
+    packet[1] = address & 0xFF;
+    memcpy(packet + 2, &rec, STORAGE_PAGE_SIZE);
+
+    unsigned long startUs = micros();
+    uint8_t status = i2cWrite(I2C_DEV_EEPROM, packet, sizeof(packet), I2C_PRIO_LOW, STORAGE_IO_TIMEOUT_MS);
+    stats.commitUs = micros() - startUs;
+    if (stats.commitUs > stats.commitMaxUs) stats.commitMaxUs = stats.commitUs;
+
+    if (status != I2C_STATUS_OK) {
+        stats.writeErrors++;
+        return false;
+    }
+    return true;
+}
+
+// =============================================
+// INIT - SCAN SLOT
+// =============================================
+// Semua state dikosongkan dulu: initStorage boleh dipanggil ulang (mis. EEPROM
+// dipasang lagi / test reboot) tanpa membawa statistik atau slot lama
+static void resetStorageState() {
+    storageAvailable = false;
+    memset(&committed, 0, sizeof(committed));
+    memset(&working, 0, sizeof(working));
+    memset(&writing, 0, sizeof(writing));
+    currentSlot = -1;
+    nextSlot = 0;
+    state = STORE_IDLE;
+    writeStartMs = 0;
+    lastCommitMs = 0;
+    commitRequested = false;
+    memset(&stats, 0, sizeof(stats));
+    lastTickMs = 0;
+    carriedGapMs = 0;
+    distanceRemainderMm = 0;
+    movingRemainderMs = 0;
+    wasMoving = false;
+}
+
+bool initStorage() {
+    resetStorageState();
+    if (!STORAGE_ENABLED) return false;
+
+    // Probe alamat dulu: modul tanpa EEPROM cukup satu NACK, bukan 64
+    if (i2cWrite(I2C_DEV_EEPROM, NULL, 0, I2C_PRIO_LOW, STORAGE_IO_TIMEOUT_MS) != I2C_STATUS_OK) {
+        serialPrintflnAlways("[STORE] AT24C32 not found at 0x%02X", EEPROM_I2C_ADDRESS);
+        return false;
+    }
+    storageAvailable = true;
+
+    for (uint16_t slot = 0; slot < STORAGE_SLOT_COUNT; slot++) {
+        StorageRecord rec;
+        if (!readSlot(slot, rec)) continue;
+
+        if (!recordValid(rec)) {
+            // Page kosong (0xFF) bukan korup, sisanya kemungkinan tulis terpotong
+            if (rec.magic != 0xFF) stats.corruptSlots++;
+            continue;
+        }
+
+        stats.validSlots++;
+        if (currentSlot < 0 || (int32_t)(rec.seq - committed.seq) > 0) {
+            committed = rec;
+            currentSlot = slot;
+        }
+    }
+
+    if (currentSlot >= 0) {
+        working = committed;
+        nextSlot = (currentSlot + 1) % STORAGE_SLOT_COUNT;
+    } else {
+        memset(&working, 0, sizeof(working));
+        working.magic = STORAGE_RECORD_MAGIC;
+        working.version = STORAGE_RECORD_VERSION;
+        working.soc = STORAGE_SOC_UNKNOWN;
+        memset(&committed, 0, sizeof(committed));
+        nextSlot = 0;
+    }
+
+    working.bootCount++;
+
+    // Terapkan ke state runtime
+    vehicle.odometer = working.odometer;
+    vehicle.tripMeters = working.tripMeters;
+    vehicle.tripSeconds = working.tripSeconds;
+    if (working.soc != STORAGE_SOC_UNKNOWN) vehicle.batterySOC = working.soc;
+    debugModeEnabled = (working.settings & STORAGE_SETTING_DEBUG) != 0;
+
+    lastTickMs = millis();
+    lastCommitMs = millis();
+
+    serialPrintflnAlways("[STORE] Slot %d/%d seq %lu, odo %lu m, %d valid, %d corrupt",
+                         currentSlot, STORAGE_SLOT_COUNT, (unsigned long)committed.seq,
+                         (unsigned long)working.odometer, stats.validSlots, stats.corruptSlots);
+    return true;
+}
+
+bool isStorageAvailable() {
+    return storageAvailable;
+}
+
+// =============================================
+// ODOMETER & TRIP
+// =============================================
+static void integrateDistance(unsigned long now) {
+    uint32_t dtMs = (lastTickMs != 0) ? now - lastTickMs + carriedGapMs : 0;
+    lastTickMs = now;
+    carriedGapMs = 0;
+
+    // Speed basi (CAN putus) / berhenti: waktu tertahan ikut dibuang
+    if (!isDataFresh() || vehicle.speed <= 0) return;
+
+    // Loop sempat tertahan lama: paling banyak STORAGE_MAX_TICK_GAP_MS per
+    // tick, sisanya dibawa ke tick berikutnya dengan speed yang lebih baru
+    if (dtMs > STORAGE_MAX_TICK_GAP_MS) {
+        carriedGapMs = dtMs - STORAGE_MAX_TICK_GAP_MS;
+        dtMs = STORAGE_MAX_TICK_GAP_MS;
+    }
+
+    // km/h * ms -> mm: v * dt * 1000000 / 3600000
+    distanceRemainderMm += (uint32_t)vehicle.speed * dtMs * 10 / 36;
+    movingRemainderMs += dtMs;
+
+    uint32_t meters = distanceRemainderMm / 1000;
+    distanceRemainderMm %= 1000;
+    uint32_t seconds = movingRemainderMs / 1000;
+    movingRemainderMs %= 1000;
+
+    vehicle.odometer += meters;
+    vehicle.tripMeters += meters;
+    vehicle.tripSeconds += seconds;
+}
+
+void storageResetTrip() {
+    vehicle.tripMeters = 0;
+    vehicle.tripSeconds = 0;
+    distanceRemainderMm = 0;
+    movingRemainderMs = 0;
+    storageRequestCommit();
+}
+
+void storageSetSOC(uint8_t soc) {
+    if (soc <= 100) working.soc = soc;
+}
+
+uint8_t storageGetSOC() {
+    return storageAvailable ? working.soc : STORAGE_SOC_UNKNOWN;
+}
+
+void storageSetSetting(uint8_t mask, bool enable) {
+    uint8_t settings = enable ? (working.settings | mask) : (working.settings & ~mask);
+    if (settings == working.settings) return;
+    working.settings = settings;
+    storageRequestCommit();
+}
+
+uint8_t storageGetSettings() {
+    return working.settings;
+}
+
+void storageRequestCommit() {
+    commitRequested = true;
+}
+
+// =============================================
+// SERVICE TICK - BATCH COMMIT
+// =============================================
+// Perubahan dikumpulkan di RAM; satu page ditulis paling sering tiap
+// STORAGE_COMMIT_INTERVAL_MS, atau segera saat berhenti/trip reset/setting.
+static void startCommit(unsigned long now) {
+    writing = working;
+    writing.seq = committed.seq + 1;
+    writing.crc = crc16((const uint8_t*)&writing, STORAGE_CRC_BYTES);
+
+    lastCommitMs = now;
+    commitRequested = false;
+
+    if (!writeSlot(nextSlot, writing)) {
+        // Coba lagi di interval berikutnya, slot sama
+        return;
+    }
+    // tWR mulai dari STOP page write, bukan dari awal tick
+    writeStartMs = millis();
+    state = STORE_WRITE_CYCLE;
+}
+
+// Baca ulang setelah tWR: hanya record yang terverifikasi dianggap committed
+static void finishCommit() {
+    StorageRecord readBack;
+    uint16_t slot = nextSlot;
+
+    state = STORE_IDLE;
+    nextSlot = (nextSlot + 1) % STORAGE_SLOT_COUNT;
+
+    if (!readSlot(slot, readBack) || memcmp(&readBack, &writing, sizeof(writing)) != 0) {
+        // Cell aus / tulis gagal: slot dilewati, record lama tetap berlaku
+        stats.verifyErrors++;
+        commitRequested = true;
+        return;
+    }
+
+    committed = writing;
+    currentSlot = slot;
+    stats.commits++;
+}
+
+void storageServiceTick() {
+    unsigned long now = millis();
+
+    integrateDistance(now);
+    if (!storageAvailable) return;
+
+    if (state == STORE_WRITE_CYCLE) {
+        // EEPROM NACK selama memprogram, jangan disentuh sebelum tWR lewat.
+        // millis() bisa naik sesaat setelah page write: +1 supaya jeda nyata >= tWR
+        if (now - writeStartMs >= STORAGE_WRITE_CYCLE_MS + 1) finishCommit();
+        return;
+    }
+
+    // Odometer tidak pernah mundur (mis. reset data kendaraan)
+    if (vehicle.odometer < working.odometer) vehicle.odometer = working.odometer;
+
+    working.odometer = vehicle.odometer;
+    working.tripMeters = vehicle.tripMeters;
+    working.tripSeconds = vehicle.tripSeconds;
+    if (isDataFresh()) saveSOCToStorage(vehicle.batterySOC);
+
+    // Baru berhenti: simpan segera, kontak bisa dimatikan kapan saja
+    bool moving = vehicle.speed > 0 && isDataFresh();
+    if (wasMoving && !moving) commitRequested = true;
+    wasMoving = moving;
+
+    unsigned long sinceCommit = now - lastCommitMs;
+    bool due = sinceCommit >= STORAGE_COMMIT_INTERVAL_MS ||
+               (commitRequested && sinceCommit >= STORAGE_MIN_COMMIT_GAP_MS);
+    if (!due) return;
+
+    if (currentSlot >= 0 && recordUnchanged(working, committed)) {
+        stats.unchanged++;
+        lastCommitMs = now;
+        commitRequested = false;
+        return;
+    }
+
+    startCommit(now);
+}
+
+// =============================================
+// STATISTICS
+// =============================================
+void getStorageStats(StorageStats &out) {
+    out = stats;
+}
+
+void printStorageStats() {
+    serialPrintflnAlways("\n=== STORAGE (AT24C32) ===");
+    if (!storageAvailable) {
+        serialPrintflnAlways("Status: not available");
+        serialPrintflnAlways("=========================");
+        return;
+    }
+
+    serialPrintflnAlways("Slot %d/%d, seq %lu, boot #%u%s",
+                         currentSlot, STORAGE_SLOT_COUNT, (unsigned long)committed.seq,
+                         working.bootCount, state == STORE_WRITE_CYCLE ? " (writing)" : "");
+    serialPrintflnAlways("Commits: %lu, unchanged %lu, interval %lu s",
+                         (unsigned long)stats.commits, (unsigned long)stats.unchanged,
+                         (unsigned long)(STORAGE_COMMIT_INTERVAL_MS / 1000));
+    serialPrintflnAlways("Page write: %lu us (max %lu) + %d ms tWR",
+                         (unsigned long)stats.commitUs, (unsigned long)stats.commitMaxUs,
+                         STORAGE_WRITE_CYCLE_MS);
+    serialPrintflnAlways("Errors: write %lu, verify %lu, read %lu",
+                         (unsigned long)stats.writeErrors, (unsigned long)stats.verifyErrors,
+                         (unsigned long)stats.readErrors);
+    serialPrintflnAlways("Boot scan: %d valid, %d corrupt", stats.validSlots, stats.corruptSlots);
+    // Tiap commit ke slot berikutnya: wear per page ~ seq / jumlah slot
+    serialPrintflnAlways("Wear: ~%lu writes/page (AT24C32: 1M)",
+                         (unsigned long)(committed.seq / STORAGE_SLOT_COUNT + 1));
+    serialPrintflnAlways("SOC: %d%%, settings 0x%02X",
+                         working.soc == STORAGE_SOC_UNKNOWN ? -1 : working.soc, working.settings);
+    serialPrintflnAlways("=========================");
+}
+
+void printTripInfo() {
+    serialPrintflnAlways("Odometer: %lu.%lu km",
+                         (unsigned long)(vehicle.odometer / 1000),
+                         (unsigned long)(vehicle.odometer % 1000 / 100));
+    serialPrintflnAlways("Trip: %lu.%lu km, %lu:%02lu moving",
+                         (unsigned long)(vehicle.tripMeters / 1000),
+                         (unsigned long)(vehicle.tripMeters % 1000 / 100),
+                         (unsigned long)(vehicle.tripSeconds / 3600),
+                         (unsigned long)(vehicle.tripSeconds / 60 % 60));
+}
@@ -0,0 +1,66 @@
+#ifndef FOX_STORAGE_H
+#define FOX_STORAGE_H
+
+#include <Arduino.h>
+#include "fox_config.h"
+
+// =============================================
+// PERSISTENT STORAGE - AT24C32 DI MODUL DS3231
+// =============================================
+// Satu record = satu page EEPROM (32 byte). Tiap commit ditulis ke slot
+// berikutnya (ring STORAGE_SLOT_COUNT slot) dengan seq +1, jadi wear tersebar
+// dan record lama tetap utuh jika listrik putus di tengah tulis. Saat boot
+// record dengan CRC valid dan seq terbesar yang dipakai.
+
+#define STORAGE_RECORD_MAGIC 0xF5
+#define STORAGE_RECORD_VERSION 1
+#define STORAGE_SOC_UNKNOWN 0xFF
+
+// Bit settings
+#define STORAGE_SETTING_DEBUG 0x01
+
+typedef struct __attribute__((packed)) {
+    uint8_t magic;
+    uint8_t version;
+    uint16_t bootCount;
+    uint32_t seq;               // Naik tiap commit, record terbaru = seq terbesar
+    uint32_t odometer;          // Meter
+    uint32_t tripMeters;
+    uint32_t tripSeconds;       // Waktu bergerak sejak trip reset
+    uint8_t soc;                // SOC terakhir dari BMS (STORAGE_SOC_UNKNOWN = belum ada)
+    uint8_t settings;           // STORAGE_SETTING_*
+    uint8_t reserved[8];
+    uint16_t crc;               // CRC16-CCITT semua byte sebelumnya
+} StorageRecord;
+
+typedef struct {
+    uint32_t commits;
+    uint32_t unchanged;         // Interval lewat tapi isi sama, tidak ditulis
+    uint32_t writeErrors;       // NACK / timeout saat tulis page
+    uint32_t verifyErrors;      // Baca ulang tidak sama (slot dilewati)
+    uint32_t readErrors;
+    uint32_t commitUs;          // Tulis page terakhir (tanpa tWR)
+    uint32_t commitMaxUs;
+    uint16_t validSlots;        // Hasil scan saat boot
+    uint16_t corruptSlots;      // CRC salah (mis. listrik putus saat tulis)
+} StorageStats;
+
+bool initStorage();             // Scan slot, muat record terbaru ke vehicle
+bool isStorageAvailable();
+
+// Dipanggil berkala dari loop: integrasi odometer/trip lalu commit batch
+void storageServiceTick();
+void storageRequestCommit();    // Commit secepatnya (trip reset, setting)
+
+void storageResetTrip();
+void storageSetSOC(uint8_t soc);
+uint8_t storageGetSOC();
+void storageSetSetting(uint8_t mask, bool enable);
+uint8_t storageGetSettings();
+
+// Statistik
+void getStorageStats(StorageStats &stats);
+void printStorageStats();
+void printTripInfo();
+
+#endif
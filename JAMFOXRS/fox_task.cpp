@@ -3,6 +3,9 @@
 #include "fox_canbus.h"
 #include "fox_serial.h"
 #include "fox_display.h"
+#include "fox_oled.h"
+#include "fox_i2c.h"
+#include "fox_ble.h"
 
 #ifdef ESP32
 
@@ -12,6 +15,9 @@
 TaskHandle_t canTaskHandle = NULL;
 TaskHandle_t displayTaskHandle = NULL;
 TaskHandle_t serialTaskHandle = NULL;
+TaskHandle_t oledFlushTaskHandle = NULL;
+TaskHandle_t i2cBusTaskHandle = NULL;
+TaskHandle_t bleTaskHandle = NULL;
 
 // Semaphores & Mutexes
 SemaphoreHandle_t dataMutex = NULL;
@@ -54,6 +60,17 @@ void createTasks() {
         CORE_CAN                 // Core 0
     );
     
+    // I2C bus owner: OLED flush, RTC, EEPROM lewat satu antrian
+    xTaskCreatePinnedToCore(
+        i2cBusTask,              // Task function
+        "I2C_Bus",               // Task name
+        I2C_BUS_TASK_STACK_SIZE, // Stack size
+        NULL,                    // Parameters
+        I2C_BUS_TASK_PRIORITY,   // Priority
+        &i2cBusTaskHandle,       // Task handle
+        I2C_BUS_TASK_CORE        // Core 1
+    );
+    
     // Create Display Task on Core 1
     if (DISPLAY_TASK_ENABLED) {
         xTaskCreatePinnedToCore(
@@ -65,6 +82,30 @@ void createTasks() {
             &displayTaskHandle,      // Task handle
             DISPLAY_TASK_CORE        // Core 1
         );
+        
+        // Flush task: kirim front buffer ke OLED per chunk
+        xTaskCreatePinnedToCore(
+            oledFlushTask,              // Task function
+            "OLED_Flush",               // Task name
+            OLED_FLUSH_TASK_STACK_SIZE, // Stack size
+            NULL,                       // Parameters
+            OLED_FLUSH_TASK_PRIORITY,   // Priority
+            &oledFlushTaskHandle,       // Task handle
+            DISPLAY_TASK_CORE           // Core 1
+        );
+    }
+    
+    // BLE streaming: jadwal notifikasi lepas dari loop()
+    if (BLE_TASK_ENABLED) {
+        xTaskCreatePinnedToCore(
+            bleTask,                 // Task function
+            "BLE_Stream",            // Task name
+            BLE_TASK_STACK_SIZE,     // Stack size
+            NULL,                    // Parameters
+            BLE_TASK_PRIORITY,       // Priority
+            &bleTaskHandle,          // Task handle
+            BLE_TASK_CORE            // Core 0
+        );
     }
     
     serialPrintflnAlways("[FreeRTOS] CAN Task created on Core %d", CORE_CAN);
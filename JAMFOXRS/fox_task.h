@@ -13,6 +13,9 @@
 extern TaskHandle_t canTaskHandle;
 extern TaskHandle_t displayTaskHandle; 
 extern TaskHandle_t serialTaskHandle;
+extern TaskHandle_t oledFlushTaskHandle;
+extern TaskHandle_t i2cBusTaskHandle;
+extern TaskHandle_t bleTaskHandle;
 
 // Semaphores & Queues
 extern SemaphoreHandle_t i2cMutex;
@@ -1,5 +1,6 @@
 #include "fox_vehicle.h"
 #include "fox_config.h"
+#include "fox_storage.h"
 #include <Arduino.h>
 
 // =============================================
@@ -91,7 +92,7 @@ void initVehicleData() {
     vehicle.rawCurrentHex = 0;
     vehicle.rawVoltageHex = 0;
     vehicle.rawSOCHex = 0;
-    vehicle.rawBalanceHex = "00 00 00 00 00 00";
+    strcpy(vehicle.rawBalanceHex, "00 00 00 00 00 00");
     
     // Timing
     vehicle.lastMessageTime = 0;
@@ -268,7 +269,7 @@ void resetAllVehicleData() {
     resetBMSData();
     resetChargerData();
     
-    vehicle.odometer = 0;
+    // Odometer & trip persistent (fox_storage), tidak ikut di-reset
     vehicle.lastMessageTime = 0;
 }
 
@@ -308,15 +309,16 @@ void printVehicleData() {
 // =============================================
 // DATA PERSISTENCE FUNCTIONS
 // =============================================
+// Disimpan ke record AT24C32 pada commit berikutnya (fox_storage, batch)
 void saveSOCToStorage(uint8_t soc) {
-    // Placeholder for SOC storage
-    Serial.printf("Saving SOC to storage: %d%%\n", soc);
+    if (!isSOCValid(soc)) return;
+    storageSetSOC(soc);
 }
 
 uint8_t loadSOCFromStorage() {
-    // Placeholder for SOC loading
-    Serial.println("Loading SOC from storage");
-    return 50;  // Default 50%
+    uint8_t soc = storageGetSOC();
+    if (!isSOCValid(soc)) return 50;  // Default 50% jika belum pernah tersimpan
+    return soc;
 }
 
 // =============================================
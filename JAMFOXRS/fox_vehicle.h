@@ -59,13 +59,15 @@ struct VehicleData {
     uint8_t chargerStatus;
     
     // ========== ODOMETER ==========
-    uint32_t odometer;            // Odometer in meters
+    uint32_t odometer;            // Odometer in meters (persistent, fox_storage)
+    uint32_t tripMeters;          // Trip sejak TRIP RESET
+    uint32_t tripSeconds;         // Waktu bergerak trip
     
     // ========== RAW DATA FOR DEBUG ==========
     uint16_t rawCurrentHex;
     uint16_t rawVoltageHex;
     uint16_t rawSOCHex;
-    String rawBalanceHex;
+    char rawBalanceHex[18];       // "XX XX XX XX XX XX"
 };
 
 // Global instance
@@ -0,0 +1,80 @@
+// =============================================
+// FUZZ TARGET - PARSER COMMAND BLE (fox_blecmd)
+// =============================================
+// libFuzzer (clang): ./_gate_build/fuzz_blecmd host/corpus/blecmd -dict=host/fuzz/blecmd.dict
+// Di gcc target yang sama dijalankan ulang atas corpus oleh test_blecmd_replay.
+//
+// Input disalin ke buffer seukuran input (tanpa NUL) supaya ASan menangkap
+// baca lewat batas. Pelanggaran invariant = abort, dianggap crash oleh libFuzzer.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "fox_blecmd.h"
+
+static void require(bool ok, const char* what) {
+    if (ok) return;
+    fprintf(stderr, "fuzz_blecmd: %s\n", what);
+    abort();
+}
+
+static bool spanInside(const char* span, size_t len, const char* begin, const char* end) {
+    return span >= begin && span <= end && len <= (size_t)(end - span);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    // Panjang dipotong seperti dispatchBleCommand (MAX_LEN + 1 -> TOO_LONG)
+    uint16_t len = (uint16_t)(size < BLE_CMD_MAX_LEN + 1 ? size : BLE_CMD_MAX_LEN + 1);
+    std::vector<char> input(data, data + len);
+    const char* begin = input.data();
+    const char* end = begin + len;
+
+    BleCmdMessage msg;
+    BleCmdStatus status = bleCmdParse(begin, len, msg);
+    require(status < BLE_CMD_STATUS_COUNT, "status di luar enum");
+    require(bleCmdStatusName(status)[0] != '?', "status tanpa nama");
+
+    if (status != BLE_CMD_OK) return 0;
+    require(len <= BLE_CMD_MAX_LEN, "input terlalu panjang diterima");
+    require(msg.count <= BLE_CMD_MAX_FIELDS, "field melebihi batas");
+
+    for (uint8_t i = 0; i < msg.count; i++) {
+        const BleCmdField &field = msg.fields[i];
+        require(spanInside(field.key, field.keyLen, begin, end), "key di luar buffer");
+        require(spanInside(field.value, field.valueLen, begin, end), "value di luar buffer");
+        require(field.type <= BLE_VAL_NESTED, "tipe tidak dikenal");
+        if (field.type == BLE_VAL_BOOL) {
+            require(field.valueLen == 4 || field.valueLen == 5, "bool bukan true/false");
+        }
+        if (field.type == BLE_VAL_NESTED) {
+            char open = field.value[0];
+            char close = field.value[field.valueLen - 1];
+            require((open == '{' && close == '}') || (open == '[' && close == ']'), "nested tidak seimbang");
+        }
+    }
+    if (msg.cmd != NULL) {
+        require(msg.cmd >= msg.fields && msg.cmd < msg.fields + msg.count, "cmd bukan field pesan");
+        require(msg.cmd->type == BLE_VAL_STRING, "cmd bukan string");
+    }
+
+    // Accessor atas setiap key yang ada: key dicopy ke NUL-terminated dulu
+    for (uint8_t i = 0; i < msg.count; i++) {
+        char key[256];
+        memcpy(key, msg.fields[i].key, msg.fields[i].keyLen);
+        key[msg.fields[i].keyLen] = '\0';
+        if (strlen(key) != msg.fields[i].keyLen) continue;   // \u0000 mentah di key
+
+        const BleCmdField* found = bleCmdFind(msg, key);
+        require(found != NULL && found <= &msg.fields[i], "key tidak ditemukan lagi");
+        bleCmdInt(msg, key, 0);
+        bleCmdBool(msg, key, false);
+        const char* value;
+        uint16_t valueLen;
+        if (bleCmdString(msg, key, value, valueLen)) {
+            require(spanInside(value, valueLen, begin, end), "string di luar buffer");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include <Adafruit_GFX.h>
+#include "glcdfont.h"
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+    _width = WIDTH;
+    _height = HEIGHT;
+    rotation = 0;
+    cursor_y = cursor_x = 0;
+    textsize_x = textsize_y = 1;
+    textcolor = textbgcolor = 0xFFFF;
+    wrap = true;
+    _cp437 = false;
+    gfxFont = NULL;
+}
+
+// =============================================
+// PRIMITIF
+// =============================================
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+// Bresenham
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+        if (steep) drawPixel(y0, x0, color);
+        else drawPixel(x0, y0, color);
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// =============================================
+// TEKS
+// =============================================
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t size_x, uint8_t size_y) {
+    if (!gfxFont) {
+        if ((x >= _width) || (y >= _height) || ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0)) return;
+        if (!_cp437 && (c >= 176)) c++;
+
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1) {
+                    if (size_x == 1 && size_y == 1) drawPixel(x + i, y + j, color);
+                    else fillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+                } else if (bg != color) {
+                    if (size_x == 1 && size_y == 1) drawPixel(x + i, y + j, bg);
+                    else fillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+                }
+            }
+        }
+        // Latar opaque: kolom spasi ke-6 ikut digambar
+        if (bg != color) {
+            if (size_x == 1 && size_y == 1) drawFastVLine(x + 5, y, 8, bg);
+            else fillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+        }
+        return;
+    }
+
+    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+    const GFXglyph* glyph = gfxFont->glyph + c;
+    const uint8_t* bitmap = gfxFont->bitmap;
+
+    uint16_t bo = glyph->bitmapOffset;
+    uint8_t w = glyph->width;
+    uint8_t h = glyph->height;
+    int8_t xo = glyph->xOffset;
+    int8_t yo = glyph->yOffset;
+    uint8_t bits = 0;
+    uint8_t bit = 0;
+    int16_t xo16 = 0;
+    int16_t yo16 = 0;
+
+    if (size_x > 1 || size_y > 1) {
+        xo16 = xo;
+        yo16 = yo;
+    }
+
+    // Bitmap glyph bersambung antar baris (MSB dulu), tanpa padding per baris
+    for (uint8_t yy = 0; yy < h; yy++) {
+        for (uint8_t xx = 0; xx < w; xx++) {
+            if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+            if (bits & 0x80) {
+                if (size_x == 1 && size_y == 1) drawPixel(x + xo + xx, y + yo + yy, color);
+                else fillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y, size_x, size_y, color);
+            }
+            bits <<= 1;
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (!gfxFont) {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        } else if (c != '\r') {
+            if (wrap && ((cursor_x + textsize_x * 6) > _width)) {
+                cursor_x = 0;
+                cursor_y += textsize_y * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            cursor_x += textsize_x * 6;
+        }
+        return 1;
+    }
+
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+    } else if (c != '\r') {
+        uint8_t first = pgm_read_byte(&gfxFont->first);
+        if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+            const GFXglyph* glyph = gfxFont->glyph + (c - first);
+            uint8_t w = glyph->width;
+            uint8_t h = glyph->height;
+            if ((w > 0) && (h > 0)) {
+                int16_t xo = glyph->xOffset;
+                if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+                    cursor_x = 0;
+                    cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                }
+                drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            }
+            cursor_x += glyph->xAdvance * (int16_t)textsize_x;
+        }
+    }
+    return 1;
+}
+
+// Font classic: cursor di pojok kiri atas; font custom: di baseline
+void Adafruit_GFX::setFont(const GFXfont* f) {
+    if (f) {
+        if (!gfxFont) cursor_y += 6;
+    } else if (gfxFont) {
+        cursor_y -= 6;
+    }
+    gfxFont = (GFXfont*)f;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny,
+                              int16_t* maxx, int16_t* maxy) {
+    if (gfxFont) {
+        if (c == '\n') {
+            *x = 0;
+            *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        } else if (c != '\r') {
+            uint8_t first = pgm_read_byte(&gfxFont->first);
+            uint8_t last = pgm_read_byte(&gfxFont->last);
+            if ((c >= first) && (c <= last)) {
+                const GFXglyph* glyph = gfxFont->glyph + (c - first);
+                uint8_t gw = glyph->width;
+                uint8_t gh = glyph->height;
+                uint8_t xa = glyph->xAdvance;
+                int8_t xo = glyph->xOffset;
+                int8_t yo = glyph->yOffset;
+                if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+                    *x = 0;
+                    *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                }
+                int16_t tsx = (int16_t)textsize_x;
+                int16_t tsy = (int16_t)textsize_y;
+                int16_t x1 = *x + xo * tsx;
+                int16_t y1 = *y + yo * tsy;
+                int16_t x2 = x1 + gw * tsx - 1;
+                int16_t y2 = y1 + gh * tsy - 1;
+                if (x1 < *minx) *minx = x1;
+                if (y1 < *miny) *miny = y1;
+                if (x2 > *maxx) *maxx = x2;
+                if (y2 > *maxy) *maxy = y2;
+                *x += xa * tsx;
+            }
+        }
+        return;
+    }
+
+    if (c == '\n') {
+        *x = 0;
+        *y += textsize_y * 8;
+    } else if (c != '\r') {
+        if (wrap && ((*x + textsize_x * 6) > _width)) {
+            *x = 0;
+            *y += textsize_y * 8;
+        }
+        int x2 = *x + textsize_x * 6 - 1;
+        int y2 = *y + textsize_y * 8 - 1;
+        if (x2 > *maxx) *maxx = x2;
+        if (y2 > *maxy) *maxy = y2;
+        if (*x < *minx) *minx = *x;
+        if (*y < *miny) *miny = *y;
+        *x += textsize_x * 6;
+    }
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                                 uint16_t* w, uint16_t* h) {
+    uint8_t c;
+    int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+
+    while ((c = *str++)) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+
+    if (maxx >= minx) {
+        *x1 = minx;
+        *w = maxx - minx + 1;
+    }
+    if (maxy >= miny) {
+        *y1 = miny;
+        *h = maxy - miny + 1;
+    }
+}
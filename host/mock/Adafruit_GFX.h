@@ -0,0 +1,73 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+// =============================================
+// HOST ADAFRUIT GFX - SUBSET YANG DIPAKAI FIRMWARE
+// =============================================
+// write/drawChar/charBounds/getTextBounds/setFont mengikuti algoritma
+// Adafruit_GFX 1.11 (termasuk geser cursor 6 px saat ganti font classic <->
+// custom), supaya posisi pixel sama dengan library asli.
+#include <Arduino.h>
+#include "gfxfont.h"
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                  uint8_t size_x, uint8_t size_y);
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextSize(uint8_t s) { setTextSize(s, s); }
+    void setTextSize(uint8_t sx, uint8_t sy) { textsize_x = sx > 0 ? sx : 1; textsize_y = sy > 0 ? sy : 1; }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool x = true) { _cp437 = x; }
+    void setFont(const GFXfont* f = NULL);
+
+    void getTextBounds(const char* string, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                       uint16_t* w, uint16_t* h);
+    void getTextBounds(const String& str, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                       uint16_t* w, uint16_t* h) {
+        getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+    }
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+    uint8_t getRotation() const { return rotation; }
+
+protected:
+    void charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny,
+                    int16_t* maxx, int16_t* maxy);
+
+    const int16_t WIDTH;
+    const int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize_x;
+    uint8_t textsize_y;
+    uint8_t rotation;
+    bool wrap;
+    bool _cp437;
+    GFXfont* gfxFont;
+};
+
+#endif
@@ -0,0 +1,524 @@
+#include <Arduino.h>
+#include <driver/twai.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include "host.h"
+#include "host_internal.h"
+
+#include <ctype.h>
+#include <deque>
+
+// =============================================
+// WAKTU
+// =============================================
+unsigned long millis() {
+    return (unsigned long)(hostTickUs() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)hostTickUs();
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)hostTickUs();
+}
+
+void delay(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+// Busy-wait di device: waktu maju tanpa memberi giliran ke task lain
+void delayMicroseconds(uint32_t us) {
+    hostAdvanceUs(us);
+}
+
+void yield() {
+    taskYIELD();
+}
+
+// =============================================
+// GPIO
+// =============================================
+#define HOST_PIN_COUNT 64
+
+typedef struct {
+    uint8_t mode;
+    int output;
+    int driven;                 // Dari luar (test), -1 = mengambang
+    void (*isr)(void);
+    int isrMode;
+} HostPin;
+
+static HostPin pins[HOST_PIN_COUNT];
+
+static HostPin* pinAt(uint8_t pin) {
+    static bool initialized = false;
+    if (!initialized) {
+        for (int i = 0; i < HOST_PIN_COUNT; i++) {
+            pins[i].output = LOW;
+            pins[i].driven = -1;
+        }
+        initialized = true;
+    }
+    return pin < HOST_PIN_COUNT ? &pins[pin] : NULL;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    HostPin* p = pinAt(pin);
+    if (p == NULL) return;
+    p->mode = mode;
+    hostI2CPinWrite(pin, mode, p->output);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    HostPin* p = pinAt(pin);
+    if (p == NULL) return;
+    p->output = val ? HIGH : LOW;
+    hostI2CPinWrite(pin, p->mode, p->output);
+}
+
+int digitalRead(uint8_t pin) {
+    HostPin* p = pinAt(pin);
+    if (p == NULL) return LOW;
+
+    int level;
+    if (hostI2CPinRead(pin, &level)) return level;
+
+    if (p->driven >= 0) return p->driven;
+    if ((p->mode & OUTPUT) == OUTPUT) return p->output;
+    return (p->mode & PULLUP) ? HIGH : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+    HostPin* p = pinAt(pin);
+    if (p == NULL) return;
+    p->isr = isr;
+    p->isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    HostPin* p = pinAt(pin);
+    if (p != NULL) p->isr = NULL;
+}
+
+void hostPinDrive(uint8_t pin, int level) {
+    HostPin* p = pinAt(pin);
+    if (p == NULL) return;
+    int before = digitalRead(pin);
+    p->driven = level;
+    int after = digitalRead(pin);
+
+    if (p->isr == NULL || before == after) return;
+    if (p->isrMode == CHANGE || (p->isrMode == FALLING && after == LOW) ||
+        (p->isrMode == RISING && after == HIGH)) {
+        p->isr();
+    }
+}
+
+uint8_t hostPinMode(uint8_t pin) {
+    HostPin* p = pinAt(pin);
+    return p != NULL ? p->mode : 0;
+}
+
+int hostPinOutput(uint8_t pin) {
+    HostPin* p = pinAt(pin);
+    return p != NULL ? p->output : LOW;
+}
+
+void hostFireInterrupt(uint8_t pin) {
+    HostPin* p = pinAt(pin);
+    if (p != NULL && p->isr != NULL) p->isr();
+}
+
+// =============================================
+// DTOSTRF (SAMA DENGAN stdlib_noniso.c ARDUINO-ESP32)
+// =============================================
+char* dtostrf(double number, signed char width, unsigned char prec, char* s) {
+    bool negative = false;
+
+    if (isnan(number)) {
+        strcpy(s, "nan");
+        return s;
+    }
+    if (isinf(number)) {
+        strcpy(s, "inf");
+        return s;
+    }
+
+    char* out = s;
+    int fillme = width;
+    if (prec > 0) fillme -= (prec + 1);
+
+    if (number < 0.0) {
+        negative = true;
+        fillme--;
+        number = -number;
+    }
+
+    // Pembulatan supaya print(1.999, 2) jadi "2.00"
+    double rounding = 2.0;
+    for (uint8_t i = 0; i < prec; ++i) rounding *= 10.0;
+    rounding = 1.0 / rounding;
+    number += rounding;
+
+    double tenpow = 1.0;
+    int digitcount = 1;
+    while (number >= 10.0 * tenpow) {
+        tenpow *= 10.0;
+        digitcount++;
+    }
+    number /= tenpow;
+    fillme -= digitcount;
+
+    while (fillme-- > 0) *out++ = ' ';
+    if (negative) *out++ = '-';
+
+    digitcount += prec;
+    int8_t digit = 0;
+    while (digitcount-- > 0) {
+        digit = (int8_t)number;
+        if (digit > 9) digit = 9;
+        *out++ = (char)('0' | digit);
+        if ((digitcount == prec) && (prec > 0)) *out++ = '.';
+        number -= digit;
+        number *= 10.0;
+    }
+
+    *out = 0;
+    return s;
+}
+
+// =============================================
+// STRING
+// =============================================
+static std::string numberToString(unsigned long value, unsigned char base, bool negative) {
+    if (base < 2) base = 10;
+    char digits[66];
+    int pos = sizeof(digits) - 1;
+    digits[pos] = '\0';
+    do {
+        unsigned d = value % base;
+        digits[--pos] = d < 10 ? '0' + d : 'a' + d - 10;
+        value /= base;
+    } while (value > 0);
+    if (negative) digits[--pos] = '-';
+    return std::string(digits + pos);
+}
+
+String::String(const char* cstr) : s(cstr ? cstr : "") {}
+String::String(char c) : s(1, c) {}
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+    if (base == 10 && value < 0) s = numberToString(-(unsigned long)value, base, true);
+    else s = numberToString((unsigned long)value, base, false);
+}
+
+String::String(unsigned long value, unsigned char base) : s(numberToString(value, base, false)) {}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char buf[33];
+    s = dtostrf(value, (decimalPlaces + 2), decimalPlaces, buf);
+}
+
+String& String::operator=(const char* cstr) {
+    s = cstr ? cstr : "";
+    return *this;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < s.length() ? s[index] : 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t pos = s.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int from) const {
+    size_t pos = s.find(str.s, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t pos = s.rfind(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int begin) const {
+    return substring(begin, s.length());
+}
+
+String String::substring(unsigned int begin, unsigned int end) const {
+    if (begin > end) std::swap(begin, end);
+    if (begin >= s.length()) return String();
+    if (end > s.length()) end = s.length();
+    return String(s.substr(begin, end - begin).c_str());
+}
+
+bool String::startsWith(const String& prefix) const {
+    return s.compare(0, prefix.s.length(), prefix.s) == 0 && prefix.s.length() <= s.length();
+}
+
+bool String::endsWith(const String& suffix) const {
+    return suffix.s.length() <= s.length() &&
+           s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (s.length() != other.s.length()) return false;
+    for (size_t i = 0; i < s.length(); i++) {
+        if (tolower((unsigned char)s[i]) != tolower((unsigned char)other.s[i])) return false;
+    }
+    return true;
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < s.length() && isspace((unsigned char)s[begin])) begin++;
+    size_t end = s.length();
+    while (end > begin && isspace((unsigned char)s[end - 1])) end--;
+    s = s.substr(begin, end - begin);
+}
+
+void String::toUpperCase() {
+    for (char& c : s) c = toupper((unsigned char)c);
+}
+
+void String::toLowerCase() {
+    for (char& c : s) c = tolower((unsigned char)c);
+}
+
+void String::remove(unsigned int index) {
+    if (index < s.length()) s.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < s.length()) s.erase(index, count);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find.s.empty()) return;
+    size_t pos = 0;
+    while ((pos = s.find(find.s, pos)) != std::string::npos) {
+        s.replace(pos, find.s.length(), replacement.s);
+        pos += replacement.s.length();
+    }
+}
+
+long String::toInt() const {
+    return atol(s.c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(s.c_str());
+}
+
+String operator+(const String& a, const String& b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
+
+String operator+(const String& a, const char* b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
+
+String operator+(const char* a, const String& b) {
+    String result(a);
+    result.concat(b);
+    return result;
+}
+
+// =============================================
+// PRINT
+// =============================================
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::print(long value, int base) {
+    String text(value, (unsigned char)base);
+    return write(text.c_str());
+}
+
+size_t Print::print(unsigned long value, int base) {
+    String text(value, (unsigned char)base);
+    return write(text.c_str());
+}
+
+size_t Print::print(double value, int digits) {
+    char buf[40];
+    dtostrf(value, 0, digits, buf);
+    return write(buf);
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+
+    std::string big(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+}
+
+// =============================================
+// SERIAL
+// =============================================
+HardwareSerial Serial;
+
+static std::string& serialCaptured = *new std::string;
+static std::deque<char>& serialInput = *new std::deque<char>;
+static bool serialEcho = true;
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    serialCaptured.append((const char*)buffer, size);
+    if (serialEcho) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+int HardwareSerial::available() {
+    return (int)serialInput.size();
+}
+
+int HardwareSerial::read() {
+    if (serialInput.empty()) return -1;
+    char c = serialInput.front();
+    serialInput.pop_front();
+    return (uint8_t)c;
+}
+
+int HardwareSerial::peek() {
+    return serialInput.empty() ? -1 : (uint8_t)serialInput.front();
+}
+
+String HardwareSerial::readStringUntil(char terminator) {
+    std::string line;
+    while (!serialInput.empty()) {
+        char c = serialInput.front();
+        serialInput.pop_front();
+        if (c == terminator) break;
+        line += c;
+    }
+    return String(line.c_str());
+}
+
+void hostSerialInput(const char* text) {
+    while (*text) serialInput.push_back(*text++);
+}
+
+std::string hostSerialTake() {
+    std::string out;
+    out.swap(serialCaptured);
+    return out;
+}
+
+void hostSerialEcho(bool on) {
+    serialEcho = on;
+}
+
+// =============================================
+// ESP & HEAP
+// =============================================
+EspClass ESP;
+
+static uint32_t freeHeap = 180000;
+
+void hostSetFreeHeap(uint32_t bytes) {
+    freeHeap = bytes;
+}
+
+uint32_t EspClass::getFreeHeap() { return freeHeap; }
+uint32_t EspClass::getMinFreeHeap() { return freeHeap - 4096; }
+uint32_t EspClass::getMaxAllocHeap() { return freeHeap / 2; }
+uint32_t EspClass::getHeapSize() { return 320000; }
+uint32_t EspClass::getSketchSize() { return 0; }
+uint32_t EspClass::getFreeSketchSpace() { return 1310720; }
+
+void EspClass::restart() {
+    fprintf(stderr, "[HOST] ESP.restart()\n");
+    abort();
+}
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) {
+    memset(info, 0, sizeof(*info));
+    info->total_free_bytes = freeHeap;
+    info->largest_free_block = freeHeap / 2;
+    info->minimum_free_bytes = freeHeap - 4096;
+    info->total_allocated_bytes = 320000 - freeHeap;
+    info->allocated_blocks = hostHeapLiveBlocks();
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return freeHeap;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return freeHeap / 2;
+}
+
+// =============================================
+// TWAI (CAN)
+// =============================================
+static std::deque<twai_message_t>& canFrames = *new std::deque<twai_message_t>;
+static bool canStarted = false;
+
+esp_err_t twai_driver_install(const twai_general_config_t* g_config, const twai_timing_config_t* t_config,
+                              const twai_filter_config_t* f_config) {
+    return ESP_OK;
+}
+
+esp_err_t twai_driver_uninstall() {
+    canStarted = false;
+    return ESP_OK;
+}
+
+esp_err_t twai_start() {
+    canStarted = true;
+    return ESP_OK;
+}
+
+esp_err_t twai_stop() {
+    canStarted = false;
+    return ESP_OK;
+}
+
+esp_err_t twai_receive(twai_message_t* message, uint32_t ticks_to_wait) {
+    // Antrian kosong: tunggu sekali selama timeout (frame hanya datang dari test)
+    if (canFrames.empty() && ticks_to_wait > 0) vTaskDelay(ticks_to_wait);
+    if (!canStarted || canFrames.empty()) return ESP_ERR_TIMEOUT;
+    *message = canFrames.front();
+    canFrames.pop_front();
+    return ESP_OK;
+}
+
+void hostCanInject(uint32_t id, const uint8_t* data, uint8_t length) {
+    twai_message_t message = {};
+    message.extd = id > 0x7FF;
+    message.identifier = id;
+    message.data_length_code = length > TWAI_FRAME_MAX_DLC ? TWAI_FRAME_MAX_DLC : length;
+    memcpy(message.data, data, message.data_length_code);
+    canFrames.push_back(message);
+}
+
+void hostCanClear() {
+    canFrames.clear();
+}
@@ -0,0 +1,196 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// =============================================
+// HOST BUILD - SUBSET ARDUINO-ESP32
+// =============================================
+// Cukup untuk mengompilasi firmware di PC. Waktu virtual (lihat host.h),
+// Serial ke stdout, pin GPIO disimulasikan (SDA/SCL ikut model bus I2C).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+using std::min;
+using std::max;
+
+#define ESP_ARDUINO_VERSION_MAJOR 2
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define OPEN_DRAIN 0x10
+#define OUTPUT_OPEN_DRAIN 0x13
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define digitalPinToInterrupt(p) (p)
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+char* dtostrf(double number, signed char width, unsigned char prec, char* s);
+
+// =============================================
+// STRING
+// =============================================
+class String {
+public:
+    String(const char* cstr = "");
+    String(const String& other) = default;
+    explicit String(char c);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+    String& operator=(const String& other) = default;
+    String& operator=(const char* cstr);
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.length(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+
+    char charAt(unsigned int index) const;
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return s[index]; }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& str, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    String substring(unsigned int begin) const;
+    String substring(unsigned int begin, unsigned int end) const;
+
+    bool startsWith(const String& prefix) const;
+    bool endsWith(const String& suffix) const;
+    bool equals(const String& other) const { return s == other.s; }
+    bool equalsIgnoreCase(const String& other) const;
+
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void replace(const String& find, const String& replacement);
+    long toInt() const;
+    float toFloat() const;
+
+    bool concat(const String& str) { s += str.s; return true; }
+    bool concat(const char* cstr) { if (cstr) s += cstr; return true; }
+    bool concat(char c) { s += c; return true; }
+    String& operator+=(const String& str) { concat(str); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    String& operator+=(int value) { concat(String(value)); return *this; }
+
+    bool operator==(const String& other) const { return s == other.s; }
+    bool operator==(const char* cstr) const { return s == (cstr ? cstr : ""); }
+    bool operator!=(const String& other) const { return s != other.s; }
+    bool operator!=(const char* cstr) const { return !(*this == cstr); }
+
+    friend String operator+(const String& a, const String& b);
+    friend String operator+(const String& a, const char* b);
+    friend String operator+(const char* a, const String& b);
+
+private:
+    std::string s;
+};
+
+// =============================================
+// PRINT / SERIAL
+// =============================================
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = 10) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = 10) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(T value, int arg) { size_t n = print(value, arg); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) {}
+    void end() {}
+    operator bool() const { return true; }
+    int available();
+    int read();
+    int peek();
+    void flush() {}
+    String readStringUntil(char terminator);
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+};
+
+extern HardwareSerial Serial;
+
+// =============================================
+// ESP
+// =============================================
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+    uint32_t getSketchSize();
+    uint32_t getFreeSketchSpace();
+    uint32_t getCpuFreqMHz() { return 240; }
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif
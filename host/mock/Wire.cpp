@@ -0,0 +1,323 @@
+#include <Wire.h>
+#include "host.h"
+#include "host_i2c.h"
+#include "host_internal.h"
+
+TwoWire Wire(0);
+
+// =============================================
+// BUS
+// =============================================
+#define I2C_DRIVER_OVERHEAD_US 20       // Setup driver + ISR per transaksi (kira-kira ESP32)
+
+static HostI2CDevice* devices[128];
+static bool devicesInitialized = false;
+
+typedef struct {
+    uint8_t address;
+    uint8_t status;
+    uint32_t count;
+} HostFault;
+
+static std::vector<HostFault>& faults = *new std::vector<HostFault>;
+static std::vector<HostI2CTxn>& txnLog = *new std::vector<HostI2CTxn>;
+
+static uint8_t stuckPulses = 0;
+static uint32_t sclPulses = 0;
+static uint32_t stopConditions = 0;
+
+// Pin bus terakhir dari Wire.begin; dipakai bit-bang recovery setelah Wire.end
+static int busSda = -1;
+static int busScl = -1;
+static int sclLevel = HIGH;
+static bool sdaDrivenLow = false;
+
+static void attachDefaults() {
+    memset(devices, 0, sizeof(devices));
+    devices[0x3C] = &hostOled;
+    devices[0x68] = &hostRtc;
+    devices[0x57] = &hostEeprom;
+    devicesInitialized = true;
+}
+
+static HostI2CDevice* deviceAt(uint8_t address) {
+    if (!devicesInitialized) attachDefaults();
+    return address < 128 ? devices[address] : NULL;
+}
+
+void hostI2CAttach(uint8_t address, HostI2CDevice* device) {
+    if (!devicesInitialized) attachDefaults();
+    if (address < 128) devices[address] = device;
+}
+
+void hostI2CDetach(uint8_t address) {
+    hostI2CAttach(address, NULL);
+}
+
+void hostI2CReset() {
+    attachDefaults();
+    hostOled.powerOn();
+    hostRtc.powerOn();
+    hostEeprom.erase();
+    hostI2CClearFaults();
+    hostI2CClearLog();
+    stuckPulses = 0;
+    sclPulses = 0;
+    stopConditions = 0;
+}
+
+void hostI2CInjectFault(uint8_t address, uint8_t status, uint32_t count) {
+    faults.push_back({address, status, count});
+}
+
+void hostI2CClearFaults() {
+    faults.clear();
+}
+
+void hostI2CStickSda(uint8_t pulses) {
+    stuckPulses = pulses;
+}
+
+uint8_t hostI2CStuckPulsesLeft() {
+    return stuckPulses;
+}
+
+uint32_t hostI2CSclPulses() {
+    return sclPulses;
+}
+
+uint32_t hostI2CStopConditions() {
+    return stopConditions;
+}
+
+const std::vector<HostI2CTxn>& hostI2CLog() {
+    return txnLog;
+}
+
+void hostI2CClearLog() {
+    HostHeapUntracked untracked;
+    txnLog.clear();
+}
+
+// Fault pertama yang cocok dipakai dan dikurangi; 0 = tidak ada
+static uint8_t takeFault(uint8_t address) {
+    for (size_t i = 0; i < faults.size(); i++) {
+        HostFault &fault = faults[i];
+        if (fault.address != HOST_I2C_ANY && fault.address != address) continue;
+        uint8_t status = fault.status;
+        if (--fault.count == 0) faults.erase(faults.begin() + i);
+        return status;
+    }
+    return 0;
+}
+
+// =============================================
+// PIN (BIT-BANG RECOVERY)
+// =============================================
+bool hostI2CPinWrite(uint8_t pin, uint8_t mode, int level) {
+    bool drivingLow = (mode & OUTPUT) == OUTPUT && level == LOW;
+
+    if (pin == busScl) {
+        int newLevel = drivingLow ? LOW : HIGH;
+        // Slave menggeser satu bit per pulsa; setelah cukup pulsa SDA dilepas
+        if (sclLevel == LOW && newLevel == HIGH) {
+            sclPulses++;
+            if (stuckPulses > 0) stuckPulses--;
+        }
+        sclLevel = newLevel;
+        return true;
+    }
+    if (pin == busSda) {
+        // STOP: SDA dilepas naik selagi SCL high
+        if (sdaDrivenLow && !drivingLow && sclLevel == HIGH) stopConditions++;
+        sdaDrivenLow = drivingLow;
+        return true;
+    }
+    return false;
+}
+
+bool hostI2CPinRead(uint8_t pin, int* level) {
+    if (pin == busScl) {
+        *level = sclLevel;
+        return true;
+    }
+    if (pin == busSda) {
+        *level = (stuckPulses > 0 || sdaDrivenLow) ? LOW : HIGH;
+        return true;
+    }
+    return false;
+}
+
+// =============================================
+// TWOWIRE
+// =============================================
+void TwoWire::allocate() {
+    delete[] txBuffer;
+    delete[] rxBuffer;
+    txBuffer = new uint8_t[bufferSize];
+    rxBuffer = new uint8_t[bufferSize];
+    txLength = 0;
+    rxLength = 0;
+    rxIndex = 0;
+}
+
+bool TwoWire::begin(int sdaPin, int sclPin, uint32_t frequency) {
+    if (isStarted) return true;
+    sda = sdaPin;
+    scl = sclPin;
+    busSda = sdaPin;
+    busScl = sclPin;
+    sclLevel = HIGH;
+    sdaDrivenLow = false;
+    clockHz = frequency ? frequency : 100000;
+    allocate();
+    isStarted = true;
+    return true;
+}
+
+bool TwoWire::end() {
+    isStarted = false;
+    txActive = false;
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    clockHz = frequency;
+    return true;
+}
+
+// Core 2.x: hanya bisa diubah sebelum begin()
+size_t TwoWire::setBufferSize(size_t size) {
+    if (isStarted || size == 0) return 0;
+    bufferSize = size;
+    return bufferSize;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+    txAddress = address;
+    txLength = 0;
+    txActive = true;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!txActive || txBuffer == NULL || txLength >= bufferSize) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+    for (size_t i = 0; i < quantity; i++) {
+        if (!write(data[i])) return i;
+    }
+    return quantity;
+}
+
+// Waktu di kabel: 9 bit per byte (termasuk ACK) + START/STOP
+static void spendBusTime(size_t bytes, uint32_t clockHz) {
+    uint64_t bits = (uint64_t)bytes * 9 + 2;
+    hostAdvanceUs(I2C_DRIVER_OVERHEAD_US + (bits * 1000000ULL + clockHz - 1) / clockHz);
+}
+
+// Status awal transaksi sebelum byte data: 0 = alamat di-ACK
+static uint8_t openTransaction(uint8_t address, bool read, uint16_t timeoutMs, uint32_t clockHz,
+                               HostI2CDevice** device) {
+    *device = deviceAt(address);
+
+    uint8_t status = 0;
+    if (stuckPulses > 0) status = 5;
+    else status = takeFault(address);
+
+    if (status == 5) {
+        hostAdvanceUs((uint64_t)timeoutMs * 1000);
+        return 5;
+    }
+    if (status == 2 || *device == NULL || !(*device)->select(read)) {
+        spendBusTime(1, clockHz);
+        return 2;
+    }
+    return status;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    if (!isStarted || !txActive || txBuffer == NULL) return 4;
+    txActive = false;
+
+    HostHeapUntracked untracked;
+    HostI2CTxn entry;
+    entry.startUs = hostNowUs();
+    entry.address = (uint8_t)txAddress;
+    entry.read = false;
+    entry.stop = sendStop;
+    entry.clockHz = clockHz;
+    entry.task = hostCurrentTaskName();
+
+    HostI2CDevice* device;
+    uint8_t status = openTransaction((uint8_t)txAddress, false, timeoutMs, clockHz, &device);
+    size_t sent = 0;
+
+    if (status == 0 || status == 3) {
+        // Fault NACK data: byte pertama ditolak
+        if (status == 3) sent = txLength > 0 ? 1 : 0;
+        while (status == 0 && sent < txLength) {
+            if (!device->write(txBuffer[sent++])) status = 3;
+        }
+        if (sendStop || status != 0) device->stop();
+        spendBusTime(1 + sent, clockHz);
+    }
+
+    entry.data.assign(txBuffer, txBuffer + sent);
+    entry.status = status;
+    entry.endUs = hostNowUs();
+    txnLog.push_back(entry);
+
+    txLength = 0;
+    return status;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+    rxLength = 0;
+    rxIndex = 0;
+    if (!isStarted || rxBuffer == NULL) return 0;
+    if (size > bufferSize) size = bufferSize;
+
+    HostHeapUntracked untracked;
+    HostI2CTxn entry;
+    entry.startUs = hostNowUs();
+    entry.address = (uint8_t)address;
+    entry.read = true;
+    entry.stop = sendStop;
+    entry.clockHz = clockHz;
+    entry.task = hostCurrentTaskName();
+
+    HostI2CDevice* device;
+    uint8_t status = openTransaction((uint8_t)address, true, timeoutMs, clockHz, &device);
+    if (status == 3) status = 0;        // Master yang ACK saat baca
+
+    if (status == 0) {
+        for (size_t i = 0; i < size; i++) rxBuffer[i] = device->read();
+        if (sendStop) device->stop();
+        rxLength = size;
+        spendBusTime(1 + size, clockHz);
+    }
+
+    entry.data.assign(rxBuffer, rxBuffer + rxLength);
+    entry.status = status;
+    entry.endUs = hostNowUs();
+    txnLog.push_back(entry);
+
+    return rxLength;
+}
+
+int TwoWire::available() {
+    return (int)(rxLength - rxIndex);
+}
+
+int TwoWire::read() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex++];
+}
+
+int TwoWire::peek() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex];
+}
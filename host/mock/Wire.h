@@ -0,0 +1,82 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// =============================================
+// HOST TWOWIRE - KE BUS I2C SIMULASI
+// =============================================
+// API sama dengan Wire Arduino-ESP32 2.x. Transaksi diteruskan ke device
+// simulasi di host_i2c.h (OLED, DS3231, AT24C32) lengkap dengan fault
+// injection; waktu virtual maju sesuai jumlah bit di clock saat itu.
+#include <Arduino.h>
+
+#define I2C_BUFFER_LENGTH 128
+
+class TwoWire {
+public:
+    TwoWire(uint8_t busNum) : busNum(busNum) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() { return clockHz; }
+    void setTimeOut(uint16_t timeOutMillis) { timeoutMs = timeOutMillis; }
+    uint16_t getTimeOut() { return timeoutMs; }
+    size_t setBufferSize(size_t size);
+
+    void beginTransmission(uint16_t address);
+    void beginTransmission(uint8_t address) { beginTransmission((uint16_t)address); }
+    void beginTransmission(int address) { beginTransmission((uint16_t)address); }
+    uint8_t endTransmission(bool sendStop);
+    uint8_t endTransmission() { return endTransmission(true); }
+
+    size_t requestFrom(uint16_t address, size_t size, bool sendStop);
+    uint8_t requestFrom(uint16_t address, uint8_t size, bool sendStop) {
+        return (uint8_t)requestFrom(address, (size_t)size, sendStop);
+    }
+    uint8_t requestFrom(uint16_t address, uint8_t size, uint8_t sendStop) {
+        return (uint8_t)requestFrom(address, (size_t)size, (bool)sendStop);
+    }
+    uint8_t requestFrom(uint16_t address, uint8_t size) {
+        return (uint8_t)requestFrom(address, (size_t)size, true);
+    }
+    uint8_t requestFrom(uint8_t address, uint8_t size) {
+        return (uint8_t)requestFrom((uint16_t)address, (size_t)size, true);
+    }
+    uint8_t requestFrom(int address, int size) {
+        return (uint8_t)requestFrom((uint16_t)address, (size_t)size, true);
+    }
+
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t quantity);
+    int available();
+    int read();
+    int peek();
+    void flush() {}
+
+    bool started() const { return isStarted; }
+    int sdaPin() const { return sda; }
+    int sclPin() const { return scl; }
+
+private:
+    uint8_t busNum;
+    bool isStarted = false;
+    int sda = -1;
+    int scl = -1;
+    uint32_t clockHz = 100000;
+    uint16_t timeoutMs = 50;
+    size_t bufferSize = I2C_BUFFER_LENGTH;
+
+    uint16_t txAddress = 0;
+    bool txActive = false;
+    uint8_t* txBuffer = NULL;
+    size_t txLength = 0;
+    uint8_t* rxBuffer = NULL;
+    size_t rxLength = 0;
+    size_t rxIndex = 0;
+
+    void allocate();
+};
+
+extern TwoWire Wire;
+
+#endif
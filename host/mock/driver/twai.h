@@ -0,0 +1,78 @@
+#ifndef HOST_DRIVER_TWAI_H
+#define HOST_DRIVER_TWAI_H
+
+// =============================================
+// HOST TWAI (CAN) - ANTRIAN RX DARI TEST
+// =============================================
+// Frame masuk lewat hostCanInject() (host.h); twai_receive mengambil dari
+// antrian yang sama seperti driver asli (tanpa blokir di host).
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+#define TWAI_IO_UNUSED ((gpio_num_t)-1)
+#define TWAI_ALERT_NONE 0
+#define TWAI_FRAME_MAX_DLC 8
+
+typedef enum {
+    TWAI_MODE_NORMAL,
+    TWAI_MODE_NO_ACK,
+    TWAI_MODE_LISTEN_ONLY
+} twai_mode_t;
+
+typedef struct {
+    twai_mode_t mode;
+    gpio_num_t tx_io;
+    gpio_num_t rx_io;
+    gpio_num_t clkout_io;
+    gpio_num_t bus_off_io;
+    uint32_t tx_queue_len;
+    uint32_t rx_queue_len;
+    uint32_t alerts_enabled;
+    uint32_t clkout_divider;
+    int intr_flags;
+} twai_general_config_t;
+
+typedef struct {
+    uint32_t brp;
+    uint8_t tseg_1;
+    uint8_t tseg_2;
+    uint8_t sjw;
+    bool triple_sampling;
+} twai_timing_config_t;
+
+typedef struct {
+    uint32_t acceptance_code;
+    uint32_t acceptance_mask;
+    bool single_filter;
+} twai_filter_config_t;
+
+#define TWAI_TIMING_CONFIG_250KBITS() {16, 15, 4, 3, false}
+#define TWAI_FILTER_CONFIG_ACCEPT_ALL() {0, 0xFFFFFFFF, true}
+
+typedef struct {
+    union {
+        struct {
+            uint32_t extd: 1;
+            uint32_t rtr: 1;
+            uint32_t ss: 1;
+            uint32_t self: 1;
+            uint32_t dlc_non_comp: 1;
+            uint32_t reserved: 27;
+        };
+        uint32_t flags;
+    };
+    uint32_t identifier;
+    uint8_t data_length_code;
+    uint8_t data[TWAI_FRAME_MAX_DLC];
+} twai_message_t;
+
+esp_err_t twai_driver_install(const twai_general_config_t* g_config, const twai_timing_config_t* t_config,
+                              const twai_filter_config_t* f_config);
+esp_err_t twai_driver_uninstall();
+esp_err_t twai_start();
+esp_err_t twai_stop();
+esp_err_t twai_receive(twai_message_t* message, uint32_t ticks_to_wait);
+
+#endif
@@ -0,0 +1,493 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "host.h"
+#include "host_internal.h"
+
+#include <string.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =============================================
+// SCHEDULER KOOPERATIF
+// =============================================
+// Satu mutex global + giliran (current). Task lain menunggu condition
+// variable masing-masing sampai current menunjuk dirinya. Ganti task hanya
+// di block()/yield, jadi kode firmware jalan tanpa balapan dan urutan
+// eksekusi sama di tiap run.
+#define NO_WAKE UINT64_MAX
+
+typedef enum {
+    TASK_READY = 0,
+    TASK_BLOCKED,
+    TASK_DONE
+} HostTaskState;
+
+struct HostTask {
+    const char* name;
+    UBaseType_t priority;
+    TaskFunction_t function;
+    void* parameter;
+    std::condition_variable cv;
+    HostTaskState state;
+    uint64_t readySeq;          // Urutan siap: round-robin di prioritas yang sama
+    uint64_t wakeUs;            // Timeout blokir (NO_WAKE = selamanya)
+    const void* waitObject;     // Objek yang ditunggu (NULL = delay murni)
+    bool timedOut;
+    uint32_t notifyValue;
+    uint64_t semaphoreWaitMaxUs;  // Blokir terlama di xSemaphoreTake
+};
+
+// Mutex konstan (dipakai device simulasi saat static init); daftar task
+// tidak pernah dihapus karena thread task masih menunggu saat proses keluar
+static std::mutex schedMutex;
+static std::vector<HostTask*>& tasks = *new std::vector<HostTask*>;
+static HostTask* current = NULL;
+static uint64_t readyCounter = 0;
+static uint64_t nowUs = 0;
+static uint32_t switches = 0;
+
+static HostTask* loopTask() {
+    static HostTask* task = NULL;
+    if (task == NULL) {
+        task = new HostTask();
+        task->name = "loop";
+        task->priority = 1;
+        task->state = TASK_READY;
+        tasks.push_back(task);
+        current = task;
+    }
+    return task;
+}
+
+static HostTask* self() {
+    if (current == NULL) loopTask();
+    return current;
+}
+
+static void makeReady(HostTask* task) {
+    task->state = TASK_READY;
+    task->waitObject = NULL;
+    task->wakeUs = NO_WAKE;
+    task->readySeq = ++readyCounter;
+}
+
+static HostTask* pickReady() {
+    HostTask* best = NULL;
+    for (HostTask* task : tasks) {
+        if (task->state != TASK_READY) continue;
+        if (best == NULL || task->priority > best->priority ||
+            (task->priority == best->priority && task->readySeq < best->readySeq)) {
+            best = task;
+        }
+    }
+    return best;
+}
+
+// Semua task menunggu: majukan waktu ke timeout terdekat
+static bool advanceToNextWake() {
+    uint64_t next = NO_WAKE;
+    for (HostTask* task : tasks) {
+        if (task->state == TASK_BLOCKED && task->wakeUs < next) next = task->wakeUs;
+    }
+    if (next == NO_WAKE) return false;
+    if (next > nowUs) nowUs = next;
+
+    for (HostTask* task : tasks) {
+        if (task->state == TASK_BLOCKED && task->wakeUs <= nowUs) {
+            task->timedOut = true;
+            makeReady(task);
+        }
+    }
+    return true;
+}
+
+// Serahkan giliran ke task siap berikutnya; kembali saat giliran task ini lagi
+static void schedule(std::unique_lock<std::mutex>& lock) {
+    HostTask* me = current;
+    HostTask* next = pickReady();
+
+    while (next == NULL) {
+        if (!advanceToNextWake()) {
+            fprintf(stderr, "[HOST] Deadlock: all tasks blocked forever (last: %s)\n", me->name);
+            for (HostTask* task : tasks) {
+                fprintf(stderr, "[HOST]   %-14s state %d\n", task->name, task->state);
+            }
+            abort();
+        }
+        next = pickReady();
+    }
+
+    if (next == me) return;
+
+    switches++;
+    current = next;
+    next->cv.notify_one();
+    if (me->state == TASK_DONE) return;
+    me->cv.wait(lock, [me] { return current == me; });
+}
+
+// Blokir task ini sampai wake(object) atau timeout. true = dibangunkan event
+static bool block(std::unique_lock<std::mutex>& lock, const void* object, TickType_t ticks) {
+    HostTask* me = self();
+    me->state = TASK_BLOCKED;
+    me->waitObject = object;
+    me->wakeUs = (ticks == portMAX_DELAY) ? NO_WAKE : nowUs + (uint64_t)ticks * 1000;
+    me->timedOut = false;
+    schedule(lock);
+    return !me->timedOut;
+}
+
+// Bangunkan satu penunggu (prioritas tertinggi, lalu yang paling lama)
+static void wakeOne(const void* object) {
+    HostTask* best = NULL;
+    for (HostTask* task : tasks) {
+        if (task->state != TASK_BLOCKED || task->waitObject != object) continue;
+        if (best == NULL || task->priority > best->priority) best = task;
+    }
+    if (best != NULL) makeReady(best);
+}
+
+static void yieldLocked(std::unique_lock<std::mutex>& lock) {
+    HostTask* me = self();
+    me->readySeq = ++readyCounter;
+    schedule(lock);
+}
+
+static void taskEntry(HostTask* task) {
+    {
+        std::unique_lock<std::mutex> lock(schedMutex);
+        task->cv.wait(lock, [task] { return current == task; });
+    }
+
+    task->function(task->parameter);
+
+    // Task FreeRTOS tidak boleh return; di host cukup dianggap selesai
+    std::unique_lock<std::mutex> lock(schedMutex);
+    task->state = TASK_DONE;
+    schedule(lock);
+}
+
+// =============================================
+// WAKTU
+// =============================================
+uint64_t hostNowUs() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return nowUs;
+}
+
+uint64_t hostTickUs() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return ++nowUs;
+}
+
+void hostAdvanceUs(uint64_t us) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    nowUs += us;
+}
+
+void hostRunMs(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+const char* hostCurrentTaskName() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return self()->name;
+}
+
+uint32_t hostTaskSwitches() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return switches;
+}
+
+uint64_t hostTaskSemaphoreWaitMaxUs(const char* name) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    for (HostTask* task : tasks) {
+        if (strcmp(task->name, name) == 0) return task->semaphoreWaitMaxUs;
+    }
+    return 0;
+}
+
+void hostResetTaskStats() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    for (HostTask* task : tasks) task->semaphoreWaitMaxUs = 0;
+}
+
+// =============================================
+// TASK API
+// =============================================
+BaseType_t xPortGetCoreID() {
+    return 0;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    self();
+
+    HostTask* task = new HostTask();
+    task->name = name;
+    task->priority = priority;
+    task->function = function;
+    task->parameter = parameter;
+    makeReady(task);
+    tasks.push_back(task);
+
+    // Task baru jalan saat pembuat blokir (tanpa preemption)
+    std::thread(taskEntry, task).detach();
+
+    if (handle != NULL) *handle = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameter, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    HostTask* task = handle != NULL ? (HostTask*)handle : self();
+    task->state = TASK_DONE;
+    if (task == current) schedule(lock);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    if (ticks == 0) {
+        yieldLocked(lock);
+        return;
+    }
+    block(lock, NULL, ticks);
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    uint64_t wakeUs = (uint64_t)(*previousWake + increment) * 1000;
+    *previousWake += increment;
+    if (wakeUs <= nowUs) {
+        yieldLocked(lock);
+        return;
+    }
+    block(lock, NULL, (TickType_t)((wakeUs - nowUs + 999) / 1000));
+}
+
+TickType_t xTaskGetTickCount() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return (TickType_t)(nowUs / 1000);
+}
+
+void taskYIELD() {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    yieldLocked(lock);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return self();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return 1024;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    HostTask* task = (HostTask*)handle;
+    task->notifyValue++;
+    if (task->state == TASK_BLOCKED && task->waitObject == &task->notifyValue) makeReady(task);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* higherPriorityTaskWoken) {
+    xTaskNotifyGive(handle);
+    if (higherPriorityTaskWoken != NULL) *higherPriorityTaskWoken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    HostTask* me = self();
+    if (me->notifyValue == 0 && ticks > 0) block(lock, &me->notifyValue, ticks);
+
+    uint32_t value = me->notifyValue;
+    if (clearOnExit) me->notifyValue = 0;
+    else if (value > 0) me->notifyValue--;
+    return value;
+}
+
+// =============================================
+// SEMAPHORE & MUTEX
+// =============================================
+struct HostSemaphore {
+    UBaseType_t count;
+    UBaseType_t maxCount;
+};
+
+static SemaphoreHandle_t createSemaphore(UBaseType_t maxCount, UBaseType_t initialCount) {
+    HostSemaphore* sem = new HostSemaphore();
+    sem->count = initialCount;
+    sem->maxCount = maxCount;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return createSemaphore(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return createSemaphore(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer) {
+    return createSemaphore(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return createSemaphore(maxCount, initialCount);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete (HostSemaphore*)semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    HostSemaphore* sem = (HostSemaphore*)semaphore;
+    HostTask* me = self();
+    uint64_t startUs = nowUs;
+    uint64_t deadline = (ticks == portMAX_DELAY) ? NO_WAKE : nowUs + (uint64_t)ticks * 1000;
+
+    BaseType_t result = pdTRUE;
+    while (sem->count == 0) {
+        if (ticks == 0 || nowUs >= deadline) {
+            result = pdFALSE;
+            break;
+        }
+        TickType_t remaining = (deadline == NO_WAKE) ? portMAX_DELAY
+                                                     : (TickType_t)((deadline - nowUs + 999) / 1000);
+        block(lock, sem, remaining);
+    }
+    if (result == pdTRUE) sem->count--;
+
+    if (nowUs - startUs > me->semaphoreWaitMaxUs) me->semaphoreWaitMaxUs = nowUs - startUs;
+    return result;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    HostSemaphore* sem = (HostSemaphore*)semaphore;
+    if (sem->count >= sem->maxCount) return pdFALSE;
+    sem->count++;
+    wakeOne(sem);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken != NULL) *higherPriorityTaskWoken = pdFALSE;
+    return xSemaphoreGive(semaphore);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return ((HostSemaphore*)semaphore)->count;
+}
+
+// =============================================
+// QUEUE
+// =============================================
+struct HostQueue {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+    char spaceEvent;            // Alamat untuk penunggu slot kosong
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete (HostQueue*)queue;
+}
+
+static BaseType_t queueSend(QueueHandle_t handle, const void* item, TickType_t ticks, bool front) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    HostQueue* queue = (HostQueue*)handle;
+    uint64_t deadline = (ticks == portMAX_DELAY) ? NO_WAKE : nowUs + (uint64_t)ticks * 1000;
+
+    while (queue->items.size() >= queue->length) {
+        if (ticks == 0 || nowUs >= deadline) return pdFALSE;
+        TickType_t remaining = (deadline == NO_WAKE) ? portMAX_DELAY
+                                                     : (TickType_t)((deadline - nowUs + 999) / 1000);
+        block(lock, &queue->spaceEvent, remaining);
+    }
+
+    const uint8_t* bytes = (const uint8_t*)item;
+    std::vector<uint8_t> copy(bytes, bytes + queue->itemSize);
+    if (front) queue->items.push_front(copy);
+    else queue->items.push_back(copy);
+    wakeOne(queue);
+    return pdTRUE;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return queueSend(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return queueSend(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return queueSend(queue, item, ticks, true);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken != NULL) *higherPriorityTaskWoken = pdFALSE;
+    return queueSend(queue, item, 0, false);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(schedMutex);
+    HostQueue* queue = (HostQueue*)handle;
+    uint64_t deadline = (ticks == portMAX_DELAY) ? NO_WAKE : nowUs + (uint64_t)ticks * 1000;
+
+    while (queue->items.empty()) {
+        if (ticks == 0 || nowUs >= deadline) return pdFALSE;
+        TickType_t remaining = (deadline == NO_WAKE) ? portMAX_DELAY
+                                                     : (TickType_t)((deadline - nowUs + 999) / 1000);
+        block(lock, queue, remaining);
+    }
+
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    wakeOne(&queue->spaceEvent);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t handle) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    HostQueue* queue = (HostQueue*)handle;
+    queue->items.clear();
+    wakeOne(&queue->spaceEvent);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    return ((HostQueue*)handle)->items.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t handle) {
+    std::lock_guard<std::mutex> lock(schedMutex);
+    HostQueue* queue = (HostQueue*)handle;
+    return queue->length - queue->items.size();
+}
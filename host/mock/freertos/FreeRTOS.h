@@ -0,0 +1,47 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// =============================================
+// HOST FREERTOS - SCHEDULER KOOPERATIF
+// =============================================
+// Tiap task = thread, tapi hanya satu yang jalan pada satu waktu. Task
+// berganti hanya di titik blokir (delay, notify, semaphore, queue), jadi
+// urutan eksekusi deterministik. Waktu virtual maju saat semua task
+// menunggu, ke timeout terdekat (lihat host.h).
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+// Tanpa preemption tidak ada yang perlu dikunci
+typedef struct {
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+BaseType_t xPortGetCoreID();
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef HOST_GFXFONT_H
+#define HOST_GFXFONT_H
+
+// Format font Adafruit GFX (sama persis dengan gfxfont.h library)
+#include <stdint.h>
+
+typedef struct {
+    uint16_t bitmapOffset;  // Offset ke GFXfont->bitmap
+    uint8_t width;          // Ukuran bitmap (pixel)
+    uint8_t height;
+    uint8_t xAdvance;       // Jarak geser cursor (x)
+    int8_t xOffset;         // Jarak dari cursor ke pojok kiri atas
+    int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+    uint8_t* bitmap;        // Bitmap glyph, bersambung antar baris
+    GFXglyph* glyph;
+    uint16_t first;         // Karakter ASCII pertama & terakhir
+    uint16_t last;
+    uint8_t yAdvance;       // Jarak baris
+} GFXfont;
+
+#endif
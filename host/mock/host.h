@@ -0,0 +1,45 @@
+#ifndef HOST_H
+#define HOST_H
+
+// =============================================
+// HOST CONTROL - DIPAKAI TEST, BUKAN FIRMWARE
+// =============================================
+#include <Arduino.h>
+#include <string>
+
+// Waktu virtual. Tiap baca micros()/millis() menambah 1 us supaya loop
+// busy-wait tetap selesai; selebihnya waktu hanya maju saat semua task
+// menunggu (ke timeout terdekat) atau lewat delayMicroseconds/hostRunMs.
+uint64_t hostNowUs();
+void hostAdvanceUs(uint64_t us);            // Tanpa menjalankan task lain
+void hostRunMs(uint32_t ms);                // Task pemanggil tidur, task lain jalan
+
+// Scheduler: nama task yang sedang jalan ("loop" = thread test)
+const char* hostCurrentTaskName();
+uint32_t hostTaskSwitches();
+uint64_t hostTaskSemaphoreWaitMaxUs(const char* name);   // Blokir terlama di xSemaphoreTake
+void hostResetTaskStats();
+
+// Serial: output selalu ditangkap, echo ke stdout bisa dimatikan
+void hostSerialInput(const char* text);
+std::string hostSerialTake();
+void hostSerialEcho(bool on);
+
+// GPIO: level yang didorong dari luar (tombol, SQW); -1 = mengambang (ikut pull-up)
+void hostPinDrive(uint8_t pin, int level);
+uint8_t hostPinMode(uint8_t pin);
+int hostPinOutput(uint8_t pin);
+void hostFireInterrupt(uint8_t pin);
+
+// CAN: frame untuk twai_receive berikutnya
+void hostCanInject(uint32_t id, const uint8_t* data, uint8_t length);
+void hostCanClear();
+
+// ESP: ukuran heap/image yang dilaporkan ESP.* dan heap_caps_*
+void hostSetFreeHeap(uint32_t bytes);
+
+// Heap host nyata (host_heap.cpp): malloc/new sejak start, blok yang masih hidup
+uint64_t hostHeapAllocations();
+size_t hostHeapLiveBlocks();
+
+#endif
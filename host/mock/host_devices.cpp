@@ -0,0 +1,376 @@
+#include "host.h"
+#include "host_i2c.h"
+
+HostSSD1306 hostOled;
+HostDS3231 hostRtc;
+HostAT24C32 hostEeprom;
+
+// =============================================
+// SSD1306
+// =============================================
+void HostSSD1306::powerOn() {
+    memset(ram, 0, sizeof(ram));
+    displayOn = false;
+    inverted = false;
+    entireOn = false;
+    startLine = 0;
+    contrast = 0x7F;
+    mux = 63;
+    addressingMode = 2;
+    colStart = 0;
+    colEnd = 127;
+    pageStart = 0;
+    pageEnd = 7;
+    col = 0;
+    page = 0;
+    commandCount = 0;
+    dataBytes = 0;
+    expectControl = true;
+    continuation = false;
+    dataMode = false;
+    pendingCommand = 0;
+    argsNeeded = 0;
+    argCount = 0;
+}
+
+bool HostSSD1306::select(bool read) {
+    expectControl = !read;
+    return true;
+}
+
+void HostSSD1306::stop() {
+    expectControl = true;
+}
+
+bool HostSSD1306::write(uint8_t byte) {
+    if (expectControl) {
+        // Co = 0: semua byte sisa transaksi sejenis (data/perintah)
+        continuation = (byte & 0x80) == 0;
+        dataMode = (byte & 0x40) != 0;
+        expectControl = false;
+        return true;
+    }
+
+    if (dataMode) data(byte);
+    else command(byte);
+
+    if (!continuation) expectControl = true;
+    return true;
+}
+
+// Jumlah argumen perintah (datasheet SSD1306 tabel 9-1)
+static uint8_t commandArgs(uint8_t cmd) {
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+void HostSSD1306::command(uint8_t byte) {
+    if (argsNeeded > 0) {
+        args[argCount++] = byte;
+        if (argCount == argsNeeded) {
+            argsNeeded = 0;
+            execute();
+        }
+        return;
+    }
+
+    commandCount++;
+    pendingCommand = byte;
+    argCount = 0;
+    argsNeeded = commandArgs(byte);
+    if (argsNeeded == 0) execute();
+}
+
+void HostSSD1306::execute() {
+    uint8_t cmd = pendingCommand;
+
+    if (cmd >= 0x40 && cmd <= 0x7F) {
+        startLine = cmd & 0x3F;
+        return;
+    }
+    if (cmd >= 0xB0 && cmd <= 0xB7) {
+        page = cmd & 0x07;
+        return;
+    }
+    if (cmd <= 0x0F) {
+        col = (col & 0xF0) | (cmd & 0x0F);
+        return;
+    }
+    if (cmd >= 0x10 && cmd <= 0x1F) {
+        col = (uint8_t)(((cmd & 0x0F) << 4) | (col & 0x0F));
+        return;
+    }
+
+    switch (cmd) {
+        case 0xAE: displayOn = false; break;
+        case 0xAF: displayOn = true; break;
+        case 0xA4: entireOn = false; break;
+        case 0xA5: entireOn = true; break;
+        case 0xA6: inverted = false; break;
+        case 0xA7: inverted = true; break;
+        case 0x81: contrast = args[0]; break;
+        case 0xA8: mux = args[0] & 0x3F; break;
+        case 0x20: addressingMode = args[0] & 0x03; break;
+        case 0x21:
+            colStart = col = args[0] & 0x7F;
+            colEnd = args[1] & 0x7F;
+            break;
+        case 0x22:
+            pageStart = page = args[0] & 0x07;
+            pageEnd = args[1] & 0x07;
+            break;
+        default:
+            break;              // Timing, charge pump, remap, scroll: tidak memengaruhi gambar
+    }
+}
+
+void HostSSD1306::data(uint8_t byte) {
+    dataBytes++;
+    ram[page & 7][col & 0x7F] = byte;
+
+    if (addressingMode == 2) {
+        col = (col + 1) & 0x7F;
+        return;
+    }
+    if (addressingMode == 1) {
+        if (page >= pageEnd) {
+            page = pageStart;
+            col = col >= colEnd ? colStart : col + 1;
+        } else {
+            page++;
+        }
+        return;
+    }
+    if (col >= colEnd) {
+        col = colStart;
+        page = page >= pageEnd ? pageStart : page + 1;
+    } else {
+        col++;
+    }
+}
+
+bool HostSSD1306::visiblePixel(int x, int y) const {
+    if (!displayOn) return false;
+    if (entireOn) return true;
+    int row = (startLine + y) & 63;
+    bool on = (ram[row >> 3][x] >> (row & 7)) & 1;
+    return on != inverted;
+}
+
+std::string HostSSD1306::visiblePbm() const {
+    std::string out = "P1\n" + std::to_string(visibleWidth()) + " " + std::to_string(visibleHeight()) + "\n";
+    for (int y = 0; y < visibleHeight(); y++) {
+        for (int x = 0; x < visibleWidth(); x++) {
+            if (x > 0) out += ' ';
+            out += visiblePixel(x, y) ? '1' : '0';
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+// =============================================
+// DS3231
+// =============================================
+static uint8_t toBcd(uint32_t value) {
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+static uint32_t fromBcd(uint8_t value) {
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+static bool leapYear(uint32_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static uint32_t daysInMonth(uint32_t year, uint32_t month) {
+    static const uint8_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && leapYear(year) ? 29 : days[month - 1];
+}
+
+void HostDS3231::powerOn() {
+    memset(regs, 0, sizeof(regs));
+    regs[0x04] = 0x01;          // 1 Januari 2000, Sabtu
+    regs[0x05] = 0x01;
+    regs[0x03] = 0x07;
+    regs[0x0E] = 0x1C;
+    regs[0x0F] = 0x88;          // OSF: oscillator sempat berhenti
+    temperature = 25.0f;
+    pointer = 0;
+    pointerSet = false;
+    timeWritten = false;
+    rebase();
+}
+
+void HostDS3231::setTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t date,
+                         uint8_t month, uint8_t year) {
+    regs[0x00] = toBcd(second);
+    regs[0x01] = toBcd(minute);
+    regs[0x02] = toBcd(hour);
+    regs[0x04] = toBcd(date);
+    regs[0x05] = toBcd(month);
+    regs[0x06] = toBcd(year);
+    rebase();
+}
+
+// Register waktu -> detik sejak 2000-01-01
+void HostDS3231::rebase() {
+    uint32_t year = 2000 + fromBcd(regs[0x06]);
+    uint32_t month = fromBcd(regs[0x05] & 0x1F);
+    uint32_t days = fromBcd(regs[0x04] & 0x3F) - 1;
+    for (uint32_t y = 2000; y < year; y++) days += leapYear(y) ? 366 : 365;
+    for (uint32_t m = 1; m < month; m++) days += daysInMonth(year, m);
+
+    uint32_t hour = fromBcd(regs[0x02] & 0x3F);
+    baseSeconds = days * 86400 + hour * 3600 + fromBcd(regs[0x01] & 0x7F) * 60 + fromBcd(regs[0x00] & 0x7F);
+    baseUs = hostNowUs();
+}
+
+// Detik berjalan -> register waktu (format 24 jam)
+void HostDS3231::latchTime() {
+    uint32_t seconds = baseSeconds + (uint32_t)((hostNowUs() - baseUs) / 1000000ULL);
+    uint32_t days = seconds / 86400;
+    uint32_t rest = seconds % 86400;
+
+    regs[0x00] = toBcd(rest % 60);
+    regs[0x01] = toBcd((rest / 60) % 60);
+    regs[0x02] = toBcd(rest / 3600);
+    regs[0x03] = (uint8_t)((days + 5) % 7 + 1);    // 2000-01-01 = Sabtu (7)
+
+    uint32_t year = 2000;
+    while (days >= (leapYear(year) ? 366u : 365u)) days -= leapYear(year++) ? 366 : 365;
+    uint32_t month = 1;
+    while (days >= daysInMonth(year, month)) days -= daysInMonth(year, month++);
+
+    regs[0x04] = toBcd(days + 1);
+    regs[0x05] = toBcd(month);
+    regs[0x06] = toBcd(year - 2000);
+
+    int16_t quarter = (int16_t)lroundf(temperature * 4.0f);
+    regs[0x11] = (uint8_t)(quarter >> 2);
+    regs[0x12] = (uint8_t)((quarter & 0x03) << 6);
+}
+
+bool HostDS3231::select(bool read) {
+    if (read) latchTime();
+    else pointerSet = false;
+    return true;
+}
+
+bool HostDS3231::write(uint8_t data) {
+    if (!pointerSet) {
+        pointer = data % sizeof(regs);
+        pointerSet = true;
+        // Tulis sebagian register waktu tetap memakai detik yang berjalan
+        if (pointer <= 0x06) latchTime();
+        return true;
+    }
+    if (pointer <= 0x06) timeWritten = true;
+    if (pointer != 0x11 && pointer != 0x12) regs[pointer] = data;
+    pointer = (pointer + 1) % sizeof(regs);
+    return true;
+}
+
+uint8_t HostDS3231::read() {
+    uint8_t value = regs[pointer];
+    pointer = (pointer + 1) % sizeof(regs);
+    return value;
+}
+
+void HostDS3231::stop() {
+    if (timeWritten) {
+        timeWritten = false;
+        rebase();
+    }
+}
+
+// =============================================
+// AT24C32
+// =============================================
+void HostAT24C32::erase() {
+    memset(mem, 0xFF, sizeof(mem));
+    memset(pageWrites, 0, sizeof(pageWrites));
+    writeCycleUs = 5000;
+    cutAfter = -1;
+    pointer = 0;
+    powerOn();
+}
+
+void HostAT24C32::powerOn() {
+    off = false;
+    addressBytes = 0;
+    dataWritten = false;
+    busyUntilUs = 0;
+}
+
+bool HostAT24C32::select(bool read) {
+    // Mati atau sedang siklus tulis: alamat tidak di-ACK (acknowledge polling)
+    if (off || hostNowUs() < busyUntilUs) return false;
+    if (!read) {
+        addressBytes = 0;
+        dataWritten = false;
+    }
+    return true;
+}
+
+bool HostAT24C32::write(uint8_t data) {
+    if (addressBytes < 2) {
+        pointer = (uint16_t)(((pointer << 8) | data) & (SIZE - 1));
+        if (++addressBytes == 2) {
+            pageBase = pointer & ~(PAGE_SIZE - 1);
+            memset(pageLoaded, 0, sizeof(pageLoaded));
+        }
+        return true;
+    }
+
+    // Lebih dari 32 byte: alamat berputar di dalam page yang sama
+    uint8_t offset = pointer & (PAGE_SIZE - 1);
+    pageBuffer[offset] = data;
+    pageLoaded[offset] = true;
+    dataWritten = true;
+    pointer = (uint16_t)(pageBase | ((offset + 1) & (PAGE_SIZE - 1)));
+    return true;
+}
+
+uint8_t HostAT24C32::read() {
+    uint8_t value = mem[pointer];
+    pointer = (pointer + 1) & (SIZE - 1);
+    return value;
+}
+
+void HostAT24C32::stop() {
+    if (dataWritten) program();
+    dataWritten = false;
+}
+
+// STOP setelah data: page buffer diprogram selama tWR
+void HostAT24C32::program() {
+    pageWrites[pageBase / PAGE_SIZE]++;
+    busyUntilUs = hostNowUs() + writeCycleUs;
+
+    int programmed = 0;
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        if (!pageLoaded[i]) continue;
+        uint8_t &cell = mem[pageBase + i];
+        if (cutAfter < 0 || programmed < cutAfter) cell = pageBuffer[i];
+        else if (programmed == cutAfter) cell = (uint8_t)~pageBuffer[i];    // Setengah jadi: pasti beda
+        programmed++;
+    }
+
+    if (cutAfter >= 0) {
+        cutAfter = -1;
+        off = true;
+    }
+}
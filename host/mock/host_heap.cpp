@@ -0,0 +1,98 @@
+// =============================================
+// HEAP HOST - HITUNG ALOKASI (malloc & operator new)
+// =============================================
+// malloc/calloc/realloc/free & varian aligned dibungkus di atas allocator
+// glibc (__libc_*). operator new bawaan libstdc++ lewat malloc, jadi ikut
+// terhitung. Dipakai heap_caps_get_info() (allocated_blocks) dan test yang
+// membuktikan jalur render tanpa alokasi. Bookkeeping mock sendiri
+// (HostHeapUntracked) tidak dihitung. Catatan: String mock memakai
+// std::string, String pendek (SSO) tidak muncul sebagai blok.
+#include <atomic>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "host.h"
+#include "host_internal.h"
+
+static std::atomic<uint64_t> heapAllocations(0);
+static std::atomic<int64_t> heapLiveBlocks(0);
+static thread_local int untrackedDepth = 0;
+
+HostHeapUntracked::HostHeapUntracked() {
+    untrackedDepth++;
+}
+
+HostHeapUntracked::~HostHeapUntracked() {
+    untrackedDepth--;
+}
+
+uint64_t hostHeapAllocations() {
+    return heapAllocations.load();
+}
+
+size_t hostHeapLiveBlocks() {
+    int64_t live = heapLiveBlocks.load();
+    return live > 0 ? (size_t)live : 0;
+}
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+static void* counted(void* ptr) {
+    if (ptr != NULL && untrackedDepth == 0) {
+        heapAllocations++;
+        heapLiveBlocks++;
+    }
+    return ptr;
+}
+
+void* malloc(size_t size) {
+    return counted(__libc_malloc(size));
+}
+
+void* calloc(size_t count, size_t size) {
+    return counted(__libc_calloc(count, size));
+}
+
+// Blok baru dari NULL dihitung alokasi; pindah blok tidak mengubah jumlah
+// blok hidup tapi tetap alokasi; size 0 = free
+void* realloc(void* ptr, size_t size) {
+    void* moved = __libc_realloc(ptr, size);
+    if (ptr == NULL) return counted(moved);
+    if (untrackedDepth > 0) return moved;
+    if (size == 0) {
+        heapLiveBlocks--;
+    } else if (moved != NULL && moved != ptr) {
+        heapAllocations++;
+    }
+    return moved;
+}
+
+void free(void* ptr) {
+    if (ptr != NULL && untrackedDepth == 0) heapLiveBlocks--;
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    return counted(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return counted(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* ptr = counted(__libc_memalign(alignment, size));
+    if (ptr == NULL) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+}
+#endif
@@ -0,0 +1,184 @@
+#ifndef HOST_I2C_H
+#define HOST_I2C_H
+
+// =============================================
+// HOST I2C - BUS & DEVICE SIMULASI
+// =============================================
+// Wire (Wire.h) meneruskan setiap transaksi ke device yang terpasang di
+// alamatnya. Device default: OLED SSD1306 (0x3C), DS3231 (0x68) dan AT24C32
+// (0x57) seperti modul RTC ZS-042.
+// Test bisa menyuntik fault per alamat, menahan SDA, dan membaca log transaksi.
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// Satu device di bus. Urutan panggilan per transaksi:
+// select() -> write()/read() per byte -> stop() (tidak dipanggil saat repeated start)
+class HostI2CDevice {
+public:
+    virtual ~HostI2CDevice() {}
+    virtual bool select(bool read) { return true; }     // false = NACK alamat
+    virtual bool write(uint8_t data) { return true; }   // false = NACK data
+    virtual uint8_t read() { return 0xFF; }
+    virtual void stop() {}
+};
+
+void hostI2CAttach(uint8_t address, HostI2CDevice* device);
+void hostI2CDetach(uint8_t address);
+void hostI2CReset();                        // Device default, tanpa fault, log kosong
+
+// =============================================
+// FAULT INJECTION
+// =============================================
+// count transaksi berikutnya ke address (0xFF = semua) gagal dengan status
+// Wire: 2 = NACK alamat, 3 = NACK data, 5 = timeout (waktu maju timeout Wire)
+#define HOST_I2C_ANY 0xFF
+void hostI2CInjectFault(uint8_t address, uint8_t status, uint32_t count = 1);
+void hostI2CClearFaults();
+
+// Slave menahan SDA low sampai menerima `pulses` pulsa SCL (bit-bang recovery).
+// Selama tertahan semua transaksi Wire timeout.
+void hostI2CStickSda(uint8_t pulses);
+uint8_t hostI2CStuckPulsesLeft();
+uint32_t hostI2CSclPulses();                // Total pulsa SCL bit-bang sejak reset
+uint32_t hostI2CStopConditions();           // STOP bit-bang (SDA naik saat SCL high)
+
+// =============================================
+// LOG TRANSAKSI
+// =============================================
+typedef struct {
+    uint64_t startUs;
+    uint64_t endUs;
+    uint8_t address;
+    bool read;                  // requestFrom
+    bool stop;                  // false = repeated start
+    std::vector<uint8_t> data;  // Ditulis (write) atau diterima (read)
+    uint8_t status;             // Kode endTransmission (read: 0 / 2)
+    uint32_t clockHz;
+    std::string task;           // Task yang memanggil Wire
+} HostI2CTxn;
+
+const std::vector<HostI2CTxn>& hostI2CLog();
+void hostI2CClearLog();
+
+// =============================================
+// DEVICE SIMULASI
+// =============================================
+// SSD1306 128x32: GDDRAM 8 page, parser control byte (Co/D-C), perintah
+// addressing horizontal/page, start line, display on/off, invert.
+class HostSSD1306 : public HostI2CDevice {
+public:
+    HostSSD1306() { powerOn(); }
+    void powerOn();
+
+    bool select(bool read) override;
+    bool write(uint8_t data) override;
+    uint8_t read() override { return 0x00; }   // Status: display on
+    void stop() override;
+
+    // Pixel yang terlihat (start line dan mux diperhitungkan)
+    int visibleWidth() const { return 128; }
+    int visibleHeight() const { return mux + 1; }
+    bool visiblePixel(int x, int y) const;
+    std::string visiblePbm() const;             // P1 ASCII, sama dengan oledDumpFrame
+
+    uint8_t ram[8][128];
+    bool displayOn;
+    bool inverted;
+    bool entireOn;
+    uint8_t startLine;
+    uint8_t contrast;
+    uint8_t mux;
+    uint8_t addressingMode;     // 0 horizontal, 1 vertical, 2 page
+    uint8_t colStart, colEnd, pageStart, pageEnd;
+    uint8_t col, page;
+    uint32_t commandCount;
+    uint32_t dataBytes;
+
+private:
+    bool expectControl;         // Byte berikutnya control byte
+    bool continuation;          // Co = 0: sisa transaksi satu jenis
+    bool dataMode;              // D/C
+    uint8_t pendingCommand;
+    uint8_t argsNeeded;
+    uint8_t argCount;
+    uint8_t args[6];
+
+    void command(uint8_t byte);
+    void execute();
+    void data(uint8_t byte);
+};
+
+// DS3231: register 0x00-0x12, jam BCD berjalan mengikuti waktu virtual
+class HostDS3231 : public HostI2CDevice {
+public:
+    HostDS3231() { powerOn(); }
+    void powerOn();
+    void setTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t date = 1,
+                 uint8_t month = 1, uint8_t year = 24);
+
+    bool select(bool read) override;
+    bool write(uint8_t data) override;
+    uint8_t read() override;
+    void stop() override;
+
+    uint8_t regs[0x13];
+    float temperature;
+
+private:
+    uint8_t pointer;
+    bool pointerSet;
+    bool timeWritten;
+    uint64_t baseUs;
+    uint32_t baseSeconds;       // Detik sejak 2000-01-01 saat baseUs
+
+    void latchTime();
+    void rebase();
+};
+
+// AT24C32: 4 KB, pointer alamat 2 byte, page write 32 byte (wrap di dalam
+// page), NACK selama siklus tulis. Power cut bisa disuntik di tengah
+// pemrograman page; isi memori tetap ada sampai erase().
+class HostAT24C32 : public HostI2CDevice {
+public:
+    static const int SIZE = 4096;
+    static const int PAGE_SIZE = 32;
+
+    HostAT24C32() { erase(); }
+    void erase();               // Semua 0xFF, wear nol, hidup
+    void powerOn();             // Setelah power cut; isi memori tidak berubah
+
+    // Page write berikutnya hanya memprogram `bytes` byte pertama. Byte ke-`bytes`
+    // setengah terprogram (isi acak, di sini ~baru), sisanya tetap isi lama; lalu chip mati
+    // (semua alamat NACK) sampai powerOn().
+    void cutPowerAfter(int bytes) { cutAfter = bytes; }
+    bool powered() const { return !off; }
+
+    bool select(bool read) override;
+    bool write(uint8_t data) override;
+    uint8_t read() override;
+    void stop() override;
+
+    uint8_t mem[SIZE];
+    uint32_t pageWrites[SIZE / PAGE_SIZE];  // Siklus tulis per page (wear)
+    uint32_t writeCycleUs;                  // tWR, default 5 ms (datasheet AT24C32D)
+
+private:
+    uint16_t pointer;
+    uint8_t addressBytes;       // Byte alamat yang sudah diterima transaksi ini
+    uint8_t pageBuffer[PAGE_SIZE];
+    bool pageLoaded[PAGE_SIZE];
+    uint16_t pageBase;
+    bool dataWritten;
+    uint64_t busyUntilUs;
+    int cutAfter;               // -1 = tidak ada power cut
+    bool off;
+
+    void program();
+};
+
+extern HostSSD1306 hostOled;
+extern HostDS3231 hostRtc;
+extern HostAT24C32 hostEeprom;
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HOST_INTERNAL_H
+#define HOST_INTERNAL_H
+
+// Antar modul mock saja (bukan untuk test maupun firmware)
+#include <stdint.h>
+
+uint64_t hostTickUs();                          // Baca waktu + 1 us
+
+// Alokasi bookkeeping mock (log transaksi I2C) di scope ini tidak dihitung
+// heap host; alokasi & free-nya harus sama-sama di dalam scope
+struct HostHeapUntracked {
+    HostHeapUntracked();
+    ~HostHeapUntracked();
+};
+
+// Pin SDA/SCL milik bus I2C simulasi (host_i2c.cpp)
+bool hostI2CPinWrite(uint8_t pin, uint8_t mode, int level);
+bool hostI2CPinRead(uint8_t pin, int* level);
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BLE_LOOP_FIXTURE_H
+#define BLE_LOOP_FIXTURE_H
+
+// =============================================
+// FIXTURE BLE LOOPBACK (TEST BLE PUMP / SUB / MULTI / DELTA)
+// =============================================
+// Task stream BLE asli + backend loopback (fox_bleloop.h) sebagai GATT
+// tiruan, tanpa radio. Sisi client: chunk JSON disusun ulang sampai '\n'
+// (frame yang diawali {"status" = reply command), frame biner didekode di
+// atas field sebelumnya (delta). Counter firmware dibaca lewat
+// getBleStreamStats(). Di-include satu file test per executable.
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "host.h"
+#include "fox_config.h"
+#include "fox_ble.h"
+#include "fox_bleloop.h"
+#include "fox_bleproto.h"
+#include "fox_task.h"
+#include "fox_vehicle.h"
+
+struct Frame {
+    uint64_t atUs;
+    BleBinHeader header;
+};
+
+// Sisi client, satu per koneksi
+struct Receiver {
+    std::string reply;                  // Reply command terakhir (tanpa '\n')
+    std::string partial;                // Frame JSON / reply yang belum ditutup '\n'
+    std::vector<std::string> json;      // Frame JSON utuh (dengan '\n')
+    std::vector<Frame> frames;   // Frame biner
+    BleBinFields state;                 // Field terakhir (delta di atas frame sebelumnya)
+    uint32_t notifications;
+    uint32_t bytes;
+    uint32_t badFrames;                 // Frame JSON bukan satu objek utuh / biner gagal decode
+    uint32_t seqGaps;                   // Seq biner tidak berurutan
+    bool haveSeq;
+    uint16_t lastSeq;
+};
+
+static std::map<uint16_t, Receiver> receivers;
+
+// Opsional: dipanggil setelah tiap frame biner didekode (r.state sudah baru)
+static void (*onBinaryFrame)(uint16_t conn, Receiver &r, const BleBinHeader &header) = NULL;
+
+// Estimasi airtime notifikasi yang diterima (BLE_NOTIFY_*)
+static uint32_t airtimeUs(const Receiver &r) {
+    return (r.bytes + r.notifications * BLE_NOTIFY_OVERHEAD_BYTES) * 8 + r.notifications * BLE_NOTIFY_EXCHANGE_US;
+}
+
+// Counter & frame yang sudah diterima dibuang; state delta & seq tetap
+static void clearReceived(Receiver &r) {
+    r.json.clear();
+    r.frames.clear();
+    r.notifications = r.bytes = r.badFrames = r.seqGaps = 0;
+}
+
+// Frame utuh = tepat satu objek JSON lalu '\n' (frame lain yang menyela
+// menutup objek pertama sebelum akhir)
+static bool singleJsonObject(const std::string &frame) {
+    if (frame.size() < 3 || frame[0] != '{' || frame.compare(frame.size() - 2, 2, "}\n") != 0) return false;
+    int depth = 0;
+    for (size_t i = 0; i + 1 < frame.size(); i++) {
+        if (frame[i] == '{') depth++;
+        else if (frame[i] == '}' && --depth == 0 && i + 2 != frame.size()) return false;
+    }
+    return depth == 0;
+}
+
+static void receive(uint16_t conn, const uint8_t *data, uint16_t len) {
+    Receiver &r = receivers[conn];
+    r.notifications++;
+    r.bytes += len;
+
+    if (r.partial.empty() && data[0] == BLE_BIN_MAGIC) {
+        BleBinHeader header;
+        BleBinFields fields = r.state;
+        if (!bleBinDecode(data, len, header, fields)) {
+            r.badFrames++;
+            return;
+        }
+        if (r.haveSeq && header.seq != (uint16_t)(r.lastSeq + 1)) r.seqGaps++;
+        r.haveSeq = true;
+        r.lastSeq = header.seq;
+        r.state = fields;
+        r.frames.push_back({hostNowUs(), header});
+        if (onBinaryFrame != NULL) onBinaryFrame(conn, r, header);
+        return;
+    }
+
+    r.partial.append((const char*)data, len);
+    if (r.partial.back() != '\n') return;
+    // Reply command: frame ber-'\n' sendiri, tidak pernah di tengah frame lain
+    if (r.partial.compare(0, 9, "{\"status\"") == 0) {
+        r.reply = r.partial.substr(0, r.partial.size() - 1);
+    } else {
+        if (!singleJsonObject(r.partial)) r.badFrames++;
+        r.json.push_back(r.partial);
+    }
+    r.partial.clear();
+}
+
+static BleStreamStats streamStats() {
+    BleStreamStats stats;
+    getBleStreamStats(stats);
+    return stats;
+}
+
+static void writeCommand(int conn, const char *json) {
+    bleLoopWrite(conn, (const uint8_t*)json, strlen(json));
+}
+
+// Client baru, opsional langsung set_proto. Advertising menyala lagi di
+// tick setelah koneksi sebelumnya
+static int connect(uint16_t mtu, const char *format = NULL) {
+    hostRunMs(20);
+    int conn = bleLoopConnect(mtu);
+    if (conn >= 0 && format != NULL) {
+        char cmd[64];
+        snprintf(cmd, sizeof(cmd), "{\"cmd\":\"set_proto\",\"fmt\":\"%s\"}", format);
+        writeCommand(conn, cmd);
+    }
+    return conn;
+}
+
+// Advertising yang berhenti karena penuh dinyalakan lagi oleh processBLE() di loop()
+static void disconnect(int conn) {
+    bleLoopDisconnect(conn);
+    hostRunMs(20);
+    processBLE();
+}
+
+// Mode kendaraan (vehicle.lastModeByte) diatur fixture turunan sebelum ini
+struct BleLoopFixture {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        initFreeRTOS();
+        xTaskCreatePinnedToCore(bleTask, "BLE_Stream", BLE_TASK_STACK_SIZE, NULL,
+                                BLE_TASK_PRIORITY, &bleTaskHandle, BLE_TASK_CORE);
+        bleLoopAutoConnect(false);
+        bleLoopSetSink(receive);
+        activateBLE();
+        hostRunMs(10);
+    }
+};
+
+#endif
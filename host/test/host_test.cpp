@@ -0,0 +1,48 @@
+#include "host_test.h"
+#include <stdio.h>
+#include <vector>
+
+// =============================================
+// REGISTRY & MAIN
+// =============================================
+typedef struct {
+    std::string name;
+    HostTestFunction function;
+} HostTestCase;
+
+static std::vector<HostTestCase>& registry() {
+    static std::vector<HostTestCase> tests;
+    return tests;
+}
+
+static int failures = 0;
+
+HostTestRegistrar::HostTestRegistrar(const char* suite, const char* name, HostTestFunction function) {
+    registry().push_back({std::string(suite) + "." + name, function});
+}
+
+void HostTestReporter::operator=(const HostTestMessage& message) const {
+    failures++;
+    std::string extra = message.text.str();
+    fprintf(stderr, "%s:%d: %s%s%s\n", file, line, what.c_str(), extra.empty() ? "" : "\n  ", extra.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    int run = 0;
+    int failed = 0;
+
+    for (const HostTestCase& test : registry()) {
+        if (test.name.find(filter) == std::string::npos) continue;
+        fprintf(stderr, "[ RUN      ] %s\n", test.name.c_str());
+        int before = failures;
+        test.function();
+        bool ok = failures == before;
+        fprintf(stderr, "[ %s ] %s\n", ok ? "     OK" : "FAILED ", test.name.c_str());
+        run++;
+        if (!ok) failed++;
+    }
+
+    fprintf(stderr, "[==========] %d test, %d gagal\n", run, failed);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
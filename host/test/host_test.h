@@ -0,0 +1,109 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// =============================================
+// HARNESS TEST HOST (TANPA DEPENDENSI)
+// =============================================
+// Subset gaya GoogleTest: TEST / TEST_F (SetUpTestSuite sekali per fixture),
+// EXPECT_* lanjut saat gagal, ASSERT_* keluar dari test. Pesan tambahan
+// bisa di-stream: EXPECT_EQ(a, b) << "konteks";
+// Argumen program = filter substring nama test ("Suite.Nama").
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+typedef void (*HostTestFunction)();
+
+struct HostTestRegistrar {
+    HostTestRegistrar(const char* suite, const char* name, HostTestFunction function);
+};
+
+struct HostTestMessage {
+    std::ostringstream text;
+    template <typename T> HostTestMessage& operator<<(const T& value) {
+        text << value;
+        return *this;
+    }
+};
+
+struct HostTestReporter {
+    const char* file;
+    int line;
+    std::string what;
+    void operator=(const HostTestMessage& message) const;
+};
+
+template <typename T> std::string hostTestValue(const T& value) {
+    std::ostringstream out;
+    if constexpr (std::is_enum<T>::value) out << (long long)value;
+    else if constexpr (std::is_arithmetic<T>::value) out << +value;
+    else out << value;
+    return out.str();
+}
+
+// String kosong = lolos; selain itu deskripsi kegagalan
+template <typename A, typename B, typename Op>
+std::string hostTestCompare(const A& a, const B& b, Op op, const char* textA, const char* opText, const char* textB) {
+    if (op(a, b)) return std::string();
+    return std::string(textA) + " " + opText + " " + textB + " (" + hostTestValue(a) + " vs " + hostTestValue(b) + ")";
+}
+
+#define HOST_TEST_FAIL(what) HostTestReporter{__FILE__, __LINE__, what} = HostTestMessage()
+
+// switch: aman dipakai di dalam if/else tanpa kurung kurawal
+#define HOST_TEST_BOOL(cond, text, fatal) \
+    switch (0) case 0: default: \
+    if (cond) {} else fatal HOST_TEST_FAIL(text)
+
+#define HOST_TEST_CMP(a, b, op, opText, fatal) \
+    switch (0) case 0: default: \
+    if (std::string hostTestResult = hostTestCompare((a), (b), [](const auto& x, const auto& y) { return x op y; }, \
+                                                     #a, opText, #b); hostTestResult.empty()) {} \
+    else fatal HOST_TEST_FAIL(hostTestResult)
+
+#define HOST_TEST_RETURN return
+
+#define EXPECT_TRUE(cond) HOST_TEST_BOOL((cond), "EXPECT_TRUE(" #cond ")", )
+#define EXPECT_FALSE(cond) HOST_TEST_BOOL(!(cond), "EXPECT_FALSE(" #cond ")", )
+#define ASSERT_TRUE(cond) HOST_TEST_BOOL((cond), "ASSERT_TRUE(" #cond ")", HOST_TEST_RETURN)
+#define ASSERT_FALSE(cond) HOST_TEST_BOOL(!(cond), "ASSERT_FALSE(" #cond ")", HOST_TEST_RETURN)
+
+#define EXPECT_EQ(a, b) HOST_TEST_CMP(a, b, ==, "==", )
+#define EXPECT_NE(a, b) HOST_TEST_CMP(a, b, !=, "!=", )
+#define EXPECT_LT(a, b) HOST_TEST_CMP(a, b, <, "<", )
+#define EXPECT_LE(a, b) HOST_TEST_CMP(a, b, <=, "<=", )
+#define EXPECT_GT(a, b) HOST_TEST_CMP(a, b, >, ">", )
+#define EXPECT_GE(a, b) HOST_TEST_CMP(a, b, >=, ">=", )
+#define ASSERT_EQ(a, b) HOST_TEST_CMP(a, b, ==, "==", HOST_TEST_RETURN)
+#define ASSERT_NE(a, b) HOST_TEST_CMP(a, b, !=, "!=", HOST_TEST_RETURN)
+#define ASSERT_LT(a, b) HOST_TEST_CMP(a, b, <, "<", HOST_TEST_RETURN)
+#define ASSERT_LE(a, b) HOST_TEST_CMP(a, b, <=, "<=", HOST_TEST_RETURN)
+#define ASSERT_GT(a, b) HOST_TEST_CMP(a, b, >, ">", HOST_TEST_RETURN)
+#define ASSERT_GE(a, b) HOST_TEST_CMP(a, b, >=, ">=", HOST_TEST_RETURN)
+#define EXPECT_STREQ(a, b) HOST_TEST_CMP(std::string(a), std::string(b), ==, "==", )
+#define ASSERT_STREQ(a, b) HOST_TEST_CMP(std::string(a), std::string(b), ==, "==", HOST_TEST_RETURN)
+#define ADD_FAILURE() HOST_TEST_FAIL("Failure")
+
+#define TEST(suite, name) \
+    static void suite##_##name(); \
+    static HostTestRegistrar suite##_##name##_registrar(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+// Fixture: struct dengan static SetUpTestSuite(), dipanggil sebelum test pertamanya
+template <typename Fixture> void hostTestSuiteOnce(HostTestFunction setUp) {
+    static bool ready = false;
+    if (!ready) {
+        ready = true;
+        setUp();
+    }
+}
+
+#define TEST_F(fixture, name) \
+    struct fixture##_##name : fixture { \
+        static void entry() { hostTestSuiteOnce<fixture>(SetUpTestSuite); run(); } \
+        static void run(); \
+    }; \
+    static HostTestRegistrar fixture##_##name##_registrar(#fixture, #name, fixture##_##name::entry); \
+    void fixture##_##name::run()
+
+#endif
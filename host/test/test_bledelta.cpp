@@ -0,0 +1,220 @@
+// =============================================
+// DELTA BLE - REPLAY PERJALANAN, AIRTIME & REKONSTRUKSI CLIENT
+// =============================================
+// Task stream BLE + backend loopback (ble_loop_fixture.h), tanpa radio. Tiga
+// client virtual terhubung bersamaan: JSON, biner dan delta. Perjalanan
+// sintetis deterministik (parkir, jalan dengan rem berkala, parkir) diputar
+// per 100 ms langsung ke struct vehicle, seperti parser CAN. Client delta
+// merekonstruksi state dari keyframe + delta, dibandingkan dengan frame full
+// biner di tick yang sama. Laporan: ctest -V -R test_bledelta.
+#include "ble_loop_fixture.h"
+
+// Validitas delta per client, di atas Receiver fixture (notifikasi, byte,
+// state hasil dekode)
+struct DeltaClient {
+    int conn;
+    bool delta;
+    uint32_t keyframes;
+    uint32_t seqGaps;           // Delta diterima tanpa urutan seq (harus 0)
+    bool valid;                 // Delta: sudah punya keyframe
+    uint16_t lastSeq;
+    uint8_t lastType;
+};
+
+static DeltaClient clients[3];
+static uint32_t pairedChecks = 0;
+static uint32_t pairedMismatches = 0;
+
+static DeltaClient* clientFor(uint16_t conn) {
+    for (DeltaClient &c : clients) {
+        if (c.conn == conn) return &c;
+    }
+    return NULL;
+}
+
+static uint32_t framesOf(const DeltaClient &c) {
+    const Receiver &r = receivers[c.conn];
+    return r.json.size() + r.frames.size();
+}
+
+static void clearCounters(DeltaClient &c) {
+    clearReceived(receivers[c.conn]);
+    c.keyframes = c.seqGaps = 0;
+}
+
+// Setelah frame full biner, frame client delta di pump yang sama dibangun
+// dari data kendaraan yang sama: state rekonstruksi harus persis sama
+// (kecuali heartbeat, counter per frame)
+static void compareWithBinary(const DeltaClient &delta) {
+    const DeltaClient &binary = clients[1];
+    if (!delta.valid || binary.lastType != BLE_BIN_FULL) return;
+    pairedChecks++;
+    uint32_t mask = BLE_BIN_FULL_MASK & ~BLE_FIELD_BIT(BLE_FIELD_HEARTBEAT);
+    if (bleBinDiff(receivers[delta.conn].state, receivers[binary.conn].state, mask) != 0) pairedMismatches++;
+}
+
+// Delta hanya sah tepat setelah frame sebelumnya; selain itu tunggu keyframe
+static void onFrame(uint16_t conn, Receiver &r, const BleBinHeader &header) {
+    DeltaClient *c = clientFor(conn);
+    if (c == NULL) return;
+    c->lastType = header.type;
+    if (!c->delta) return;
+    if (header.flags & BLE_BIN_FLAG_KEYFRAME) {
+        c->keyframes++;
+        c->valid = true;
+    } else if (!c->valid || header.seq != (uint16_t)(c->lastSeq + 1)) {
+        c->seqGaps++;
+        c->valid = false;
+    }
+    c->lastSeq = header.seq;
+    compareWithBinary(*c);
+}
+
+// =============================================
+// PERJALANAN SINTETIS
+// =============================================
+// step = 100 ms. 0-20 s parkir, 20-100 s jalan (rem 2 s tiap 15 s),
+// 100-120 s parkir. BMS menyapu satu sel per detik, suhu naik pelan
+static const int RIDE_STEPS = 1200;
+
+static void rideStep(int step) {
+    int second = step / 10;
+    bool moving = second >= 20 && second < 100;
+    bool braking = moving && (second - 20) % 15 >= 13;
+
+    int speed = 0;
+    if (moving) {
+        int phase = (step - 200) % 300;             // Naik-turun tiap 30 s
+        speed = 25 + (phase < 150 ? phase : 300 - phase) / 5;
+        if (braking) speed -= 10;
+    }
+    vehicle.lastModeByte = !moving ? 0x00 : (braking ? 0x72 : 0x70);
+    vehicle.speed = speed;
+    vehicle.rpm = speed * 66;
+    vehicle.batteryCurrent = moving ? -(speed * 0.6f) : -0.3f;
+    vehicle.batteryVoltage = 74.0f - step * 0.001f;
+    vehicle.batterySOC = 90 - step / 300;
+
+    vehicle.tempCtrl = 30 + second / 10;
+    vehicle.tempMotor = 32 + second / 8;
+    vehicle.tempBatt = 28 + second / 30;
+
+    if (step % 10 == 0) {
+        int cell = second % MAX_CELLS;
+        vehicle.cellVoltages[cell] = 3320 - second / 4 + cell % 3;
+    }
+    vehicle.tempMax = 29 + second / 30;
+}
+
+static void startRide() {
+    vehicle.batterySOH = 97;
+    vehicle.batteryCycleCount = 212;
+    vehicle.fullCapacity = 45.0f;
+    vehicle.remainingCapacity = 38.0f;
+    for (int i = 0; i < MAX_CELLS; i++) vehicle.cellVoltages[i] = 3320 + i % 3;
+    rideStep(0);
+}
+
+struct BleDelta : BleLoopFixture {
+    static void SetUpTestSuite() {
+        startRide();
+        onBinaryFrame = onFrame;
+        BleLoopFixture::SetUpTestSuite();
+
+        const char *formats[] = {NULL, "bin", "delta"};
+        for (int i = 0; i < 3; i++) {
+            clients[i].conn = connect(247, formats[i]);
+            clients[i].delta = i == 2;
+        }
+        hostRunMs(100);
+    }
+};
+
+TEST_F(BleDelta, ClientsConnected) {
+    for (const DeltaClient &c : clients) {
+        ASSERT_GE(c.conn, 0);
+        EXPECT_TRUE(bleLoopConnected(c.conn));
+        EXPECT_GT(framesOf(c), 0u) << "conn " << c.conn;
+        EXPECT_EQ(0u, receivers[c.conn].badFrames) << "conn " << c.conn;
+    }
+    EXPECT_TRUE(clients[2].valid) << "client delta belum menerima keyframe";
+}
+
+// =============================================
+// REPLAY: NOTIFIKASI & AIRTIME PER FORMAT
+// =============================================
+TEST_F(BleDelta, RideReplayAirtime) {
+    for (DeltaClient &c : clients) clearCounters(c);
+    pairedChecks = pairedMismatches = 0;
+
+    for (int step = 0; step < RIDE_STEPS; step++) {
+        rideStep(step);
+        hostRunMs(100);
+    }
+
+    const Receiver &json = receivers[clients[0].conn];
+    const Receiver &binary = receivers[clients[1].conn];
+    const Receiver &delta = receivers[clients[2].conn];
+    printf("\nRide %d s, MTU 247     frames   notif    bytes  airtime ms\n", RIDE_STEPS / 10);
+    const char *names[] = {"JSON", "BINARY", "DELTA"};
+    for (int i = 0; i < 3; i++) {
+        const Receiver &r = receivers[clients[i].conn];
+        printf("%-6s              %7lu %7lu %8lu %10lu\n", names[i], (unsigned long)framesOf(clients[i]),
+               (unsigned long)r.notifications, (unsigned long)r.bytes, (unsigned long)(airtimeUs(r) / 1000));
+    }
+    printf("Delta: %lu keyframes, %lu frames compared with binary full frames\n",
+           (unsigned long)clients[2].keyframes, (unsigned long)pairedChecks);
+
+    // Jadwal sama untuk ketiganya, biner & delta satu notifikasi per frame
+    EXPECT_EQ(json.json.size(), binary.frames.size());
+    EXPECT_EQ(binary.frames.size(), delta.frames.size());
+    EXPECT_EQ(binary.frames.size(), binary.notifications);
+    EXPECT_EQ(delta.frames.size(), delta.notifications);
+    EXPECT_GT(json.notifications, binary.notifications);
+    EXPECT_EQ(0u, json.badFrames + binary.badFrames + delta.badFrames);
+
+    EXPECT_LT(airtimeUs(binary), airtimeUs(json));
+    EXPECT_LT(airtimeUs(delta), airtimeUs(binary));
+    EXPECT_LT(delta.bytes, binary.bytes);
+
+    // Keyframe berkala tiap BLE_DELTA_KEYFRAME_MS
+    uint32_t periodic = RIDE_STEPS * 100 / BLE_DELTA_KEYFRAME_MS;
+    EXPECT_GE(clients[2].keyframes, periodic - 1);
+    EXPECT_LE(clients[2].keyframes, periodic + 1);
+
+    EXPECT_EQ(0u, clients[2].seqGaps);
+    EXPECT_GT(pairedChecks, (uint32_t)(RIDE_STEPS / 20));
+    EXPECT_EQ(0u, pairedMismatches);
+}
+
+// =============================================
+// KEYFRAME ATAS PERMINTAAN & SETELAH FRAME HILANG
+// =============================================
+TEST_F(BleDelta, KeyframeOnRequest) {
+    DeltaClient &delta = clients[2];
+    hostRunMs(BLE_DELTA_KEYFRAME_MS / 2);           // Jauh dari keyframe berkala
+    clearCounters(delta);
+
+    writeCommand(delta.conn, "{\"cmd\":\"keyframe\"}");
+    hostRunMs(50);
+    EXPECT_EQ(1u, delta.keyframes);
+    EXPECT_EQ(1u, framesOf(delta));
+    EXPECT_TRUE(delta.valid);
+}
+
+// Notify gagal terus: frame dibuang, seq yang hilang tidak boleh diisi
+// delta. Frame berikutnya harus keyframe
+TEST_F(BleDelta, LostFrameForcesKeyframe) {
+    DeltaClient &delta = clients[2];
+    hostRunMs(BLE_DELTA_KEYFRAME_MS / 2);
+    clearCounters(delta);
+
+    rideStep(500);                                  // Jalan: frame tiap 150 ms
+    bleLoopRejectNotifies(delta.conn, BLE_NOTIFY_MAX_RETRIES + 1);
+    hostRunMs(1000);
+
+    EXPECT_EQ(0u, delta.seqGaps);
+    EXPECT_EQ(1u, delta.keyframes);
+    EXPECT_TRUE(delta.valid);
+    EXPECT_GT(framesOf(delta), 1u);
+}
@@ -0,0 +1,248 @@
+// =============================================
+// JSON STREAMING BLE - IDENTIK DENGAN SNPRINTF REFERENSI
+// =============================================
+// Pengganti serial BLE TEST. Referensi di bawah adalah format snprintf
+// penuh sebelum serializer streaming (dulu di fox_ble.cpp); output
+// bleJsonRead harus sama byte per byte untuk setiap ukuran chunk, atas
+// snapshot acak deterministik. Ukuran state & waktu CPU host dicetak:
+// ctest -V -R test_blejson.
+#include "host_test.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "fox_config.h"
+#include "fox_ble.h"
+#include "fox_bleproto.h"
+
+// =============================================
+// REFERENCE JSON (snprintf penuh)
+// =============================================
+static int buildFastJson(char *buf, size_t cap, const BleJsonSnapshot &v) {
+    int len = snprintf(buf, cap,
+        "{\"r\":%d,\"s\":%d,\"m\":\"%s\",\"v\":%.1f,\"a\":%.1f,\"p\":%.0f,\"sc\":%d,"
+        "\"t\":{\"c\":%d,\"m\":%d,\"b\":%d},\"cr\":%lu,\"hb\":%lu,\"type\":\"fast\"}\n",
+        v.rpm, v.speed, v.mode,
+        v.voltage, v.current,
+        v.voltage * v.current,
+        v.soc,
+        v.tempCtrl, v.tempMotor, v.tempBatt,
+        (unsigned long)v.canRate,
+        v.heartbeat
+    );
+
+    if (len < 0 || len >= (int)cap) return 0;
+    return len;
+}
+
+static int buildFullJson(char *buf, size_t cap, const BleJsonSnapshot &v) {
+    char balanceCells[64];
+    int bpos = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        int byteIndex = i / 8;
+        int bitIndex = i % 8;
+        bool isBalancing = (v.balanceBits[byteIndex] & (1 << bitIndex)) != 0;
+        bpos += snprintf(balanceCells + bpos, sizeof(balanceCells) - bpos,
+                         "%d%s", isBalancing ? 1 : 0, (i < MAX_CELLS-1) ? "," : "");
+    }
+
+    char cellsStr[200];
+    int cpos = 0;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        cpos += snprintf(cellsStr + cpos, sizeof(cellsStr) - cpos,
+                         "%u%s", v.cells[i], (i < MAX_CELLS-1) ? "," : "");
+    }
+
+    int len = snprintf(buf, cap,
+        "{\"r\":%d,\"s\":%d,\"m\":\"%s\",\"v\":%.1f,\"a\":%.1f,\"p\":%.0f,\"sc\":%d,"
+        "\"t\":{\"c\":%d,\"m\":%d,\"b\":%d},\"cells\":[%s],\"cd\":%d,\"cr\":%lu,"
+        "\"h\":{\"soh\":%d,\"cyc\":%u,\"rc\":%.1f,\"fc\":%.1f},"
+        "\"cvs\":{\"hi\":%u,\"hiC\":%u,\"lo\":%u,\"loC\":%u,\"av\":%u},"
+        "\"ts\":{\"max\":%u,\"maxC\":%u,\"min\":%u,\"minC\":%u},"
+        "\"b\":{\"md\":%u,\"st\":%u,\"cells\":[%s]},"
+        "\"chr\":{\"v\":%.1f,\"a\":%.1f},\"hb\":%lu,\"type\":\"full\"}\n",
+        v.rpm, v.speed, v.mode,
+        v.voltage, v.current,
+        v.voltage * v.current,
+        v.soc,
+        v.tempCtrl, v.tempMotor, v.tempBatt,
+        cellsStr, v.cellDelta,
+        (unsigned long)v.canRate,
+        v.soh, v.cycles,
+        v.remainCap, v.fullCap,
+        v.cellHi, v.cellHiNum,
+        v.cellLo, v.cellLoNum,
+        v.cellAvg,
+        v.tempMax, v.tempMaxCell,
+        v.tempMin, v.tempMinCell,
+        v.balanceMode, v.balanceStatus, balanceCells,
+        v.chargerVoltage, v.chargerCurrent,
+        v.heartbeat
+    );
+
+    if (len < 0 || len >= (int)cap) return 0;
+    return len;
+}
+
+// =============================================
+// SNAPSHOT ACAK
+// =============================================
+static uint32_t randomState = 0x9E3779B9;
+
+static uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static int randomRange(int lo, int hi) {
+    return lo + (int)(nextRandom() % (uint32_t)(hi - lo + 1));
+}
+
+// Sepersepuluh dalam rentang, kadang tepat di .x5 (pembulatan %.1f)
+static float randomDeci(int lo, int hi) {
+    float value = randomRange(lo * 10, hi * 10) / 10.0f;
+    if (nextRandom() % 4 == 0) value += 0.05f;
+    return value;
+}
+
+// Rentang selebar tipe CAN / BMS: lebar angka ikut teruji
+static BleJsonSnapshot randomSnapshot() {
+    static const char *MODES[] = {"PARK", "DRIVE", "BRAKE", "CHARGING", "STAND", "SPORT", "UNKNOWN"};
+    BleJsonSnapshot v;
+    memset(&v, 0, sizeof(v));
+    v.rpm = randomRange(-32768, 32767);
+    v.speed = randomRange(-20, 255);
+    v.mode = MODES[nextRandom() % (sizeof(MODES) / sizeof(MODES[0]))];
+    v.voltage = randomDeci(0, 150);
+    v.current = randomDeci(-500, 500);
+    v.soc = randomRange(0, 100);
+    v.tempCtrl = randomRange(-40, 150);
+    v.tempMotor = randomRange(-40, 150);
+    v.tempBatt = randomRange(-40, 150);
+    v.canRate = nextRandom() % 5000;
+    v.heartbeat = nextRandom();
+    for (int i = 0; i < MAX_CELLS; i++) v.cells[i] = (uint16_t)nextRandom();
+    v.cellDelta = randomRange(0, 65535);
+    v.soh = randomRange(0, 100);
+    v.cycles = (uint16_t)nextRandom();
+    v.remainCap = randomDeci(0, 200);
+    v.fullCap = randomDeci(0, 200);
+    v.cellHi = (uint16_t)nextRandom();
+    v.cellHiNum = (uint8_t)nextRandom();
+    v.cellLo = (uint16_t)nextRandom();
+    v.cellLoNum = (uint8_t)nextRandom();
+    v.cellAvg = (uint16_t)nextRandom();
+    v.tempMax = (uint8_t)nextRandom();
+    v.tempMaxCell = (uint8_t)nextRandom();
+    v.tempMin = (uint8_t)nextRandom();
+    v.tempMinCell = (uint8_t)nextRandom();
+    v.balanceMode = (uint8_t)nextRandom();
+    v.balanceStatus = (uint8_t)nextRandom();
+    for (int i = 0; i < 4; i++) v.balanceBits[i] = (uint8_t)nextRandom();
+    v.chargerVoltage = randomDeci(0, 150);
+    v.chargerCurrent = randomDeci(-50, 50);
+    return v;
+}
+
+static std::string streamJson(const BleJsonSnapshot &snap, bool full, uint16_t chunk) {
+    static BleJsonStream stream;
+    uint8_t piece[BLE_MAX_CHUNK];
+    stream.snap = snap;
+    bleJsonBegin(stream, full);
+    std::string out;
+    uint16_t n;
+    while ((n = bleJsonRead(stream, piece, chunk)) > 0) {
+        EXPECT_LE(n, chunk);
+        out.append((const char*)piece, n);
+    }
+    EXPECT_TRUE(bleJsonDone(stream));
+    return out;
+}
+
+// =============================================
+// IDENTIK DENGAN REFERENSI
+// =============================================
+TEST(BleJson, StreamMatchesReference) {
+    // Chunk 1 byte, prima kecil, ATT default, MTU umum, chunk maksimum
+    static const uint16_t CHUNKS[] = {1, 2, 7, 13, BLE_DEFAULT_MTU - BLE_ATT_HEADER_BYTES, 64,
+                                      182, 244, BLE_MAX_CHUNK};
+    char expected[2200];
+
+    for (int i = 0; i < 500; i++) {
+        BleJsonSnapshot snap = randomSnapshot();
+        for (int full = 0; full < 2; full++) {
+            int len = full ? buildFullJson(expected, sizeof(expected), snap)
+                           : buildFastJson(expected, sizeof(expected), snap);
+            ASSERT_GT(len, 0);
+            for (uint16_t chunk : CHUNKS) {
+                std::string got = streamJson(snap, full, chunk);
+                ASSERT_EQ(std::string(expected, len), got) << (full ? "full" : "fast") << " snapshot "
+                                                           << i << " chunk " << chunk;
+            }
+        }
+    }
+}
+
+// Frame full tidak pernah dipotong di tengah oleh scratch serializer
+TEST(BleJson, WidestSnapshotFits) {
+    BleJsonSnapshot v = randomSnapshot();
+    v.rpm = -32768;
+    v.speed = -32768;
+    v.voltage = v.current = v.remainCap = v.fullCap = -6553.5f;
+    v.chargerVoltage = v.chargerCurrent = -6553.5f;
+    v.soc = v.soh = v.cellDelta = -32768;
+    v.tempCtrl = v.tempMotor = v.tempBatt = -32768;
+    v.canRate = 0xFFFFFFFF;
+    v.heartbeat = 0xFFFFFFFF;
+    v.cycles = v.cellHi = v.cellLo = v.cellAvg = 65535;
+    for (int i = 0; i < MAX_CELLS; i++) v.cells[i] = 65535;
+    v.cellHiNum = v.cellLoNum = v.tempMax = v.tempMaxCell = v.tempMin = v.tempMinCell = 255;
+    v.balanceMode = v.balanceStatus = 255;
+
+    char expected[2200];
+    int fast = buildFastJson(expected, sizeof(expected), v);
+    EXPECT_EQ(std::string(expected, fast), streamJson(v, false, BLE_MAX_CHUNK));
+    int full = buildFullJson(expected, sizeof(expected), v);
+    EXPECT_EQ(std::string(expected, full), streamJson(v, true, BLE_MAX_CHUNK));
+}
+
+// =============================================
+// RAM & CPU
+// =============================================
+TEST(BleJson, CostReport) {
+    const int rounds = 20000;
+    BleJsonSnapshot snap = randomSnapshot();
+    char reference[2200];
+    int fullLen = buildFullJson(reference, sizeof(reference), snap);
+    int fastLen = buildFastJson(reference, sizeof(reference), snap);
+
+    static BleJsonStream stream;
+    uint8_t piece[BLE_MAX_CHUNK];
+    uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        stream.snap = snap;
+        bleJsonBegin(stream, true);
+        uint16_t n;
+        while ((n = bleJsonRead(stream, piece, 182)) > 0) sink += piece[n - 1];
+    }
+    auto streamed = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) sink += buildFullJson(reference, sizeof(reference), snap);
+    auto printed = std::chrono::steady_clock::now() - start;
+
+    double streamNs = std::chrono::duration<double, std::nano>(streamed).count() / rounds;
+    double printNs = std::chrono::duration<double, std::nano>(printed).count() / rounds;
+    printf("\nJSON frame: fast %d B, full %d B\n", fastLen, fullLen);
+    printf("RAM: stream state %u B + chunk %u B (was frame buffer 2200 B)\n",
+           (unsigned)sizeof(BleJsonStream), (unsigned)BLE_MAX_CHUNK);
+    printf("Full frame CPU (host): stream %.0f ns (chunk 182), snprintf %.0f ns  [%u]\n",
+           streamNs, printNs, (unsigned)(sink & 1));
+
+    // Host 64-bit (pointer mode & long lebih lebar): di ESP32 lebih kecil lagi
+    EXPECT_LT(sizeof(BleJsonStream) + BLE_MAX_CHUNK, 2200u);
+}
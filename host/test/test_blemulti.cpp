@@ -0,0 +1,85 @@
+// =============================================
+// MULTI-CLIENT BLE - FAN-OUT & THROUGHPUT PER CLIENT
+// =============================================
+// 1..BLE_MAX_CLIENTS client loopback di format yang sama lewat task stream
+// asli (ble_loop_fixture.h). Frame JSON / biner yang jatuh di tick yang sama
+// diserialisasi sekali untuk semua client; delta selalu per client. Tabel:
+// ctest -V -R test_blemulti.
+#include "ble_loop_fixture.h"
+
+struct ScaleRow {
+    unsigned long serialized;
+    unsigned long delivered;
+    uint32_t framesPerClient;
+    uint32_t bytesPerSecPerClient;
+};
+
+// n client format yang sama, DRIVE selama windowMs
+static ScaleRow runClients(const char *format, int n, uint32_t windowMs) {
+    ScaleRow row = {0, 0, 0, 0};
+    int conns[BLE_MAX_CLIENTS];
+    for (int i = 0; i < n; i++) {
+        conns[i] = connect(247, format);
+        EXPECT_GE(conns[i], 0) << format << " client " << i;
+        if (conns[i] < 0) return row;
+    }
+    hostRunMs(1000);                                // Keyframe delta & frame pertama lewat
+
+    bleLoopResetStats();
+    BleStreamStats before = streamStats();
+    hostRunMs(windowMs);
+    BleStreamStats after = streamStats();
+    row.serialized = after.framesSerialized - before.framesSerialized;
+    row.delivered = after.clientFrames - before.clientFrames;
+    EXPECT_EQ(before.stallDrops, after.stallDrops) << format << " x" << n;
+
+    // Client identik: frame & byte sama, framing bersih
+    const BleLoopStats *first = bleLoopGetStats(conns[0]);
+    row.framesPerClient = first->jsonFrames + first->binaryFrames;
+    row.bytesPerSecPerClient = (uint32_t)((uint64_t)first->bytes * 1000 / windowMs);
+    for (int i = 0; i < n; i++) {
+        const BleLoopStats *s = bleLoopGetStats(conns[i]);
+        EXPECT_EQ(0u, s->badChunks) << format << " client " << i;
+        EXPECT_EQ(row.framesPerClient, s->jsonFrames + s->binaryFrames) << format << " client " << i;
+        EXPECT_EQ(first->notifications, s->notifications) << format << " client " << i;
+    }
+
+    for (int i = 0; i < n; i++) disconnect(conns[i]);
+    return row;
+}
+
+struct BleMulti : BleLoopFixture {
+    static void SetUpTestSuite() {
+        vehicle.lastModeByte = 0x70;                // DRIVE: fast 150 ms, full 1000 ms
+        BleLoopFixture::SetUpTestSuite();
+    }
+};
+
+TEST_F(BleMulti, FanoutScaling) {
+    static const char *FORMATS[] = {"json", "bin", "delta"};
+    const uint32_t windowMs = 3000;
+
+    printf("\nFormat  n  serialized  delivered  frames/client  B/s/client  B/s total\n");
+    for (const char *format : FORMATS) {
+        bool shared = strcmp(format, "delta") != 0;
+        uint32_t oneClientFrames = 0;
+        for (int n = 1; n <= BLE_MAX_CLIENTS; n++) {
+            ScaleRow row = runClients(format, n, windowMs);
+            printf("%-6s  %d  %10lu  %9lu  %13lu  %10lu  %9lu\n", format, n, row.serialized, row.delivered,
+                   (unsigned long)row.framesPerClient, (unsigned long)row.bytesPerSecPerClient,
+                   (unsigned long)row.bytesPerSecPerClient * n);
+
+            // Laju per client tidak turun karena client lain
+            if (n == 1) oneClientFrames = row.framesPerClient;
+            EXPECT_GE(row.framesPerClient + 1, oneClientFrames) << format << " x" << n;
+            EXPECT_GE(row.delivered + n, row.framesPerClient * n) << format << " x" << n;
+
+            if (shared) {
+                // Satu serialisasi per tick untuk semua client
+                EXPECT_LE(row.serialized, row.delivered / n + 1) << format << " x" << n;
+            } else {
+                EXPECT_EQ(row.serialized, row.delivered) << format << " x" << n;
+            }
+        }
+    }
+}
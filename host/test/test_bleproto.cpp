@@ -0,0 +1,246 @@
+// =============================================
+// PROTOKOL BINER BLE - ROUND-TRIP, FRAME RUSAK, UKURAN VS JSON
+// =============================================
+// Hanya fox_bleproto (tanpa task / stack). Nilai field acak deterministik
+// (xorshift, seed tetap) supaya kegagalan bisa diulang. Laporan ukuran &
+// laju dicetak ke stdout: ctest -V -R test_bleproto.
+#include "host_test.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "fox_config.h"
+#include "fox_ble.h"
+#include "fox_bleproto.h"
+
+static uint32_t randomState = 0x2545F491;
+
+static uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Semua byte acak: encoder/decoder tidak boleh peduli isi field
+static BleBinFields randomFields() {
+    BleBinFields fields;
+    uint8_t *bytes = (uint8_t*)&fields;
+    for (size_t i = 0; i < sizeof(fields); i++) bytes[i] = (uint8_t)nextRandom();
+    return fields;
+}
+
+static uint32_t randomMask() {
+    switch (nextRandom() % 4) {
+        case 0: return BLE_BIN_FAST_MASK;
+        case 1: return BLE_BIN_FULL_MASK;
+        case 2: return bleGroupFieldMask((uint8_t)(nextRandom() & BLE_GROUP_ALL));
+        default: return nextRandom() & BLE_BIN_FULL_MASK;
+    }
+}
+
+// =============================================
+// ROUND-TRIP
+// =============================================
+TEST(BleProto, RandomRoundTrip) {
+    uint8_t frame[BLE_BIN_MAX_FRAME];
+    uint8_t again[BLE_BIN_MAX_FRAME];
+
+    for (int i = 0; i < 5000; i++) {
+        BleBinFields source = randomFields();
+        uint32_t mask = randomMask();
+        uint8_t type = (uint8_t)(nextRandom() % 4);
+        uint16_t seq = (uint16_t)nextRandom();
+        uint8_t flags = (uint8_t)(nextRandom() & BLE_BIN_FLAG_KEYFRAME);
+
+        uint16_t len = bleBinEncode(source, mask, type, seq, frame, sizeof(frame), flags);
+        ASSERT_EQ(bleBinFrameSize(mask), len) << "mask 0x" << std::hex << mask;
+
+        // Field di luar bitmap tidak disentuh decoder
+        BleBinFields untouched = randomFields();
+        BleBinFields decoded = untouched;
+        BleBinHeader header;
+        ASSERT_TRUE(bleBinDecode(frame, len, header, decoded)) << "iterasi " << i;
+        EXPECT_EQ(BLE_BIN_MAGIC, header.magic);
+        EXPECT_EQ(BLE_BIN_VERSION, header.version);
+        EXPECT_EQ(type, header.type);
+        EXPECT_EQ(flags, header.flags);
+        EXPECT_EQ(seq, header.seq);
+        EXPECT_EQ(mask, header.present);
+        EXPECT_EQ(0u, bleBinDiff(decoded, source, mask)) << "iterasi " << i;
+        EXPECT_EQ(0u, bleBinDiff(decoded, untouched, BLE_BIN_FULL_MASK & ~mask)) << "iterasi " << i;
+
+        // Encode ulang hasil decode: byte identik
+        uint16_t againLen = bleBinEncode(decoded, header.present, header.type, header.seq,
+                                         again, sizeof(again), header.flags);
+        ASSERT_EQ(len, againLen);
+        EXPECT_EQ(0, memcmp(frame, again, len)) << "iterasi " << i;
+    }
+}
+
+// Frame full berisi setiap byte BleBinFields, dan muat satu notifikasi
+TEST(BleProto, FullFrameCarriesEveryField) {
+    BleBinFields source = randomFields();
+    uint8_t frame[BLE_BIN_MAX_FRAME];
+    uint16_t len = bleBinEncode(source, BLE_BIN_FULL_MASK, BLE_BIN_FULL, 7, frame, sizeof(frame));
+    EXPECT_EQ(BLE_BIN_MAX_FRAME, len);
+
+    BleBinFields decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    BleBinHeader header;
+    ASSERT_TRUE(bleBinDecode(frame, len, header, decoded));
+    EXPECT_EQ(0, memcmp(&source, &decoded, sizeof(source)));
+    EXPECT_LE(len, 185 - BLE_ATT_HEADER_BYTES);
+}
+
+TEST(BleProto, EncodeRefusesSmallBuffer) {
+    BleBinFields source = randomFields();
+    uint8_t frame[BLE_BIN_MAX_FRAME];
+    uint16_t need = bleBinFrameSize(BLE_BIN_FULL_MASK);
+    EXPECT_EQ(0, bleBinEncode(source, BLE_BIN_FULL_MASK, BLE_BIN_FULL, 0, frame, need - 1));
+    EXPECT_EQ(need, bleBinEncode(source, BLE_BIN_FULL_MASK, BLE_BIN_FULL, 0, frame, need));
+}
+
+// =============================================
+// FRAME RUSAK
+// =============================================
+TEST(BleProto, RejectsTruncatedAndPaddedFrames) {
+    for (int i = 0; i < 200; i++) {
+        BleBinFields source = randomFields();
+        uint32_t mask = randomMask();
+        uint8_t frame[BLE_BIN_MAX_FRAME + 1];
+        uint16_t len = bleBinEncode(source, mask, BLE_BIN_GROUPS, 0, frame, BLE_BIN_MAX_FRAME);
+
+        BleBinHeader header;
+        BleBinFields decoded;
+        for (uint16_t cut = 0; cut < len; cut++) {
+            EXPECT_FALSE(bleBinDecode(frame, cut, header, decoded)) << "mask 0x" << std::hex << mask
+                                                                   << std::dec << " panjang " << cut;
+        }
+        frame[len] = 0;
+        EXPECT_FALSE(bleBinDecode(frame, len + 1, header, decoded)) << "byte sisa diterima";
+    }
+}
+
+TEST(BleProto, RejectsBadHeader) {
+    BleBinFields source = randomFields();
+    uint8_t frame[BLE_BIN_MAX_FRAME];
+    uint16_t len = bleBinEncode(source, BLE_BIN_FAST_MASK, BLE_BIN_FAST, 1, frame, sizeof(frame));
+    BleBinHeader header;
+    BleBinFields decoded;
+    ASSERT_TRUE(bleBinDecode(frame, len, header, decoded));
+
+    uint8_t bad[BLE_BIN_MAX_FRAME];
+    memcpy(bad, frame, len);
+    bad[0] = '{';                                   // Chunk JSON, bukan frame biner
+    EXPECT_FALSE(bleBinDecode(bad, len, header, decoded));
+
+    memcpy(bad, frame, len);
+    bad[1] = BLE_BIN_VERSION + 1;
+    EXPECT_FALSE(bleBinDecode(bad, len, header, decoded));
+
+    // Bit field dari versi lebih baru: panjangnya tidak diketahui
+    BleBinHeader newer;
+    memcpy(&newer, frame, sizeof(newer));
+    newer.present |= BLE_FIELD_BIT(BLE_FIELD_COUNT);
+    memcpy(bad, frame, len);
+    memcpy(bad, &newer, sizeof(newer));
+    EXPECT_FALSE(bleBinDecode(bad, len, header, decoded));
+}
+
+// =============================================
+// UKURAN & LAJU VS JSON
+// =============================================
+// Snapshot realistis (23 sel 3.3xx V, nilai kendaraan berjalan). Laju pakai
+// interval mode dari getFast/SlowUpdateInterval() di fox_ble.cpp: full tiap
+// interval lambat, fast mengisi sisanya
+static BleJsonSnapshot rideSnapshot() {
+    BleJsonSnapshot v;
+    memset(&v, 0, sizeof(v));
+    v.rpm = 3120;
+    v.speed = 47;
+    v.mode = "DRIVE";
+    v.voltage = 72.4f;
+    v.current = -18.6f;
+    v.soc = 81;
+    v.tempCtrl = 41;
+    v.tempMotor = 55;
+    v.tempBatt = 33;
+    v.canRate = 412;
+    v.heartbeat = 123456;
+    for (int i = 0; i < MAX_CELLS; i++) v.cells[i] = 3300 + (i * 7) % 40;
+    v.cellDelta = 39;
+    v.soh = 97;
+    v.cycles = 212;
+    v.remainCap = 30.5f;
+    v.fullCap = 45.0f;
+    v.cellHi = 3339;
+    v.cellHiNum = 17;
+    v.cellLo = 3300;
+    v.cellLoNum = 1;
+    v.cellAvg = 3318;
+    v.tempMax = 34;
+    v.tempMaxCell = 3;
+    v.tempMin = 31;
+    v.tempMinCell = 1;
+    v.balanceBits[0] = 0x05;
+    return v;
+}
+
+static int jsonLength(bool full) {
+    static BleJsonStream stream;
+    uint8_t piece[BLE_MAX_CHUNK];
+    stream.snap = rideSnapshot();
+    bleJsonBegin(stream, full);
+    int total = 0;
+    uint16_t n;
+    while ((n = bleJsonRead(stream, piece, sizeof(piece))) > 0) total += n;
+    return total;
+}
+
+static int notifications(int len, uint16_t mtu) {
+    int cap = mtu - BLE_ATT_HEADER_BYTES;
+    return (len + cap - 1) / cap;
+}
+
+TEST(BleProto, RateReportBinaryVsJson) {
+    struct ModeRate {
+        const char *name;
+        uint32_t fastMs;
+        uint32_t slowMs;
+    };
+    static const ModeRate MODES[] = {{"PARK", 500, 2000}, {"DRIVE", 150, 1000}, {"BRAKE", 100, 1000}};
+    static const uint16_t MTUS[] = {BLE_DEFAULT_MTU, 185, 247, BLE_REQUESTED_MTU};
+
+    int fastJson = jsonLength(false);
+    int fullJson = jsonLength(true);
+    int fastBin = bleBinFrameSize(BLE_BIN_FAST_MASK);
+    int fullBin = bleBinFrameSize(BLE_BIN_FULL_MASK);
+    EXPECT_LT(fastBin, fastJson);
+    EXPECT_LT(fullBin, fullJson);
+    // Frame biner tanpa framing antar chunk: set_proto menolak MTU < frame full
+    EXPECT_LE(fullBin, 185 - BLE_ATT_HEADER_BYTES);
+
+    printf("\nFrame: fast JSON %d B / binary %d B, full JSON %d B / binary %d B\n",
+           fastJson, fastBin, fullJson, fullBin);
+    printf("Mode   MTU   JSON B/s  notif/s   binary B/s  notif/s\n");
+    for (const ModeRate &mode : MODES) {
+        float fullPerSec = 1000.0f / mode.slowMs;
+        float fastPerSec = 1000.0f / mode.fastMs - fullPerSec;
+        for (uint16_t mtu : MTUS) {
+            float jsonBytes = fastJson * fastPerSec + fullJson * fullPerSec;
+            float jsonNotif = notifications(fastJson, mtu) * fastPerSec + notifications(fullJson, mtu) * fullPerSec;
+            if (mtu - BLE_ATT_HEADER_BYTES < fullBin) {
+                printf("%-5s  %3u  %9.0f  %7.1f  %11s  %7s\n", mode.name, mtu, jsonBytes, jsonNotif,
+                       "(MTU kecil)", "-");
+                continue;
+            }
+            // Biner: tepat satu notifikasi per frame
+            float binBytes = fastBin * fastPerSec + fullBin * fullPerSec;
+            float binNotif = fastPerSec + fullPerSec;
+            EXPECT_LT(binBytes, jsonBytes);
+            EXPECT_LE(binNotif, jsonNotif);
+            printf("%-5s  %3u  %9.0f  %7.1f  %11.0f  %7.1f\n", mode.name, mtu, jsonBytes, jsonNotif,
+                   binBytes, binNotif);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+// =============================================
+// PUMP BLE - CHUNK PER MTU, CONGESTION, RETRY, CONN PARAM
+// =============================================
+// Task stream BLE + backend loopback (ble_loop_fixture.h). Tiap test
+// memakai client sendiri lalu memutusnya.
+#include "ble_loop_fixture.h"
+
+static size_t largestJsonFrame(const Receiver &r) {
+    size_t largest = 0;
+    for (const std::string &frame : r.json) largest = max(largest, frame.size());
+    return largest;
+}
+
+struct BlePump : BleLoopFixture {
+    static void SetUpTestSuite() {
+        vehicle.lastModeByte = 0x00;
+        BleLoopFixture::SetUpTestSuite();
+    }
+};
+
+// =============================================
+// UKURAN CHUNK = MTU - 3
+// =============================================
+TEST_F(BlePump, ChunksFitMtu) {
+    static const uint16_t MTUS[] = {BLE_DEFAULT_MTU, 64, 185, 247, BLE_REQUESTED_MTU};
+    for (uint16_t mtu : MTUS) {
+        int conn = connect(mtu);
+        ASSERT_GE(conn, 0) << "MTU " << mtu;
+        hostRunMs(2500);                            // PARK: minimal satu frame full
+
+        const BleLoopStats *s = bleLoopGetStats(conn);
+        const Receiver &r = receivers[conn];
+        // Chunk dipenuhi sampai batas MTU kecuali seluruh frame muat satu chunk
+        size_t cap = min(mtu - BLE_ATT_HEADER_BYTES, BLE_MAX_CHUNK);
+        EXPECT_EQ(min(cap, largestJsonFrame(r)), (size_t)s->maxChunk) << "MTU " << mtu;
+        EXPECT_EQ(0u, s->badChunks) << "MTU " << mtu;
+        EXPECT_GE(r.json.size(), 5u) << "MTU " << mtu;
+        EXPECT_EQ(0u, r.badFrames) << "MTU " << mtu;
+        disconnect(conn);
+    }
+}
+
+// =============================================
+// CONGESTION & NOTIFY GAGAL
+// =============================================
+// Selama stack congested tidak ada notify sama sekali (bukan notify yang
+// ditolak); setelah event lepas frame yang tertahan dilanjutkan utuh
+TEST_F(BlePump, CongestionDefersNotifications) {
+    int conn = connect(BLE_DEFAULT_MTU);
+    ASSERT_GE(conn, 0);
+    hostRunMs(600);
+
+    const BleLoopStats *s = bleLoopGetStats(conn);
+    BleStreamStats before = streamStats();
+    uint32_t notified = s->notifications;
+    bleLoopCongest(conn, true);
+    hostRunMs(1000);
+    BleStreamStats during = streamStats();
+    EXPECT_EQ(notified, s->notifications);
+    EXPECT_EQ(0u, s->rejected);
+    EXPECT_GT(during.chunksDeferred, before.chunksDeferred);
+    EXPECT_EQ(before.framesDropped, during.framesDropped);
+
+    bleLoopCongest(conn, false);
+    hostRunMs(1000);
+    const Receiver &r = receivers[conn];
+    EXPECT_GT(s->notifications, notified);
+    EXPECT_EQ(0u, r.badFrames);
+    EXPECT_EQ(before.framesDropped, streamStats().framesDropped);
+    disconnect(conn);
+}
+
+// Gagal sesekali: chunk yang sama dicoba lagi. Gagal lebih dari
+// BLE_NOTIFY_MAX_RETRIES: frame dibuang, seq frame itu hilang
+TEST_F(BlePump, RejectedNotifyRetriedThenDropped) {
+    int conn = connect(185, "bin");
+    ASSERT_GE(conn, 0);
+    hostRunMs(600);
+    const Receiver &r = receivers[conn];
+    ASSERT_GT(r.frames.size(), 0u);
+
+    BleStreamStats before = streamStats();
+    bleLoopRejectNotifies(conn, 5);
+    hostRunMs(1000);
+    BleStreamStats after = streamStats();
+    EXPECT_EQ(before.chunksRetried + 5, after.chunksRetried);
+    EXPECT_EQ(before.framesDropped, after.framesDropped);
+    EXPECT_EQ(0u, r.seqGaps);
+
+    bleLoopRejectNotifies(conn, BLE_NOTIFY_MAX_RETRIES + 1);
+    hostRunMs(2000);
+    BleStreamStats dropped = streamStats();
+    EXPECT_EQ(after.chunksRetried + BLE_NOTIFY_MAX_RETRIES + 1, dropped.chunksRetried);
+    EXPECT_EQ(after.framesDropped + 1, dropped.framesDropped);
+    EXPECT_EQ(1u, r.seqGaps);
+    EXPECT_EQ(0u, r.badFrames);
+    disconnect(conn);
+}
+
+// =============================================
+// CONN PARAM MENGIKUTI MODE
+// =============================================
+TEST_F(BlePump, ConnParamsFollowMode) {
+    vehicle.lastModeByte = 0x00;
+    int conn = connect(185);
+    ASSERT_GE(conn, 0);
+    hostRunMs(100);
+    const BleLoopStats *s = bleLoopGetStats(conn);
+    EXPECT_EQ(1u, s->connParamRequests);
+    EXPECT_EQ(BLE_CONN_IDLE_MIN_INTERVAL, s->minInterval);
+    EXPECT_EQ(BLE_CONN_IDLE_MAX_INTERVAL, s->maxInterval);
+
+    // Berkendara: fast 150 ms -> interval rapat, tapi tidak sebelum jeda minimum
+    vehicle.lastModeByte = 0x70;
+    hostRunMs(1000);
+    EXPECT_EQ(1u, s->connParamRequests);
+    hostRunMs(BLE_CONN_PARAM_MIN_GAP_MS);
+    EXPECT_EQ(2u, s->connParamRequests);
+    EXPECT_EQ(BLE_CONN_STREAM_MIN_INTERVAL, s->minInterval);
+    EXPECT_EQ(BLE_CONN_STREAM_MAX_INTERVAL, s->maxInterval);
+
+    vehicle.lastModeByte = 0x00;
+    hostRunMs(BLE_CONN_PARAM_MIN_GAP_MS + 500);
+    EXPECT_EQ(3u, s->connParamRequests);
+    EXPECT_EQ(BLE_CONN_IDLE_MIN_INTERVAL, s->minInterval);
+    disconnect(conn);
+}
+
+// =============================================
+// EVENT KONEKSI TIDAK PERNAH HILANG
+// =============================================
+// Burst write lalu client langsung putus: disconnect tetap diterapkan
+// setelah write. Connect yang putus sebelum task stream sempat menerapkannya
+// tidak memakai entry client dan advertising jalan lagi
+TEST_F(BlePump, LifecycleAfterWriteBurst) {
+    int conn = connect(185);
+    ASSERT_GE(conn, 0);
+    hostRunMs(100);
+    ASSERT_EQ(1, streamStats().connectedClients);
+
+    for (int i = 0; i < 3 * BLE_EVENT_QUEUE_SIZE; i++) writeCommand(conn, "{\"cmd\":\"keyframe\"}");
+    disconnect(conn);
+    EXPECT_EQ(0, streamStats().connectedClients);
+    EXPECT_EQ(0u, streamStats().writesDropped);
+
+    int brief = bleLoopConnect(185);
+    ASSERT_GE(brief, 0);
+    bleLoopDisconnect(brief);
+    hostRunMs(20);
+    processBLE();
+    EXPECT_EQ(0, streamStats().connectedClients);
+
+    int again = connect(185);
+    ASSERT_GE(again, 0);
+    hostRunMs(100);
+    EXPECT_EQ(1, streamStats().connectedClients);
+    disconnect(again);
+}
@@ -0,0 +1,167 @@
+// =============================================
+// SUBSCRIPTION BLE - COMMAND, GRUP, LAJU, UNSUBSCRIBE
+// =============================================
+// Command subscribe ditulis ke characteristic tiruan (bleLoopWrite), bukan
+// lewat serial. Client biner mendekode tiap frame: bitmap present harus
+// berada di dalam grup yang dilanggan, dan jarak antar frame per grup
+// tidak boleh lebih rapat dari interval hasil clamp.
+#include "ble_loop_fixture.h"
+
+static int binaryConn = -1;
+static int jsonConn = -1;
+
+// Field milik satu grup saja (tanpa heartbeat / canRate yang ikut tiap frame)
+static uint32_t groupOnlyFields(uint8_t g) {
+    return bleGroupFieldMask(BLE_GROUP_BIT(g)) & ~bleGroupFieldMask(0);
+}
+
+static uint8_t groupsIn(uint32_t present) {
+    uint8_t groups = 0;
+    for (uint8_t g = 0; g < BLE_GROUP_COUNT; g++) {
+        if (present & groupOnlyFields(g)) groups |= BLE_GROUP_BIT(g);
+    }
+    return groups;
+}
+
+// Frame jadwal lama yang masih antri dibuang dulu
+static void settle() {
+    hostRunMs(300);
+    for (auto &entry : receivers) clearReceived(entry.second);
+}
+
+struct BleSub : BleLoopFixture {
+    static void SetUpTestSuite() {
+        vehicle.lastModeByte = 0x70;                // DRIVE: jadwal bawaan fast 150 ms
+        BleLoopFixture::SetUpTestSuite();
+        binaryConn = connect(247, "bin");
+        jsonConn = connect(247);
+        hostRunMs(100);
+    }
+};
+
+// =============================================
+// REPLY: INTERVAL EFEKTIF SETELAH CLAMP
+// =============================================
+TEST_F(BleSub, ReplyClampsIntervals) {
+    ASSERT_GE(binaryConn, 0);
+    writeCommand(binaryConn, "{\"cmd\":\"subscribe\",\"motion\":10,\"pack\":500,\"cells\":999999,\"temps\":0}");
+    hostRunMs(10);
+    char expected[160];
+    snprintf(expected, sizeof(expected),
+             "{\"status\":\"ok\",\"cmd\":\"subscribe\",\"motion\":%d,\"pack\":500,\"cells\":%d,\"temps\":0,\"charger\":0}",
+             BLE_SUB_MIN_MOTION_MS, BLE_SUB_MAX_INTERVAL_MS);
+    EXPECT_EQ(std::string(expected), receivers[binaryConn].reply);
+}
+
+// MTU default (chunk 20 B): reply dipecah seperti frame JSON, tidak dipotong
+TEST_F(BleSub, ReplyChunkedAtDefaultMtu) {
+    int conn = connect(BLE_DEFAULT_MTU);
+    ASSERT_GE(conn, 0);
+    hostRunMs(100);
+    const BleLoopStats *s = bleLoopGetStats(conn);
+    uint32_t notified = s->notifications;
+    writeCommand(conn, "{\"cmd\":\"subscribe\",\"motion\":100,\"pack\":200}");
+    hostRunMs(300);
+
+    char expected[160];
+    int len = snprintf(expected, sizeof(expected),
+                       "{\"status\":\"ok\",\"cmd\":\"subscribe\",\"motion\":100,\"pack\":200,\"cells\":0,\"temps\":0,\"charger\":0}");
+    EXPECT_EQ(std::string(expected), receivers[conn].reply);
+    EXPECT_EQ(1u, s->replies);
+    EXPECT_EQ(0u, s->badChunks);
+    EXPECT_GE(s->notifications - notified, (uint32_t)(len + 1 + 19) / 20);
+    disconnect(conn);
+}
+
+// =============================================
+// HANYA GRUP YANG DILANGGAN, LAJU DIBATASI
+// =============================================
+TEST_F(BleSub, OnlySubscribedGroupsAtCappedRate) {
+    // motion diminta lebih cepat dari batas firmware
+    writeCommand(binaryConn, "{\"cmd\":\"subscribe\",\"motion\":20,\"cells\":1000}");
+    settle();
+    const uint32_t windowMs = 5000;
+    hostRunMs(windowMs);
+
+    const uint8_t subscribed = BLE_GROUP_BIT(BLE_GROUP_MOTION) | BLE_GROUP_BIT(BLE_GROUP_CELLS);
+    const Receiver &r = receivers[binaryConn];
+    uint32_t sends[BLE_GROUP_COUNT] = {0};
+    uint64_t lastUs[BLE_GROUP_COUNT] = {0};
+    uint64_t minGapUs[BLE_GROUP_COUNT];
+    for (int g = 0; g < BLE_GROUP_COUNT; g++) minGapUs[g] = UINT64_MAX;
+
+    for (const Frame &f : r.frames) {
+        EXPECT_EQ(BLE_BIN_GROUPS, f.header.type);
+        EXPECT_EQ(0u, f.header.present & ~bleGroupFieldMask(subscribed)) << "present 0x" << std::hex << f.header.present;
+        uint8_t groups = groupsIn(f.header.present);
+        for (int g = 0; g < BLE_GROUP_COUNT; g++) {
+            if (!(groups & BLE_GROUP_BIT(g))) continue;
+            if (sends[g] > 0) minGapUs[g] = min(minGapUs[g], f.atUs - lastUs[g]);
+            lastUs[g] = f.atUs;
+            sends[g]++;
+        }
+    }
+    printf("\nSubscribe motion 20 (-> %d) + cells 1000, %lu ms: %u frames, motion %u, cells %u\n",
+           BLE_SUB_MIN_MOTION_MS, (unsigned long)windowMs, (unsigned)r.frames.size(),
+           (unsigned)sends[BLE_GROUP_MOTION], (unsigned)sends[BLE_GROUP_CELLS]);
+
+    EXPECT_EQ(0u, sends[BLE_GROUP_PACK]);
+    EXPECT_EQ(0u, sends[BLE_GROUP_TEMPS]);
+    EXPECT_EQ(0u, sends[BLE_GROUP_CHARGER]);
+    EXPECT_GE(sends[BLE_GROUP_MOTION], windowMs / BLE_SUB_MIN_MOTION_MS - 1);
+    EXPECT_LE(sends[BLE_GROUP_MOTION], windowMs / BLE_SUB_MIN_MOTION_MS + 1);
+    EXPECT_GE(sends[BLE_GROUP_CELLS], windowMs / 1000 - 1);
+    EXPECT_LE(sends[BLE_GROUP_CELLS], windowMs / 1000 + 1);
+    // Grup yang hampir jatuh tempo boleh ikut frame lebih awal, maks BLE_SUB_COALESCE_MS
+    EXPECT_GE(minGapUs[BLE_GROUP_MOTION], (BLE_SUB_MIN_MOTION_MS - BLE_SUB_COALESCE_MS) * 1000ULL);
+    EXPECT_GE(minGapUs[BLE_GROUP_CELLS], (1000 - BLE_SUB_COALESCE_MS) * 1000ULL);
+}
+
+// Client JSON menerima frame "sub" berisi key grup yang dilanggan saja
+TEST_F(BleSub, JsonCarriesOnlySubscribedKeys) {
+    ASSERT_GE(jsonConn, 0);
+    writeCommand(jsonConn, "{\"cmd\":\"subscribe\",\"pack\":200}");
+    settle();
+    hostRunMs(2000);
+
+    const Receiver &r = receivers[jsonConn];
+    ASSERT_GE(r.json.size(), 9u);
+    for (const std::string &frame : r.json) {
+        EXPECT_NE(std::string::npos, frame.find("\"type\":\"sub\"")) << frame;
+        EXPECT_NE(std::string::npos, frame.find("\"v\":")) << frame;
+        EXPECT_EQ(std::string::npos, frame.find("\"r\":")) << frame;
+        EXPECT_EQ(std::string::npos, frame.find("\"cells\":")) << frame;
+        EXPECT_EQ(std::string::npos, frame.find("\"chr\":")) << frame;
+    }
+    EXPECT_LE(r.json.size(), 2000u / BLE_SUB_MIN_PACK_MS + 1);
+}
+
+// =============================================
+// UNSUBSCRIBE: KEMBALI KE JADWAL BAWAAN
+// =============================================
+TEST_F(BleSub, UnsubscribeRestoresDefaultSchedule) {
+    writeCommand(binaryConn, "{\"cmd\":\"unsubscribe\"}");
+    hostRunMs(10);
+    EXPECT_EQ("{\"status\":\"ok\",\"cmd\":\"unsubscribe\"}", receivers[binaryConn].reply);
+    settle();
+    hostRunMs(3000);
+
+    // DRIVE: fast 150 ms, full tiap 1000 ms
+    uint32_t fast = 0, full = 0;
+    for (const Frame &f : receivers[binaryConn].frames) {
+        if (f.header.type == BLE_BIN_FAST) {
+            EXPECT_EQ(BLE_BIN_FAST_MASK, f.header.present);
+            fast++;
+        } else if (f.header.type == BLE_BIN_FULL) {
+            EXPECT_EQ(BLE_BIN_FULL_MASK, f.header.present);
+            full++;
+        } else {
+            ADD_FAILURE() << "frame tipe " << (int)f.header.type << " setelah unsubscribe";
+        }
+    }
+    printf("Unsubscribe, DRIVE 3000 ms: %u fast + %u full frames\n", (unsigned)fast, (unsigned)full);
+    EXPECT_GE(full, 2u);
+    EXPECT_LE(full, 4u);
+    EXPECT_GE(fast + full, 3000u / 150 - 1);
+    EXPECT_LE(fast + full, 3000u / 150 + 3000u / 1000);
+}
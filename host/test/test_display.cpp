@@ -0,0 +1,233 @@
+// =============================================
+// GOLDEN IMAGE - SEMUA PAGE & LAYAR KHUSUS
+// =============================================
+// Gambar dibandingkan dari GDDRAM OLED simulasi (bukan buffer Adafruit), jadi
+// jalur render + transfer I2C ikut diuji. Page digambar dua kali: langsung
+// (display.display(), sebelum task jalan) dan lewat display task + flush
+// dirty-region + slide start line; keduanya harus sama dengan golden.
+//
+// Font FreeSansBold = subset firmware (JAMFOXRS/fox_font_*.h) dari TTF GNU
+// FreeFont lewat host/tools/fontconvert; host dan ESP32 memakai header yang
+// sama. Perbarui golden dengan FOX_UPDATE_GOLDEN=1.
+#include "host_test.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "host.h"
+#include "host_i2c.h"
+#include "fox_config.h"
+#include "fox_display.h"
+#include "fox_canbus.h"
+#include "fox_i2c.h"
+#include "fox_oled.h"
+#include "fox_rtc.h"
+#include "fox_page.h"
+#include "fox_task.h"
+#include "fox_ble.h"
+#include "fox_history.h"
+#include <driver/twai.h>
+
+// Tidak ada di header: dipanggil langsung oleh test
+void parseCANMessage(twai_message_t &message);
+void showSplashScreen();
+
+static void canFrame(uint32_t id, std::initializer_list<uint8_t> bytes) {
+    twai_message_t message = {};
+    message.extd = 1;
+    message.identifier = id;
+    message.data_length_code = (uint8_t)bytes.size();
+    std::copy(bytes.begin(), bytes.end(), message.data);
+    parseCANMessage(message);
+}
+
+// 72.4 V, arus dalam 0.1 A (signed), sisa 30.0 Ah dari 45.0 Ah
+static void feedBattery(int16_t deciAmps) {
+    uint16_t raw = (uint16_t)deciAmps;
+    canFrame(ID_VOLTAGE_CURRENT, {0x02, 0xD4, (uint8_t)(raw >> 8), (uint8_t)raw, 0x01, 0x2C, 0x01, 0xC2});
+}
+
+static void feedVehicle() {
+    canFrame(ID_CTRL_MOTOR, {0x00, 0x00, 0xE8, 0x03, 42, 55, 0x00, 0x00});
+    canFrame(0x0E6C0D09, {31, 32, 33, 34, 35});
+    feedBattery(-125);
+}
+
+static std::string readFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static void writeFile(const std::string &path, const std::string &content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+static int differingPixels(const std::string &a, const std::string &b) {
+    int diff = (int)std::max(a.size(), b.size()) - (int)std::min(a.size(), b.size());
+    for (size_t i = 0; i < std::min(a.size(), b.size()); i++) {
+        if (a[i] != b[i]) diff++;
+    }
+    return diff;
+}
+
+static void expectGolden(const char* name) {
+    std::string actual = hostOled.visiblePbm();
+    std::string goldenPath = std::string(HOST_GOLDEN_DIR) + "/" + name + ".pbm";
+
+    if (getenv("FOX_UPDATE_GOLDEN") != NULL) {
+        writeFile(goldenPath, actual);
+        return;
+    }
+
+    std::string golden = readFile(goldenPath);
+    if (actual != golden) {
+        std::string actualPath = std::string(HOST_OUTPUT_DIR) + "/" + name + ".actual.pbm";
+        writeFile(actualPath, actual);
+        ADD_FAILURE() << name << ": " << differingPixels(actual, golden)
+                      << " pixel beda dari golden, hasil di " << actualPath;
+    }
+}
+
+struct DisplayGolden {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        hostI2CReset();
+        hostRtc.setTime(8, 45, 12, 17, 8, 24);
+
+        // Urutan sama dengan setup(), tanpa task dulu (jalur sinkron)
+        Wire.setBufferSize(I2C_WIRE_BUFFER_BYTES);
+        Wire.begin(SDA_PIN, SCL_PIN);
+        Wire.setClock(100000);
+        Wire.setTimeOut(500);
+        initI2CBus();
+        initDisplay();
+        initRTC();
+
+        // Riwayat sparkline: frame CAN tiap 1/10 interval sampai layar penuh,
+        // daya -5 kW..+1.4 kW supaya kurva melewati baseline nol
+        for (int i = 0; historyHeadSeq() < SCREEN_WIDTH; i++) {
+            feedBattery((int16_t)(-250 + 450 * sin(i / 100.0)));
+            hostAdvanceUs(SPARK_SAMPLE_INTERVAL_MS * 100ULL);
+        }
+        feedVehicle();
+    }
+};
+
+TEST_F(DisplayGolden, SplashScreen) {
+    showSplashScreen();
+    expectGolden("splash");
+}
+
+TEST_F(DisplayGolden, AppModeWaiting) {
+    deviceConnected = false;
+    updateAppModeDisplay();
+    expectGolden("app_mode_waiting");
+}
+
+// Baris status ditulis di y=55 (sejak awal), di luar panel 128x32: golden
+// sama dengan AppModeWaiting. Kalau posisinya dibetulkan, golden ikut beda.
+TEST_F(DisplayGolden, AppModeConnected) {
+    deviceConnected = true;
+    updateAppModeDisplay();
+    deviceConnected = false;
+    expectGolden("app_mode_connected");
+}
+
+TEST_F(DisplayGolden, BleOff) {
+    showBleOffDisplay();
+    expectGolden("ble_off");
+}
+
+TEST_F(DisplayGolden, SetupMode) {
+    showSetupMode(true);
+    expectGolden("setup_mode");
+}
+
+TEST_F(DisplayGolden, PagesDirect) {
+    for (int page = 1; page <= PAGE_COUNT; page++) {
+        currentPage = page;
+        updateDisplay(page);
+        expectGolden(("page" + std::to_string(page)).c_str());
+    }
+}
+
+// Render + present page tanpa malloc/new sama sekali (termasuk yang langsung
+// dibebaskan lagi, tidak terlihat di allocated_blocks). Probe firmware ikut
+// mencatat frame tanpa alokasi
+TEST_F(DisplayGolden, PagesRenderWithoutAllocation) {
+    uint32_t frames, framesWithAlloc;
+    int32_t lastDelta;
+    getDisplayHeapStats(frames, framesWithAlloc, lastDelta);
+    uint32_t framesBefore = frames, allocFramesBefore = framesWithAlloc;
+
+    for (int page = 1; page <= PAGE_COUNT; page++) {
+        currentPage = page;
+        uint64_t before = hostHeapAllocations();
+        updateDisplay(page);
+        EXPECT_EQ(before, hostHeapAllocations()) << "page " << page;
+    }
+
+    getDisplayHeapStats(frames, framesWithAlloc, lastDelta);
+    EXPECT_EQ(framesBefore + PAGE_COUNT, frames);
+    EXPECT_EQ(allocFramesBefore, framesWithAlloc);
+    EXPECT_EQ(0, lastDelta);
+}
+
+// Display task + flush task: pre-render, dirty region, slide lewat start line
+TEST_F(DisplayGolden, PagesThroughDisplayTask) {
+    initFreeRTOS();
+    initDisplayTask();
+    createTasks();
+
+    for (int page = 1; page <= PAGE_COUNT; page++) {
+        currentPage = page;
+        ASSERT_TRUE(requestPageChange(page));
+        hostRunMs(1000);
+        EXPECT_EQ(0, hostOled.startLine % SCREEN_HEIGHT) << "slide belum selesai di page " << page;
+        expectGolden(("page" + std::to_string(page)).c_str());
+    }
+}
+
+// Tombol seperti ISR: handleShortPress(oledLatencyMark()) lewat display task.
+// Page berikutnya sudah di-pre-render saat idle, jadi tombol langsung
+// menukar buffer; latensi tombol sampai pixel pertama terkirim tercatat
+TEST_F(DisplayGolden, ShortPressUsesPreRender) {
+    currentPage = 1;
+    ASSERT_TRUE(requestPageChange(1));
+    hostRunMs(1000);                                // Slide selesai, idle pre-render page 2
+
+    uint32_t hits, misses, refreshes;
+    getPreRenderStats(hits, misses, refreshes);
+    ASSERT_GT(refreshes, 0u);
+    uint32_t hitsBefore = hits, missesBefore = misses;
+    resetOledStats();
+
+    handleShortPress(oledLatencyMark());
+    hostRunMs(1000);
+    EXPECT_EQ(getNextPageInOrder(1), currentPage);
+
+    getPreRenderStats(hits, misses, refreshes);
+    EXPECT_EQ(hitsBefore + 1, hits);
+    EXPECT_EQ(missesBefore, misses);
+
+    OledStats stats;
+    getOledStats(stats);
+    printf("\nShort press -> pixel: %lu us (max %lu)\n", (unsigned long)stats.eventLatencyUs,
+           (unsigned long)stats.eventLatencyMaxUs);
+    // Tanpa render: paling lama satu frame penuh di kabel (9 bit/byte, +64 B
+    // alamat/control/window) ditambah 2 ms wake task
+    uint32_t frameWireUs = (uint32_t)((OLED_BUFFER_SIZE + 64) * 9 * 1000000ULL / i2cGetClockHz());
+    EXPECT_GT(stats.eventLatencyUs, 0u);
+    EXPECT_LE(stats.eventLatencyMaxUs, frameWireUs + 2000);
+    expectGolden(("page" + std::to_string(currentPage)).c_str());
+}
+
+TEST_F(DisplayGolden, BmsStaleMarker) {
+    currentPage = 3;
+    ASSERT_TRUE(requestPageChange(3));
+    hostRunMs(DATA_FRESH_TIMEOUT_NORMAL_MS + 1000);
+    expectGolden("page3_stale");
+}
@@ -0,0 +1,189 @@
+// =============================================
+// FORMAT ANGKA - ORACLE STRING + DTOSTRF LAMA
+// =============================================
+// formatVoltage/Current/Power dan removeTrailingZero versi buffer harus
+// menghasilkan teks yang sama persis dengan versi String sebelum user-026.
+// Versi lama disalin apa adanya di bawah; dtostrf di mock adalah port dari
+// stdlib_noniso.c arduino-esp32, sprintf("%.0f") memakai libc host.
+#include "host_test.h"
+#include <math.h>
+#include <random>
+
+#include "host.h"
+#include "fox_display.h"
+#include "fox_fonts.h"
+#include "fox_font_clock18.h"
+#include "fox_font_label12.h"
+#include "fox_font_label9.h"
+
+// =============================================
+// VERSI LAMA (SEBELUM user-026)
+// =============================================
+static String legacyRemoveTrailingZero(float value, int decimalPlaces) {
+    char buffer[20];
+    dtostrf(value, 0, decimalPlaces, buffer);
+    String result = String(buffer);
+    if (result.indexOf('.') != -1) {
+        while (result.endsWith("0")) result.remove(result.length() - 1);
+        if (result.endsWith(".")) result.remove(result.length() - 1);
+    }
+    return result;
+}
+
+static String legacyFormatVoltage(float voltage) {
+    if (voltage < 0.05f && voltage > -0.05f) return "0";
+    if (voltage < 100.0f) return legacyRemoveTrailingZero(voltage, 1);
+    else {
+        char buffer[10];
+        sprintf(buffer, "%.0f", voltage);
+        return String(buffer);
+    }
+}
+
+static String legacyFormatCurrent(float current) {
+    float absCurrent = fabs(current);
+    if (absCurrent < 0.05f) return "0";
+    if (absCurrent < 10.0f) return legacyRemoveTrailingZero(absCurrent, 1);
+    else if (absCurrent < 100.0f) return legacyRemoveTrailingZero(absCurrent, 1);
+    else {
+        char buffer[10];
+        sprintf(buffer, "%.0f", absCurrent);
+        return String(buffer);
+    }
+}
+
+static String legacyFormatPower(float power) {
+    float absPower = fabs(power);
+    if (absPower < 0.05f) return "0";
+    if (absPower < 10.0f) return legacyRemoveTrailingZero(absPower, 1);
+    else {
+        char buffer[10];
+        sprintf(buffer, "%.0f", absPower);
+        return String(buffer);
+    }
+}
+
+// =============================================
+// INPUT
+// =============================================
+// Kelipatan 0.01 (nilai CAN x0.1 dan hasil kali daya), kelipatan 1/8 (tie
+// pembulatan yang tepat di float), batas cabang, plus float acak
+static std::vector<float> sampleValues(float limit) {
+    std::vector<float> values;
+    for (int i = -(int)(limit * 100); i <= (int)(limit * 100); i++) values.push_back(i / 100.0f);
+    for (int i = -(int)(limit * 8); i <= (int)(limit * 8); i++) values.push_back(i / 8.0f);
+
+    const float edges[] = {0.05f, 0.0499999f, 9.95f, 9.9499998f, 10.0f, 99.95f, 99.9499969f, 100.0f,
+                           100.5f, 101.5f, 999.5f, 9999.5f};
+    for (float edge : edges) {
+        values.push_back(edge);
+        values.push_back(-edge);
+        values.push_back(nextafterf(edge, 0.0f));
+        values.push_back(nextafterf(edge, 2.0f * edge));
+    }
+
+    std::mt19937 rng(26);
+    std::uniform_real_distribution<float> dist(-limit, limit);
+    for (int i = 0; i < 200000; i++) values.push_back(dist(rng));
+    return values;
+}
+
+template <typename NewFormat, typename OldFormat>
+static void expectSameText(const char* what, float limit, NewFormat newFormat, OldFormat oldFormat) {
+    int mismatches = 0;
+    for (float value : sampleValues(limit)) {
+        char buf[16];
+        TextExtent extent = newFormat(buf, sizeof(buf), value);
+        String expected = oldFormat(value);
+        if (expected != buf && mismatches++ < 10) {
+            ADD_FAILURE() << what << "(" << value << "): lama \"" << expected.c_str() << "\", baru \"" << buf << "\"";
+        }
+        EXPECT_EQ(strlen(buf), (size_t)extent.length);
+    }
+    EXPECT_EQ(0, mismatches);
+}
+
+// Rentang mengikuti kendaraan: tegangan < 150 V, arus +-400 A, daya +-30 kW
+TEST(FormatOracle, Voltage) {
+    expectSameText("formatVoltage", 150.0f,
+                   [](char* buf, size_t size, float v) { return formatVoltage(buf, size, v); },
+                   legacyFormatVoltage);
+}
+
+TEST(FormatOracle, Current) {
+    expectSameText("formatCurrent", 400.0f,
+                   [](char* buf, size_t size, float v) { return formatCurrent(buf, size, v); },
+                   legacyFormatCurrent);
+}
+
+TEST(FormatOracle, Power) {
+    expectSameText("formatPower", 30000.0f,
+                   [](char* buf, size_t size, float v) { return formatPower(buf, size, v); },
+                   legacyFormatPower);
+}
+
+TEST(FormatOracle, RemoveTrailingZero) {
+    for (int decimalPlaces = 0; decimalPlaces <= 3; decimalPlaces++) {
+        int mismatches = 0;
+        for (float value : sampleValues(1000.0f)) {
+            char buf[24];
+            removeTrailingZero(buf, sizeof(buf), value, decimalPlaces);
+            String expected = legacyRemoveTrailingZero(value, decimalPlaces);
+            if (expected != buf && mismatches++ < 10) {
+                ADD_FAILURE() << "removeTrailingZero(" << value << ", " << decimalPlaces << "): lama \""
+                              << expected.c_str() << "\", baru \"" << buf << "\"";
+            }
+        }
+        EXPECT_EQ(0, mismatches) << "decimalPlaces " << decimalPlaces;
+    }
+}
+
+// Lebar = jumlah karakter x 6 px x textSize (font default 5x7 + spasi)
+TEST(FormatOracle, ExtentWidth) {
+    char buf[16];
+    for (uint8_t textSize = 1; textSize <= 3; textSize++) {
+        TextExtent extent = formatVoltage(buf, sizeof(buf), 72.4f, textSize);
+        EXPECT_STREQ("72.4", buf);
+        EXPECT_EQ(4, extent.length);
+        EXPECT_EQ(4 * 6 * textSize, extent.width);
+    }
+}
+
+TEST(FormatOracle, NonFinite) {
+    char buf[16];
+    removeTrailingZero(buf, sizeof(buf), NAN, 1);
+    EXPECT_STREQ(legacyRemoveTrailingZero(NAN, 1).c_str(), buf);
+    removeTrailingZero(buf, sizeof(buf), INFINITY, 1);
+    EXPECT_STREQ(legacyRemoveTrailingZero(INFINITY, 1).c_str(), buf);
+    removeTrailingZero(buf, sizeof(buf), 5e9f, 1);
+    EXPECT_STREQ(legacyRemoveTrailingZero(5e9f, 1).c_str(), buf);
+}
+
+// =============================================
+// FONT SUBSET - METRIK CONSTEXPR = TABEL GLYPH
+// =============================================
+// Posisi label dihitung compiler dari metrik constexpr; harus sama dengan
+// centeredXFont() yang membaca GFXglyph dari header yang sama
+TEST(FontSubset, ConstexprMatchesGlyphTable) {
+    static const char *LABELS[] = {"APP MODE", "BLE OFF", SETUP_TEXT, SPLASH_TEXT, " ", ""};
+    for (const char *label : LABELS) {
+        EXPECT_EQ(centeredXFont(&FreeSansBold9ptLabels, label),
+                  constCenteredXFont(FreeSansBold9ptLabelsLayout, label)) << "9pt \"" << label << "\"";
+    }
+    EXPECT_EQ(centeredXFont(&FreeSansBold12ptLabels, SPLASH_TEXT),
+              constCenteredXFont(FreeSansBold12ptLabelsLayout, SPLASH_TEXT));
+    EXPECT_EQ(centeredXFont(&FreeSansBold18ptClock, "12:34"), constCenteredXFont(FreeSansBold18ptClockLayout, "12:34"));
+
+    static_assert(fontCovers(FreeSansBold18ptClockLayout, "0123456789:"), "digit jam");
+    static_assert(!fontCovers(FreeSansBold9ptLabelsLayout, "C"), "C tidak ada di subset label");
+    static_assert(!fontCovers(FreeSansBold18ptClockLayout, "12.34"), "titik di luar rentang");
+}
+
+// Glyph di luar subset kosong: tanpa tinta, tanpa advance, tanpa bitmap
+TEST(FontSubset, UnselectedGlyphsAreEmpty) {
+    const GFXglyph &c = FreeSansBold9ptLabelsGlyphs['C' - FreeSansBold9ptLabels.first];
+    EXPECT_EQ(0, c.width);
+    EXPECT_EQ(0, c.height);
+    EXPECT_EQ(0, c.xAdvance);
+    EXPECT_EQ(0, fontTextExtent(&FreeSansBold9ptLabels, "C").width);
+}
@@ -0,0 +1,134 @@
+// =============================================
+// I2C CLOCK GOVERNOR - TURUN SAAT ERROR, NAIK SAAT TENANG
+// =============================================
+// Bus task saja di atas bus simulasi. Error disuntik per transaksi; clock
+// yang benar-benar dipakai dibaca dari log transaksi Wire.
+#include "host_test.h"
+
+#include "host.h"
+#include "host_i2c.h"
+#include <Wire.h>
+#include "fox_config.h"
+#include "fox_i2c.h"
+#include "fox_task.h"
+
+static const uint8_t PROBE[] = {0x00};
+
+struct I2CGovernor {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        hostI2CReset();
+        Wire.begin(SDA_PIN, SCL_PIN);
+        Wire.setClock(100000);
+        Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+
+        initFreeRTOS();
+        initI2CBus();
+        xTaskCreatePinnedToCore(i2cBusTask, "I2C_Bus", I2C_BUS_TASK_STACK_SIZE, NULL,
+                                I2C_BUS_TASK_PRIORITY, &i2cBusTaskHandle, I2C_BUS_TASK_CORE);
+        hostRunMs(1);
+    }
+};
+
+static uint8_t okWrite() {
+    return i2cWrite(I2C_DEV_OLED, PROBE, sizeof(PROBE));
+}
+
+// Error tunggal (NACK data) diapit transaksi sukses supaya recovery tidak terpicu
+static void nackWrite() {
+    hostI2CInjectFault(OLED_ADDRESS, 3);
+    i2cWrite(I2C_DEV_OLED, PROBE, sizeof(PROBE));
+    okWrite();
+}
+
+static uint32_t wireClockOfNextTransaction() {
+    okWrite();
+    return hostI2CLog().back().clockHz;
+}
+
+TEST_F(I2CGovernor, StartsAtConfiguredClock) {
+    EXPECT_EQ((uint32_t)I2C_CLOCK_START_HZ, i2cGetClockHz());
+    // Wire.setClock(100k) dari setup ditimpa sebelum transaksi pertama
+    EXPECT_EQ((uint32_t)I2C_CLOCK_START_HZ, wireClockOfNextTransaction());
+}
+
+TEST_F(I2CGovernor, SingleErrorPerWindowKeepsClock) {
+    uint32_t start = i2cGetClockHz();
+    nackWrite();
+    EXPECT_EQ(start, i2cGetClockHz());
+
+    // Jendela penuh tanpa error lagi: hitungan error kembali nol
+    for (int i = 0; i < I2C_GOVERNOR_WINDOW; i++) okWrite();
+    nackWrite();
+    EXPECT_EQ(start, i2cGetClockHz());
+}
+
+// Address NACK = device absen / sibuk, bukan error sinyal
+TEST_F(I2CGovernor, AddressNackKeepsClock) {
+    uint32_t start = i2cGetClockHz();
+    I2CDeviceStats before;
+    getI2CDeviceStats(I2C_DEV_OLED, before);
+    for (int i = 0; i < 2 * I2C_GOVERNOR_STEP_DOWN_ERRORS; i++) {
+        hostI2CInjectFault(OLED_ADDRESS, 2);
+        i2cWrite(I2C_DEV_OLED, PROBE, sizeof(PROBE));
+        okWrite();
+    }
+    EXPECT_EQ(start, i2cGetClockHz());
+
+    I2CDeviceStats after;
+    getI2CDeviceStats(I2C_DEV_OLED, after);
+    EXPECT_EQ(before.addressNacks + 2 * I2C_GOVERNOR_STEP_DOWN_ERRORS, after.addressNacks);
+}
+
+TEST_F(I2CGovernor, StepsDownOneLevelOnErrors) {
+    uint32_t start = i2cGetClockHz();
+    for (int i = 0; i < I2C_GOVERNOR_STEP_DOWN_ERRORS; i++) nackWrite();
+
+    EXPECT_EQ(start / 2, i2cGetClockHz());
+    EXPECT_EQ(start / 2, wireClockOfNextTransaction());
+
+    // Timeout juga dihitung sebagai error bus
+    for (int i = 0; i < I2C_GOVERNOR_STEP_DOWN_ERRORS; i++) {
+        hostI2CInjectFault(OLED_ADDRESS, 5);
+        okWrite();
+        okWrite();
+    }
+    EXPECT_EQ(start / 4, i2cGetClockHz());
+}
+
+TEST_F(I2CGovernor, NeverBelowMinimum) {
+    for (int step = 0; step < 10; step++) {
+        for (int i = 0; i < I2C_GOVERNOR_STEP_DOWN_ERRORS; i++) nackWrite();
+    }
+    EXPECT_EQ((uint32_t)I2C_CLOCK_MIN_HZ, i2cGetClockHz());
+    EXPECT_EQ((uint32_t)I2C_CLOCK_MIN_HZ, wireClockOfNextTransaction());
+}
+
+// Error di tengah periode tenang memulai hitungan dari awal
+TEST_F(I2CGovernor, ErrorRestartsQuietPeriod) {
+    uint32_t slow = i2cGetClockHz();
+    hostRunMs(I2C_GOVERNOR_QUIET_MS - 1000);
+    nackWrite();
+    hostRunMs(I2C_GOVERNOR_QUIET_MS - 1000);
+    okWrite();
+    EXPECT_EQ(slow, i2cGetClockHz());
+}
+
+// Tiap periode tenang naik satu level (dievaluasi saat ada transaksi), sampai maksimum
+TEST_F(I2CGovernor, StepsUpAfterQuietPeriodUpToMaximum) {
+    uint32_t expected = i2cGetClockHz();
+    for (int step = 0; step < 10; step++) {
+        hostRunMs(I2C_GOVERNOR_QUIET_MS);
+        okWrite();
+        if (expected < (uint32_t)I2C_CLOCK_MAX_HZ) expected *= 2;
+        EXPECT_EQ(expected, i2cGetClockHz()) << "periode " << step;
+    }
+    EXPECT_EQ((uint32_t)I2C_CLOCK_MAX_HZ, i2cGetClockHz());
+    EXPECT_EQ((uint32_t)I2C_CLOCK_MAX_HZ, wireClockOfNextTransaction());
+
+    // Tanpa transaksi tidak ada evaluasi, clock tidak berubah diam-diam
+    for (int i = 0; i < I2C_GOVERNOR_STEP_DOWN_ERRORS; i++) nackWrite();
+    uint32_t stepped = i2cGetClockHz();
+    hostRunMs(3 * I2C_GOVERNOR_QUIET_MS);
+    EXPECT_EQ(stepped, i2cGetClockHz());
+}
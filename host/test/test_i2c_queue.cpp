@@ -0,0 +1,203 @@
+// =============================================
+// I2C BUS MANAGER - ANTRIAN, PRIORITAS, FAULT
+// =============================================
+// Hanya task I2C_Bus yang dibuat; test (task "loop") submit transaksi lalu
+// tidur dengan hostRunMs supaya bus task jalan. Urutan eksekusi dibaca dari
+// callback dan log transaksi Wire simulasi.
+#include "host_test.h"
+#include <vector>
+
+#include "host.h"
+#include "host_i2c.h"
+#include <Wire.h>
+#include "fox_config.h"
+#include "fox_i2c.h"
+#include "fox_task.h"
+
+static const uint8_t OLED_DATA[] = {0x40, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+                                    0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+
+static std::vector<int> completed;
+
+static void recordCompletion(I2CTransaction *txn) {
+    completed.push_back((int)(intptr_t)txn->context);
+}
+
+static I2CTransaction oledWrite(I2CPriority priority, uint32_t deadlineMs, int tag) {
+    I2CTransaction txn = {};
+    txn.device = I2C_DEV_OLED;
+    txn.priority = priority;
+    txn.txData = OLED_DATA;
+    txn.txLen = sizeof(OLED_DATA);
+    txn.deadlineMs = deadlineMs;
+    txn.callback = recordCompletion;
+    txn.context = (void*)(intptr_t)tag;
+    return txn;
+}
+
+struct I2CQueue {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        hostI2CReset();
+        Wire.setBufferSize(I2C_WIRE_BUFFER_BYTES);
+        Wire.begin(SDA_PIN, SCL_PIN);
+        Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+
+        initFreeRTOS();
+        initI2CBus();
+        xTaskCreatePinnedToCore(i2cBusTask, "I2C_Bus", I2C_BUS_TASK_STACK_SIZE, NULL,
+                                I2C_BUS_TASK_PRIORITY, &i2cBusTaskHandle, I2C_BUS_TASK_CORE);
+        hostRunMs(1);
+    }
+};
+
+TEST_F(I2CQueue, SyncReadReturnsDeviceData) {
+    hostRtc.setTime(21, 7, 33, 5, 6, 25);
+    uint8_t reg = 0x00;
+    uint8_t rx[3] = {0};
+
+    ASSERT_EQ(I2C_STATUS_OK, i2cWriteRead(I2C_DEV_RTC, &reg, 1, rx, sizeof(rx)));
+    EXPECT_EQ(0x33, rx[0]);
+    EXPECT_EQ(0x07, rx[1]);
+    EXPECT_EQ(0x21, rx[2]);
+    // Dieksekusi bus task, bukan pemanggil
+    EXPECT_STREQ("I2C_Bus", hostI2CLog().back().task.c_str());
+}
+
+// Prioritas, lalu deadline terdekat (tanpa deadline paling akhir), lalu FIFO
+TEST_F(I2CQueue, PriorityDeadlineFifoOrder) {
+    I2CTransaction txns[] = {
+        oledWrite(I2C_PRIO_LOW, 0, 0),
+        oledWrite(I2C_PRIO_NORMAL, 0, 1),
+        oledWrite(I2C_PRIO_NORMAL, 50, 2),
+        oledWrite(I2C_PRIO_NORMAL, 10, 3),
+        oledWrite(I2C_PRIO_HIGH, 0, 4),
+        oledWrite(I2C_PRIO_NORMAL, 0, 5),
+        oledWrite(I2C_PRIO_HIGH, 0, 6),
+    };
+
+    completed.clear();
+    for (I2CTransaction &txn : txns) ASSERT_TRUE(i2cSubmit(&txn));
+    hostRunMs(20);
+
+    std::vector<int> expected = {4, 6, 3, 2, 1, 5, 0};
+    ASSERT_EQ(expected.size(), completed.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i], completed[i]) << "posisi " << i;
+    }
+    for (I2CTransaction &txn : txns) EXPECT_EQ(I2C_STATUS_OK, txn.status);
+}
+
+TEST_F(I2CQueue, ExpiredBeforeRunNeverReachesWire) {
+    I2CTransaction txn = oledWrite(I2C_PRIO_NORMAL, 1, 0);
+    I2CDeviceStats before;
+    getI2CDeviceStats(I2C_DEV_OLED, before);
+
+    hostI2CClearLog();
+    ASSERT_TRUE(i2cSubmit(&txn));
+    hostAdvanceUs(2000);            // Bus task belum sempat jalan
+    hostRunMs(5);
+
+    I2CDeviceStats after;
+    getI2CDeviceStats(I2C_DEV_OLED, after);
+    EXPECT_EQ(I2C_STATUS_EXPIRED, txn.status);
+    EXPECT_EQ(before.expired + 1, after.expired);
+    EXPECT_TRUE(hostI2CLog().empty());
+}
+
+TEST_F(I2CQueue, QueueFullRejected) {
+    I2CTransaction txns[I2C_QUEUE_DEPTH + 1];
+    for (int i = 0; i <= I2C_QUEUE_DEPTH; i++) txns[i] = oledWrite(I2C_PRIO_LOW, 0, i);
+
+    completed.clear();
+    for (int i = 0; i < I2C_QUEUE_DEPTH; i++) ASSERT_TRUE(i2cSubmit(&txns[i]));
+    EXPECT_FALSE(i2cSubmit(&txns[I2C_QUEUE_DEPTH]));
+    EXPECT_EQ(I2C_STATUS_QUEUE_FULL, txns[I2C_QUEUE_DEPTH].status);
+
+    hostRunMs(50);
+    EXPECT_EQ((size_t)I2C_QUEUE_DEPTH, completed.size());
+}
+
+// Status Wire sampai ke pemanggil dan ke counter per device
+TEST_F(I2CQueue, InjectedFaultsReported) {
+    resetI2CStats();
+
+    hostI2CInjectFault(OLED_ADDRESS, 2);
+    EXPECT_EQ(2, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+    EXPECT_EQ(I2C_STATUS_OK, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+
+    hostI2CInjectFault(OLED_ADDRESS, 3);
+    EXPECT_EQ(3, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+    EXPECT_EQ(I2C_STATUS_OK, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+
+    hostI2CInjectFault(OLED_ADDRESS, 5);
+    uint64_t startUs = hostNowUs();
+    EXPECT_EQ(I2C_STATUS_TIMEOUT, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+    EXPECT_GE(hostNowUs() - startUs, (uint64_t)I2C_WIRE_TIMEOUT_MS * 1000);
+    EXPECT_EQ(I2C_STATUS_OK, i2cWrite(I2C_DEV_OLED, OLED_DATA, sizeof(OLED_DATA)));
+
+    // Modul tanpa EEPROM: address NACK
+    uint8_t reg[2] = {0x00, 0x00};
+    hostI2CDetach(EEPROM_I2C_ADDRESS);
+    EXPECT_EQ(2, i2cWrite(I2C_DEV_EEPROM, reg, sizeof(reg)));
+    hostI2CAttach(EEPROM_I2C_ADDRESS, &hostEeprom);
+
+    I2CDeviceStats oled;
+    getI2CDeviceStats(I2C_DEV_OLED, oled);
+    EXPECT_EQ(6u, oled.transactions);
+    EXPECT_EQ(3u, oled.errors);
+    EXPECT_EQ(2u, oled.nacks);
+    EXPECT_EQ(1u, oled.addressNacks);
+    EXPECT_EQ(1u, oled.timeouts);
+
+    I2CDeviceStats eeprom;
+    getI2CDeviceStats(I2C_DEV_EEPROM, eeprom);
+    EXPECT_EQ(1u, eeprom.nacks);
+    EXPECT_EQ(1u, eeprom.addressNacks);
+
+    // Error tidak berturut-turut: tidak memicu recovery
+    I2CRecoveryStats recovery;
+    getI2CRecoveryStats(recovery);
+    EXPECT_EQ(0u, recovery.requested);
+}
+
+// =============================================
+// STARVATION
+// =============================================
+// Dua transaksi HIGH submit ulang dirinya dari callback, jadi antrian HIGH
+// tidak pernah kosong. Transaksi LOW harus tetap jalan lewat aging.
+static int floodCount = 0;
+static bool lowDone = false;
+static uint64_t lowDoneUs = 0;
+
+static void floodCallback(I2CTransaction *txn) {
+    floodCount++;
+    if (!lowDone && floodCount < 2000) i2cSubmit(txn);
+}
+
+static void lowCallback(I2CTransaction *txn) {
+    lowDone = true;
+    lowDoneUs = hostNowUs();
+}
+
+TEST_F(I2CQueue, LowPriorityNotStarved) {
+    I2CTransaction flood[2] = {oledWrite(I2C_PRIO_HIGH, 0, 0), oledWrite(I2C_PRIO_HIGH, 0, 1)};
+    for (I2CTransaction &txn : flood) txn.callback = floodCallback;
+
+    I2CTransaction low = oledWrite(I2C_PRIO_LOW, 0, 2);
+    low.callback = lowCallback;
+
+    for (I2CTransaction &txn : flood) ASSERT_TRUE(i2cSubmit(&txn));
+    uint64_t submitUs = hostNowUs();
+    ASSERT_TRUE(i2cSubmit(&low));
+    hostRunMs(1000);
+
+    ASSERT_TRUE(lowDone);
+    uint64_t waitedMs = (lowDoneUs - submitUs) / 1000;
+    // LOW -> NORMAL -> HIGH: dua langkah aging, lalu menang FIFO
+    EXPECT_GE(waitedMs, (uint64_t)2 * I2C_QUEUE_AGING_MS);
+    EXPECT_LE(waitedMs, (uint64_t)2 * I2C_QUEUE_AGING_MS + 2);
+    // Selama menunggu, HIGH tetap didahulukan
+    EXPECT_GT(floodCount, 10);
+    EXPECT_LT(floodCount, 2000);
+}
@@ -0,0 +1,229 @@
+// =============================================
+// I2C BUS RECOVERY - STATE MACHINE & DAMPAK KE DISPLAY
+// =============================================
+// Sistem lengkap (semua task) jalan di atas bus simulasi. Slave dibuat
+// menahan SDA (hostI2CStickSda): transaksi timeout beruntun harus memicu
+// recovery otomatis, tiap langkah terlihat di pin, dan display task tidak
+// pernah tertahan lebih dari satu frame.
+#include "host_test.h"
+#include <string>
+#include <vector>
+
+#include "host.h"
+#include "host_i2c.h"
+#include <Wire.h>
+#include "fox_config.h"
+#include "fox_display.h"
+#include "fox_i2c.h"
+#include "fox_page.h"
+#include "fox_task.h"
+
+struct I2CRecovery {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        hostI2CReset();
+
+        Wire.setBufferSize(I2C_WIRE_BUFFER_BYTES);
+        Wire.begin(SDA_PIN, SCL_PIN);
+        Wire.setClock(100000);
+        Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+        initI2CBus();
+        initDisplay();
+
+        initFreeRTOS();
+        initDisplayTask();
+        createTasks();
+
+        // Page tanpa jam: isi layar tetap selama test
+        currentPage = 3;
+        requestPageChange(3);
+        hostRunMs(1000);
+    }
+};
+
+static uint32_t recoveriesDone() {
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    return stats.succeeded + stats.failed;
+}
+
+// Jalankan sistem per 1 ms sampai recovery selesai; urutan nama langkah dicatat
+static std::vector<std::string> runUntilRecovered(uint32_t limitMs, void (*onStep)(const std::string&) = NULL) {
+    std::vector<std::string> states = {i2cRecoveryStateName()};
+    uint32_t doneBefore = recoveriesDone();
+
+    for (uint32_t ms = 0; ms < limitMs && recoveriesDone() == doneBefore; ms++) {
+        hostRunMs(1);
+        std::string state = i2cRecoveryStateName();
+        if (state != states.back()) {
+            states.push_back(state);
+            if (onStep != NULL) onStep(state);
+        }
+    }
+    return states;
+}
+
+// =============================================
+// SETIAP LANGKAH
+// =============================================
+static uint32_t pulsesAtStart = 0;
+static uint32_t stopsAtStart = 0;
+static int stepFailures = 0;
+
+// Nama = langkah berikutnya, jadi yang dicek adalah hasil langkah sebelumnya
+static void checkStep(const std::string &state) {
+    if (state == "PULSE") {
+        // RELEASE: Wire dilepas, pin jadi GPIO (SCL open-drain high, SDA input)
+        if (hostPinMode(SCL_PIN) != OUTPUT_OPEN_DRAIN || hostPinMode(SDA_PIN) != INPUT_PULLUP) stepFailures++;
+    } else if (state == "STOP") {
+        // PULSE: slave melepas SDA setelah 5 pulsa, tidak ada pulsa lebih
+        if (hostI2CStuckPulsesLeft() != 0 || hostI2CSclPulses() - pulsesAtStart != 5) stepFailures++;
+        if (digitalRead(SDA_PIN) != HIGH) stepFailures++;
+    } else if (state == "REINIT") {
+        // STOP: satu kondisi STOP di bus
+        if (hostI2CStopConditions() - stopsAtStart != 1) stepFailures++;
+    } else if (state == "PROBE") {
+        // REINIT: pin dikembalikan ke Wire, probe menunggu settle
+        if (hostPinMode(SCL_PIN) != INPUT_PULLUP || hostPinMode(SDA_PIN) != INPUT_PULLUP) stepFailures++;
+    }
+}
+
+// Sekaligus regresi reinit: display.begin() mengosongkan back buffer, frame
+// sesudah recovery harus menggambar ulang page penuh (bukan hanya widget berubah)
+TEST_F(I2CRecovery, StuckSdaRecoveredStepByStep) {
+    std::string before = hostOled.visiblePbm();
+    uint32_t clockBefore = i2cGetClockHz();
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    uint32_t succeededBefore = stats.succeeded;
+
+    pulsesAtStart = hostI2CSclPulses();
+    stopsAtStart = hostI2CStopConditions();
+    stepFailures = 0;
+
+    // Glitch: OLED reset (GDDRAM & konfigurasi hilang) dan SDA ditahan
+    hostOled.powerOn();
+    hostI2CStickSda(5);
+
+    std::vector<std::string> states = runUntilRecovered(5000, checkStep);
+    std::vector<std::string> expected = {"IDLE", "RELEASE", "PULSE", "STOP", "REINIT", "PROBE", "IDLE"};
+    ASSERT_EQ(expected.size(), states.size());
+    for (size_t i = 0; i < expected.size(); i++) EXPECT_STREQ(expected[i].c_str(), states[i].c_str());
+    EXPECT_EQ(0, stepFailures);
+
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(succeededBefore + 1, stats.succeeded);
+    EXPECT_EQ(5, stats.lastPulses);
+    // Tanpa probe gagal: langkah + settle, jauh di bawah satu frame
+    EXPECT_LT(stats.lastTimeUs, (uint32_t)(I2C_RECOVERY_SETTLE_MS + 10) * 1000);
+    // Langkah terlama: probe + display.begin() di hook (~25 perintah I2C)
+    EXPECT_LT(stats.stepMaxUs, 2000u);
+    // Mulai lagi satu level lebih lambat
+    EXPECT_LT(i2cGetClockHz(), clockBefore);
+
+    // OLED dikonfigurasi ulang oleh hook dan page digambar penuh lagi
+    hostRunMs(2 * DISPLAY_UPDATE_INTERVAL_MS);
+    EXPECT_TRUE(hostOled.displayOn);
+    EXPECT_GT(hostOled.commandCount, 0u);
+    EXPECT_TRUE(hostOled.visiblePbm() == before) << "page tidak digambar ulang penuh setelah recovery";
+}
+
+// Satu siklus = 9 pulsa + 1 tepi SCL dari STOP; slave butuh 12 -> siklus kedua
+TEST_F(I2CRecovery, SecondCycleWhenNinePulsesNotEnough) {
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    uint32_t succeededBefore = stats.succeeded;
+
+    hostI2CStickSda(12);
+    i2cRequestRecovery();
+    runUntilRecovered(5000);
+
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(succeededBefore + 1, stats.succeeded);
+    EXPECT_EQ(2, stats.lastPulses);
+    EXPECT_EQ(0, hostI2CStuckPulsesLeft());
+    // Probe saat SDA masih tertahan habis di timeout Wire, tidak lebih
+    EXPECT_LE(stats.stepMaxUs, (uint32_t)(I2C_WIRE_TIMEOUT_MS + 1) * 1000);
+}
+
+TEST_F(I2CRecovery, GivesUpThenCooldown) {
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    uint32_t failedBefore = stats.failed;
+
+    hostI2CStickSda(255);
+    i2cRequestRecovery();
+    runUntilRecovered(10000);
+
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(failedBefore + 1, stats.failed);
+    EXPECT_STREQ("IDLE", i2cRecoveryStateName());
+    // Bus tidak dipegang lagi setelah gagal
+    EXPECT_FALSE(i2cRecoveryActive());
+
+    // Selama cooldown request diabaikan
+    uint32_t ignoredBefore = stats.ignored;
+    i2cRequestRecovery();
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(ignoredBefore + 1, stats.ignored);
+    EXPECT_FALSE(i2cRecoveryActive());
+
+    // Setelah cooldown diterima lagi; kali ini slave sudah lepas
+    hostRunMs(I2C_RECOVERY_COOLDOWN_MS);
+    hostI2CStickSda(0);
+    uint32_t succeededBefore = stats.succeeded;
+    i2cRequestRecovery();
+    if (i2cRecoveryActive()) runUntilRecovered(5000);
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(succeededBefore + 1, stats.succeeded);
+}
+
+// OLED tidak menjawab probe: semua percobaan NACK, lalu menyerah
+TEST_F(I2CRecovery, MissingOledFailsProbe) {
+    hostRunMs(I2C_RECOVERY_COOLDOWN_MS);
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    uint32_t failedBefore = stats.failed;
+
+    hostI2CDetach(OLED_ADDRESS);
+    hostI2CClearLog();
+    i2cRequestRecovery();
+    runUntilRecovered(10000);
+    hostI2CAttach(OLED_ADDRESS, &hostOled);
+
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(failedBefore + 1, stats.failed);
+
+    int probes = 0;
+    for (const HostI2CTxn &txn : hostI2CLog()) {
+        if (txn.address == OLED_ADDRESS && txn.data.empty() && txn.task == "I2C_Bus") probes++;
+    }
+    EXPECT_EQ(I2C_RECOVERY_MAX_ATTEMPTS * I2C_RECOVERY_PROBE_RETRIES, probes);
+
+    hostRunMs(I2C_RECOVERY_COOLDOWN_MS);
+    i2cRequestRecovery();
+    runUntilRecovered(5000);
+}
+
+// =============================================
+// DISPLAY TASK TIDAK TERTAHAN
+// =============================================
+// Dari SDA macet sampai pulih: display task tidak pernah menunggu bus lebih
+// dari satu interval frame (probe di safeI2COperation), selama recovery
+// frame dilewati tanpa menunggu.
+TEST_F(I2CRecovery, DisplayTaskNeverStallsMoreThanOneFrame) {
+    hostRunMs(I2C_RECOVERY_COOLDOWN_MS);
+    I2CRecoveryStats stats;
+    getI2CRecoveryStats(stats);
+    uint32_t requestedBefore = stats.requested;
+
+    hostResetTaskStats();
+    hostI2CStickSda(7);
+    runUntilRecovered(5000);
+    hostRunMs(1000);
+
+    getI2CRecoveryStats(stats);
+    EXPECT_EQ(requestedBefore + 1, stats.requested) << "recovery otomatis tidak terpicu";
+    EXPECT_FALSE(i2cRecoveryActive());
+    EXPECT_LT(hostTaskSemaphoreWaitMaxUs("Display_Task"), (uint64_t)DISPLAY_UPDATE_INTERVAL_MS * 1000);
+}
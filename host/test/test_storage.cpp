@@ -0,0 +1,223 @@
+// =============================================
+// STORAGE - RING AT24C32, POWER CUT & WEAR
+// =============================================
+// Bus task + AT24C32 simulasi (hostEeprom, 0x57). Commit dijalankan seperti
+// loop(): storageServiceTick() dipanggil dari task test. "Reboot" = chip
+// dinyalakan lagi lalu initStorage() dipanggil ulang, isi EEPROM tetap.
+#include "host_test.h"
+#include <algorithm>
+
+#include "host.h"
+#include "host_i2c.h"
+#include <Wire.h>
+#include "fox_canbus.h"
+#include "fox_config.h"
+#include "fox_i2c.h"
+#include "fox_storage.h"
+#include "fox_task.h"
+#include "fox_vehicle.h"
+
+struct Storage {
+    static void SetUpTestSuite() {
+        hostSerialEcho(false);
+        hostI2CReset();
+        Wire.setBufferSize(I2C_WIRE_BUFFER_BYTES);
+        Wire.begin(SDA_PIN, SCL_PIN);
+        Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+
+        initFreeRTOS();
+        initI2CBus();
+        xTaskCreatePinnedToCore(i2cBusTask, "I2C_Bus", I2C_BUS_TASK_STACK_SIZE, NULL,
+                                I2C_BUS_TASK_PRIORITY, &i2cBusTaskHandle, I2C_BUS_TASK_CORE);
+        hostRunMs(1);
+    }
+};
+
+static bool reboot() {
+    hostEeprom.powerOn();
+    vehicle.odometer = 0;
+    return initStorage();
+}
+
+// Satu commit lengkap: page write, tunggu tWR, verify baca ulang
+static void commitOdometer(uint32_t odometer) {
+    vehicle.odometer = odometer;
+    storageRequestCommit();
+    hostRunMs(STORAGE_MIN_COMMIT_GAP_MS);
+    storageServiceTick();
+    hostRunMs(STORAGE_WRITE_CYCLE_MS + 1);
+    storageServiceTick();
+}
+
+static StorageStats currentStats() {
+    StorageStats stats;
+    getStorageStats(stats);
+    return stats;
+}
+
+TEST_F(Storage, EmptyEepromStartsFresh) {
+    hostEeprom.erase();
+    ASSERT_TRUE(reboot());
+    EXPECT_EQ(0u, vehicle.odometer);
+    EXPECT_EQ(0, currentStats().validSlots);
+    EXPECT_EQ(0, currentStats().corruptSlots);
+
+    commitOdometer(1234);
+    EXPECT_EQ(1u, currentStats().commits);
+    EXPECT_EQ(1u, hostEeprom.pageWrites[0]);
+
+    ASSERT_TRUE(reboot());
+    EXPECT_EQ(1234u, vehicle.odometer);
+    // Statistik scan tidak menumpuk dari init sebelumnya
+    EXPECT_EQ(1, currentStats().validSlots);
+    EXPECT_EQ(0u, currentStats().commits);
+}
+
+TEST_F(Storage, MissingEepromReported) {
+    hostI2CDetach(EEPROM_I2C_ADDRESS);
+    EXPECT_FALSE(initStorage());
+    EXPECT_FALSE(isStorageAvailable());
+    hostI2CAttach(EEPROM_I2C_ADDRESS, &hostEeprom);
+    EXPECT_TRUE(reboot());
+}
+
+// tWR terburuk (datasheet 10 ms) dan page write di tengah milidetik: baca
+// ulang tidak boleh mendahului siklus tulis. Tick tiap 1 ms seperti loop()
+TEST_F(Storage, VerifyWaitsFullWriteCycle) {
+    hostEeprom.erase();
+    ASSERT_TRUE(reboot());
+    uint32_t defaultCycleUs = hostEeprom.writeCycleUs;
+    hostEeprom.writeCycleUs = STORAGE_WRITE_CYCLE_MS * 1000;
+
+    for (uint32_t offsetUs = 0; offsetUs < 1000; offsetUs += 100) {
+        vehicle.odometer += 10;
+        storageRequestCommit();
+        hostRunMs(STORAGE_MIN_COMMIT_GAP_MS);
+        delayMicroseconds(offsetUs);
+        storageServiceTick();
+        for (int ms = 0; ms < 2 * STORAGE_WRITE_CYCLE_MS; ms++) {
+            hostRunMs(1);
+            storageServiceTick();
+        }
+        EXPECT_EQ(0u, currentStats().verifyErrors) << "offset " << offsetUs << " us";
+    }
+    EXPECT_EQ(10u, currentStats().commits);
+    hostEeprom.writeCycleUs = defaultCycleUs;
+}
+
+// =============================================
+// ODOMETER: LOOP TERTAHAN
+// =============================================
+// 36 km/h = 10 m/s. Tick tertahan 5 s: dt dibatasi per tick tapi sisanya
+// dihitung di tick berikutnya, jarak tidak hilang
+static void tickMoving(uint32_t ms) {
+    hostRunMs(ms);
+    realtimeUpdateTime.store(millis());
+    storageServiceTick();
+}
+
+TEST_F(Storage, StalledTickKeepsDistance) {
+    hostEeprom.erase();
+    ASSERT_TRUE(reboot());
+    vehicle.speed = 36;
+    tickMoving(1);
+    uint32_t start = vehicle.tripMeters;
+
+    tickMoving(5000);
+    EXPECT_EQ(start + 10 * STORAGE_MAX_TICK_GAP_MS / 1000, vehicle.tripMeters);
+    tickMoving(100);
+    tickMoving(100);
+    EXPECT_EQ(start + 52, vehicle.tripMeters);
+
+    vehicle.speed = 0;
+    tickMoving(100);
+}
+
+// =============================================
+// POWER CUT DI SETIAP OFFSET BYTE
+// =============================================
+// Chip mati setelah n byte page terprogram. Setelah reboot record terbaru yang
+// valid dipakai: record baru hanya jika page lengkap (n = 32), selain itu
+// record sebelumnya. Commit berikutnya menimpa slot yang robek.
+static void powerCutAt(int bytes, uint32_t previous, uint32_t next) {
+    hostEeprom.cutPowerAfter(bytes);
+    commitOdometer(next);
+    EXPECT_FALSE(hostEeprom.powered());
+    // Verify gagal: record lama tetap dianggap committed
+    EXPECT_EQ(1u, currentStats().verifyErrors) << "offset " << bytes;
+
+    ASSERT_TRUE(reboot());
+    uint32_t expected = bytes == HostAT24C32::PAGE_SIZE ? next : previous;
+    EXPECT_EQ(expected, vehicle.odometer) << "offset " << bytes;
+
+    commitOdometer(next + 1);
+    EXPECT_EQ(1u, currentStats().commits) << "offset " << bytes;
+    ASSERT_TRUE(reboot());
+    EXPECT_EQ(next + 1, vehicle.odometer) << "offset " << bytes;
+}
+
+// Slot tujuan masih 0xFF
+TEST_F(Storage, PowerCutOnEmptySlot) {
+    for (int bytes = 0; bytes <= HostAT24C32::PAGE_SIZE; bytes++) {
+        hostEeprom.erase();
+        ASSERT_TRUE(reboot());
+        commitOdometer(1000);
+        commitOdometer(2000);
+        powerCutAt(bytes, 2000, 3000);
+    }
+}
+
+// Ring sudah berputar: slot tujuan berisi record valid yang lebih tua
+TEST_F(Storage, PowerCutOverOldRecord) {
+    hostEeprom.erase();
+    ASSERT_TRUE(reboot());
+    uint32_t odometer = 0;
+    for (int i = 0; i < STORAGE_SLOT_COUNT + 5; i++) commitOdometer(odometer += 100);
+
+    for (int bytes = 0; bytes <= HostAT24C32::PAGE_SIZE; bytes++) {
+        ASSERT_TRUE(reboot());
+        EXPECT_EQ(STORAGE_SLOT_COUNT, currentStats().validSlots);
+        powerCutAt(bytes, odometer, odometer + 50);
+        odometer += 100;
+        commitOdometer(odometer);
+    }
+}
+
+// =============================================
+// WEAR LEVELING
+// =============================================
+// Banyak commit diselingi reboot: slot terbaru ditemukan lewat seq melewati
+// batas ring, dan tiap page ring ditulis rata (selisih paling banyak satu)
+TEST_F(Storage, EvenWearAcrossRing) {
+    hostEeprom.erase();
+    ASSERT_TRUE(reboot());
+
+    const uint32_t commits = 10 * STORAGE_SLOT_COUNT + 7;
+    for (uint32_t i = 1; i <= commits; i++) {
+        commitOdometer(i * 10);
+        if (i % 13 == 0) {
+            ASSERT_TRUE(reboot());
+            EXPECT_EQ(i * 10, vehicle.odometer);
+        }
+    }
+
+    const uint32_t firstPage = STORAGE_BASE_ADDRESS / HostAT24C32::PAGE_SIZE;
+    const uint32_t* ring = hostEeprom.pageWrites + firstPage;
+    uint32_t least = *std::min_element(ring, ring + STORAGE_SLOT_COUNT);
+    uint32_t most = *std::max_element(ring, ring + STORAGE_SLOT_COUNT);
+    uint32_t total = 0;
+    for (int i = 0; i < STORAGE_SLOT_COUNT; i++) total += ring[i];
+
+    EXPECT_EQ(commits, total);
+    EXPECT_LE(most - least, 1u);
+    // Di luar ring tidak pernah ditulis
+    for (int page = 0; page < HostAT24C32::SIZE / HostAT24C32::PAGE_SIZE; page++) {
+        if (page < (int)firstPage || page >= (int)firstPage + STORAGE_SLOT_COUNT) {
+            EXPECT_EQ(0u, hostEeprom.pageWrites[page]) << "page " << page;
+        }
+    }
+
+    ASSERT_TRUE(reboot());
+    EXPECT_EQ(commits * 10, vehicle.odometer);
+    EXPECT_EQ(STORAGE_SLOT_COUNT, currentStats().validSlots);
+}
@@ -0,0 +1,183 @@
+// =============================================
+// FONTCONVERT (PORT ADAFRUIT GFX) - SUBSET FREESANSBOLD FIRMWARE
+// =============================================
+// Sumber: FreeSansBold.ttf dari GNU FreeFont (font yang sama dengan
+// Fonts/FreeSansBold*pt7b.h Adafruit GFX), dirender dengan aturan
+// fontconvert Adafruit: 141 DPI, mono, interpreter TrueType v35, glyph
+// kosong 0x0 dengan yOffset 1, yAdvance = tinggi baris face.
+// Revisi TTF yang dipakai Adafruit lebih baru: bentuk glyph bisa beda satu
+// pixel dan yAdvance lebih kecil (19/26/38 vs 22/29/42 di 9/12/18 pt).
+//
+// Argumen chars: subset untuk firmware (JAMFOXRS/fox_font_*.h). Rentang
+// glyph dari karakter terkecil sampai terbesar; karakter di luar chars jadi
+// glyph kosong 0x0 tanpa advance dan tanpa bitmap. Header subset ikut
+// membawa metrik constexpr (fox_fonts.h) untuk posisi teks saat compile.
+// Tanpa chars: font penuh 0x20..0x7E seperti header Adafruit.
+//
+//   g++ -O2 -I/usr/include/freetype2 fontconvert.cpp -lfreetype -o fontconvert
+//   ./fontconvert FreeSansBold.ttf 9 FreeSansBold9ptLabels " ABDEFLMNOPRSTUY" > ../../JAMFOXRS/fox_font_label9.h
+//   ./fontconvert FreeSansBold.ttf 12 FreeSansBold12ptLabels "LNOPRTY" > ../../JAMFOXRS/fox_font_label12.h
+//   ./fontconvert FreeSansBold.ttf 18 FreeSansBold18ptClock "0123456789:" > ../../JAMFOXRS/fox_font_clock18.h
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_MODULE_H
+#include FT_TRUETYPE_DRIVER_H
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define DPI 141
+#define FIRST_CHAR 0x20
+#define LAST_CHAR 0x7E
+
+struct Glyph {
+    unsigned bitmapOffset, width, height, xAdvance;
+    int xOffset, yOffset;
+};
+
+static std::vector<unsigned char> bitmap;
+static unsigned char bitBuffer = 0, bitCount = 0;
+
+static void enbit(bool on) {
+    if (on) bitBuffer |= 0x80 >> bitCount;
+    if (++bitCount == 8) {
+        bitmap.push_back(bitBuffer);
+        bitBuffer = 0;
+        bitCount = 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s font.ttf size name [chars]\n", argv[0]);
+        return 1;
+    }
+    int size = atoi(argv[2]);
+    const char* name = argv[3];
+    const char* chars = argc > 4 ? argv[4] : NULL;
+
+    int first = FIRST_CHAR, last = LAST_CHAR;
+    if (chars != NULL) {
+        first = 0xFF;
+        last = 0;
+        for (const char* c = chars; *c; c++) {
+            if (*c < FIRST_CHAR || *c > LAST_CHAR) {
+                fprintf(stderr, "Char 0x%02X outside 0x%02X..0x%02X\n", (unsigned char)*c, FIRST_CHAR, LAST_CHAR);
+                return 1;
+            }
+            if (*c < first) first = *c;
+            if (*c > last) last = *c;
+        }
+    }
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library)) return 1;
+    FT_UInt interpreter = TT_INTERPRETER_VERSION_35;
+    FT_Property_Set(library, "truetype", "interpreter-version", &interpreter);
+    if (FT_New_Face(library, argv[1], 0, &face)) {
+        fprintf(stderr, "Font load error\n");
+        return 1;
+    }
+    FT_Set_Char_Size(face, size << 6, 0, DPI, 0);
+
+    std::vector<Glyph> glyphs;
+    for (int c = first; c <= last; c++) {
+        if (chars != NULL && strchr(chars, c) == NULL) {
+            Glyph none = {(unsigned)bitmap.size(), 0, 0, 0, 0, 0};
+            glyphs.push_back(none);
+            continue;
+        }
+        if (FT_Load_Char(face, c, FT_LOAD_TARGET_MONO) ||
+            FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO)) {
+            fprintf(stderr, "Glyph 0x%02X error\n", c);
+            return 1;
+        }
+        FT_Bitmap* bm = &face->glyph->bitmap;
+
+        Glyph g;
+        g.bitmapOffset = (unsigned)bitmap.size();
+        g.width = bm->width;
+        g.height = bm->rows;
+        g.xAdvance = (unsigned)(face->glyph->advance.x >> 6);
+        g.xOffset = face->glyph->bitmap_left;
+        g.yOffset = 1 - face->glyph->bitmap_top;
+
+        // Renderer mono lama memberi 1x1 kosong untuk spasi: simpan 0x0 seperti Adafruit
+        bool empty = true;
+        for (unsigned y = 0; y < bm->rows && empty; y++) {
+            for (unsigned x = 0; x < bm->width; x++) {
+                if (bm->buffer[y * bm->pitch + x / 8] & (0x80 >> (x & 7))) empty = false;
+            }
+        }
+        if (empty) {
+            g.width = g.height = 0;
+            g.xOffset = 0;
+            g.yOffset = 1;
+            glyphs.push_back(g);
+            continue;
+        }
+
+        for (unsigned y = 0; y < bm->rows; y++) {
+            for (unsigned x = 0; x < bm->width; x++) {
+                enbit(bm->buffer[y * bm->pitch + x / 8] & (0x80 >> (x & 7)));
+            }
+        }
+        // Glyph berikutnya mulai di byte baru
+        while (bitCount != 0) enbit(false);
+        glyphs.push_back(g);
+    }
+
+    std::string guard;
+    for (const char* c = name; *c; c++) guard += (char)toupper((unsigned char)*c);
+    guard += "_H";
+
+    printf("// Dibuat oleh host/tools/fontconvert dari GNU FreeFont FreeSansBold %dpt (%s)\n", size, name);
+    if (chars != NULL) printf("// Subset: \"%s\"\n", chars);
+    printf("#ifndef %s\n#define %s\n\n#include <Adafruit_GFX.h>\n", guard.c_str(), guard.c_str());
+    if (chars != NULL) printf("#include \"fox_fonts.h\"\n");
+    printf("\nconst uint8_t %sBitmaps[] PROGMEM = {", name);
+    for (size_t i = 0; i < bitmap.size(); i++) {
+        printf("%s0x%02X%s", (i % 12) == 0 ? "\n  " : " ", bitmap[i], i + 1 < bitmap.size() ? "," : "");
+    }
+    printf(" };\n\n");
+
+    printf("const GFXglyph %sGlyphs[] PROGMEM = {\n", name);
+    for (size_t i = 0; i < glyphs.size(); i++) {
+        const Glyph& g = glyphs[i];
+        int c = first + (int)i;
+        printf("  { %5u, %3u, %3u, %3u, %4d, %4d }%s   // 0x%02X", g.bitmapOffset, g.width, g.height,
+               g.xAdvance, g.xOffset, g.yOffset, i + 1 < glyphs.size() ? "," : " ", c);
+        if (c != '\\') printf(" '%c'", c);
+        printf("\n");
+    }
+    printf("};\n\n");
+
+    printf("const GFXfont %s PROGMEM = {\n", name);
+    printf("  (uint8_t  *)%sBitmaps,\n", name);
+    printf("  (GFXglyph *)%sGlyphs,\n", name);
+    printf("  0x%02X, 0x%02X, %ld };\n", first, last, (long)(face->size->metrics.height >> 6));
+
+    if (chars != NULL) {
+        printf("\n// Lebar tinta, advance, xOffset per glyph untuk posisi teks saat compile\n");
+        printf("constexpr FontGlyphMetric %sMetrics[] = {\n", name);
+        for (size_t i = 0; i < glyphs.size(); i++) {
+            const Glyph& g = glyphs[i];
+            int c = first + (int)i;
+            printf("  { %3u, %3u, %4d }%s   // 0x%02X", g.width, g.xAdvance, g.xOffset, i + 1 < glyphs.size() ? "," : " ", c);
+            if (c != '\\') printf(" '%c'", c);
+            printf("\n");
+        }
+        printf("};\n\n");
+        printf("constexpr FontMetrics %sLayout = {%sMetrics, 0x%02X, 0x%02X};\n", name, name, first, last);
+    }
+    printf("\n#endif\n");
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    return 0;
+}